@@ -14,9 +14,10 @@
  */
 #include "appevent_watcher_impl.h"
 
+#include <algorithm>
 #include <cinttypes>
 
-#include "json/json.h"
+#include "app_event_params_decoder.h"
 #include "log.h"
  
 using namespace OHOS::HiviewDFX;
@@ -135,278 +136,203 @@ void AppEventWatcherImpl::InitReceiver(void (*callbackRef)(char*, CArrRetAppEven
     context_->receiveContext->onReceive = CJLambda::Create(callbackRef);
 }
 
-void ConvertArrBool(CParameters &retValue, const Json::Value& jsonValue)
+template<typename T>
+T* MallocValues(size_t size)
 {
-    retValue.valueType = TYPE_ARRBOOL;
-    bool* retArrValue = static_cast<bool*>(malloc(sizeof(bool) * retValue.size));
-    if (retArrValue == nullptr) {
+    T* values = static_cast<T*>(malloc(sizeof(T) * size));
+    if (values == nullptr) {
         LOGE("malloc is failed");
-        return;
-    }
-    for (size_t i = 0; i < jsonValue.size(); ++i) {
-        retArrValue[i] = jsonValue[static_cast<int>(i)].asBool();
     }
-    retValue.value = retArrValue;
+    return values;
 }
 
-void ConvertArrInt(CParameters &retValue, const Json::Value& jsonValue)
+char** MallocCStrings(const std::vector<std::string>& strs)
 {
-    retValue.valueType = TYPE_ARRINT;
-    int32_t* retArrValue = static_cast<int32_t*>(malloc(sizeof(int32_t) * retValue.size));
-    if (retArrValue == nullptr) {
-        LOGE("malloc is failed");
-        return;
+    char** values = MallocValues<char*>(strs.size());
+    if (values == nullptr) {
+        return nullptr;
     }
-    for (size_t i = 0; i < jsonValue.size(); ++i) {
-        retArrValue[i] = jsonValue[static_cast<int>(i)].asInt();
+    for (size_t i = 0; i < strs.size(); ++i) {
+        values[i] = MallocCString(strs[i]);
     }
-    retValue.value = retArrValue;
+    return values;
 }
 
-void ConvertArrInt64(CParameters &retValue, const Json::Value& jsonValue)
+bool IsInt32(int64_t value)
 {
-    retValue.valueType = TYPE_ARRINT64;
-    int64_t* retArrValue = static_cast<int64_t*>(malloc(sizeof(int64_t) * retValue.size));
-    if (retArrValue == nullptr) {
-        LOGE("malloc is failed");
-        return;
-    }
-    for (size_t i = 0; i < jsonValue.size(); ++i) {
-        retArrValue[i] = jsonValue[static_cast<int>(i)].asInt64();
-    }
-    retValue.value = retArrValue;
+    return value >= INT32_MIN && value <= INT32_MAX;
 }
 
-void CovertArrDouble(CParameters &retValue, const Json::Value& jsonValue)
-{
-    retValue.valueType = TYPE_ARRFLOAT;
-    double* retArrValue = static_cast<double*>(malloc(sizeof(double) * retValue.size));
-    if (retArrValue == nullptr) {
-        LOGE("malloc is failed");
-        return;
-    }
-    for (size_t i = 0; i < jsonValue.size(); ++i) {
-        retArrValue[i] = jsonValue[static_cast<int>(i)].asDouble();
+// converts the decoded params into the cj params, the nested objects and arrays are given as json text
+class CjParamsBuilder : public AppEventParamsHandler {
+public:
+    CjParamsBuilder() = default;
+    ~CjParamsBuilder() override
+    {
+        for (auto& param : params_) {
+            FreeCParameters(param);
+        }
     }
-    retValue.value = retArrValue;
-}
 
-void CovertArrString(CParameters &retValue, const Json::Value& jsonValue)
-{
-    retValue.valueType = TYPE_ARRSTRING;
-    char** retArrValue = static_cast<char**>(malloc(sizeof(char*) * retValue.size));
-    if (retArrValue == nullptr) {
-        LOGE("malloc is failed");
-        return;
+    CArrParameters Release()
+    {
+        CArrParameters params{0};
+        params.head = MallocValues<CParameters>(params_.size());
+        if (params.head == nullptr) {
+            return params;
+        }
+        std::copy(params_.begin(), params_.end(), params.head);
+        params.size = static_cast<int64_t>(params_.size());
+        params_.clear();
+        return params;
     }
-    for (size_t i = 0; i < jsonValue.size(); ++i) {
-        retArrValue[i] = MallocCString(jsonValue[static_cast<int>(i)].asString());
+
+    void OnKey(const std::string& key) override
+    {
+        params_.push_back(CParameters{ .key = MallocCString(key) });
     }
-    retValue.value = retArrValue;
-}
 
-void CovertArrObjStr(CParameters &retValue, const Json::Value& jsonValue)
-{
-    retValue.valueType = TYPE_ARRSTRING;
-    char** retArrValue = static_cast<char**>(malloc(sizeof(char*) * retValue.size));
-    if (retArrValue == nullptr) {
-        LOGE("malloc is failed");
-        return;
+    void OnNull() override
+    {
+        SetString("null");
     }
-    for (size_t i = 0; i < jsonValue.size(); ++i) {
-        Json::FastWriter writer;
-        std::string json_string = writer.write(jsonValue[static_cast<int>(i)]);
-        retArrValue[i] = MallocCString(json_string);
+
+    void OnBool(bool value) override
+    {
+        SetValues<bool>(TYPE_BOOL, 1, [value](bool* values) { values[0] = value; });
     }
-    retValue.value = retArrValue;
-}
 
-bool CheckArrBool(const Json::Value& jsonValue)
-{
-    size_t nBool = 0;
-    for (size_t i = 0; i < jsonValue.size(); ++i) {
-        if (jsonValue[static_cast<int>(i)].isBool()) {
-            nBool++;
+    void OnInt(int64_t value) override
+    {
+        // the ints out of the range of int32 are given as floats
+        if (!IsInt32(value)) {
+            OnDouble(static_cast<double>(value));
+            return;
         }
+        SetValues<int32_t>(TYPE_INT, 1, [value](int32_t* values) { values[0] = static_cast<int32_t>(value); });
     }
-    return nBool == jsonValue.size();
-}
 
-bool CheckArrInt(const Json::Value& jsonValue)
-{
-    size_t nInt = 0;
-    for (size_t i = 0; i < jsonValue.size(); ++i) {
-        if (jsonValue[static_cast<int>(i)].isInt()) {
-            nInt++;
-        }
+    void OnDouble(double value) override
+    {
+        SetValues<double>(TYPE_FLOAT, 1, [value](double* values) { values[0] = value; });
     }
-    return nInt == jsonValue.size();
-}
 
-bool CheckArrInt64(const Json::Value& jsonValue)
-{
-    size_t nInt = 0;
-    for (size_t i = 0; i < jsonValue.size(); ++i) {
-        if (jsonValue[static_cast<int>(i)].isInt64() && jsonValue.type() != Json::ValueType::uintValue) {
-            nInt++;
-        }
+    void OnString(const std::string& value) override
+    {
+        SetString(value);
     }
-    return nInt == jsonValue.size();
-}
 
-bool CheckArrDouble(const Json::Value& jsonValue)
-{
-    size_t nDouble = 0;
-    for (size_t i = 0; i < jsonValue.size(); ++i) {
-        if (jsonValue[static_cast<int>(i)].isDouble()) {
-            nDouble++;
-        }
+    void OnBoolArray(const std::vector<bool>& values) override
+    {
+        SetValues<bool>(TYPE_ARRBOOL, values.size(), [&values](bool* arr) {
+            std::copy(values.begin(), values.end(), arr);
+        });
     }
-    return nDouble == jsonValue.size();
-}
 
-bool CheckArrString(const Json::Value& jsonValue)
-{
-    size_t nString = 0;
-    for (size_t i = 0; i < jsonValue.size(); ++i) {
-        if (jsonValue[static_cast<int>(i)].isString()) {
-            nString++;
+    void OnIntArray(const std::vector<int64_t>& values) override
+    {
+        if (!std::all_of(values.begin(), values.end(), IsInt32)) {
+            SetValues<double>(TYPE_ARRFLOAT, values.size(), [&values](double* arr) {
+                std::copy(values.begin(), values.end(), arr);
+            });
+            return;
         }
+        SetValues<int32_t>(TYPE_ARRINT, values.size(), [&values](int32_t* arr) {
+            std::copy(values.begin(), values.end(), arr);
+        });
     }
-    return nString == jsonValue.size();
-}
 
-void CreatArr(CParameters &retValue, const Json::Value& jsonValue)
-{
-    retValue.size = jsonValue.size();
-    if (CheckArrBool(jsonValue)) {
-        ConvertArrBool(retValue, jsonValue);
-    } else if (CheckArrInt(jsonValue)) {
-        ConvertArrInt(retValue, jsonValue);
-    } else if (CheckArrDouble(jsonValue)) {
-        CovertArrDouble(retValue, jsonValue);
-    } else if (CheckArrString(jsonValue)) {
-        CovertArrString(retValue, jsonValue);
-    } else if (CheckArrInt64(jsonValue)) {
-        ConvertArrInt64(retValue, jsonValue);
-    } else {
-        CovertArrObjStr(retValue, jsonValue);
+    void OnDoubleArray(const std::vector<double>& values) override
+    {
+        SetValues<double>(TYPE_ARRFLOAT, values.size(), [&values](double* arr) {
+            std::copy(values.begin(), values.end(), arr);
+        });
     }
-}
 
-void CreatElmInt(CParameters &retValue, const Json::Value& jsonValue)
-{
-    retValue.size = 1;
-    retValue.valueType = TYPE_INT;
-    int32_t* retInt = static_cast<int32_t*>(malloc(sizeof(int32_t) * retValue.size));
-    if (retInt == nullptr) {
-        LOGE("malloc is failed");
-        return;
+    void OnStringArray(const std::vector<std::string>& values) override
+    {
+        SetStrings(values);
     }
-    retInt[0] = jsonValue.asInt();
-    retValue.value = retInt;
-}
 
-void CreatElmInt64(CParameters &retValue, const Json::Value& jsonValue)
-{
-    retValue.size = 1;
-    retValue.valueType = TYPE_INT64;
-    int64_t* retInt = static_cast<int64_t*>(malloc(sizeof(int64_t) * retValue.size));
-    if (retInt == nullptr) {
-        LOGE("malloc is failed");
-        return;
+    bool OnObjectBegin() override
+    {
+        return false;
     }
-    retInt[0] = jsonValue.asInt64();
-    retValue.value = retInt;
-}
 
-void CreatElmBool(CParameters &retValue, const Json::Value& jsonValue)
-{
-    retValue.size = 1;
-    retValue.valueType = TYPE_BOOL;
-    bool* retBool = static_cast<bool*>(malloc(sizeof(bool) * retValue.size));
-    if (retBool == nullptr) {
-        LOGE("malloc is failed");
-        return;
+    void OnObjectEnd() override {}
+
+    bool OnArrayBegin() override
+    {
+        isInArray_ = true;
+        elements_.clear();
+        return false;
     }
-    retBool[0] = jsonValue.asBool();
-    retValue.value = retBool;
-}
 
-void CreatElmDou(CParameters &retValue, const Json::Value& jsonValue)
-{
-    retValue.size = 1;
-    retValue.valueType = TYPE_FLOAT;
-    double* retF = static_cast<double*>(malloc(sizeof(double) * retValue.size));
-    if (retF == nullptr) {
-        LOGE("malloc is failed");
-        return;
+    void OnArrayEnd() override
+    {
+        isInArray_ = false;
+        if (elements_.empty()) {
+            // the empty arrays are given as bool arrays
+            SetValues<bool>(TYPE_ARRBOOL, 0, [](bool*) {});
+            return;
+        }
+        SetStrings(elements_);
     }
-    retF[0] = jsonValue.asDouble();
-    retValue.value = retF;
-}
 
-void CreatElmStr(CParameters &retValue, const Json::Value& jsonValue)
-{
-    retValue.size = 1;
-    retValue.valueType = TYPE_STRING;
-    retValue.value = MallocCString(jsonValue.asString());
-}
+    void OnRawValue(const char* data, size_t len) override
+    {
+        if (isInArray_) {
+            elements_.emplace_back(data, len);
+            return;
+        }
+        SetString(std::string(data, len));
+    }
+
+private:
+    template<typename T, typename F>
+    void SetValues(uint8_t valueType, size_t size, F fill)
+    {
+        auto& param = params_.back();
+        param.valueType = valueType;
+        param.size = static_cast<int64_t>(size);
+        T* values = MallocValues<T>(size);
+        if (values == nullptr) {
+            return;
+        }
+        fill(values);
+        param.value = values;
+    }
 
-void CreatObjStr(CParameters &retValue, const Json::Value& jsonValue)
-{
-    retValue.size = 1;
-    retValue.valueType = TYPE_STRING;
-    Json::FastWriter writer;
-    std::string json_string = writer.write(jsonValue);
-    retValue.value = MallocCString(json_string);
-}
+    void SetString(const std::string& value)
+    {
+        auto& param = params_.back();
+        param.valueType = TYPE_STRING;
+        param.size = 1;
+        param.value = MallocCString(value);
+    }
 
-void CreateValueByJson(CParameters &retValue, const Json::Value& jsonValue)
-{
-    if (jsonValue.isArray()) {
-        CreatArr(retValue, jsonValue);
-    } else if (jsonValue.isInt()) {
-        CreatElmInt(retValue, jsonValue);
-    } else if (jsonValue.isBool()) {
-        CreatElmBool(retValue, jsonValue);
-    } else if (jsonValue.isDouble()) {
-        CreatElmDou(retValue, jsonValue);
-    } else if (jsonValue.isString()) {
-        CreatElmStr(retValue, jsonValue);
-    } else if (jsonValue.isInt64() && jsonValue.type() != Json::ValueType::uintValue) {
-        CreatElmInt64(retValue, jsonValue);
-    } else {
-        CreatObjStr(retValue, jsonValue);
+    void SetStrings(const std::vector<std::string>& values)
+    {
+        auto& param = params_.back();
+        param.valueType = TYPE_ARRSTRING;
+        param.size = static_cast<int64_t>(values.size());
+        param.value = MallocCStrings(values);
     }
-}
 
-CArrParameters CreateValueByJsonStr(const std::string& jsonStr)
+private:
+    std::vector<CParameters> params_;
+    std::vector<std::string> elements_;
+    bool isInArray_ = false;
+};
+
+CArrParameters CreateParams(const AppEventPack& event)
 {
-    CArrParameters pameters{0};
-    Json::Value jsonValue;
-    Json::Reader reader(Json::Features::strictMode());
-    if (!reader.parse(jsonStr, jsonValue)) {
+    CjParamsBuilder builder;
+    if (!AppEventParamsDecoder::Decode(event, builder)) {
         LOGE("parse event detail info failed, please check the style of json");
-        return pameters;
-    }
-
-    auto eventNameList = jsonValue.getMemberNames();
-    pameters.size = static_cast<int64_t>(eventNameList.size());
-    CParameters* retValue = static_cast<CParameters*>(malloc(sizeof(CParameters) * pameters.size));
-    if (retValue == nullptr) {
-        LOGE("malloc is failed");
-        return pameters;
-    }
-    int i = 0;
-    for (const auto& it : eventNameList) {
-        const auto& propertyName = it;
-        retValue[i].key = MallocCString(propertyName);
-        CreateValueByJson(retValue[i], jsonValue[propertyName]);
-        ++i;
+        return CArrParameters{0};
     }
-    pameters.head = retValue;
-    return pameters;
+    return builder.Release();
 }
 
 void FreeRetValue(RetAppEventGroup* retValue, size_t index)
@@ -460,7 +386,7 @@ CArrRetAppEventGroup getEventGroups(const std::vector<std::shared_ptr<OHOS::Hivi
                 retValue2[i].domain = MallocCString(it.second[i]->GetDomain());
                 retValue2[i].name = MallocCString(it.second[i]->GetName());
                 retValue2[i].event = it.second[i]->GetType();
-                retValue2[i].cArrParamters = CreateValueByJsonStr(it.second[i]->GetParamStr());
+                retValue2[i].cArrParamters = CreateParams(*it.second[i]);
             }
             appEventInfos.head = retValue2;
             retValue1[index++].appEventInfos = appEventInfos;
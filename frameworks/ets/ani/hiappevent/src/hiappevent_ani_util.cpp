@@ -17,7 +17,7 @@
 
 #include <ani_signature_builder.h>
 
-#include "json/json.h"
+#include "app_event_params_decoder.h"
 #include "hiappevent_ani_error_code.h"
 #include "hiappevent_ani_parameter_name.h"
 #include "hilog/log.h"
@@ -696,23 +696,6 @@ ani_object HiAppEventAniUtil::CreateObject(ani_env *env, const std::string &name
     return obj;
 }
 
-static ani_ref CreateBaseValueByJson(ani_env *env, const Json::Value& jsonValue)
-{
-    if (env == nullptr) {
-        return nullptr;
-    }
-    if (jsonValue.isBool()) {
-        return HiAppEventAniUtil::CreateBool(env, jsonValue.asBool());
-    }
-    if (jsonValue.isDouble()) {
-        return HiAppEventAniUtil::CreateDouble(env, jsonValue.asDouble());
-    }
-    if (jsonValue.isString()) {
-        return HiAppEventAniUtil::CreateAniString(env, jsonValue.asString());
-    }
-    return nullptr;
-}
-
 static ani_method GetRecordSetMethod(ani_env *env)
 {
     if (env == nullptr) {
@@ -733,71 +716,165 @@ static ani_method GetRecordSetMethod(ani_env *env)
     return set;
 }
 
-static ani_ref CreateValueByJson(ani_env *env, const Json::Value& jsonValue)
-{
-    if (env == nullptr) {
-        return nullptr;
+namespace {
+// converts the decoded params into a record, the numbers are given as doubles
+class AniParamsBuilder : public AppEventParamsHandler {
+public:
+    explicit AniParamsBuilder(ani_env *env) : env_(env), setMethod_(GetRecordSetMethod(env))
+    {
+        containers_.push_back({ HiAppEventAniUtil::CreateObject(env, CLASS_NAME_RECORD), false, false, {}, "" });
     }
+    ~AniParamsBuilder() override = default;
 
-    if (jsonValue.isArray() && jsonValue[0].isBool()) {
-        ani_ref boolArray = CreateArray(env, CLASS_NAME_BOOLEAN, jsonValue.size());
-        for (Json::ArrayIndex i = 0; i < jsonValue.size(); ++i) {
-            if (env->Array_Set(static_cast<ani_array>(boolArray), static_cast<ani_size>(i),
-                CreateValueByJson(env, jsonValue[static_cast<int>(i)])) != ANI_OK) {
-                HILOG_ERROR(LOG_CORE, "create boolArray failed, Array_Set failed");
-            }
+    ani_ref GetParams() const
+    {
+        return containers_.front().record;
+    }
+
+    void OnKey(const std::string& key) override
+    {
+        key_ = key;
+    }
+
+    void OnNull() override
+    {
+        SetValue(nullptr, false);
+    }
+
+    void OnBool(bool value) override
+    {
+        SetValue(HiAppEventAniUtil::CreateBool(env_, value), true);
+    }
+
+    void OnInt(int64_t value) override
+    {
+        OnDouble(static_cast<double>(value));
+    }
+
+    void OnDouble(double value) override
+    {
+        SetValue(HiAppEventAniUtil::CreateDouble(env_, value), true);
+    }
+
+    void OnString(const std::string& value) override
+    {
+        SetValue(HiAppEventAniUtil::CreateAniString(env_, value), true);
+    }
+
+    void OnBoolArray(const std::vector<bool>& values) override
+    {
+        SetValue(CreateArrayByValues(CLASS_NAME_BOOLEAN, values.size(), [this, &values](size_t i) {
+            return HiAppEventAniUtil::CreateBool(env_, values[i]);
+        }), false);
+    }
+
+    void OnIntArray(const std::vector<int64_t>& values) override
+    {
+        SetValue(CreateArrayByValues(CLASS_NAME_DOUBLE, values.size(), [this, &values](size_t i) {
+            return HiAppEventAniUtil::CreateDouble(env_, static_cast<double>(values[i]));
+        }), false);
+    }
+
+    void OnDoubleArray(const std::vector<double>& values) override
+    {
+        SetValue(CreateArrayByValues(CLASS_NAME_DOUBLE, values.size(), [this, &values](size_t i) {
+            return HiAppEventAniUtil::CreateDouble(env_, values[i]);
+        }), false);
+    }
+
+    void OnStringArray(const std::vector<std::string>& values) override
+    {
+        SetValue(CreateArrayByValues(CLASS_NAME_STRING, values.size(), [this, &values](size_t i) {
+            return HiAppEventAniUtil::CreateAniString(env_, values[i]);
+        }), false);
+    }
+
+    bool OnObjectBegin() override
+    {
+        containers_.push_back({ HiAppEventAniUtil::CreateObject(env_, CLASS_NAME_RECORD), false, false, {}, key_ });
+        return true;
+    }
+
+    void OnObjectEnd() override
+    {
+        Container container = std::move(containers_.back());
+        containers_.pop_back();
+        key_ = std::move(container.key);
+        SetValue(container.record, false);
+    }
+
+    // the length of the array is only known at the end, so the elements are kept until then
+    bool OnArrayBegin() override
+    {
+        containers_.push_back({ nullptr, true, false, {}, key_ });
+        return true;
+    }
+
+    void OnArrayEnd() override
+    {
+        Container container = std::move(containers_.back());
+        containers_.pop_back();
+        key_ = std::move(container.key);
+        // only the arrays starting with a boolean, number or string value are supported
+        if (!container.isFirstScalar) {
+            SetValue(nullptr, false);
+            return;
         }
-        return boolArray;
-    }
-    if (jsonValue.isArray() && jsonValue[0].isDouble()) {
-        ani_ref doubleArray = CreateArray(env, CLASS_NAME_DOUBLE, jsonValue.size());
-        for (Json::ArrayIndex i = 0; i < jsonValue.size(); ++i) {
-            if (env->Array_Set(static_cast<ani_array>(doubleArray), static_cast<ani_size>(i),
-                CreateValueByJson(env, jsonValue[static_cast<int>(i)])) != ANI_OK) {
-                HILOG_ERROR(LOG_CORE, "create doubleArray failed, Array_Set failed");
+        const auto& elements = container.elements;
+        SetValue(CreateArrayByValues(CLASS_NAME_ARRAY, elements.size(), [&elements](size_t i) {
+            return elements[i];
+        }), false);
+    }
+
+    void OnRawValue(const char* data, size_t len) override
+    {
+        // all the objects and arrays are built, so there is no raw value
+        HILOG_WARN(LOG_CORE, "unexpected raw value, len=%{public}zu", len);
+    }
+
+private:
+    struct Container {
+        ani_object record;
+        bool isArray;
+        bool isFirstScalar;
+        std::vector<ani_ref> elements;
+        std::string key; // the key of the container in its parent
+    };
+
+    void SetValue(ani_ref value, bool isScalar)
+    {
+        auto& container = containers_.back();
+        if (container.isArray) {
+            if (container.elements.empty()) {
+                container.isFirstScalar = isScalar;
             }
+            container.elements.emplace_back(value);
+            return;
         }
-        return doubleArray;
-    }
-    if (jsonValue.isArray() && jsonValue[0].isString()) {
-        ani_ref stringArray = CreateArray(env, CLASS_NAME_STRING, jsonValue.size());
-        for (Json::ArrayIndex i = 0; i < jsonValue.size(); ++i) {
-            if (env->Array_Set(static_cast<ani_array>(stringArray), static_cast<ani_size>(i),
-                CreateValueByJson(env, jsonValue[static_cast<int>(i)])) != ANI_OK) {
-                    HILOG_ERROR(LOG_CORE, "create stringArray failed, Array_Set failed");
-            }
+        if (env_->Object_CallMethod_Void(container.record, setMethod_, HiAppEventAniUtil::CreateAniString(env_, key_),
+            value) != ANI_OK) {
+            HILOG_ERROR(LOG_CORE, "set record params Fail: %{public}s", CLASS_NAME_RECORD);
         }
-        return stringArray;
-    }
-    if (jsonValue.isObject()) {
-        ani_object obj = HiAppEventAniUtil::CreateObject(env, CLASS_NAME_RECORD);
-        ani_method set = GetRecordSetMethod(env);
-        auto eventNameList = jsonValue.getMemberNames();
-        for (auto it = eventNameList.cbegin(); it != eventNameList.cend(); ++it) {
-            auto propertyName = *it;
-            if (env->Object_CallMethod_Void(obj, set, HiAppEventAniUtil::CreateAniString(env, propertyName),
-                CreateValueByJson(env, jsonValue[propertyName])) != ANI_OK) {
-                HILOG_ERROR(LOG_CORE, "set record params Fail: %{public}s", CLASS_NAME_RECORD);
-                return obj;
+    }
+
+    template<typename F>
+    ani_ref CreateArrayByValues(const std::string& name, size_t size, F createValue)
+    {
+        ani_ref arr = CreateArray(env_, name, size);
+        for (size_t i = 0; i < size; ++i) {
+            if (env_->Array_Set(static_cast<ani_array>(arr), static_cast<ani_size>(i), createValue(i)) != ANI_OK) {
+                HILOG_ERROR(LOG_CORE, "create %{public}s array failed, Array_Set failed", name.c_str());
             }
         }
-        return obj;
+        return arr;
     }
-    return CreateBaseValueByJson(env, jsonValue);
-}
 
-static ani_ref CreateValueByJsonStr(ani_env *env, const std::string& jsonStr)
-{
-    if (env == nullptr) {
-        return nullptr;
-    }
-    Json::Value jsonValue;
-    Json::Reader reader(Json::Features::strictMode());
-    if (!reader.parse(jsonStr, jsonValue)) {
-        HILOG_ERROR(LOG_CORE, "parse event detail info failed, please check the style of json");
-        return nullptr;
-    }
-    return CreateValueByJson(env, jsonValue);
+private:
+    ani_env *env_;
+    ani_method setMethod_;
+    std::string key_;
+    std::vector<Container> containers_;
+};
 }
 
 static ani_object CreateEventInfo(ani_env *env, std::shared_ptr<AppEventPack> event)
@@ -812,8 +889,14 @@ static ani_object CreateEventInfo(ani_env *env, std::shared_ptr<AppEventPack> ev
         HiAppEventAniUtil::CreateAniString(env, event->GetName()));
     env->Object_SetPropertyByName_Ref(obj, EVENT_INFO_EVENT_TYPE,
         ToAniEnum(env, static_cast<EventTypeAni>(event->GetType())));
-    env->Object_SetPropertyByName_Ref(obj, EVENT_INFO_PARAMS,
-        CreateValueByJsonStr(env, event->GetParamStr()));
+    AniParamsBuilder builder(env);
+    ani_ref params = nullptr;
+    if (AppEventParamsDecoder::Decode(*event, builder)) {
+        params = builder.GetParams();
+    } else {
+        HILOG_ERROR(LOG_CORE, "parse event detail info failed, please check the style of json");
+    }
+    env->Object_SetPropertyByName_Ref(obj, EVENT_INFO_PARAMS, params);
     return obj;
 }
 
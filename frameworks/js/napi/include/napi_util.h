@@ -17,10 +17,11 @@
 #define HIAPPEVENT_FRAMEWORKS_JS_NAPI_INCLUDE_NAPI_UTIL_H
 
 #include <cstdint>
+#include <memory>
 #include <string>
 #include <unordered_set>
+#include <vector>
 
-#include "json/json.h"
 #include "napi/native_api.h"
 #include "napi/native_node_api.h"
 
@@ -81,9 +82,6 @@ std::string CreateErrMsg(const std::string& name);
 std::string CreateErrMsg(const std::string& name, const std::string& type);
 std::string CreateErrMsg(const std::string& name, const napi_valuetype type);
 
-napi_value CreateBaseValueByJson(const napi_env env, const Json::Value& jsonValue);
-napi_value CreateValueByJson(napi_env env, const Json::Value& jsonValue);
-napi_value CreateValueByJsonStr(napi_env env, const std::string& jsonStr);
 napi_value CreateEventInfo(napi_env env, std::shared_ptr<AppEventPack> event);
 napi_value CreateEventInfoArray(napi_env env, const std::vector<std::shared_ptr<AppEventPack>>& events);
 napi_value CreateEventGroups(napi_env env, const std::vector<std::shared_ptr<AppEventPack>>& events);
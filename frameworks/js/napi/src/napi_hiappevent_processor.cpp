@@ -55,6 +55,7 @@ constexpr const char* EVENT_CONFIGS = "eventConfigs";
 constexpr const char* EVENT_CONFIG_DOMAIN = "domain";
 constexpr const char* EVENT_CONFIG_NAME = "name";
 constexpr const char* EVENT_CONFIG_REALTIME = "isRealTime";
+constexpr const char* EVENT_CONFIG_CONDITION = "condition";
 constexpr const char* CONFIG_ID = "configId";
 constexpr const char* CUSTOM_CONFIG = "customConfigs";
 constexpr const char* CONFIG_NAME = "configName";
@@ -247,6 +248,10 @@ int GenConfigReportProp(const napi_env env, const napi_value config, HiAppEvent:
         HILOG_WARN(LOG_CORE, "Parameter error. The event isRealTime parameter is invalid.");
         return ERR_CODE_PARAM_INVALID;
     }
+    if (!GenConfigStrProp(env, config, EVENT_CONFIG_CONDITION, reportConf.condition)) {
+        HILOG_WARN(LOG_CORE, "Parameter error. The event condition parameter is invalid.");
+        return ERR_CODE_PARAM_INVALID;
+    }
     if (!AppEventVerifyFacade::VerifyIsValidEventConfig(reportConf)) {
         HILOG_WARN(LOG_CORE, "Parameter error. The event config is invalid, domain=%{public}s, name=%{public}s.",
             reportConf.domain.c_str(), reportConf.name.c_str());
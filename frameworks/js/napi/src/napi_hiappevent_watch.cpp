@@ -42,6 +42,7 @@ constexpr const char* FILTERS_PROPERTY = "appEventFilters";
 constexpr const char* FILTERS_DOMAIN_PROP = "domain";
 constexpr const char* FILTERS_TYPES_PROP = "eventTypes";
 constexpr const char* FILTERS_NAMES_PROP = "names";
+constexpr const char* FILTERS_CONDITION_PROP = "condition";
 constexpr const char* TRIGGER_PROPERTY = "onTrigger";
 constexpr const char* RECEIVE_PROPERTY = "onReceive";
 constexpr int BIT_MASK = 1;
@@ -236,6 +237,25 @@ TriggerCondition GetCondition(const napi_env env, const napi_value watcher)
     return resCond;
 }
 
+bool GetFilterCondition(const napi_env env, const napi_value filterValue, std::string& condition)
+{
+    napi_value conditionValue = NapiUtil::GetProperty(env, filterValue, FILTERS_CONDITION_PROP);
+    if (conditionValue == nullptr || NapiUtil::GetType(env, conditionValue) == napi_undefined
+        || NapiUtil::IsNull(env, conditionValue)) {
+        return true;
+    }
+    if (!NapiUtil::IsString(env, conditionValue)) {
+        NapiUtil::ThrowError(env, NapiError::ERR_PARAM, NapiUtil::CreateErrMsg(FILTERS_CONDITION_PROP, "string"));
+        return false;
+    }
+    condition = NapiUtil::GetString(env, conditionValue);
+    if (!AppEventVerifyFacade::VerifyIsValidCondition(condition)) {
+        NapiUtil::ThrowError(env, NapiError::ERR_PARAM, "Invalid condition of the filter.");
+        return false;
+    }
+    return true;
+}
+
 void GetFilters(const napi_env env, const napi_value watcher, std::vector<AppEventFilter>& filters)
 {
     napi_value filtersValue = NapiUtil::GetProperty(env, watcher, FILTERS_PROPERTY);
@@ -251,9 +271,14 @@ void GetFilters(const napi_env env, const napi_value watcher, std::vector<AppEve
         if (namesValue != nullptr) {
             NapiUtil::GetStringsToSet(env, namesValue, names);
         }
+        std::string condition;
+        if (!GetFilterCondition(env, filterValue, condition)) {
+            continue;
+        }
         napi_value typesValue = NapiUtil::GetProperty(env, filterValue, FILTERS_TYPES_PROP);
         if (typesValue == nullptr) {
             filters.emplace_back(AppEventFilter(domain, names, BIT_ALL_TYPES));
+            filters.back().SetCondition(condition);
             continue;
         }
         std::vector<int> types;
@@ -269,6 +294,7 @@ void GetFilters(const napi_env env, const napi_value watcher, std::vector<AppEve
         }
         filterType = filterType > 0 ? filterType : BIT_ALL_TYPES;
         filters.emplace_back(AppEventFilter(domain, names, filterType));
+        filters.back().SetCondition(condition);
     }
 }
 
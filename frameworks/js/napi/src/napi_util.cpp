@@ -16,6 +16,7 @@
 
 #include <unordered_map>
 
+#include "app_event_params_decoder.h"
 #include "hiappevent_base.h"
 #include "hilog/log.h"
 #include "napi_error.h"
@@ -554,56 +555,155 @@ std::string CreateErrMsg(const std::string& name, const napi_valuetype type)
     return CreateErrMsg(name, typeStr);
 }
 
-napi_value CreateBaseValueByJson(const napi_env env, const Json::Value& jsonValue)
+namespace {
+template<typename T>
+napi_value CreateArrayByValues(const napi_env env, const std::vector<T>& values,
+    napi_value (*createValue)(const napi_env, T))
 {
-    if (jsonValue.isBool()) {
-        return CreateBoolean(env, jsonValue.asBool());
+    napi_value arr = CreateArray(env);
+    for (size_t i = 0; i < values.size(); ++i) {
+        SetElement(env, arr, i, createValue(env, values[i]));
+    }
+    return arr;
+}
+
+napi_value CreateNumber(const napi_env env, int64_t num)
+{
+    return (num >= INT32_MIN && num <= INT32_MAX) ? CreateInt32(env, static_cast<int32_t>(num)) :
+        CreateInt64(env, num);
+}
+
+// creates the napi values of the params while they are decoded, the objects and arrays being built are kept in a stack
+class NapiParamsBuilder : public AppEventParamsHandler {
+public:
+    explicit NapiParamsBuilder(const napi_env env) : env_(env)
+    {
+        containers_.push_back({ CreateObject(env), false, 0, "" });
+    }
+    ~NapiParamsBuilder() override = default;
+
+    napi_value GetParams() const
+    {
+        return containers_.front().value;
     }
-    if (jsonValue.isInt()) {
-        return CreateInt32(env, jsonValue.asInt());
+
+    void OnKey(const std::string& key) override
+    {
+        key_ = key;
     }
-    if (jsonValue.isInt64() && jsonValue.type() != Json::ValueType::uintValue) {
-        return CreateInt64(env, jsonValue.asInt64());
+
+    void OnNull() override
+    {
+        SetValue(nullptr);
     }
-    if (jsonValue.isDouble()) {
-        return CreateDouble(env, jsonValue.asDouble());
+
+    void OnBool(bool value) override
+    {
+        SetValue(CreateBoolean(env_, value));
     }
-    if (jsonValue.isString()) {
-        return CreateString(env, jsonValue.asString());
+
+    void OnInt(int64_t value) override
+    {
+        SetValue(CreateNumber(env_, value));
     }
-    return nullptr;
-}
 
-napi_value CreateValueByJson(napi_env env, const Json::Value& jsonValue)
-{
-    if (jsonValue.isArray()) {
-        napi_value array = CreateArray(env);
-        for (size_t i = 0; i < jsonValue.size(); ++i) {
-            SetElement(env, array, i, CreateValueByJson(env, jsonValue[static_cast<int>(i)]));
+    void OnDouble(double value) override
+    {
+        SetValue(CreateDouble(env_, value));
+    }
+
+    void OnString(const std::string& value) override
+    {
+        SetValue(CreateString(env_, value));
+    }
+
+    void OnBoolArray(const std::vector<bool>& values) override
+    {
+        napi_value arr = CreateArray(env_);
+        for (size_t i = 0; i < values.size(); ++i) {
+            SetElement(env_, arr, i, CreateBoolean(env_, values[i]));
         }
-        return array;
+        SetValue(arr);
     }
-    if (jsonValue.isObject()) {
-        napi_value obj = CreateObject(env);
-        auto eventNameList = jsonValue.getMemberNames();
-        for (auto it = eventNameList.cbegin(); it != eventNameList.cend(); ++it) {
-            auto propertyName = *it;
-            SetNamedProperty(env, obj, propertyName, CreateValueByJson(env, jsonValue[propertyName]));
+
+    void OnIntArray(const std::vector<int64_t>& values) override
+    {
+        SetValue(CreateArrayByValues<int64_t>(env_, values, CreateNumber));
+    }
+
+    void OnDoubleArray(const std::vector<double>& values) override
+    {
+        SetValue(CreateArrayByValues<double>(env_, values, CreateDouble));
+    }
+
+    void OnStringArray(const std::vector<std::string>& values) override
+    {
+        SetValue(CreateStrings(env_, values));
+    }
+
+    bool OnObjectBegin() override
+    {
+        containers_.push_back({ CreateObject(env_), false, 0, key_ });
+        return true;
+    }
+
+    void OnObjectEnd() override
+    {
+        EndContainer();
+    }
+
+    bool OnArrayBegin() override
+    {
+        containers_.push_back({ CreateArray(env_), true, 0, key_ });
+        return true;
+    }
+
+    void OnArrayEnd() override
+    {
+        EndContainer();
+    }
+
+    void OnRawValue(const char* data, size_t len) override
+    {
+        // all the objects and arrays are built, so there is no raw value
+        HILOG_WARN(LOG_CORE, "unexpected raw value, len=%{public}zu", len);
+    }
+
+private:
+    struct Container {
+        napi_value value;
+        bool isArray;
+        uint32_t index;
+        std::string key; // the key of the container in its parent
+    };
+
+    // the null values are skipped, which leaves a hole in the arrays
+    void SetValue(napi_value value)
+    {
+        auto& container = containers_.back();
+        if (container.isArray) {
+            if (value != nullptr) {
+                SetElement(env_, container.value, container.index, value);
+            }
+            ++container.index;
+        } else if (value != nullptr) {
+            SetNamedProperty(env_, container.value, key_, value);
         }
-        return obj;
     }
-    return CreateBaseValueByJson(env, jsonValue);
-}
 
-napi_value CreateValueByJsonStr(napi_env env, const std::string& jsonStr)
-{
-    Json::Value jsonValue;
-    Json::Reader reader(Json::Features::strictMode());
-    if (!reader.parse(jsonStr, jsonValue)) {
-        HILOG_ERROR(LOG_CORE, "parse event detail info failed, please check the style of json");
-        return nullptr;
+    void EndContainer()
+    {
+        Container container = std::move(containers_.back());
+        containers_.pop_back();
+        key_ = std::move(container.key);
+        SetValue(container.value);
     }
-    return CreateValueByJson(env, jsonValue);
+
+private:
+    napi_env env_;
+    std::string key_;
+    std::vector<Container> containers_;
+};
 }
 
 napi_value CreateEventInfo(napi_env env, std::shared_ptr<AppEventPack> event)
@@ -612,7 +712,12 @@ napi_value CreateEventInfo(napi_env env, std::shared_ptr<AppEventPack> event)
     SetNamedProperty(env, obj, DOMAIN_PROPERTY, CreateString(env, event->GetDomain()));
     SetNamedProperty(env, obj, NAME_PROPERTY, CreateString(env, event->GetName()));
     SetNamedProperty(env, obj, EVENT_TYPE_PROPERTY, CreateInt32(env, event->GetType()));
-    SetNamedProperty(env, obj, PARAM_PROPERTY, CreateValueByJsonStr(env, event->GetParamStr()));
+    NapiParamsBuilder builder(env);
+    if (AppEventParamsDecoder::Decode(*event, builder)) {
+        SetNamedProperty(env, obj, PARAM_PROPERTY, builder.GetParams());
+    } else {
+        HILOG_ERROR(LOG_CORE, "parse event detail info failed, please check the style of json");
+    }
     return obj;
 }
 
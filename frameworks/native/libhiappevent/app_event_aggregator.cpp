@@ -0,0 +1,188 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "app_event_aggregator.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <utility>
+#include <vector>
+
+#include "app_event_crash_ring.h"
+#include "event_aggregation_policy.h"
+#include "ffrt.h"
+#include "ffrt_inner.h"
+#include "hiappevent_base.h"
+#include "hiappevent_write.h"
+#include "hilog/log.h"
+#include "pipeline_metrics.h"
+#include "time_util.h"
+
+#undef LOG_DOMAIN
+#define LOG_DOMAIN 0xD002D07
+
+#undef LOG_TAG
+#define LOG_TAG "Aggregator"
+
+namespace OHOS {
+namespace HiviewDFX {
+namespace {
+constexpr const char* COUNT_PARAM = "count";
+constexpr const char* FIRST_TIME_PARAM = "first_time";
+constexpr const char* LAST_TIME_PARAM = "last_time";
+constexpr const char* FLUSH_TASK_NAME = "app_event_aggregation";
+constexpr char KEY_DELIMITER = '\x1f';
+constexpr size_t MAX_ENTRY_NUM = 1000;
+constexpr uint64_t US_PER_MS = 1000;
+
+void RegisterExitFlush()
+{
+    // registered after the crash ring is created, so that the ring outlives the flush at exit
+    static std::once_flag onceFlag;
+    std::call_once(onceFlag, [] {
+        if (std::atexit([] { AppEventAggregator::GetInstance().FlushToRing(); }) != 0) {
+            HILOG_WARN(LOG_CORE, "failed to register the flush of the aggregated events at exit.");
+        }
+    });
+}
+}
+
+AppEventAggregator& AppEventAggregator::GetInstance()
+{
+    static AppEventAggregator instance;
+    return instance;
+}
+
+bool AppEventAggregator::Aggregate(std::shared_ptr<AppEventPack> event)
+{
+    if (event == nullptr || !EventAggregationPolicy::HasRules()) {
+        return false;
+    }
+    AggregationRule rule;
+    if (!EventAggregationPolicy::GetRule(event->GetDomain(), event->GetName(), rule)) {
+        return false;
+    }
+    std::string key = GetKey(*event, rule);
+    uint64_t time = event->GetTime();
+    int64_t now = TimeUtil::GetElapsedMilliSecondsSinceBoot();
+    std::lock_guard<std::mutex> lockGuard(mutex_);
+    auto it = entries_.find(key);
+    if (it != entries_.end()) {
+        Entry& entry = it->second;
+        ++entry.count;
+        entry.firstTime = std::min(entry.firstTime, time);
+        entry.lastTime = std::max(entry.lastTime, time);
+        PipelineMetrics::Add(PipelineMetrics::WRITE_AGGREGATED);
+        return true;
+    }
+    if (entries_.size() >= MAX_ENTRY_NUM) {
+        HILOG_DEBUG(LOG_CORE, "the number of aggregation entries exceeds the limit %{public}zu.", MAX_ENTRY_NUM);
+        return false;
+    }
+    int64_t deadline = now + static_cast<int64_t>(rule.window);
+    // the held event stays in the crash ring until it is flushed, so that a crash within the window loses nothing
+    entries_.emplace(std::move(key), Entry {
+        .event = event,
+        .count = 1,
+        .firstTime = time,
+        .lastTime = time,
+        .deadline = deadline,
+        .ringToken = AppEventCrashRing::GetInstance().Append(*event),
+    });
+    RegisterExitFlush();
+    ScheduleFlush(deadline, now);
+    return true;
+}
+
+void AppEventAggregator::Flush(bool isForced)
+{
+    std::vector<std::pair<std::shared_ptr<AppEventPack>, uint32_t>> events;
+    {
+        std::lock_guard<std::mutex> lockGuard(mutex_);
+        int64_t now = TimeUtil::GetElapsedMilliSecondsSinceBoot();
+        int64_t nextDeadline = 0;
+        flushTime_ = 0;
+        for (auto it = entries_.begin(); it != entries_.end();) {
+            Entry& entry = it->second;
+            if (!isForced && entry.deadline > now) {
+                nextDeadline = nextDeadline == 0 ? entry.deadline : std::min(nextDeadline, entry.deadline);
+                ++it;
+                continue;
+            }
+            AddAggregatedParams(*(entry.event), entry);
+            events.emplace_back(std::move(entry.event), entry.ringToken);
+            it = entries_.erase(it);
+        }
+        if (nextDeadline != 0) {
+            ScheduleFlush(nextDeadline, now);
+        }
+    }
+    // the events have been sampled before, so they skip the sampler and the aggregator. The held record is only
+    // completed once the flushed event has been appended to the crash ring by the write queue, or published to the
+    // shared ring, so the event is never out of a durable place
+    for (auto& [event, ringToken] : events) {
+        QueueWritingTask(event, FLUSH_TASK_NAME);
+        AppEventCrashRing::GetInstance().Complete(ringToken);
+    }
+}
+
+void AppEventAggregator::FlushToRing()
+{
+    // the process is exiting and the tasks may not run any more, so the held events are completed in the crash
+    // ring with their counters, and they are written by the next startup
+    auto& ring = AppEventCrashRing::GetInstance();
+    std::lock_guard<std::mutex> lockGuard(mutex_);
+    for (auto& [key, entry] : entries_) {
+        AppEventPack event = *(entry.event);
+        AddAggregatedParams(event, entry);
+        if (ring.Append(event) != AppEventCrashRing::INVALID_TOKEN) {
+            ring.Complete(entry.ringToken);
+            entry.ringToken = AppEventCrashRing::INVALID_TOKEN;
+        }
+    }
+}
+
+void AppEventAggregator::AddAggregatedParams(AppEventPack& event, const Entry& entry)
+{
+    event.AddParam(COUNT_PARAM, entry.count);
+    event.AddParam(FIRST_TIME_PARAM, static_cast<int64_t>(entry.firstTime));
+    event.AddParam(LAST_TIME_PARAM, static_cast<int64_t>(entry.lastTime));
+}
+
+std::string AppEventAggregator::GetKey(const AppEventPack& event, const AggregationRule& rule)
+{
+    std::string key = event.GetDomain() + KEY_DELIMITER + event.GetName();
+    if (rule.keys.empty()) {
+        return key + KEY_DELIMITER + event.GetParamStr();
+    }
+    for (const auto& paramName : rule.keys) {
+        key += KEY_DELIMITER + event.GetParamValue(paramName);
+    }
+    return key;
+}
+
+void AppEventAggregator::ScheduleFlush(int64_t deadline, int64_t now)
+{
+    // a flush task which runs no later than the deadline is enough
+    if (flushTime_ != 0 && flushTime_ <= deadline) {
+        return;
+    }
+    flushTime_ = deadline;
+    uint64_t delay = deadline > now ? static_cast<uint64_t>(deadline - now) * US_PER_MS : 0;
+    ffrt::submit([] {
+        AppEventAggregator::GetInstance().Flush();
+    }, ffrt::task_attr().name(FLUSH_TASK_NAME).delay(delay));
+}
+} // namespace HiviewDFX
+} // namespace OHOS
@@ -0,0 +1,402 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "app_event_params_codec.h"
+
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+namespace OHOS {
+namespace HiviewDFX {
+namespace AppEventParamsCodec {
+namespace {
+constexpr uint8_t CODEC_VERSION = 1;
+constexpr uint32_t VARINT_PAYLOAD_BITS = 7;
+constexpr uint64_t VARINT_PAYLOAD_MASK = 0x7f;
+constexpr uint8_t VARINT_MORE_FLAG = 0x80;
+constexpr uint32_t MAX_VARINT_SHIFT = 63;
+constexpr size_t BYTE_BITS = 8;
+constexpr uint8_t MAX_PARAM_TYPE = AppEventParamType::STRVECTOR;
+
+uint64_t ZigzagEncode(int64_t value)
+{
+    return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63); // 63: the sign bit
+}
+
+int64_t ZigzagDecode(uint64_t value)
+{
+    return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+class ParamsWriter {
+public:
+    explicit ParamsWriter(std::vector<uint8_t>& out) : out_(out) {}
+    ~ParamsWriter() = default;
+
+    void Write(const std::list<AppEventParam>& params)
+    {
+        out_.push_back(CODEC_VERSION);
+        WriteVarint(params.size());
+        for (const auto& param : params) {
+            WriteValue(param.name);
+            out_.push_back(static_cast<uint8_t>(param.value.index()));
+            std::visit([this](const auto& value) { WriteValue(value); }, param.value);
+        }
+    }
+
+private:
+    void WriteVarint(uint64_t value)
+    {
+        while (value > VARINT_PAYLOAD_MASK) {
+            out_.push_back(static_cast<uint8_t>(value & VARINT_PAYLOAD_MASK) | VARINT_MORE_FLAG);
+            value >>= VARINT_PAYLOAD_BITS;
+        }
+        out_.push_back(static_cast<uint8_t>(value));
+    }
+
+    void WriteBytes(const void* data, size_t len)
+    {
+        const auto* begin = static_cast<const uint8_t*>(data);
+        out_.insert(out_.end(), begin, begin + len);
+    }
+
+    void WriteValue(const std::monostate&) {}
+
+    void WriteValue(bool value)
+    {
+        out_.push_back(value ? 1 : 0);
+    }
+
+    void WriteValue(char value)
+    {
+        out_.push_back(static_cast<uint8_t>(value));
+    }
+
+    void WriteValue(const std::string& value)
+    {
+        WriteVarint(value.size());
+        WriteBytes(value.data(), value.size());
+    }
+
+    void WriteValue(const std::vector<bool>& values)
+    {
+        WriteVarint(values.size());
+        uint8_t bits = 0;
+        for (size_t i = 0; i < values.size(); ++i) {
+            bits |= static_cast<uint8_t>(values[i] ? 1 : 0) << (i % BYTE_BITS);
+            if ((i % BYTE_BITS) == (BYTE_BITS - 1)) {
+                out_.push_back(bits);
+                bits = 0;
+            }
+        }
+        if ((values.size() % BYTE_BITS) != 0) {
+            out_.push_back(bits);
+        }
+    }
+
+    void WriteValue(const std::vector<char>& values)
+    {
+        WriteVarint(values.size());
+        WriteBytes(values.data(), values.size());
+    }
+
+    void WriteValue(const std::vector<std::string>& values)
+    {
+        WriteVarint(values.size());
+        for (const auto& value : values) {
+            WriteValue(value);
+        }
+    }
+
+    // the integers are zigzag varints, and the floats are copied as they are
+    template<typename T>
+    void WriteValue(T value)
+    {
+        if constexpr (std::is_floating_point_v<T>) {
+            WriteBytes(&value, sizeof(value));
+        } else {
+            WriteVarint(ZigzagEncode(value));
+        }
+    }
+
+    template<typename T>
+    void WriteValue(const std::vector<T>& values)
+    {
+        WriteVarint(values.size());
+        if constexpr (std::is_floating_point_v<T>) {
+            WriteBytes(values.data(), values.size() * sizeof(T));
+        } else {
+            for (auto value : values) {
+                WriteVarint(ZigzagEncode(value));
+            }
+        }
+    }
+
+private:
+    std::vector<uint8_t>& out_;
+};
+
+class ParamsReader {
+public:
+    ParamsReader(const uint8_t* data, size_t len) : cur_(data), end_(data + len) {}
+    ~ParamsReader() = default;
+
+    bool Read(std::list<AppEventParam>& params)
+    {
+        if (cur_ == end_ || *cur_ != CODEC_VERSION) {
+            return false;
+        }
+        ++cur_;
+        size_t paramNum = 0;
+        if (!ReadSize(paramNum, 1)) {
+            return false;
+        }
+        for (size_t i = 0; i < paramNum; ++i) {
+            std::string name;
+            if (!ReadValue(name) || cur_ == end_ || *cur_ > MAX_PARAM_TYPE) {
+                return false;
+            }
+            uint8_t type = *cur_++;
+            AppEventParam& param = params.emplace_back(std::move(name), std::monostate{});
+            if (!ReadParamValue(type, param.value)) {
+                return false;
+            }
+        }
+        return cur_ == end_;
+    }
+
+private:
+    size_t GetRemainingSize() const
+    {
+        return static_cast<size_t>(end_ - cur_);
+    }
+
+    bool ReadVarint(uint64_t& value)
+    {
+        value = 0;
+        for (uint32_t shift = 0; shift <= MAX_VARINT_SHIFT; shift += VARINT_PAYLOAD_BITS) {
+            if (cur_ == end_) {
+                return false;
+            }
+            uint8_t byte = *cur_++;
+            value |= (byte & VARINT_PAYLOAD_MASK) << shift;
+            if ((byte & VARINT_MORE_FLAG) == 0) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // the size is checked against the remaining bytes, so a corrupted size can not cause a huge allocation
+    bool ReadSize(size_t& size, size_t minBytesPerItem)
+    {
+        uint64_t value = 0;
+        if (!ReadVarint(value) || value > GetRemainingSize() / minBytesPerItem) {
+            return false;
+        }
+        size = static_cast<size_t>(value);
+        return true;
+    }
+
+    bool ReadBytes(void* data, size_t len)
+    {
+        if (len > GetRemainingSize()) {
+            return false;
+        }
+        if (len > 0) {
+            (void)memcpy(data, cur_, len);
+        }
+        cur_ += len;
+        return true;
+    }
+
+    bool ReadValue(bool& value)
+    {
+        if (cur_ == end_) {
+            return false;
+        }
+        value = (*cur_++ != 0);
+        return true;
+    }
+
+    bool ReadValue(char& value)
+    {
+        return ReadBytes(&value, sizeof(value));
+    }
+
+    bool ReadValue(std::string& value)
+    {
+        size_t size = 0;
+        if (!ReadSize(size, 1)) {
+            return false;
+        }
+        value.assign(reinterpret_cast<const char*>(cur_), size);
+        cur_ += size;
+        return true;
+    }
+
+    bool ReadValue(std::vector<bool>& values)
+    {
+        uint64_t size = 0;
+        if (!ReadVarint(size) || size > GetRemainingSize() * BYTE_BITS) {
+            return false;
+        }
+        size_t byteNum = (size + BYTE_BITS - 1) / BYTE_BITS;
+        if (byteNum > GetRemainingSize()) {
+            return false;
+        }
+        values.resize(size);
+        for (size_t i = 0; i < size; ++i) {
+            values[i] = ((cur_[i / BYTE_BITS] >> (i % BYTE_BITS)) & 1) != 0;
+        }
+        cur_ += byteNum;
+        return true;
+    }
+
+    bool ReadValue(std::vector<char>& values)
+    {
+        size_t size = 0;
+        if (!ReadSize(size, 1)) {
+            return false;
+        }
+        values.assign(cur_, cur_ + size);
+        cur_ += size;
+        return true;
+    }
+
+    bool ReadValue(std::vector<std::string>& values)
+    {
+        size_t size = 0;
+        if (!ReadSize(size, 1)) {
+            return false;
+        }
+        values.resize(size);
+        for (auto& value : values) {
+            if (!ReadValue(value)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    template<typename T>
+    bool ReadValue(T& value)
+    {
+        if constexpr (std::is_floating_point_v<T>) {
+            return ReadBytes(&value, sizeof(value));
+        } else {
+            uint64_t rawValue = 0;
+            if (!ReadVarint(rawValue)) {
+                return false;
+            }
+            value = static_cast<T>(ZigzagDecode(rawValue));
+            return true;
+        }
+    }
+
+    template<typename T>
+    bool ReadValue(std::vector<T>& values)
+    {
+        size_t size = 0;
+        if constexpr (std::is_floating_point_v<T>) {
+            if (!ReadSize(size, sizeof(T))) {
+                return false;
+            }
+            values.resize(size);
+            return ReadBytes(values.data(), size * sizeof(T));
+        } else {
+            if (!ReadSize(size, 1)) {
+                return false;
+            }
+            values.resize(size);
+            for (auto& value : values) {
+                if (!ReadValue(value)) {
+                    return false;
+                }
+            }
+            return true;
+        }
+    }
+
+    template<size_t Index>
+    bool ReadParamValueAs(AppEventParamValue& value)
+    {
+        return ReadValue(value.emplace<Index>());
+    }
+
+    bool ReadParamValue(uint8_t type, AppEventParamValue& value)
+    {
+        switch (type) {
+            case AppEventParamType::EMPTY:
+                return true;
+            case AppEventParamType::BOOL:
+                return ReadParamValueAs<AppEventParamType::BOOL>(value);
+            case AppEventParamType::CHAR:
+                return ReadParamValueAs<AppEventParamType::CHAR>(value);
+            case AppEventParamType::SHORT:
+                return ReadParamValueAs<AppEventParamType::SHORT>(value);
+            case AppEventParamType::INTEGER:
+                return ReadParamValueAs<AppEventParamType::INTEGER>(value);
+            case AppEventParamType::LONGLONG:
+                return ReadParamValueAs<AppEventParamType::LONGLONG>(value);
+            case AppEventParamType::FLOAT:
+                return ReadParamValueAs<AppEventParamType::FLOAT>(value);
+            case AppEventParamType::DOUBLE:
+                return ReadParamValueAs<AppEventParamType::DOUBLE>(value);
+            case AppEventParamType::STRING:
+                return ReadParamValueAs<AppEventParamType::STRING>(value);
+            case AppEventParamType::BVECTOR:
+                return ReadParamValueAs<AppEventParamType::BVECTOR>(value);
+            case AppEventParamType::CVECTOR:
+                return ReadParamValueAs<AppEventParamType::CVECTOR>(value);
+            case AppEventParamType::SHVECTOR:
+                return ReadParamValueAs<AppEventParamType::SHVECTOR>(value);
+            case AppEventParamType::IVECTOR:
+                return ReadParamValueAs<AppEventParamType::IVECTOR>(value);
+            case AppEventParamType::LLVECTOR:
+                return ReadParamValueAs<AppEventParamType::LLVECTOR>(value);
+            case AppEventParamType::FVECTOR:
+                return ReadParamValueAs<AppEventParamType::FVECTOR>(value);
+            case AppEventParamType::DVECTOR:
+                return ReadParamValueAs<AppEventParamType::DVECTOR>(value);
+            case AppEventParamType::STRVECTOR:
+                return ReadParamValueAs<AppEventParamType::STRVECTOR>(value);
+            default:
+                return false;
+        }
+    }
+
+private:
+    const uint8_t* cur_;
+    const uint8_t* end_;
+};
+}
+
+void Encode(const std::list<AppEventParam>& params, std::vector<uint8_t>& out)
+{
+    ParamsWriter(out).Write(params);
+}
+
+bool Decode(const uint8_t* data, size_t len, std::list<AppEventParam>& params)
+{
+    if (data == nullptr) {
+        return false;
+    }
+    return ParamsReader(data, len).Read(params);
+}
+} // namespace AppEventParamsCodec
+} // namespace HiviewDFX
+} // namespace OHOS
@@ -0,0 +1,689 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "app_event_params_decoder.h"
+
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <list>
+#include <type_traits>
+#include <variant>
+
+#include "hiappevent_base.h"
+#include "string_util.h"
+
+namespace OHOS {
+namespace HiviewDFX {
+namespace AppEventParamsDecoder {
+namespace {
+constexpr int MAX_JSON_DEPTH = 1000; // the same limit as the one of jsoncpp
+constexpr int DEC_BASE = 10;
+
+bool AssignUnescaped(const std::string& value, std::string& out)
+{
+    out.clear();
+    return StringUtil::UnescapeJsonChars(value.data(), value.size(), out);
+}
+
+// the decimals are kept the same as the 6 ones of the json text of the params
+double RoundAsParamStr(double value)
+{
+    return std::strtod(std::to_string(value).c_str(), nullptr);
+}
+
+// gives the typed params which have not been converted to json text, as if they were read from the json text
+class TypedParamsWriter {
+public:
+    explicit TypedParamsWriter(AppEventParamsHandler& handler) : handler_(handler) {}
+    ~TypedParamsWriter() = default;
+
+    bool Write(const std::list<AppEventParam>& params)
+    {
+        for (const auto& param : params) {
+            // the empty params can not be written as json text either
+            if (param.value.index() == AppEventParamType::EMPTY) {
+                continue;
+            }
+            handler_.OnKey(param.name);
+            bool isWritten = std::visit([this](const auto& value) {
+                return WriteValue(value);
+            }, param.value);
+            if (!isWritten) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+private:
+    bool WriteValue(const std::monostate&)
+    {
+        return true;
+    }
+
+    bool WriteValue(bool value)
+    {
+        handler_.OnBool(value);
+        return true;
+    }
+
+    bool WriteValue(char value)
+    {
+        // the char params are written as the strings of their numbers
+        handler_.OnString(std::to_string(value));
+        return true;
+    }
+
+    template<typename T, std::enable_if_t<std::is_integral_v<T>, int> = 0>
+    bool WriteValue(T value)
+    {
+        handler_.OnInt(static_cast<int64_t>(value));
+        return true;
+    }
+
+    bool WriteValue(float value)
+    {
+        handler_.OnDouble(RoundAsParamStr(value));
+        return true;
+    }
+
+    bool WriteValue(double value)
+    {
+        handler_.OnDouble(RoundAsParamStr(value));
+        return true;
+    }
+
+    bool WriteValue(const std::string& value)
+    {
+        // the string params have been escaped when the event is verified
+        if (value.find('\\') == std::string::npos) {
+            handler_.OnString(value);
+            return true;
+        }
+        if (!AssignUnescaped(value, str_)) {
+            return false;
+        }
+        handler_.OnString(str_);
+        return true;
+    }
+
+    bool WriteValue(const std::vector<bool>& values)
+    {
+        if (IsEmptyArray(values)) {
+            return true;
+        }
+        handler_.OnBoolArray(values);
+        return true;
+    }
+
+    bool WriteValue(const std::vector<char>& values)
+    {
+        if (IsEmptyArray(values)) {
+            return true;
+        }
+        strs_.clear();
+        for (auto value : values) {
+            strs_.emplace_back(std::to_string(value));
+        }
+        handler_.OnStringArray(strs_);
+        return true;
+    }
+
+    template<typename T, std::enable_if_t<std::is_integral_v<T>, int> = 0>
+    bool WriteValue(const std::vector<T>& values)
+    {
+        if (IsEmptyArray(values)) {
+            return true;
+        }
+        if constexpr (std::is_same_v<T, int64_t>) {
+            handler_.OnIntArray(values);
+        } else {
+            ints_.assign(values.begin(), values.end());
+            handler_.OnIntArray(ints_);
+        }
+        return true;
+    }
+
+    template<typename T, std::enable_if_t<std::is_floating_point_v<T>, int> = 0>
+    bool WriteValue(const std::vector<T>& values)
+    {
+        if (IsEmptyArray(values)) {
+            return true;
+        }
+        doubles_.clear();
+        for (auto value : values) {
+            doubles_.emplace_back(RoundAsParamStr(value));
+        }
+        handler_.OnDoubleArray(doubles_);
+        return true;
+    }
+
+    bool WriteValue(const std::vector<std::string>& values)
+    {
+        if (IsEmptyArray(values)) {
+            return true;
+        }
+        auto it = values.begin();
+        while (it != values.end() && it->find('\\') == std::string::npos) {
+            ++it;
+        }
+        if (it == values.end()) {
+            handler_.OnStringArray(values);
+            return true;
+        }
+        strs_.assign(values.begin(), it);
+        for (; it != values.end(); ++it) {
+            if (!AssignUnescaped(*it, str_)) {
+                return false;
+            }
+            strs_.emplace_back(str_);
+        }
+        handler_.OnStringArray(strs_);
+        return true;
+    }
+
+    // the empty arrays are given as the ones read from the json text
+    template<typename T>
+    bool IsEmptyArray(const std::vector<T>& values)
+    {
+        if (!values.empty()) {
+            return false;
+        }
+        handler_.OnArrayBegin();
+        handler_.OnArrayEnd();
+        return true;
+    }
+
+private:
+    AppEventParamsHandler& handler_;
+    std::string str_;
+    std::vector<int64_t> ints_;
+    std::vector<double> doubles_;
+    std::vector<std::string> strs_;
+};
+
+enum class ValueKind {
+    NONE,
+    BOOL,
+    INT,
+    DOUBLE,
+    STRING,
+    OTHER,
+};
+
+// reads the json text once without building a value tree, only the arrays of mixed values are read twice
+class ParamsReader {
+public:
+    ParamsReader(const std::string& paramStr, AppEventParamsHandler& handler)
+        : handler_(handler), cur_(paramStr.c_str()), end_(paramStr.c_str() + paramStr.size()) {}
+    ~ParamsReader() = default;
+
+    bool Read()
+    {
+        SkipSpaces();
+        if (cur_ == end_ || *cur_ != '{') {
+            return false;
+        }
+        if (!ReadMembers(0)) {
+            return false;
+        }
+        SkipSpaces();
+        return cur_ == end_;
+    }
+
+private:
+    void SkipSpaces()
+    {
+        while (cur_ < end_ && (*cur_ == ' ' || *cur_ == '\t' || *cur_ == '\n' || *cur_ == '\r')) {
+            ++cur_;
+        }
+    }
+
+    // reads a ',' or the closing char, and sets isClosed if it is the latter
+    bool ReadSeparator(char closingChar, bool& isClosed)
+    {
+        SkipSpaces();
+        if (cur_ == end_ || (*cur_ != ',' && *cur_ != closingChar)) {
+            return false;
+        }
+        isClosed = (*cur_ == closingChar);
+        ++cur_;
+        return true;
+    }
+
+    // returns true if the container is empty, with the closing char skipped
+    bool SkipEmpty(char closingChar)
+    {
+        SkipSpaces();
+        if (cur_ < end_ && *cur_ == closingChar) {
+            ++cur_;
+            return true;
+        }
+        return false;
+    }
+
+    ValueKind PeekKind()
+    {
+        SkipSpaces();
+        if (cur_ == end_) {
+            return ValueKind::NONE;
+        }
+        switch (*cur_) {
+            case '\"':
+                return ValueKind::STRING;
+            case 't':
+            case 'f':
+                return ValueKind::BOOL;
+            case '{':
+            case '[':
+            case 'n':
+                return ValueKind::OTHER;
+            default:
+                return ValueKind::INT; // the number may turn out to be a double after it is read
+        }
+    }
+
+    bool ReadMembers(int depth)
+    {
+        ++cur_; // skip '{'
+        if (SkipEmpty('}')) {
+            return true;
+        }
+        for (bool isClosed = false; !isClosed;) {
+            SkipSpaces();
+            if (!ReadString(str_)) {
+                return false;
+            }
+            handler_.OnKey(str_);
+            SkipSpaces();
+            if (cur_ == end_ || *cur_ != ':') {
+                return false;
+            }
+            ++cur_;
+            if (!ReadValue(depth + 1) || !ReadSeparator('}', isClosed)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool ReadValue(int depth)
+    {
+        if (depth > MAX_JSON_DEPTH) {
+            return false;
+        }
+        SkipSpaces();
+        if (cur_ == end_) {
+            return false;
+        }
+        switch (*cur_) {
+            case '{':
+                return ReadObject(depth);
+            case '[':
+                return ReadArray(depth);
+            case '\"':
+                if (!ReadString(str_)) {
+                    return false;
+                }
+                handler_.OnString(str_);
+                return true;
+            case 'n':
+                if (!ReadLiteral("null")) {
+                    return false;
+                }
+                handler_.OnNull();
+                return true;
+            default:
+                return ReadScalar();
+        }
+    }
+
+    bool ReadScalar()
+    {
+        if (*cur_ == 't' || *cur_ == 'f') {
+            bool value = false;
+            if (!ReadBool(value)) {
+                return false;
+            }
+            handler_.OnBool(value);
+            return true;
+        }
+        bool isInt = false;
+        int64_t intValue = 0;
+        double doubleValue = 0;
+        if (!ReadNumber(isInt, intValue, doubleValue)) {
+            return false;
+        }
+        if (isInt) {
+            handler_.OnInt(intValue);
+        } else {
+            handler_.OnDouble(doubleValue);
+        }
+        return true;
+    }
+
+    bool ReadObject(int depth)
+    {
+        const char* begin = cur_;
+        if (!handler_.OnObjectBegin()) {
+            if (!SkipValue(depth)) {
+                return false;
+            }
+            handler_.OnRawValue(begin, cur_ - begin);
+            return true;
+        }
+        if (!ReadMembers(depth)) {
+            return false;
+        }
+        handler_.OnObjectEnd();
+        return true;
+    }
+
+    bool ReadArray(int depth)
+    {
+        const char* begin = cur_;
+        bool isTyped = false;
+        if (!ReadTypedArray(isTyped)) {
+            return false;
+        }
+        if (isTyped) {
+            return true;
+        }
+        cur_ = begin + 1; // skip '['
+        bool isOpened = handler_.OnArrayBegin();
+        if (SkipEmpty(']')) {
+            handler_.OnArrayEnd();
+            return true;
+        }
+        for (bool isClosed = false; !isClosed;) {
+            if (isOpened) {
+                if (!ReadValue(depth + 1)) {
+                    return false;
+                }
+            } else {
+                SkipSpaces();
+                const char* elementBegin = cur_;
+                if (!SkipValue(depth + 1)) {
+                    return false;
+                }
+                handler_.OnRawValue(elementBegin, cur_ - elementBegin);
+            }
+            if (!ReadSeparator(']', isClosed)) {
+                return false;
+            }
+        }
+        handler_.OnArrayEnd();
+        return true;
+    }
+
+    // reads the array if its elements are of one scalar type, otherwise sets isTyped to false to read it again
+    bool ReadTypedArray(bool& isTyped)
+    {
+        ++cur_; // skip '['
+        isTyped = false;
+        if (SkipEmpty(']')) {
+            return true;
+        }
+        ValueKind arrKind = ValueKind::NONE;
+        bools_.clear();
+        ints_.clear();
+        doubles_.clear();
+        strs_.clear();
+        for (bool isClosed = false; !isClosed;) {
+            ValueKind kind = PeekKind();
+            if (kind == ValueKind::NONE) {
+                return false;
+            }
+            bool isNumber = (kind == ValueKind::INT) && (arrKind == ValueKind::NONE || arrKind == ValueKind::INT ||
+                arrKind == ValueKind::DOUBLE);
+            if (kind == ValueKind::OTHER || (arrKind != ValueKind::NONE && arrKind != kind && !isNumber)) {
+                return true;
+            }
+            if (!ReadElement(kind, arrKind) || !ReadSeparator(']', isClosed)) {
+                return false;
+            }
+        }
+        isTyped = true;
+        switch (arrKind) {
+            case ValueKind::BOOL:
+                handler_.OnBoolArray(bools_);
+                break;
+            case ValueKind::INT:
+                handler_.OnIntArray(ints_);
+                break;
+            case ValueKind::DOUBLE:
+                handler_.OnDoubleArray(doubles_);
+                break;
+            default:
+                handler_.OnStringArray(strs_);
+                break;
+        }
+        return true;
+    }
+
+    bool ReadElement(ValueKind kind, ValueKind& arrKind)
+    {
+        if (kind == ValueKind::STRING) {
+            if (!ReadString(str_)) {
+                return false;
+            }
+            strs_.emplace_back(str_);
+            arrKind = kind;
+            return true;
+        }
+        if (kind == ValueKind::BOOL) {
+            bool value = false;
+            if (!ReadBool(value)) {
+                return false;
+            }
+            bools_.emplace_back(value);
+            arrKind = kind;
+            return true;
+        }
+        bool isInt = false;
+        int64_t intValue = 0;
+        double doubleValue = 0;
+        if (!ReadNumber(isInt, intValue, doubleValue)) {
+            return false;
+        }
+        if (isInt && arrKind != ValueKind::DOUBLE) {
+            ints_.emplace_back(intValue);
+            arrKind = ValueKind::INT;
+            return true;
+        }
+        if (arrKind == ValueKind::INT) {
+            doubles_.assign(ints_.begin(), ints_.end());
+        }
+        doubles_.emplace_back(isInt ? static_cast<double>(intValue) : doubleValue);
+        arrKind = ValueKind::DOUBLE;
+        return true;
+    }
+
+    // skips a value with its syntax checked
+    bool SkipValue(int depth)
+    {
+        if (depth > MAX_JSON_DEPTH) {
+            return false;
+        }
+        SkipSpaces();
+        if (cur_ == end_) {
+            return false;
+        }
+        bool isClosed = false;
+        switch (*cur_) {
+            case '{':
+                ++cur_;
+                if (SkipEmpty('}')) {
+                    return true;
+                }
+                while (!isClosed) {
+                    SkipSpaces();
+                    const char* begin = nullptr;
+                    size_t len = 0;
+                    if (!ReadStringChars(begin, len)) {
+                        return false;
+                    }
+                    SkipSpaces();
+                    if (cur_ == end_ || *cur_ != ':') {
+                        return false;
+                    }
+                    ++cur_;
+                    if (!SkipValue(depth + 1) || !ReadSeparator('}', isClosed)) {
+                        return false;
+                    }
+                }
+                return true;
+            case '[':
+                ++cur_;
+                if (SkipEmpty(']')) {
+                    return true;
+                }
+                while (!isClosed) {
+                    if (!SkipValue(depth + 1) || !ReadSeparator(']', isClosed)) {
+                        return false;
+                    }
+                }
+                return true;
+            default:
+                return SkipScalar();
+        }
+    }
+
+    bool SkipScalar()
+    {
+        if (*cur_ == '\"') {
+            const char* begin = nullptr;
+            size_t len = 0;
+            return ReadStringChars(begin, len);
+        }
+        if (*cur_ == 'n') {
+            return ReadLiteral("null");
+        }
+        if (*cur_ == 't' || *cur_ == 'f') {
+            bool value = false;
+            return ReadBool(value);
+        }
+        bool isInt = false;
+        int64_t intValue = 0;
+        double doubleValue = 0;
+        return ReadNumber(isInt, intValue, doubleValue);
+    }
+
+    // gives the chars between the quotation marks, with the escapes unresolved
+    bool ReadStringChars(const char*& begin, size_t& len)
+    {
+        if (cur_ == end_ || *cur_ != '\"') {
+            return false;
+        }
+        begin = ++cur_;
+        while (cur_ < end_) {
+            if (*cur_ == '\"') {
+                len = static_cast<size_t>(cur_ - begin);
+                ++cur_;
+                return true;
+            }
+            if (*cur_ == '\\' && ++cur_ == end_) {
+                return false;
+            }
+            ++cur_;
+        }
+        return false;
+    }
+
+    bool ReadString(std::string& out)
+    {
+        const char* begin = nullptr;
+        size_t len = 0;
+        if (!ReadStringChars(begin, len)) {
+            return false;
+        }
+        out.clear();
+        return StringUtil::UnescapeJsonChars(begin, len, out);
+    }
+
+    bool ReadLiteral(const char* literal)
+    {
+        size_t len = std::strlen(literal);
+        if (static_cast<size_t>(end_ - cur_) < len || std::memcmp(cur_, literal, len) != 0) {
+            return false;
+        }
+        cur_ += len;
+        return true;
+    }
+
+    bool ReadBool(bool& value)
+    {
+        value = (*cur_ == 't');
+        return ReadLiteral(value ? "true" : "false");
+    }
+
+    bool ReadNumber(bool& isInt, int64_t& intValue, double& doubleValue)
+    {
+        const char* begin = cur_;
+        isInt = true;
+        if (*cur_ == '-') {
+            ++cur_;
+        }
+        while (cur_ < end_ && ((*cur_ >= '0' && *cur_ <= '9') || *cur_ == '.' || *cur_ == 'e' || *cur_ == 'E' ||
+            *cur_ == '+' || *cur_ == '-')) {
+            isInt = isInt && (*cur_ >= '0' && *cur_ <= '9');
+            ++cur_;
+        }
+        if (cur_ == begin) {
+            return false;
+        }
+        // the chars of the number are always followed by another char or the terminating null char
+        char* numEnd = nullptr;
+        if (isInt) {
+            errno = 0;
+            long long num = std::strtoll(begin, &numEnd, DEC_BASE);
+            if (numEnd == cur_ && errno == 0) {
+                intValue = static_cast<int64_t>(num);
+                return true;
+            }
+            isInt = false; // the ints out of the range of int64 are taken as doubles
+        }
+        doubleValue = std::strtod(begin, &numEnd);
+        return numEnd == cur_;
+    }
+
+private:
+    AppEventParamsHandler& handler_;
+    const char* cur_;
+    const char* end_;
+    std::string str_;
+    std::vector<bool> bools_;
+    std::vector<int64_t> ints_;
+    std::vector<double> doubles_;
+    std::vector<std::string> strs_;
+};
+}
+
+bool Decode(const AppEventPack& event, AppEventParamsHandler& handler)
+{
+    const auto* typedParams = event.GetTypedParams();
+    if (typedParams != nullptr) {
+        return TypedParamsWriter(handler).Write(*typedParams);
+    }
+    return Decode(event.GetParamStr(), handler);
+}
+
+bool Decode(const std::string& paramStr, AppEventParamsHandler& handler)
+{
+    return ParamsReader(paramStr, handler).Read();
+}
+} // namespace AppEventParamsDecoder
+} // namespace HiviewDFX
+} // namespace OHOS
@@ -0,0 +1,264 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "app_event_sampler.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <random>
+#include <sstream>
+#include <thread>
+
+#include "hiappevent_base.h"
+#include "hilog/log.h"
+#include "pipeline_metrics.h"
+
+#undef LOG_DOMAIN
+#define LOG_DOMAIN 0xD002D07
+
+#undef LOG_TAG
+#define LOG_TAG "Sampler"
+
+namespace OHOS {
+namespace HiviewDFX {
+namespace {
+constexpr const char* ALL_NAMES = "*";
+constexpr const char* SAMPLE_RATE_PARAM = "sample_rate";
+constexpr size_t MAX_RULE_NUM = 100;
+constexpr size_t MAX_PARAM_NUM = 32; // the same limit as the verification of the params
+constexpr int64_t NS_PER_SECOND = 1000 * 1000 * 1000;
+constexpr size_t RULE_DOMAIN_INDEX = 0;
+constexpr size_t RULE_NAME_INDEX = 1;
+constexpr size_t RULE_TYPE_INDEX = 2;
+constexpr size_t RULE_ARG_INDEX = 3;
+constexpr size_t RULE_BURST_INDEX = 4;
+
+int64_t GetSteadyTimeNs()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+double GetRandomNum()
+{
+    thread_local std::minstd_rand engine(static_cast<uint32_t>(
+        std::hash<std::thread::id>()(std::this_thread::get_id()) ^ static_cast<size_t>(GetSteadyTimeNs())));
+    return std::uniform_real_distribution<double>(0.0, 1.0)(engine);
+}
+
+void SplitStr(const std::string& str, char delimiter, std::vector<std::string>& elems)
+{
+    std::stringstream ss(str);
+    std::string elem;
+    while (std::getline(ss, elem, delimiter)) {
+        elems.emplace_back(elem);
+    }
+}
+
+bool ParseNum(const std::string& str, double& num)
+{
+    char* end = nullptr;
+    num = std::strtod(str.c_str(), &end);
+    return !str.empty() && end != nullptr && *end == '\0';
+}
+
+bool IsValidRule(const SamplingRule& rule)
+{
+    switch (rule.type) {
+        case SamplingType::NONE:
+            return true;
+        case SamplingType::ONE_IN_N:
+            return rule.interval > 0;
+        case SamplingType::RATIO:
+            return rule.ratio > 0.0 && rule.ratio <= 1.0;
+        case SamplingType::TOKEN_BUCKET:
+            return rule.rate > 0.0 && rule.burst > 0;
+        default:
+            return false;
+    }
+}
+
+bool ParseRule(const std::vector<std::string>& elems, SamplingRule& rule)
+{
+    const std::string& type = elems[RULE_TYPE_INDEX];
+    double arg = 0.0;
+    if (type == "none") {
+        rule.type = SamplingType::NONE;
+        return elems.size() == RULE_ARG_INDEX;
+    }
+    if (elems.size() <= RULE_ARG_INDEX || !ParseNum(elems[RULE_ARG_INDEX], arg)) {
+        return false;
+    }
+    if (type == "one_in_n" && elems.size() == (RULE_ARG_INDEX + 1) && arg >= 1.0 && arg <= UINT32_MAX) {
+        rule.type = SamplingType::ONE_IN_N;
+        rule.interval = static_cast<uint32_t>(arg);
+        return true;
+    }
+    if (type == "ratio" && elems.size() == (RULE_ARG_INDEX + 1)) {
+        rule.type = SamplingType::RATIO;
+        rule.ratio = arg;
+        return true;
+    }
+    if (type == "token_bucket") {
+        rule.type = SamplingType::TOKEN_BUCKET;
+        rule.rate = arg;
+        double burst = 1.0;
+        if (elems.size() == (RULE_BURST_INDEX + 1) && (!ParseNum(elems[RULE_BURST_INDEX], burst) ||
+            burst < 1.0 || burst > UINT32_MAX)) {
+            return false;
+        }
+        rule.burst = static_cast<uint32_t>(burst);
+        return elems.size() <= (RULE_BURST_INDEX + 1);
+    }
+    return false;
+}
+}
+
+AppEventSampler& AppEventSampler::GetInstance()
+{
+    static AppEventSampler instance;
+    return instance;
+}
+
+bool AppEventSampler::SetRule(const std::string& ruleStr)
+{
+    // the format of the rule is "domain,name,type[,arg[,burst]]", e.g. "com_demo,click,one_in_n,10"
+    std::vector<std::string> elems;
+    SplitStr(ruleStr, ',', elems);
+    SamplingRule rule;
+    if (elems.size() <= RULE_TYPE_INDEX || !ParseRule(elems, rule)) {
+        HILOG_ERROR(LOG_CORE, "invalid sampling rule=%{public}s.", ruleStr.c_str());
+        return false;
+    }
+    return SetRule(elems[RULE_DOMAIN_INDEX], elems[RULE_NAME_INDEX], rule);
+}
+
+bool AppEventSampler::SetRule(const std::string& domain, const std::string& name, const SamplingRule& rule)
+{
+    if (domain.empty() || name.empty() || !IsValidRule(rule)) {
+        HILOG_ERROR(LOG_CORE, "invalid sampling rule of domain=%{public}s, name=%{public}s.",
+            domain.c_str(), name.c_str());
+        return false;
+    }
+    std::lock_guard<std::mutex> lockGuard(mutex_);
+    SnapshotReader<RuleTable> curTable(tables_);
+    auto table = curTable.Get() == nullptr ? std::make_unique<RuleTable>() :
+        std::make_unique<RuleTable>(*(curTable.Get()));
+    if (rule.type == SamplingType::NONE) {
+        auto it = table->find(domain);
+        if (it != table->end()) {
+            it->second.erase(name);
+            if (it->second.empty()) {
+                table->erase(it);
+            }
+        }
+    } else {
+        size_t ruleNum = 0;
+        for (const auto& domainRules : *table) {
+            ruleNum += domainRules.second.size();
+        }
+        if (ruleNum >= MAX_RULE_NUM && ((*table)[domain].count(name) == 0)) {
+            HILOG_ERROR(LOG_CORE, "the number of sampling rules exceeds the limit %{public}zu.", MAX_RULE_NUM);
+            return false;
+        }
+        auto state = std::make_shared<RuleState>();
+        state->rule = rule;
+        if (rule.type == SamplingType::TOKEN_BUCKET) {
+            state->emissionInterval = static_cast<int64_t>(NS_PER_SECOND / rule.rate);
+            state->burstTolerance = state->emissionInterval * static_cast<int64_t>(rule.burst - 1);
+        }
+        (*table)[domain][name] = state;
+    }
+    tables_.Publish(table->empty() ? nullptr : std::move(table));
+    HILOG_INFO(LOG_CORE, "set sampling rule of domain=%{public}s, name=%{public}s, type=%{public}d.",
+        domain.c_str(), name.c_str(), static_cast<int>(rule.type));
+    return true;
+}
+
+void AppEventSampler::ClearRules()
+{
+    std::lock_guard<std::mutex> lockGuard(mutex_);
+    tables_.Publish(nullptr);
+}
+
+bool AppEventSampler::Sample(AppEventPack& event)
+{
+    SnapshotReader<RuleTable> table(tables_);
+    if (table.Get() == nullptr) {
+        return true;
+    }
+    auto domainIt = table->find(event.GetDomain());
+    if (domainIt == table->end()) {
+        return true;
+    }
+    const auto& rules = domainIt->second;
+    auto ruleIt = rules.find(event.GetName());
+    if (ruleIt == rules.end()) {
+        ruleIt = rules.find(ALL_NAMES);
+        if (ruleIt == rules.end()) {
+            return true;
+        }
+    }
+    double sampleRate = 1.0;
+    if (!IsKept(*(ruleIt->second), sampleRate)) {
+        PipelineMetrics::Add(PipelineMetrics::WRITE_DROPPED_SAMPLING);
+        return false;
+    }
+    // the param is added after the event is verified, so it must neither repeat a param nor exceed the limit
+    const auto* params = event.GetTypedParams();
+    if (params == nullptr || params->size() >= MAX_PARAM_NUM || event.FindBaseParam(SAMPLE_RATE_PARAM) != nullptr) {
+        HILOG_WARN(LOG_CORE, "no room for the param %{public}s of the event %{public}s.", SAMPLE_RATE_PARAM,
+            event.GetName().c_str());
+        return true;
+    }
+    event.AddParam(SAMPLE_RATE_PARAM, sampleRate);
+    return true;
+}
+
+bool AppEventSampler::IsKept(RuleState& state, double& sampleRate)
+{
+    uint64_t seenNum = state.seenNum.fetch_add(1, std::memory_order_relaxed) + 1;
+    const SamplingRule& rule = state.rule;
+    switch (rule.type) {
+        case SamplingType::ONE_IN_N:
+            sampleRate = 1.0 / rule.interval;
+            return (seenNum - 1) % rule.interval == 0;
+        case SamplingType::RATIO:
+            sampleRate = rule.ratio;
+            return GetRandomNum() < rule.ratio;
+        case SamplingType::TOKEN_BUCKET: {
+            // generic cell rate algorithm, the token bucket is kept as the theoretical arrival time of the event
+            int64_t now = GetSteadyTimeNs();
+            int64_t arrivalTime = state.arrivalTime.load(std::memory_order_relaxed);
+            int64_t newArrivalTime = 0;
+            do {
+                int64_t startTime = std::max(arrivalTime, now);
+                if (startTime - now > state.burstTolerance) {
+                    sampleRate = static_cast<double>(state.keptNum.load(std::memory_order_relaxed)) / seenNum;
+                    return false;
+                }
+                newArrivalTime = startTime + state.emissionInterval;
+            } while (!state.arrivalTime.compare_exchange_weak(arrivalTime, newArrivalTime,
+                std::memory_order_relaxed));
+            uint64_t keptNum = state.keptNum.fetch_add(1, std::memory_order_relaxed) + 1;
+            sampleRate = static_cast<double>(keptNum) / seenNum;
+            return true;
+        }
+        default:
+            return true;
+    }
+}
+} // namespace HiviewDFX
+} // namespace OHOS
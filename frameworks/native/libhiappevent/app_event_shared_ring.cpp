@@ -0,0 +1,537 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "app_event_shared_ring.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <csignal>
+#include <ctime>
+#include <fstream>
+#include <linux/futex.h>
+#include <pthread.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include "app_event_record.h"
+#include "app_event_write_queue.h"
+#include "file_util.h"
+#include "hiappevent_base.h"
+#include "hiappevent_config.h"
+#include "hilog/log.h"
+#include "time_util.h"
+
+#undef LOG_DOMAIN
+#define LOG_DOMAIN 0xD002D07
+
+#undef LOG_TAG
+#define LOG_TAG "SharedRing"
+
+namespace OHOS {
+namespace HiviewDFX {
+namespace {
+constexpr const char* RING_DIR = "ipc";
+constexpr const char* RING_FILE = "event_ring";
+constexpr const char* LOCK_FILE = "owner.lock";
+constexpr const char* WRITER_LOCK_FILE = "writer.lock";
+constexpr const char* POLL_TASK_NAME = "app_event_shared_ring";
+constexpr const char* POLL_THREAD_NAME = "OS_AppEvent_Rg";
+constexpr uint32_t RING_CAPACITY = 1024 * 1024; // 1M, must be a power of two
+constexpr uint32_t RING_MAGIC = 0x48415352; // "HASR"
+constexpr uint32_t RING_VERSION = 2;
+constexpr size_t HEADER_SIZE = 64;
+constexpr uint32_t RECORD_ALIGN = 16;
+constexpr uint32_t MAX_RECORD_RATIO = 4; // one record takes a quarter of the ring at most
+constexpr mode_t RING_FILE_MODE = 0660;
+constexpr uint64_t ELECT_INTERVAL = 1000; // 1s
+constexpr time_t STALL_CHECK_INTERVAL = 1; // 1s
+constexpr size_t POLL_BATCH_NUM = 200;
+
+enum RecordState : uint32_t {
+    FREE = 0,
+    WRITING,
+    COMMITTED,
+    PADDING,
+};
+
+struct RingHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t capacity;
+    std::atomic<uint32_t> head;
+    std::atomic<uint32_t> tail;
+    std::atomic<uint32_t> doorbell;
+    std::atomic<uint32_t> isOwnerWaiting;
+};
+
+// the pid of the writer is set before the state, so that the record of a dead writer can be told apart
+struct RecordHeader {
+    std::atomic<uint32_t> state;
+    uint32_t pos;
+    uint32_t len;
+    uint32_t checksum;
+    int32_t pid;
+    uint32_t reserved[3];
+};
+
+static_assert(sizeof(RingHeader) <= HEADER_SIZE, "ring header is too large");
+static_assert(sizeof(RecordHeader) % RECORD_ALIGN == 0, "record header must be aligned");
+static_assert(std::atomic<uint32_t>::is_always_lock_free, "the ring requires lock-free atomics");
+static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t), "the doorbell must be usable as a futex");
+
+uint32_t AlignUp(uint32_t len)
+{
+    return (len + RECORD_ALIGN - 1) & ~(RECORD_ALIGN - 1);
+}
+
+RingHeader* GetRingHeader(uint8_t* base)
+{
+    return reinterpret_cast<RingHeader*>(base);
+}
+
+uint8_t* GetRecordAddr(uint8_t* base, uint32_t capacity, uint32_t pos)
+{
+    return base + HEADER_SIZE + (pos & (capacity - 1));
+}
+
+RecordHeader* GetRecordHeader(uint8_t* base, uint32_t capacity, uint32_t pos)
+{
+    return reinterpret_cast<RecordHeader*>(GetRecordAddr(base, capacity, pos));
+}
+
+// the space is cleared before it is released, so that a writer never sees the state of an old record
+void ClearSpace(uint8_t* base, uint32_t capacity, uint32_t begin, uint32_t end)
+{
+    while (begin != end) {
+        uint32_t len = std::min(end - begin, capacity - (begin & (capacity - 1)));
+        (void)memset(GetRecordAddr(base, capacity, begin), 0, len);
+        begin += len;
+    }
+}
+
+// returns the position of the first record after the one at tail whose header has been written, or head if none
+uint32_t FindNextRecord(uint8_t* base, uint32_t capacity, uint32_t tail, uint32_t head)
+{
+    for (uint32_t pos = tail + RECORD_ALIGN; pos != head; pos += RECORD_ALIGN) {
+        auto record = GetRecordHeader(base, capacity, pos);
+        uint32_t state = record->state.load(std::memory_order_acquire);
+        if (state != FREE && state <= PADDING && record->pos == pos) {
+            return pos;
+        }
+    }
+    return head;
+}
+
+uint32_t* GetFutexAddr(std::atomic<uint32_t>& doorbell)
+{
+    return reinterpret_cast<uint32_t*>(&doorbell);
+}
+
+// the doorbell lives in the shared file, so the futex is not private and wakes the owner in another process
+void RingDoorbell(RingHeader* header)
+{
+    header->doorbell.fetch_add(1);
+    if (header->isOwnerWaiting.load() != 0) {
+        (void)syscall(SYS_futex, GetFutexAddr(header->doorbell), FUTEX_WAKE, 1, nullptr, nullptr, 0);
+    }
+}
+
+// returns at once if the doorbell has been rung since it was read as bell
+void WaitDoorbell(RingHeader* header, uint32_t bell, const struct timespec* timeout)
+{
+    header->isOwnerWaiting.store(1);
+    (void)syscall(SYS_futex, GetFutexAddr(header->doorbell), FUTEX_WAIT, bell, timeout, nullptr, 0);
+    header->isOwnerWaiting.store(0);
+}
+
+bool IsProcessAlive(int32_t pid)
+{
+    return pid > 0 && (kill(pid, 0) == 0 || errno != ESRCH);
+}
+
+// the secondary processes of an application are named as "bundleName:processName"
+bool IsMainProcess()
+{
+    static const bool isMainProcess = [] {
+        std::ifstream file("/proc/self/cmdline");
+        std::string processName;
+        std::getline(file, processName, '\0');
+        return !processName.empty() && processName.find(':') == std::string::npos;
+    }();
+    return isMainProcess;
+}
+}
+
+AppEventSharedRing& AppEventSharedRing::GetInstance()
+{
+    static AppEventSharedRing instance;
+    return instance;
+}
+
+AppEventSharedRing::~AppEventSharedRing()
+{
+    StopPoll();
+}
+
+bool AppEventSharedRing::Publish(const AppEventPack& event)
+{
+    if (!HiAppEventConfig::GetInstance().IsMultiProcess()) {
+        return false;
+    }
+    if (!isInit_) {
+        Init();
+    }
+    // the owner writes its own events directly, and so does a process whose event does not fit into the ring
+    return !IsOwner() && Append(event);
+}
+
+void AppEventSharedRing::Elect()
+{
+    if (!HiAppEventConfig::GetInstance().IsMultiProcess() || !IsMainProcess()) {
+        return;
+    }
+    if (!isInit_) {
+        Init();
+    }
+    (void)IsOwner();
+}
+
+void AppEventSharedRing::Init()
+{
+    std::string dir = HiAppEventConfig::GetInstance().GetStorageDir();
+    if (dir.empty()) {
+        HILOG_WARN(LOG_CORE, "storage dir is empty, the shared ring is disabled.");
+        isInit_ = true;
+        return;
+    }
+    (void)Open(FileUtil::GetFilePathByDir(dir, RING_DIR), RING_CAPACITY);
+}
+
+bool AppEventSharedRing::Open(const std::string& dir, uint32_t capacity)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    isInit_ = true;
+    if (base_.load() != nullptr) {
+        return true;
+    }
+    if (capacity == 0 || (capacity & (capacity - 1)) != 0) {
+        HILOG_ERROR(LOG_CORE, "invalid ring capacity=%{public}u.", capacity);
+        return false;
+    }
+    if (!FileUtil::IsFileExists(dir) && !FileUtil::ForceCreateDirectory(dir)) {
+        HILOG_ERROR(LOG_CORE, "failed to create ring dir, errno=%{public}d.", errno);
+        return false;
+    }
+    int fd = open(FileUtil::GetFilePathByDir(dir, RING_FILE).c_str(), O_RDWR | O_CREAT | O_CLOEXEC, RING_FILE_MODE);
+    if (fd < 0) {
+        HILOG_ERROR(LOG_CORE, "failed to open ring file, errno=%{public}d.", errno);
+        return false;
+    }
+    if (!InitRingFile(fd, capacity)) {
+        close(fd);
+        return false;
+    }
+    size_t mapSize = HEADER_SIZE + capacity;
+    void* addr = mmap(nullptr, mapSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (addr == MAP_FAILED) {
+        HILOG_ERROR(LOG_CORE, "failed to map ring file, errno=%{public}d.", errno);
+        return false;
+    }
+    lockFd_ = open(FileUtil::GetFilePathByDir(dir, LOCK_FILE).c_str(), O_RDWR | O_CREAT | O_CLOEXEC, RING_FILE_MODE);
+    writerLockPath_ = FileUtil::GetFilePathByDir(dir, WRITER_LOCK_FILE);
+    writerLockFd_ = open(writerLockPath_.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, RING_FILE_MODE);
+    if (lockFd_ < 0 || writerLockFd_ < 0) {
+        HILOG_ERROR(LOG_CORE, "failed to open lock file, errno=%{public}d.", errno);
+        CloseLockFiles();
+        (void)munmap(addr, mapSize);
+        return false;
+    }
+    capacity_ = capacity;
+    mapSize_ = mapSize;
+    base_.store(static_cast<uint8_t*>(addr), std::memory_order_release);
+    return true;
+}
+
+bool AppEventSharedRing::InitRingFile(int fd, uint32_t capacity)
+{
+    // the processes may open the ring at the same time, so the file is checked and initialized under the file lock
+    if (flock(fd, LOCK_EX) != 0) {
+        HILOG_ERROR(LOG_CORE, "failed to lock ring file, errno=%{public}d.", errno);
+        return false;
+    }
+    size_t mapSize = HEADER_SIZE + capacity;
+    RingHeader header {};
+    struct stat statBuf {};
+    bool isValid = fstat(fd, &statBuf) == 0 && static_cast<size_t>(statBuf.st_size) == mapSize
+        && pread(fd, &header, sizeof(header), 0) == static_cast<ssize_t>(sizeof(header))
+        && header.magic == RING_MAGIC && header.version == RING_VERSION && header.capacity == capacity;
+    if (!isValid) {
+        // the size is reset first, so that the records of an old ring are cleared
+        RingHeader newHeader {};
+        newHeader.magic = RING_MAGIC;
+        newHeader.version = RING_VERSION;
+        newHeader.capacity = capacity;
+        isValid = ftruncate(fd, 0) == 0 && ftruncate(fd, static_cast<off_t>(mapSize)) == 0
+            && pwrite(fd, &newHeader, sizeof(newHeader), 0) == static_cast<ssize_t>(sizeof(newHeader));
+        if (!isValid) {
+            HILOG_ERROR(LOG_CORE, "failed to init ring file, errno=%{public}d.", errno);
+        }
+    }
+    (void)flock(fd, LOCK_UN);
+    return isValid;
+}
+
+void AppEventSharedRing::Close()
+{
+    // the poll thread reads the ring, so it is stopped before the ring is unmapped
+    StopPoll();
+    std::lock_guard<std::mutex> lock(mutex_);
+    uint8_t* base = base_.exchange(nullptr);
+    if (base != nullptr) {
+        (void)munmap(base, mapSize_);
+    }
+    CloseLockFiles();
+    isOwner_ = false;
+    isWriter_ = false;
+    isInit_ = false;
+    electTime_ = 0;
+}
+
+void AppEventSharedRing::CloseLockFiles()
+{
+    // the owner lock and the writer lock are released with the files
+    if (lockFd_ >= 0) {
+        close(lockFd_);
+        lockFd_ = -1;
+    }
+    if (writerLockFd_ >= 0) {
+        close(writerLockFd_);
+        writerLockFd_ = -1;
+    }
+}
+
+bool AppEventSharedRing::AttachWriter()
+{
+    // every process appending to the ring holds a shared lock until it exits, so the owner knows whether any
+    // writer is still alive
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (isWriter_) {
+        return true;
+    }
+    if (writerLockFd_ < 0 || flock(writerLockFd_, LOCK_SH) != 0) {
+        HILOG_ERROR(LOG_CORE, "failed to lock writer file, errno=%{public}d.", errno);
+        return false;
+    }
+    isWriter_ = true;
+    return true;
+}
+
+bool AppEventSharedRing::HasLiveWriter() const
+{
+    // the exclusive lock is only taken when no writer holds the shared lock any more
+    int fd = open(writerLockPath_.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return true;
+    }
+    bool isLocked = flock(fd, LOCK_EX | LOCK_NB) != 0;
+    close(fd);
+    return isLocked;
+}
+
+bool AppEventSharedRing::IsOwner()
+{
+    if (isOwner_ || !IsMainProcess() || base_.load(std::memory_order_acquire) == nullptr) {
+        return isOwner_;
+    }
+    // only the main process drains the ring, so that the events of all the processes reach its observers. The lock
+    // may still be held by the last main process while it exits, so it is checked again at most once a second
+    uint64_t now = TimeUtil::GetMilliseconds();
+    uint64_t electTime = electTime_;
+    if (now < electTime + ELECT_INTERVAL || !electTime_.compare_exchange_strong(electTime, now)) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (isOwner_ || lockFd_ < 0 || flock(lockFd_, LOCK_EX | LOCK_NB) != 0) {
+        return isOwner_;
+    }
+    HILOG_INFO(LOG_CORE, "the process becomes the owner of the shared ring.");
+    isOwner_ = true;
+    pollThread_ = std::make_unique<std::thread>([this] { Poll(); });
+    return true;
+}
+
+bool AppEventSharedRing::Append(const AppEventPack& event)
+{
+    uint8_t* base = base_.load(std::memory_order_acquire);
+    if (base == nullptr) {
+        return false;
+    }
+    std::string data = AppEventRecord::Encode(event);
+    uint32_t len = static_cast<uint32_t>(data.size());
+    if (data.size() > capacity_ / MAX_RECORD_RATIO || (!isWriter_ && !AttachWriter())) {
+        return false;
+    }
+    uint32_t recordLen = AlignUp(sizeof(RecordHeader) + len);
+    auto header = GetRingHeader(base);
+    uint32_t oldHead = header->head.load(std::memory_order_relaxed);
+    uint32_t paddingLen = 0;
+    do {
+        uint32_t offset = oldHead & (capacity_ - 1);
+        // a record never crosses the end of the ring, the remaining space is padded instead
+        paddingLen = offset + recordLen > capacity_ ? capacity_ - offset : 0;
+        if (oldHead + paddingLen + recordLen - header->tail.load(std::memory_order_acquire) > capacity_) {
+            return false;
+        }
+    } while (!header->head.compare_exchange_weak(oldHead, oldHead + paddingLen + recordLen,
+        std::memory_order_acq_rel, std::memory_order_relaxed));
+    if (paddingLen > 0) {
+        auto padding = GetRecordHeader(base, capacity_, oldHead);
+        padding->pos = oldHead;
+        padding->len = paddingLen - sizeof(RecordHeader);
+        padding->state.store(PADDING, std::memory_order_release);
+    }
+    uint32_t pos = oldHead + paddingLen;
+    auto record = GetRecordHeader(base, capacity_, pos);
+    record->pos = pos;
+    record->len = len;
+    record->pid = getpid();
+    record->state.store(WRITING, std::memory_order_release);
+    (void)memcpy(GetRecordAddr(base, capacity_, pos) + sizeof(RecordHeader), data.data(), len);
+    record->checksum = AppEventRecord::GetChecksum(reinterpret_cast<const uint8_t*>(data.data()), len);
+    record->state.store(COMMITTED, std::memory_order_release);
+    RingDoorbell(header);
+    return true;
+}
+
+size_t AppEventSharedRing::Consume(std::vector<std::shared_ptr<AppEventPack>>& events, size_t maxNum)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    uint8_t* base = base_.load(std::memory_order_acquire);
+    if (base == nullptr) {
+        return 0;
+    }
+    auto header = GetRingHeader(base);
+    uint32_t tail = header->tail.load(std::memory_order_relaxed);
+    uint32_t head = header->head.load(std::memory_order_acquire);
+    size_t num = 0;
+    while (tail != head && num < maxNum) {
+        auto record = GetRecordHeader(base, capacity_, tail);
+        uint32_t state = record->state.load(std::memory_order_acquire);
+        bool isReady = (state == COMMITTED || state == PADDING) && record->pos == tail
+            && record->len <= capacity_ - (tail & (capacity_ - 1)) - sizeof(RecordHeader);
+        if (!isReady) {
+            // the writer has reserved the space but not finished the record yet
+            if (!Skip(tail, head)) {
+                break;
+            }
+            continue;
+        }
+        uint32_t recordLen = AlignUp(sizeof(RecordHeader) + record->len);
+        const uint8_t* data = GetRecordAddr(base, capacity_, tail) + sizeof(RecordHeader);
+        if (state == COMMITTED && AppEventRecord::GetChecksum(data, record->len) == record->checksum) {
+            auto event = AppEventRecord::Decode(std::string(reinterpret_cast<const char*>(data), record->len));
+            if (event != nullptr) {
+                events.emplace_back(event);
+                ++num;
+            }
+        }
+        ClearSpace(base, capacity_, tail, tail + recordLen);
+        tail += recordLen;
+        header->tail.store(tail, std::memory_order_release);
+    }
+    return num;
+}
+
+bool AppEventSharedRing::Skip(uint32_t& tail, uint32_t head)
+{
+    // the record is only skipped once its writer is known to be dead, however long it takes. A slow writer still
+    // owns the space, and it would write into the space reused by the others if the space were released
+    uint8_t* base = base_.load();
+    auto record = GetRecordHeader(base, capacity_, tail);
+    bool isWriting = record->state.load(std::memory_order_acquire) == WRITING && record->pos == tail
+        && record->len <= capacity_ - (tail & (capacity_ - 1)) - sizeof(RecordHeader);
+    uint32_t next = tail;
+    if (isWriting) {
+        // a live pid may have been reused by another process, so the writer lock is checked as well
+        if (IsProcessAlive(record->pid) && HasLiveWriter()) {
+            return false;
+        }
+        HILOG_WARN(LOG_CORE, "skip the record left unfinished by a dead writer, pos=%{public}u.", tail);
+        next = tail + AlignUp(sizeof(RecordHeader) + record->len);
+    } else {
+        // the writer has not written the header, so it is only known to be dead once no writer is alive, and then
+        // the record ends where the next written header starts
+        if (HasLiveWriter()) {
+            return false;
+        }
+        HILOG_WARN(LOG_CORE, "skip the record reserved by a dead writer, pos=%{public}u.", tail);
+        next = FindNextRecord(base, capacity_, tail, head);
+    }
+    ClearSpace(base, capacity_, tail, next);
+    tail = next;
+    GetRingHeader(base)->tail.store(tail, std::memory_order_release);
+    return true;
+}
+
+void AppEventSharedRing::Poll()
+{
+    if (pthread_setname_np(pthread_self(), POLL_THREAD_NAME) != 0) {
+        HILOG_WARN(LOG_CORE, "failed to set the name of the poll thread.");
+    }
+    auto header = GetRingHeader(base_.load());
+    while (true) {
+        // the doorbell is read before the ring is consumed, so an event appended meanwhile ends the wait at once
+        uint32_t bell = header->doorbell.load();
+        if (!isOwner_) {
+            return;
+        }
+        std::vector<std::shared_ptr<AppEventPack>> events;
+        size_t num = Consume(events, POLL_BATCH_NUM);
+        for (const auto& event : events) {
+            AppEventWriteQueue::GetInstance().Push(event, POLL_TASK_NAME);
+        }
+        if (num == POLL_BATCH_NUM) {
+            continue;
+        }
+        // an idle ring is waited without a timeout, while a record left unfinished is checked again once a second
+        // until it is written or its writer has died
+        bool isStalled = header->tail.load(std::memory_order_acquire)
+            != header->head.load(std::memory_order_acquire);
+        struct timespec timeout = { STALL_CHECK_INTERVAL, 0 };
+        WaitDoorbell(header, bell, isStalled ? &timeout : nullptr);
+    }
+}
+
+void AppEventSharedRing::StopPoll()
+{
+    std::unique_ptr<std::thread> pollThread;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        isOwner_ = false;
+        pollThread = std::move(pollThread_);
+    }
+    if (pollThread == nullptr) {
+        return;
+    }
+    RingDoorbell(GetRingHeader(base_.load()));
+    pollThread->join();
+}
+} // namespace HiviewDFX
+} // namespace OHOS
@@ -0,0 +1,316 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "app_event_write_queue.h"
+
+#include <chrono>
+#include <cinttypes>
+
+#include "app_event_crash_ring.h"
+#include "app_event_observer_mgr.h"
+#include "app_event_record.h"
+#include "ffrt.h"
+#include "hiappevent_base.h"
+#include "hiappevent_write.h"
+#include "hilog/log.h"
+#include "pipeline_metrics.h"
+#include "time_util.h"
+
+#undef LOG_DOMAIN
+#define LOG_DOMAIN 0xD002D07
+
+#undef LOG_TAG
+#define LOG_TAG "WriteQueue"
+
+namespace OHOS {
+namespace HiviewDFX {
+namespace {
+constexpr int FAULT = 1;
+constexpr int STATISTIC = 2;
+constexpr int SECURITY = 3;
+constexpr size_t DRAIN_BATCH_NUM = 50;
+constexpr size_t MAX_DROP_RECORD_NUM = 100;
+constexpr uint64_t SUMMARY_INTERVAL = 10 * 1000; // 10s
+constexpr const char* SUMMARY_DOMAIN = "api_diagnostic";
+constexpr const char* SUMMARY_NAME = "write_queue_overflow";
+
+thread_local bool g_isDrainThread = false;
+
+AppEventWriteQueue::Lane GetEventLane(std::shared_ptr<AppEventPack> event)
+{
+    switch (event->GetType()) {
+        case FAULT:
+            return AppEventWriteQueue::URGENT_LANE;
+        case SECURITY:
+            return AppEventWriteQueue::SECURITY_LANE;
+        case STATISTIC:
+            return AppEventWriteQueue::STATISTIC_LANE;
+        default:
+            break;
+    }
+    return AppEventObserverMgr::GetInstance().IsRealTimeEvent(event) ?
+        AppEventWriteQueue::URGENT_LANE : AppEventWriteQueue::BEHAVIOR_LANE;
+}
+
+const char* GetPolicyName(WriteOverflowPolicy policy)
+{
+    switch (policy) {
+        case WriteOverflowPolicy::DROP_NEWEST:
+            return "drop_newest";
+        case WriteOverflowPolicy::DROP_OLDEST:
+            return "drop_oldest";
+        case WriteOverflowPolicy::BLOCK:
+            return "block";
+        case WriteOverflowPolicy::SAMPLE:
+            return "sample";
+        default:
+            return "";
+    }
+}
+}
+
+AppEventWriteQueue& AppEventWriteQueue::GetInstance()
+{
+    static AppEventWriteQueue instance;
+    return instance;
+}
+
+bool AppEventWriteQueue::Push(std::shared_ptr<AppEventPack> event, const std::string& taskName)
+{
+    if (event == nullptr) {
+        HILOG_ERROR(LOG_CORE, "event is null.");
+        return false;
+    }
+    WriteQueueConfig config = HiAppEventConfig::GetInstance().GetWriteQueueConfig();
+    size_t size = event->GetEstimatedSize();
+    Lane lane = GetEventLane(event);
+    // the record is encoded before the lock is taken, and the event is kept in the crash ring from the moment it is
+    // admitted until it is written, so that the queued events are not lost if the app crashes
+    auto& ring = AppEventCrashRing::GetInstance();
+    std::string record = ring.IsReady() ? AppEventRecord::Encode(*event) : "";
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (!Admit(lock, config, size, lane)) {
+        RecordDrop(*event);
+        return false;
+    }
+    uint32_t ringToken = record.empty() ? AppEventCrashRing::INVALID_TOKEN :
+        ring.Append(record.data(), static_cast<uint32_t>(record.size()));
+    lanes_[lane].emplace_back(Item { event, size, lane, PipelineMetrics::NowUs(), ringToken,
+        PipelineTrace::AsyncTrace(PipelineTrace::WRITE_QUEUE) });
+    ++num_;
+    size_ += size;
+    PipelineMetrics::UpdateGauge(PipelineMetrics::WRITE_QUEUE_EVENTS, 1);
+    if (isDraining_) {
+        return true;
+    }
+    isDraining_ = true;
+    lock.unlock();
+    SubmitDrainTask(taskName);
+    return true;
+}
+
+size_t AppEventWriteQueue::GetSize()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return num_;
+}
+
+size_t AppEventWriteQueue::GetSize(Lane lane)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return lane < LANE_NUM ? lanes_[lane].size() : 0;
+}
+
+bool AppEventWriteQueue::IsFull(const WriteQueueConfig& config, size_t size) const
+{
+    // an empty queue always accepts one event, so that a single large event is not starved
+    return num_ != 0 && (num_ >= config.capacity || size_ + size > config.maxSize);
+}
+
+bool AppEventWriteQueue::Admit(std::unique_lock<std::mutex>& lock, const WriteQueueConfig& config,
+    size_t size, Lane lane)
+{
+    if (!IsFull(config, size)) {
+        if (config.policy != WriteOverflowPolicy::SAMPLE) {
+            return true;
+        }
+        // start sampling once the queue is half full, before any event has to be dropped
+        bool isHalfFull = num_ >= config.capacity / 2 || size_ + size > config.maxSize / 2; // 2: half
+        return !isHalfFull || (sampleCnt_++ % config.sampleRate) == 0;
+    }
+    switch (config.policy) {
+        case WriteOverflowPolicy::DROP_OLDEST:
+            return EvictOldest(config, size, lane);
+        case WriteOverflowPolicy::BLOCK:
+            // the draining task must not wait for itself
+            if (g_isDrainThread) {
+                return false;
+            }
+            return notFullCond_.wait_for(lock, std::chrono::milliseconds(config.blockTimeout),
+                [this, &config, size] { return !IsFull(config, size); });
+        case WriteOverflowPolicy::SAMPLE:
+            // keep sampling once the queue is full, the sampled event takes the place of the oldest one
+            return (sampleCnt_++ % config.sampleRate) == 0 && EvictOldest(config, size, lane);
+        default:
+            return false;
+    }
+}
+
+bool AppEventWriteQueue::EvictOldest(const WriteQueueConfig& config, size_t size, Lane maxLane)
+{
+    while (IsFull(config, size)) {
+        size_t lane = 0;
+        while (lane <= maxLane && lanes_[lane].empty()) {
+            ++lane;
+        }
+        if (lane > maxLane) {
+            return false;
+        }
+        auto& item = lanes_[lane].front();
+        RecordDrop(*(item.event));
+        item.queueTrace.Finish();
+        AppEventCrashRing::GetInstance().Complete(item.ringToken);
+        size_ -= item.size;
+        --num_;
+        lanes_[lane].pop_front();
+        PipelineMetrics::UpdateGauge(PipelineMetrics::WRITE_QUEUE_EVENTS, -1);
+    }
+    return true;
+}
+
+void AppEventWriteQueue::PopFront(std::vector<Item>& items, size_t num)
+{
+    // the urgent events are taken alone, so that they are not held back by writing a batch of the other lanes
+    for (size_t lane = LANE_NUM; lane > 0 && items.size() < num; --lane) {
+        auto& queue = lanes_[lane - 1];
+        while (!queue.empty() && items.size() < num) {
+            size_ -= queue.front().size;
+            items.emplace_back(std::move(queue.front()));
+            queue.pop_front();
+        }
+        if (lane - 1 == URGENT_LANE && !items.empty()) {
+            break;
+        }
+    }
+    num_ -= items.size();
+    PipelineMetrics::UpdateGauge(PipelineMetrics::WRITE_QUEUE_EVENTS, -static_cast<int64_t>(items.size()));
+}
+
+int AppEventWriteQueue::GetDrainQos() const
+{
+    return lanes_[URGENT_LANE].empty() ? ffrt_qos_default : ffrt_qos_user_initiated;
+}
+
+void AppEventWriteQueue::RecordDrop(const AppEventPack& event)
+{
+    PipelineMetrics::Add(PipelineMetrics::WRITE_DROPPED_OVERFLOW);
+    if (dropNum_ == 0) {
+        HILOG_WARN(LOG_CORE, "write queue is full, start to drop events.");
+    }
+    ++dropNum_;
+    auto key = std::make_pair(event.GetDomain(), event.GetName());
+    auto it = dropNums_.find(key);
+    if (it != dropNums_.end()) {
+        ++(it->second);
+    } else if (dropNums_.size() < MAX_DROP_RECORD_NUM) {
+        dropNums_.emplace(std::move(key), 1);
+    }
+}
+
+std::shared_ptr<AppEventPack> AppEventWriteQueue::TakeDropSummary(bool isDrained, WriteOverflowPolicy policy)
+{
+    if (dropNum_ == 0) {
+        return nullptr;
+    }
+    uint64_t curTime = TimeUtil::GetMilliseconds();
+    if (!isDrained && curTime < lastSummaryTime_ + SUMMARY_INTERVAL) {
+        return nullptr;
+    }
+    std::vector<std::string> domains;
+    std::vector<std::string> names;
+    std::vector<int64_t> dropNums;
+    for (const auto& [key, num] : dropNums_) {
+        domains.emplace_back(key.first);
+        names.emplace_back(key.second);
+        dropNums.emplace_back(static_cast<int64_t>(num));
+    }
+    auto summary = std::make_shared<AppEventPack>(SUMMARY_DOMAIN, SUMMARY_NAME, STATISTIC);
+    summary->AddParam("policy", GetPolicyName(policy));
+    summary->AddParam("drop_num", static_cast<int64_t>(dropNum_));
+    summary->AddParam("domains", domains);
+    summary->AddParam("names", names);
+    summary->AddParam("drop_nums", dropNums);
+    HILOG_WARN(LOG_CORE, "write queue dropped %{public}" PRIu64 " events.", dropNum_);
+    dropNums_.clear();
+    dropNum_ = 0;
+    lastSummaryTime_ = curTime;
+    return summary;
+}
+
+void AppEventWriteQueue::SubmitDrainTask(const std::string& taskName)
+{
+    int qos = ffrt_qos_default;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        qos = GetDrainQos();
+    }
+    AppEventObserverMgr::GetInstance().SubmitTaskToFFRTQueue([this, taskName] {
+        Drain(taskName);
+        }, taskName, qos);
+}
+
+void AppEventWriteQueue::Drain(const std::string& taskName)
+{
+    // the events are taken in small batches to keep the lock short, and one task writes at most one queue of
+    // events, so that the other tasks of the queue are not starved by a writer that never stops. The lanes are
+    // checked again before each batch, so an urgent event waits for one batch of the other lanes at most
+    uint32_t capacity = HiAppEventConfig::GetInstance().GetWriteQueueConfig().capacity;
+    uint32_t writtenNum = 0;
+    bool isDrained = false;
+    bool needYield = false;
+    g_isDrainThread = true;
+    while (!isDrained && !needYield) {
+        std::vector<Item> items;
+        std::shared_ptr<AppEventPack> summary;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            PopFront(items, DRAIN_BATCH_NUM);
+            isDrained = num_ == 0;
+            isDraining_ = !isDrained;
+            summary = TakeDropSummary(isDrained, HiAppEventConfig::GetInstance().GetWriteQueueConfig().policy);
+        }
+        notFullCond_.notify_all();
+        auto& ring = AppEventCrashRing::GetInstance();
+        uint64_t now = PipelineMetrics::NowUs();
+        for (const auto& item : items) {
+            item.queueTrace.Finish();
+            PipelineMetrics::Observe(static_cast<PipelineMetrics::Histogram>(PipelineMetrics::LANE_WAIT_BEHAVIOR +
+                item.lane), now - item.enqueueTime);
+            WriteEvent(item.event);
+            ring.Complete(item.ringToken);
+        }
+        if (summary != nullptr) {
+            WriteEvent(summary);
+        }
+        writtenNum += items.size();
+        needYield = writtenNum >= capacity;
+    }
+    g_isDrainThread = false;
+    if (!isDrained) {
+        SubmitDrainTask(taskName);
+    }
+}
+
+} // namespace HiviewDFX
+} // namespace OHOS
@@ -0,0 +1,393 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "app_event_crash_ring.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "app_event_record.h"
+#include "file_util.h"
+#include "hiappevent_base.h"
+#include "hiappevent_config.h"
+#include "hilog/log.h"
+#include "time_util.h"
+
+#undef LOG_DOMAIN
+#define LOG_DOMAIN 0xD002D07
+
+#undef LOG_TAG
+#define LOG_TAG "CrashRing"
+
+namespace OHOS {
+namespace HiviewDFX {
+namespace {
+constexpr const char* RING_DIR = "ring";
+constexpr const char* RING_FILE_PREFIX = "inflight_events";
+constexpr uint32_t RING_CAPACITY = 1024 * 1024; // 1M, must be a power of two
+constexpr uint32_t RING_MAGIC = 0x48414552; // "HAER"
+constexpr uint32_t RING_VERSION = 1;
+constexpr size_t HEADER_SIZE = 64;
+constexpr uint32_t RECORD_ALIGN = 16;
+constexpr uint32_t MAX_RECORD_RATIO = 4; // one record takes a quarter of the ring at most
+constexpr mode_t RING_FILE_MODE = 0660;
+constexpr int MAX_CREATE_TIMES = 16;
+
+enum RecordState : uint32_t {
+    FREE = 0,
+    WRITING,
+    PENDING,
+    DONE,
+    PADDING,
+};
+
+struct RingHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t capacity;
+    std::atomic<uint32_t> head;
+};
+
+// the position is the offset of the record in the stream of all records, and it is used to recognize the
+// records that have been overwritten
+struct RecordHeader {
+    std::atomic<uint32_t> state;
+    uint32_t pos;
+    uint32_t len;
+    uint32_t checksum;
+};
+
+static_assert(sizeof(RingHeader) <= HEADER_SIZE, "ring header is too large");
+static_assert(sizeof(RecordHeader) == RECORD_ALIGN, "record header must be aligned");
+static_assert(std::atomic<uint32_t>::is_always_lock_free, "the ring requires lock-free atomics");
+
+uint32_t AlignUp(uint32_t len)
+{
+    return (len + RECORD_ALIGN - 1) & ~(RECORD_ALIGN - 1);
+}
+
+RingHeader* GetRingHeader(uint8_t* base)
+{
+    return reinterpret_cast<RingHeader*>(base);
+}
+
+RecordHeader* GetRecordHeader(uint8_t* base, uint32_t offset)
+{
+    return reinterpret_cast<RecordHeader*>(base + HEADER_SIZE + offset);
+}
+
+bool IsValidCapacity(uint32_t capacity)
+{
+    return capacity != 0 && (capacity & (capacity - 1)) == 0;
+}
+
+bool IsValidRing(const uint8_t* base, uint32_t capacity)
+{
+    auto header = reinterpret_cast<const RingHeader*>(base);
+    return header->magic == RING_MAGIC && header->version == RING_VERSION && header->capacity == capacity;
+}
+
+// collects the pending records of a ring in the order they were appended
+void CollectRecords(const uint8_t* base, uint32_t capacity, std::vector<std::string>& out)
+{
+    uint32_t head = reinterpret_cast<const RingHeader*>(base)->head.load();
+    std::vector<std::pair<uint32_t, std::string>> records;
+    uint32_t offset = 0;
+    while (offset + sizeof(RecordHeader) <= capacity) {
+        auto record = reinterpret_cast<const RecordHeader*>(base + HEADER_SIZE + offset);
+        uint32_t state = record->state.load(std::memory_order_acquire);
+        bool isValid = state != FREE && state <= PADDING && (record->pos & (capacity - 1)) == offset
+            && record->len <= capacity - offset - sizeof(RecordHeader);
+        if (!isValid) {
+            // skip the broken or overwritten space and look for the next record
+            offset += RECORD_ALIGN;
+            continue;
+        }
+        const uint8_t* data = base + HEADER_SIZE + offset + sizeof(RecordHeader);
+        if (state == PENDING && head - record->pos <= capacity
+            && AppEventRecord::GetChecksum(data, record->len) == record->checksum) {
+            records.emplace_back(record->pos, std::string(reinterpret_cast<const char*>(data), record->len));
+        }
+        offset += AlignUp(sizeof(RecordHeader) + record->len);
+    }
+    std::sort(records.begin(), records.end(), [head](const auto& left, const auto& right) {
+        return head - left.first > head - right.first;
+    });
+    for (auto& record : records) {
+        out.emplace_back(std::move(record.second));
+    }
+}
+}
+
+AppEventCrashRing& AppEventCrashRing::GetInstance()
+{
+    static AppEventCrashRing instance;
+    return instance;
+}
+
+AppEventCrashRing::AppEventCrashRing()
+{
+    std::string dir = HiAppEventConfig::GetInstance().GetStorageDir();
+    if (dir.empty()) {
+        HILOG_WARN(LOG_CORE, "storage dir is empty, the crash ring is disabled.");
+        return;
+    }
+    std::string ringDir = FileUtil::GetFilePathByDir(dir, RING_DIR);
+    if (!FileUtil::IsFileExists(ringDir) && !FileUtil::ForceCreateDirectory(ringDir)) {
+        HILOG_ERROR(LOG_CORE, "failed to create ring dir, errno=%{public}d.", errno);
+        return;
+    }
+    (void)Open(ringDir, RING_CAPACITY);
+}
+
+AppEventCrashRing::~AppEventCrashRing()
+{
+    // the mapping is released by the exit of the process, since the writers may still be appending records
+}
+
+bool AppEventCrashRing::Open(const std::string& dir, uint32_t capacity)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!IsValidCapacity(capacity)) {
+        HILOG_ERROR(LOG_CORE, "invalid ring capacity=%{public}u.", capacity);
+        return false;
+    }
+    // release the lock of the ring opened before, so that it is recovered as the ring of a dead process
+    Unmap();
+    std::string path;
+    int fd = CreateRingFile(dir, path);
+    if (fd < 0) {
+        return false;
+    }
+    size_t mapSize = HEADER_SIZE + capacity;
+    if (ftruncate(fd, static_cast<off_t>(mapSize)) != 0) {
+        HILOG_ERROR(LOG_CORE, "failed to resize ring file, errno=%{public}d.", errno);
+        (void)FileUtil::RemoveFile(path);
+        close(fd);
+        return false;
+    }
+    void* addr = mmap(nullptr, mapSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (addr == MAP_FAILED) {
+        HILOG_ERROR(LOG_CORE, "failed to map ring file, errno=%{public}d.", errno);
+        (void)FileUtil::RemoveFile(path);
+        close(fd);
+        return false;
+    }
+    fd_ = fd;
+    capacity_ = capacity;
+    mapSize_ = mapSize;
+    base_.store(static_cast<uint8_t*>(addr), std::memory_order_release);
+    Reset();
+    RecoverOrphans(dir, path);
+    HILOG_INFO(LOG_CORE, "recovered %{public}zu events from the crash ring.", recoveredRecords_.size());
+    return true;
+}
+
+void AppEventCrashRing::Close()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    Unmap();
+    recoveredRecords_.clear();
+    // the recovered rings are kept, since their records have not been written
+    for (const auto& file : recoveredFiles_) {
+        close(file.second);
+    }
+    recoveredFiles_.clear();
+}
+
+int AppEventCrashRing::CreateRingFile(const std::string& dir, std::string& path)
+{
+    // the file of each run has a new name, so the ring left by a dead process of the same pid is never reused
+    std::string prefix = std::string(RING_FILE_PREFIX) + "_" + std::to_string(getpid()) + "_";
+    uint64_t id = TimeUtil::GetMilliseconds();
+    for (int i = 0; i < MAX_CREATE_TIMES; ++i, ++id) {
+        path = FileUtil::GetFilePathByDir(dir, prefix + std::to_string(id));
+        int fd = open(path.c_str(), O_RDWR | O_CREAT | O_EXCL | O_CLOEXEC, RING_FILE_MODE);
+        if (fd < 0) {
+            if (errno == EEXIST) {
+                continue;
+            }
+            HILOG_ERROR(LOG_CORE, "failed to create ring file, errno=%{public}d.", errno);
+            return -1;
+        }
+        // the lock is held until the process exits, it tells the other processes that the ring is in use
+        if (flock(fd, LOCK_EX | LOCK_NB) != 0) {
+            HILOG_ERROR(LOG_CORE, "failed to lock ring file, errno=%{public}d.", errno);
+            close(fd);
+            (void)FileUtil::RemoveFile(path);
+            return -1;
+        }
+        return fd;
+    }
+    HILOG_ERROR(LOG_CORE, "failed to create ring file, the names are in use.");
+    return -1;
+}
+
+void AppEventCrashRing::Unmap()
+{
+    uint8_t* base = base_.exchange(nullptr);
+    if (base != nullptr) {
+        (void)munmap(base, mapSize_);
+    }
+    if (fd_ >= 0) {
+        close(fd_);
+        fd_ = -1;
+    }
+}
+
+bool AppEventCrashRing::IsReady() const
+{
+    return base_.load(std::memory_order_acquire) != nullptr;
+}
+
+void AppEventCrashRing::RecoverOrphans(const std::string& dir, const std::string& ownPath)
+{
+    std::vector<std::string> files;
+    FileUtil::GetDirFiles(dir, files);
+    std::string prefix = FileUtil::GetFilePathByDir(dir, RING_FILE_PREFIX);
+    for (const auto& file : files) {
+        if (file == ownPath || file.compare(0, prefix.size(), prefix) != 0) {
+            continue;
+        }
+        int fd = open(file.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            continue;
+        }
+        // the owner of the ring, or the process recovering it, is still alive if the lock is held, and the ring
+        // which has no link any more has been recovered by another process already
+        struct stat statBuf {};
+        if (flock(fd, LOCK_EX | LOCK_NB) != 0 || fstat(fd, &statBuf) != 0 || statBuf.st_nlink == 0) {
+            close(fd);
+            continue;
+        }
+        size_t mapSize = static_cast<size_t>(statBuf.st_size);
+        void* addr = mapSize > HEADER_SIZE ? mmap(nullptr, mapSize, PROT_READ, MAP_PRIVATE, fd, 0) : MAP_FAILED;
+        if (addr != MAP_FAILED) {
+            const uint8_t* base = static_cast<const uint8_t*>(addr);
+            uint32_t capacity = static_cast<uint32_t>(mapSize - HEADER_SIZE);
+            if (IsValidCapacity(capacity) && IsValidRing(base, capacity)) {
+                CollectRecords(base, capacity, recoveredRecords_);
+            }
+            (void)munmap(addr, mapSize);
+        }
+        // the ring is kept locked until its records are written, so that they survive another crash before it
+        recoveredFiles_.emplace_back(file, fd);
+    }
+}
+
+void AppEventCrashRing::Reset()
+{
+    uint8_t* base = base_.load();
+    (void)memset(base + HEADER_SIZE, 0, capacity_);
+    auto header = GetRingHeader(base);
+    header->magic = RING_MAGIC;
+    header->version = RING_VERSION;
+    header->capacity = capacity_;
+    header->head.store(0, std::memory_order_release);
+}
+
+uint32_t AppEventCrashRing::Append(const AppEventPack& event)
+{
+    if (!IsReady()) {
+        return INVALID_TOKEN;
+    }
+    std::string record = AppEventRecord::Encode(event);
+    return Append(record.data(), static_cast<uint32_t>(record.size()));
+}
+
+uint32_t AppEventCrashRing::Append(const char* data, uint32_t len)
+{
+    // no lock or allocation here, so that the records can be appended from a signal handler
+    uint8_t* base = base_.load(std::memory_order_acquire);
+    if (base == nullptr || data == nullptr || len > capacity_ / MAX_RECORD_RATIO) {
+        return INVALID_TOKEN;
+    }
+    uint32_t recordLen = AlignUp(sizeof(RecordHeader) + len);
+    auto& head = GetRingHeader(base)->head;
+    uint32_t oldHead = head.load(std::memory_order_relaxed);
+    uint32_t paddingLen = 0;
+    do {
+        uint32_t offset = oldHead & (capacity_ - 1);
+        // a record never crosses the end of the ring, the remaining space is padded instead
+        paddingLen = offset + recordLen > capacity_ ? capacity_ - offset : 0;
+    } while (!head.compare_exchange_weak(oldHead, oldHead + paddingLen + recordLen, std::memory_order_acq_rel,
+        std::memory_order_relaxed));
+    if (paddingLen > 0) {
+        auto padding = GetRecordHeader(base, oldHead & (capacity_ - 1));
+        padding->pos = oldHead;
+        padding->len = paddingLen - sizeof(RecordHeader);
+        padding->state.store(PADDING, std::memory_order_release);
+    }
+    uint32_t pos = oldHead + paddingLen;
+    auto record = GetRecordHeader(base, pos & (capacity_ - 1));
+    record->state.store(WRITING, std::memory_order_relaxed);
+    record->pos = pos;
+    record->len = len;
+    (void)memcpy(reinterpret_cast<uint8_t*>(record) + sizeof(RecordHeader), data, len);
+    record->checksum = AppEventRecord::GetChecksum(reinterpret_cast<const uint8_t*>(data), len);
+    record->state.store(PENDING, std::memory_order_release);
+    // the positions are aligned, so the lowest bit marks a valid token
+    return pos | 1;
+}
+
+void AppEventCrashRing::Complete(uint32_t token)
+{
+    uint8_t* base = base_.load(std::memory_order_acquire);
+    if (base == nullptr || token == INVALID_TOKEN) {
+        return;
+    }
+    uint32_t pos = token & ~1u;
+    auto record = GetRecordHeader(base, pos & (capacity_ - 1));
+    uint32_t state = PENDING;
+    if (record->pos == pos) {
+        (void)record->state.compare_exchange_strong(state, DONE, std::memory_order_release);
+    }
+}
+
+void AppEventCrashRing::TakeRecoveredEvents(std::vector<std::shared_ptr<AppEventPack>>& events)
+{
+    std::vector<std::string> records;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        records.swap(recoveredRecords_);
+    }
+    // the rings the records come from are kept until ReleaseRecoveredEvents is called
+    for (const auto& record : records) {
+        auto event = AppEventRecord::Decode(record);
+        if (event == nullptr) {
+            HILOG_WARN(LOG_CORE, "failed to decode the recovered event.");
+            continue;
+        }
+        events.emplace_back(event);
+    }
+}
+
+void AppEventCrashRing::ReleaseRecoveredEvents()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    // the file is removed before its lock is released, so no other process recovers it again
+    for (const auto& [file, fd] : recoveredFiles_) {
+        (void)FileUtil::RemoveFile(file);
+        close(fd);
+    }
+    recoveredFiles_.clear();
+}
+} // namespace HiviewDFX
+} // namespace OHOS
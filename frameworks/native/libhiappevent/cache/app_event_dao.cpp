@@ -14,8 +14,13 @@
  */
 #include "app_event_dao.h"
 
+#include <utility>
+#include <vector>
+
 #include "app_event_cache_common.h"
+#include "app_event_params_codec.h"
 #include "app_event_store.h"
+#include "compress_util.h"
 #include "hiappevent_base.h"
 #include "hilog/log.h"
 #include "rdb_helper.h"
@@ -37,15 +42,18 @@ int Create(NativeRdb::RdbStore& dbStore)
      * table: events
      *
      * |-------|--------|------|------|------|-----|-----|----------|---------|----------|------------|--------|
-     * ------------|
+     * ------------|--------------|
      * |  seq  | domain | name | type |  tz  | pid | tid | trace_id | span_id | pspan_id | trace_flag | params |
-     *  running_id |
+     *  running_id | params_codec |
      * |-------|--------|------|------|------|-----|-----|----------|---------|----------|------------|--------|
-     * ------------|
+     * ------------|--------------|
      * | INT64 |  TEXT  | TEXT |  INT | TEXT | INT | INT |  INT64   |  INT64  |   INT64  |    INT     |  TEXT  |
-     *     TEXT    |
+     *     TEXT    |      INT     |
      * |-------|--------|------|------|------|-----|-----|----------|---------|----------|------------|--------|
-     * ------------|
+     * ------------|--------------|
+     *
+     * the params are stored as a BLOB instead of the json text if params_codec is not 0, and they are in the binary
+     * form of AppEventParamsCodec if the FORMAT_BINARY flag of params_codec is set.
      */
     const std::vector<std::pair<std::string, std::string>> fields = {
         {Events::FIELD_DOMAIN, SqlUtil::SQL_TEXT_TYPE},
@@ -61,11 +69,41 @@ int Create(NativeRdb::RdbStore& dbStore)
         {Events::FIELD_TRACE_FLAG, SqlUtil::SQL_INT_TYPE},
         {Events::FIELD_PARAMS, SqlUtil::SQL_TEXT_TYPE},
         {Events::FIELD_RUNNING_ID, SqlUtil::SQL_TEXT_TYPE},
+        {Events::FIELD_PARAMS_CODEC, SqlUtil::SQL_INT_ZERO_TYPE},
     };
     std::string sql = SqlUtil::CreateTable(Events::TABLE, fields);
     return dbStore.ExecuteSql(sql);
 }
 
+int MakeParamsValue(const AppEventPack& event, NativeRdb::ValueObject& value)
+{
+    // the typed params are stored in the binary form, which is smaller and faster to decode than the json text
+    const auto* typedParams = event.GetTypedParams();
+    if (typedParams != nullptr) {
+        std::vector<uint8_t> binary;
+        AppEventParamsCodec::Encode(*typedParams, binary);
+        int codec = CompressUtil::SelectCodec(event.GetDomain(), binary.size());
+        std::vector<uint8_t> params;
+        if (codec != CompressUtil::CODEC_NONE && CompressUtil::Compress(binary.data(), binary.size(), codec, params)) {
+            value = NativeRdb::ValueObject(std::move(params));
+            return AppEventParamsCodec::FORMAT_BINARY | codec;
+        }
+        value = NativeRdb::ValueObject(std::move(binary));
+        return AppEventParamsCodec::FORMAT_BINARY;
+    }
+    std::string paramStr = event.GetParamStr();
+    int codec = CompressUtil::SelectCodec(event.GetDomain(), paramStr.size());
+    if (codec != CompressUtil::CODEC_NONE) {
+        std::vector<uint8_t> params;
+        if (CompressUtil::Compress(paramStr, codec, params)) {
+            value = NativeRdb::ValueObject(std::move(params));
+            return codec;
+        }
+    }
+    value = NativeRdb::ValueObject(std::move(paramStr));
+    return CompressUtil::CODEC_NONE;
+}
+
 int Insert(std::shared_ptr<NativeRdb::RdbStore> dbStore, std::shared_ptr<AppEventPack> event, int64_t& seq)
 {
     NativeRdb::ValuesBucket bucket;
@@ -80,8 +118,11 @@ int Insert(std::shared_ptr<NativeRdb::RdbStore> dbStore, std::shared_ptr<AppEven
     bucket.PutLong(Events::FIELD_SPAN_ID, event->GetSpanId());
     bucket.PutLong(Events::FIELD_PSPAN_ID, event->GetPspanId());
     bucket.PutInt(Events::FIELD_TRACE_FLAG, event->GetTraceFlag());
-    bucket.PutString(Events::FIELD_PARAMS, event->GetParamStr());
+    NativeRdb::ValueObject params;
+    int codec = MakeParamsValue(*event, params);
+    bucket.Put(Events::FIELD_PARAMS, params);
     bucket.PutString(Events::FIELD_RUNNING_ID, event->GetRunningId());
+    bucket.PutInt(Events::FIELD_PARAMS_CODEC, codec);
     return dbStore->Insert(seq, Events::TABLE, bucket);
 }
 
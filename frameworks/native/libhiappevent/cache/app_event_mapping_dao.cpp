@@ -39,18 +39,45 @@ int Create(NativeRdb::RdbStore& dbStore)
     /**
      * table: event_observer_mapping
      *
-     * |-------|-----------|--------------|
-     * |  seq  | event_seq | observer_seq |
-     * |-------|-----------|--------------|
-     * | INT64 |   INT64   |    INT64     |
-     * |-------|-----------|--------------|
+     * |-------|-----------|--------------|------------|
+     * |  seq  | event_seq | observer_seq | event_size |
+     * |-------|-----------|--------------|------------|
+     * | INT64 |   INT64   |    INT64     |    INT64   |
+     * |-------|-----------|--------------|------------|
      */
     const std::vector<std::pair<std::string, std::string>> fields = {
         {FIELD_EVENT_SEQ, SqlUtil::SQL_INT_TYPE},
         {FIELD_OBSERVER_SEQ, SqlUtil::SQL_INT_TYPE},
+        {FIELD_EVENT_SIZE, SqlUtil::SQL_INT_ZERO_TYPE},
     };
     std::string sql = SqlUtil::CreateTable(TABLE, fields);
-    return dbStore.ExecuteSql(sql);
+    if (int ret = dbStore.ExecuteSql(sql); ret != NativeRdb::E_OK) {
+        return ret;
+    }
+    return CreateCounterTriggers(dbStore);
+}
+
+int CreateCounterTriggers(NativeRdb::RdbStore& dbStore)
+{
+    // the counters of observers are updated in the same statement as the mapping records
+    std::string insertSql = "CREATE TRIGGER IF NOT EXISTS " + TABLE + "_insert AFTER INSERT ON " + TABLE
+        + " BEGIN UPDATE " + Observers::TABLE + " SET " + Observers::FIELD_EVENT_ROWS + "="
+        + Observers::FIELD_EVENT_ROWS + "+1," + Observers::FIELD_EVENT_BYTES + "=" + Observers::FIELD_EVENT_BYTES
+        + "+NEW." + FIELD_EVENT_SIZE + " WHERE " + Observers::FIELD_SEQ + "=NEW." + FIELD_OBSERVER_SEQ + "; END";
+    if (int ret = dbStore.ExecuteSql(insertSql); ret != NativeRdb::E_OK) {
+        HILOG_ERROR(LOG_CORE, "failed to create insert trigger, ret=%{public}d", ret);
+        return ret;
+    }
+    std::string deleteSql = "CREATE TRIGGER IF NOT EXISTS " + TABLE + "_delete AFTER DELETE ON " + TABLE
+        + " BEGIN UPDATE " + Observers::TABLE + " SET " + Observers::FIELD_EVENT_ROWS + "=MAX("
+        + Observers::FIELD_EVENT_ROWS + "-1,0)," + Observers::FIELD_EVENT_BYTES + "=MAX("
+        + Observers::FIELD_EVENT_BYTES + "-OLD." + FIELD_EVENT_SIZE + ",0) WHERE " + Observers::FIELD_SEQ + "=OLD."
+        + FIELD_OBSERVER_SEQ + "; END";
+    if (int ret = dbStore.ExecuteSql(deleteSql); ret != NativeRdb::E_OK) {
+        HILOG_ERROR(LOG_CORE, "failed to create delete trigger, ret=%{public}d", ret);
+        return ret;
+    }
+    return NativeRdb::E_OK;
 }
 
 int Insert(std::shared_ptr<NativeRdb::RdbStore> dbStore, const std::vector<EventObserverInfo>& eventObservers)
@@ -60,6 +87,7 @@ int Insert(std::shared_ptr<NativeRdb::RdbStore> dbStore, const std::vector<Event
         NativeRdb::ValuesBucket bucket;
         bucket.PutLong(FIELD_EVENT_SEQ, eventObserver.eventSeq);
         bucket.PutLong(FIELD_OBSERVER_SEQ, eventObserver.observerSeq);
+        bucket.PutLong(FIELD_EVENT_SIZE, eventObserver.eventSize);
         buckets.emplace_back(bucket);
     }
     int64_t insertRows = 0;
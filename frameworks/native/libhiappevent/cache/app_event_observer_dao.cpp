@@ -35,16 +35,18 @@ int Create(NativeRdb::RdbStore& dbStore)
     /**
      * table: observers
      *
-     * |-------|------|------|---------|
-     * |  seq  | name | hash | filters |
-     * |-------|------|------|---------|
-     * | INT64 | TEXT | INT64|   TEXT  |
-     * |-------|------|------|---------|
+     * |-------|------|------|---------|------------|-------------|
+     * |  seq  | name | hash | filters | event_rows | event_bytes |
+     * |-------|------|------|---------|------------|-------------|
+     * | INT64 | TEXT | INT64|   TEXT  |    INT64   |    INT64    |
+     * |-------|------|------|---------|------------|-------------|
      */
     const std::vector<std::pair<std::string, std::string>> fields = {
         {FIELD_NAME, SqlUtil::SQL_TEXT_TYPE},
         {FIELD_HASH, SqlUtil::SQL_INT_TYPE},
         {FIELD_FILTERS, SqlUtil::SQL_TEXT_TYPE},
+        {FIELD_EVENT_ROWS, SqlUtil::SQL_INT_ZERO_TYPE},
+        {FIELD_EVENT_BYTES, SqlUtil::SQL_INT_ZERO_TYPE},
     };
     std::string sql = SqlUtil::CreateTable(TABLE, fields);
     return dbStore.ExecuteSql(sql);
@@ -97,6 +99,33 @@ int QuerySeqAndFilters(std::shared_ptr<NativeRdb::RdbStore> dbStore, const Obser
     return ret;
 }
 
+int QueryObserver(std::shared_ptr<NativeRdb::RdbStore> dbStore, Observer& observer)
+{
+    NativeRdb::AbsRdbPredicates predicates(TABLE);
+    predicates.EqualTo(FIELD_NAME, observer.name);
+    predicates.EqualTo(FIELD_HASH, observer.hashCode);
+    auto resultSet = dbStore->Query(predicates, {FIELD_SEQ, FIELD_FILTERS, FIELD_EVENT_ROWS, FIELD_EVENT_BYTES});
+    if (resultSet == nullptr) {
+        HILOG_ERROR(LOG_CORE, "failed to query table, observer name=%{public}s, hash code=%{public}" PRId64,
+            observer.name.c_str(), observer.hashCode);
+        return NativeRdb::E_ERROR;
+    }
+
+    // the hash code is unique, so get only the first
+    int ret = resultSet->GoToNextRow();
+    if (ret == NativeRdb::E_OK) {
+        if (resultSet->GetLong(0, observer.seq) != NativeRdb::E_OK // 0 means index of seq
+            || resultSet->GetString(1, observer.filters) != NativeRdb::E_OK // 1 means index of filters
+            || resultSet->GetLong(2, observer.eventRows) != NativeRdb::E_OK // 2 means index of event_rows
+            || resultSet->GetLong(3, observer.eventBytes) != NativeRdb::E_OK) { // 3 means index of event_bytes
+            HILOG_ERROR(LOG_CORE, "failed to get value from resultSet, observer=%{public}s", observer.name.c_str());
+            observer.seq = 0;
+        }
+    }
+    resultSet->Close();
+    return ret == NativeRdb::E_SQLITE_CORRUPT ? ret : NativeRdb::E_OK;
+}
+
 int QuerySeqs(std::shared_ptr<NativeRdb::RdbStore> dbStore, const std::string& name,
     std::vector<int64_t>& observerSeqs)
 {
@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "app_event_record.h"
+
+#include <cstring>
+
+#include "hiappevent_base.h"
+
+namespace OHOS {
+namespace HiviewDFX {
+namespace AppEventRecord {
+namespace {
+void EncodeInt(std::string& buf, uint64_t value)
+{
+    buf.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+void EncodeStr(std::string& buf, const std::string& str)
+{
+    EncodeInt(buf, str.size());
+    buf.append(str);
+}
+
+bool DecodeInt(const std::string& buf, size_t& offset, uint64_t& value)
+{
+    if (buf.size() - offset < sizeof(value)) {
+        return false;
+    }
+    (void)memcpy(&value, buf.data() + offset, sizeof(value));
+    offset += sizeof(value);
+    return true;
+}
+
+bool DecodeStr(const std::string& buf, size_t& offset, std::string& str)
+{
+    uint64_t len = 0;
+    if (!DecodeInt(buf, offset, len) || buf.size() - offset < len) {
+        return false;
+    }
+    str.assign(buf, offset, len);
+    offset += len;
+    return true;
+}
+}
+
+std::string Encode(const AppEventPack& event)
+{
+    std::string buf;
+    EncodeStr(buf, event.GetDomain());
+    EncodeStr(buf, event.GetName());
+    EncodeInt(buf, static_cast<uint64_t>(event.GetType()));
+    EncodeInt(buf, event.GetTime());
+    EncodeStr(buf, event.GetTimeZone());
+    EncodeInt(buf, static_cast<uint64_t>(event.GetPid()));
+    EncodeInt(buf, static_cast<uint64_t>(event.GetTid()));
+    EncodeInt(buf, static_cast<uint64_t>(event.GetTraceId()));
+    EncodeInt(buf, static_cast<uint64_t>(event.GetSpanId()));
+    EncodeInt(buf, static_cast<uint64_t>(event.GetPspanId()));
+    EncodeInt(buf, static_cast<uint64_t>(event.GetTraceFlag()));
+    EncodeStr(buf, event.GetRunningId());
+    EncodeStr(buf, event.GetParamStr());
+    return buf;
+}
+
+std::shared_ptr<AppEventPack> Decode(const std::string& buf)
+{
+    std::string domain;
+    std::string name;
+    std::string timeZone;
+    std::string runningId;
+    std::string paramStr;
+    uint64_t type = 0;
+    uint64_t time = 0;
+    uint64_t pid = 0;
+    uint64_t tid = 0;
+    uint64_t traceId = 0;
+    uint64_t spanId = 0;
+    uint64_t pspanId = 0;
+    uint64_t traceFlag = 0;
+    size_t offset = 0;
+    if (!DecodeStr(buf, offset, domain) || !DecodeStr(buf, offset, name) || !DecodeInt(buf, offset, type)
+        || !DecodeInt(buf, offset, time) || !DecodeStr(buf, offset, timeZone) || !DecodeInt(buf, offset, pid)
+        || !DecodeInt(buf, offset, tid) || !DecodeInt(buf, offset, traceId) || !DecodeInt(buf, offset, spanId)
+        || !DecodeInt(buf, offset, pspanId) || !DecodeInt(buf, offset, traceFlag)
+        || !DecodeStr(buf, offset, runningId) || !DecodeStr(buf, offset, paramStr)) {
+        return nullptr;
+    }
+    auto event = std::make_shared<AppEventPack>();
+    event->SetDomain(domain);
+    event->SetName(name);
+    event->SetType(static_cast<int>(type));
+    event->SetTime(time);
+    event->SetTimeZone(timeZone);
+    event->SetPid(static_cast<int>(pid));
+    event->SetTid(static_cast<int>(tid));
+    event->SetTraceId(static_cast<int64_t>(traceId));
+    event->SetSpanId(static_cast<int64_t>(spanId));
+    event->SetPspanId(static_cast<int64_t>(pspanId));
+    event->SetTraceFlag(static_cast<int>(traceFlag));
+    event->SetRunningId(runningId);
+    event->SetParamStr(paramStr);
+    return event;
+}
+
+uint32_t GetChecksum(const uint8_t* data, uint32_t len)
+{
+    // FNV-1a, no allocation, so that it is safe to be called in a signal handler
+    uint32_t hash = 2166136261u;
+    for (uint32_t i = 0; i < len; ++i) {
+        hash = (hash ^ data[i]) * 16777619u;
+    }
+    return hash;
+}
+} // namespace AppEventRecord
+} // namespace HiviewDFX
+} // namespace OHOS
@@ -0,0 +1,243 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "app_event_statement_cache.h"
+
+#include <algorithm>
+#include <cinttypes>
+
+#include "app_event_dao.h"
+#include "hiappevent_base.h"
+#include "hiappevent_common.h"
+#include "hilog/log.h"
+#include "rdb_errno.h"
+
+#undef LOG_DOMAIN
+#define LOG_DOMAIN 0xD002D07
+
+#undef LOG_TAG
+#define LOG_TAG "StatementCache"
+
+namespace OHOS {
+namespace HiviewDFX {
+using namespace AppEventCacheCommon;
+namespace {
+// max rows bound to one mapping insert statement, 3 args per row
+constexpr size_t MAX_ROWS_OF_INSERT_MAPPING = 64;
+// max seqs bound to one mapping delete statement, equal to the max size of one report
+constexpr size_t MAX_SEQS_OF_DELETE_MAPPING = 100;
+constexpr int64_t NO_LIMIT = -1;
+
+std::string GetPlaceholders(const std::string& placeholder, size_t num)
+{
+    std::string placeholders;
+    for (size_t i = 0; i < num; ++i) {
+        placeholders += (i == 0) ? placeholder : ("," + placeholder);
+    }
+    return placeholders;
+}
+}
+
+AppEventStatementCache::AppEventStatementCache(std::shared_ptr<NativeRdb::RdbStore> dbStore) : dbStore_(dbStore)
+{
+    BuildStatements();
+}
+
+void AppEventStatementCache::BuildStatements()
+{
+    insertEventSql_ = std::string("INSERT INTO ") + Events::TABLE + "(" + Events::FIELD_DOMAIN + ","
+        + Events::FIELD_NAME + "," + Events::FIELD_TYPE + "," + Events::FIELD_TIME + "," + Events::FIELD_TZ + ","
+        + Events::FIELD_PID + "," + Events::FIELD_TID + "," + Events::FIELD_TRACE_ID + "," + Events::FIELD_SPAN_ID + ","
+        + Events::FIELD_PSPAN_ID + "," + Events::FIELD_TRACE_FLAG + "," + Events::FIELD_PARAMS + ","
+        + Events::FIELD_RUNNING_ID + "," + Events::FIELD_PARAMS_CODEC + ") VALUES (" + GetPlaceholders("?", 14)
+        + ")"; // 14 means num of fields
+
+    queryEventsSql_ = std::string("SELECT ") + Events::TABLE + ".* FROM " + AppEventMapping::TABLE + " INNER JOIN "
+        + Events::TABLE + " ON " + AppEventMapping::TABLE + "." + AppEventMapping::FIELD_EVENT_SEQ + "="
+        + Events::TABLE + "." + Events::FIELD_SEQ + " WHERE " + AppEventMapping::FIELD_OBSERVER_SEQ + "=?"
+        + " ORDER BY " + AppEventMapping::TABLE + "." + AppEventMapping::FIELD_EVENT_SEQ + " DESC LIMIT ?";
+
+    // event name is not mandatory, the params with empty name are ordered first and overwritten by the named ones
+    queryCustomParamsSql_ = "SELECT " + CustomEventParams::FIELD_PARAM_KEY + "," + CustomEventParams::FIELD_PARAM_VALUE
+        + " FROM " + CustomEventParams::TABLE + " WHERE " + CustomEventParams::FIELD_RUNNING_ID + "=? AND "
+        + CustomEventParams::FIELD_DOMAIN + "=? AND " + CustomEventParams::FIELD_NAME + " IN ('',?) ORDER BY "
+        + CustomEventParams::FIELD_NAME + " ASC";
+
+    // keep the latest reservedNum events, and keep the latest reservedNumOs events of OS domain
+    deleteHistoryEventSql_ = std::string("DELETE FROM ") + Events::TABLE + " WHERE " + Events::FIELD_SEQ
+        + " NOT IN (SELECT " + Events::FIELD_SEQ + " FROM " + Events::TABLE + " WHERE " + Events::FIELD_DOMAIN
+        + " != ? ORDER BY " + Events::FIELD_SEQ + " DESC LIMIT 0,?) AND " + Events::FIELD_SEQ + " NOT IN (SELECT "
+        + Events::FIELD_SEQ + " FROM " + Events::TABLE + " WHERE " + Events::FIELD_DOMAIN + " = ? ORDER BY "
+        + Events::FIELD_SEQ + " DESC LIMIT 0,?)";
+
+    insertMappingSqls_.resize(MAX_ROWS_OF_INSERT_MAPPING + 1);
+    for (size_t num = 1; num <= MAX_ROWS_OF_INSERT_MAPPING; ++num) {
+        insertMappingSqls_[num] = "INSERT INTO " + AppEventMapping::TABLE + "(" + AppEventMapping::FIELD_EVENT_SEQ
+            + "," + AppEventMapping::FIELD_OBSERVER_SEQ + "," + AppEventMapping::FIELD_EVENT_SIZE + ") VALUES "
+            + GetPlaceholders("(?,?,?)", num);
+    }
+    deleteMappingSqls_.resize(MAX_SEQS_OF_DELETE_MAPPING + 1);
+    for (size_t num = 1; num <= MAX_SEQS_OF_DELETE_MAPPING; ++num) {
+        deleteMappingSqls_[num] = "DELETE FROM " + AppEventMapping::TABLE + " WHERE "
+            + AppEventMapping::FIELD_OBSERVER_SEQ + "=? AND " + AppEventMapping::FIELD_EVENT_SEQ + " IN ("
+            + GetPlaceholders("?", num) + ")";
+    }
+}
+
+int AppEventStatementCache::InsertEvent(std::shared_ptr<AppEventPack> event, int64_t& seq)
+{
+    NativeRdb::ValueObject params;
+    int codec = AppEventDao::MakeParamsValue(*event, params);
+    std::vector<NativeRdb::ValueObject> bindArgs = {
+        NativeRdb::ValueObject(event->GetDomain()),
+        NativeRdb::ValueObject(event->GetName()),
+        NativeRdb::ValueObject(event->GetType()),
+        NativeRdb::ValueObject(static_cast<int64_t>(event->GetTime())),
+        NativeRdb::ValueObject(event->GetTimeZone()),
+        NativeRdb::ValueObject(event->GetPid()),
+        NativeRdb::ValueObject(event->GetTid()),
+        NativeRdb::ValueObject(event->GetTraceId()),
+        NativeRdb::ValueObject(event->GetSpanId()),
+        NativeRdb::ValueObject(event->GetPspanId()),
+        NativeRdb::ValueObject(event->GetTraceFlag()),
+        params,
+        NativeRdb::ValueObject(event->GetRunningId()),
+        NativeRdb::ValueObject(codec),
+    };
+    return dbStore_->ExecuteForLastInsertedRowId(seq, insertEventSql_, bindArgs);
+}
+
+int AppEventStatementCache::ExecuteMappingInsert(const std::vector<EventObserverInfo>& eventObservers,
+    size_t start, size_t num)
+{
+    std::vector<NativeRdb::ValueObject> bindArgs;
+    bindArgs.reserve(num * 3); // 3 means num of args per row
+    for (size_t i = start; i < start + num; ++i) {
+        bindArgs.emplace_back(NativeRdb::ValueObject(eventObservers[i].eventSeq));
+        bindArgs.emplace_back(NativeRdb::ValueObject(eventObservers[i].observerSeq));
+        bindArgs.emplace_back(NativeRdb::ValueObject(eventObservers[i].eventSize));
+    }
+    return dbStore_->ExecuteSql(insertMappingSqls_[num], bindArgs);
+}
+
+int AppEventStatementCache::InsertEventMapping(const std::vector<EventObserverInfo>& eventObservers)
+{
+    if (eventObservers.empty()) {
+        return NativeRdb::E_OK;
+    }
+    if (eventObservers.size() <= MAX_ROWS_OF_INSERT_MAPPING) {
+        return ExecuteMappingInsert(eventObservers, 0, eventObservers.size());
+    }
+    dbStore_->BeginTransaction();
+    for (size_t start = 0; start < eventObservers.size(); start += MAX_ROWS_OF_INSERT_MAPPING) {
+        size_t num = std::min(MAX_ROWS_OF_INSERT_MAPPING, eventObservers.size() - start);
+        if (int ret = ExecuteMappingInsert(eventObservers, start, num); ret != NativeRdb::E_OK) {
+            dbStore_->RollBack();
+            return ret;
+        }
+    }
+    dbStore_->Commit();
+    return NativeRdb::E_OK;
+}
+
+std::shared_ptr<NativeRdb::AbsSharedResultSet> AppEventStatementCache::QueryEvents(int64_t observerSeq, uint32_t size)
+{
+    std::vector<NativeRdb::ValueObject> bindArgs = {
+        NativeRdb::ValueObject(observerSeq),
+        NativeRdb::ValueObject(size > 0 ? static_cast<int64_t>(size) : NO_LIMIT),
+    };
+    return dbStore_->QuerySql(queryEventsSql_, bindArgs);
+}
+
+int AppEventStatementCache::QueryCustomParams(std::unordered_map<std::string, std::string>& params,
+    const std::string& runningId, const std::string& domain, const std::string& name)
+{
+    std::vector<NativeRdb::ValueObject> bindArgs = {
+        NativeRdb::ValueObject(runningId),
+        NativeRdb::ValueObject(domain),
+        NativeRdb::ValueObject(name),
+    };
+    auto resultSet = dbStore_->QuerySql(queryCustomParamsSql_, bindArgs);
+    if (resultSet == nullptr) {
+        HILOG_ERROR(LOG_CORE, "failed to query custom params");
+        return NativeRdb::E_ERROR;
+    }
+    int ret = resultSet->GoToNextRow();
+    while (ret == NativeRdb::E_OK) {
+        std::string paramKey;
+        std::string paramValue;
+        if (resultSet->GetString(0, paramKey) != NativeRdb::E_OK
+            || resultSet->GetString(1, paramValue) != NativeRdb::E_OK) {
+            HILOG_ERROR(LOG_CORE, "failed to get value, runningId=%{public}s, domain=%{public}s, name=%{public}s",
+                runningId.c_str(), domain.c_str(), name.c_str());
+            ret = resultSet->GoToNextRow();
+            continue;
+        }
+        params[paramKey] = paramValue;
+        ret = resultSet->GoToNextRow();
+    }
+    resultSet->Close();
+    return ret == NativeRdb::E_SQLITE_CORRUPT ? ret : NativeRdb::E_OK;
+}
+
+int AppEventStatementCache::ExecuteMappingDelete(int64_t observerSeq, const std::vector<int64_t>& eventSeqs,
+    size_t start, size_t num)
+{
+    std::vector<NativeRdb::ValueObject> bindArgs;
+    bindArgs.reserve(num + 1); // 1 means the arg of observer seq
+    bindArgs.emplace_back(NativeRdb::ValueObject(observerSeq));
+    for (size_t i = start; i < start + num; ++i) {
+        bindArgs.emplace_back(NativeRdb::ValueObject(eventSeqs[i]));
+    }
+    int64_t deleteRows = 0;
+    return dbStore_->ExecuteForChangedRowCount(deleteRows, deleteMappingSqls_[num], bindArgs);
+}
+
+int AppEventStatementCache::DeleteEventMapping(int64_t observerSeq, const std::vector<int64_t>& eventSeqs)
+{
+    if (eventSeqs.empty()) {
+        return NativeRdb::E_OK;
+    }
+    if (eventSeqs.size() <= MAX_SEQS_OF_DELETE_MAPPING) {
+        return ExecuteMappingDelete(observerSeq, eventSeqs, 0, eventSeqs.size());
+    }
+    dbStore_->BeginTransaction();
+    for (size_t start = 0; start < eventSeqs.size(); start += MAX_SEQS_OF_DELETE_MAPPING) {
+        size_t num = std::min(MAX_SEQS_OF_DELETE_MAPPING, eventSeqs.size() - start);
+        if (int ret = ExecuteMappingDelete(observerSeq, eventSeqs, start, num); ret != NativeRdb::E_OK) {
+            dbStore_->RollBack();
+            return ret;
+        }
+    }
+    dbStore_->Commit();
+    return NativeRdb::E_OK;
+}
+
+int AppEventStatementCache::DeleteHistoryEvent(int reservedNum, int reservedNumOs)
+{
+    std::vector<NativeRdb::ValueObject> bindArgs = {
+        NativeRdb::ValueObject(std::string(HiAppEvent::DOMAIN_OS)),
+        NativeRdb::ValueObject(reservedNum),
+        NativeRdb::ValueObject(std::string(HiAppEvent::DOMAIN_OS)),
+        NativeRdb::ValueObject(reservedNumOs),
+    };
+    int64_t deleteRows = 0;
+    int ret = dbStore_->ExecuteForChangedRowCount(deleteRows, deleteHistoryEventSql_, bindArgs);
+    if (ret == NativeRdb::E_OK) {
+        HILOG_INFO(LOG_CORE, "delete %{public}" PRId64 " events over limit", deleteRows);
+    }
+    return ret;
+}
+} // namespace HiviewDFX
+} // namespace OHOS
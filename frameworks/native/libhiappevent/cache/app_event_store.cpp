@@ -20,11 +20,13 @@
 
 #include "app_event_cache_common.h"
 #include "app_event_store_callback.h"
+#include "compress_util.h"
 #include "file_util.h"
 #include "hiappevent_base.h"
 #include "hiappevent_common.h"
 #include "hiappevent_config.h"
 #include "hilog/log.h"
+#include "pipeline_metrics.h"
 #include "rdb_errno.h"
 #include "rdb_helper.h"
 #include "sql_util.h"
@@ -43,6 +45,7 @@ namespace {
 const char* DATABASE_NAME = "appevent.db";
 const char* DATABASE_DIR = "databases/";
 static constexpr size_t MAX_NUM_OF_CUSTOM_PARAMS = 64;
+static constexpr size_t MAX_NUM_OF_CACHED_CUSTOM_PARAMS = 100;
 
 int GetIntFromResultSet(std::shared_ptr<NativeRdb::AbsSharedResultSet> resultSet, const std::string& colName)
 {
@@ -86,6 +89,21 @@ std::string GetStringFromResultSet(std::shared_ptr<NativeRdb::AbsSharedResultSet
     return value;
 }
 
+std::vector<uint8_t> GetBlobFromResultSet(std::shared_ptr<NativeRdb::AbsSharedResultSet> resultSet,
+    const std::string& colName)
+{
+    std::vector<uint8_t> value;
+    int colIndex = 0;
+    if (resultSet->GetColumnIndex(colName, colIndex) != NativeRdb::E_OK) {
+        HILOG_WARN(LOG_CORE, "failed to get column index, colName=%{public}s", colName.c_str());
+        return value;
+    }
+    if (resultSet->GetBlob(colIndex, value) != NativeRdb::E_OK) {
+        HILOG_WARN(LOG_CORE, "failed to get blob value, colName=%{public}s", colName.c_str());
+    }
+    return value;
+}
+
 std::shared_ptr<AppEventPack> GetEventFromResultSet(std::shared_ptr<NativeRdb::AbsSharedResultSet> resultSet)
 {
     auto event = std::make_shared<AppEventPack>();
@@ -101,7 +119,11 @@ std::shared_ptr<AppEventPack> GetEventFromResultSet(std::shared_ptr<NativeRdb::A
     event->SetSpanId(GetLongFromResultSet(resultSet, Events::FIELD_SPAN_ID));
     event->SetPspanId(GetLongFromResultSet(resultSet, Events::FIELD_PSPAN_ID));
     event->SetTraceFlag(GetIntFromResultSet(resultSet, Events::FIELD_TRACE_FLAG));
-    event->SetParamStr(GetStringFromResultSet(resultSet, Events::FIELD_PARAMS));
+    if (int codec = GetIntFromResultSet(resultSet, Events::FIELD_PARAMS_CODEC); codec != CompressUtil::CODEC_NONE) {
+        event->SetStoredParams(GetBlobFromResultSet(resultSet, Events::FIELD_PARAMS), codec);
+    } else {
+        event->SetParamStr(GetStringFromResultSet(resultSet, Events::FIELD_PARAMS));
+    }
     event->SetRunningId(GetStringFromResultSet(resultSet, Events::FIELD_RUNNING_ID));
     return event;
 }
@@ -119,6 +141,36 @@ int UpToDbVersion3(NativeRdb::RdbStore& rdbStore)
         + Observers::FIELD_FILTERS + " " + SqlUtil::SQL_TEXT_TYPE + " DEFAULT " + "'';";
     return rdbStore.ExecuteSql(sql);
 }
+
+int UpToDbVersion4(NativeRdb::RdbStore& rdbStore)
+{
+    const std::vector<std::string> sqls = {
+        "ALTER TABLE " + AppEventMapping::TABLE + " ADD COLUMN " + AppEventMapping::FIELD_EVENT_SIZE + " "
+            + SqlUtil::SQL_INT_ZERO_TYPE + ";",
+        std::string("ALTER TABLE ") + Observers::TABLE + " ADD COLUMN " + Observers::FIELD_EVENT_ROWS + " "
+            + SqlUtil::SQL_INT_ZERO_TYPE + ";",
+        std::string("ALTER TABLE ") + Observers::TABLE + " ADD COLUMN " + Observers::FIELD_EVENT_BYTES + " "
+            + SqlUtil::SQL_INT_ZERO_TYPE + ";",
+        // the size of the history mapping records is unknown, so only the rows are restored
+        std::string("UPDATE ") + Observers::TABLE + " SET " + Observers::FIELD_EVENT_ROWS + "=(SELECT COUNT(*) FROM "
+            + AppEventMapping::TABLE + " WHERE " + AppEventMapping::FIELD_OBSERVER_SEQ + "=" + Observers::TABLE + "."
+            + Observers::FIELD_SEQ + ");",
+    };
+    for (const auto& sql : sqls) {
+        if (int ret = rdbStore.ExecuteSql(sql); ret != NativeRdb::E_OK) {
+            return ret;
+        }
+    }
+    return AppEventMappingDao::CreateCounterTriggers(rdbStore);
+}
+
+int UpToDbVersion5(NativeRdb::RdbStore& rdbStore)
+{
+    // the params of the history events are kept as the json text
+    std::string sql = std::string("ALTER TABLE ") + Events::TABLE + " ADD COLUMN " + Events::FIELD_PARAMS_CODEC + " "
+        + SqlUtil::SQL_INT_ZERO_TYPE + ";";
+    return rdbStore.ExecuteSql(sql);
+}
 }
 
 int AppEventStoreCallback::OnCreate(NativeRdb::RdbStore& rdbStore)
@@ -172,6 +224,18 @@ int AppEventStoreCallback::OnUpgrade(NativeRdb::RdbStore& rdbStore, int oldVersi
                     return ret;
                 }
                 break;
+            case 3: // upgrade db version from 3 to 4
+                if (int ret = UpToDbVersion4(rdbStore); ret != NativeRdb::E_OK) {
+                    HILOG_ERROR(LOG_CORE, "failed to upgrade db version from 3 to 4, ret=%{public}d", ret);
+                    return ret;
+                }
+                break;
+            case 4: // upgrade db version from 4 to 5
+                if (int ret = UpToDbVersion5(rdbStore); ret != NativeRdb::E_OK) {
+                    HILOG_ERROR(LOG_CORE, "failed to upgrade db version from 4 to 5, ret=%{public}d", ret);
+                    return ret;
+                }
+                break;
             default:
                 break;
         }
@@ -179,13 +243,11 @@ int AppEventStoreCallback::OnUpgrade(NativeRdb::RdbStore& rdbStore, int oldVersi
     return NativeRdb::E_OK;
 }
 
-AppEventStore::AppEventStore()
-{
-    (void)InitDbStore();
-}
+AppEventStore::AppEventStore() = default;
 
 AppEventStore::~AppEventStore()
 {
+    stmtCache_ = nullptr;
     dbStore_ = nullptr;
 }
 
@@ -195,6 +257,15 @@ AppEventStore& AppEventStore::GetInstance()
     return instance;
 }
 
+int AppEventStore::OpenDbStore()
+{
+    std::unique_lock<std::shared_mutex> lock(dbMutex_);
+    if (dbStore_ != nullptr) {
+        return DB_SUCC;
+    }
+    return InitDbStore();
+}
+
 int AppEventStore::InitDbStore()
 {
     if (!InitDbStoreDir()) {
@@ -204,7 +275,7 @@ int AppEventStore::InitDbStore()
     int ret = NativeRdb::E_OK;
     NativeRdb::RdbStoreConfig config(dirPath_ + DATABASE_NAME);
     config.SetSecurityLevel(NativeRdb::SecurityLevel::S1);
-    const int dbVersion = 3; // 3 means new db version
+    const int dbVersion = 5; // 5 means new db version
     AppEventStoreCallback callback;
     auto dbStore = NativeRdb::RdbHelper::GetRdbStore(config, dbVersion, callback, ret);
     if (ret != NativeRdb::E_OK || dbStore == nullptr) {
@@ -214,6 +285,7 @@ int AppEventStore::InitDbStore()
     }
 
     dbStore_ = dbStore;
+    stmtCache_ = std::make_shared<AppEventStatementCache>(dbStore);
     HILOG_INFO(LOG_CORE, "create db store successfully");
     return DB_SUCC;
 }
@@ -235,12 +307,18 @@ bool AppEventStore::InitDbStoreDir()
 
 int AppEventStore::ExecuteDbOperation(const std::function<int()>& func)
 {
+    PipelineMetrics::StageTimer timer(PipelineMetrics::DB_OP);
+    PipelineMetrics::Add(PipelineMetrics::DB_OPS);
     bool isExecuted = false;
     int OperationRes = ExecuteReadOperation(func, isExecuted);
     if (OperationRes == DB_SUCC) {
         return DB_SUCC;
     }
-    return ExecuteWriteOperation(func, isExecuted, OperationRes);
+    int ret = ExecuteWriteOperation(func, isExecuted, OperationRes);
+    if (ret != DB_SUCC) {
+        PipelineMetrics::Add(PipelineMetrics::DB_OP_FAILURES);
+    }
+    return ret;
 }
 
 int AppEventStore::ExecuteReadOperation(const std::function<int()>& func, bool& isExecuted)
@@ -269,12 +347,21 @@ int AppEventStore::ExecuteWriteOperation(const std::function<int()>& func, const
     return DB_FAILED;
 }
 
+void AppEventStore::ClearCustomParamsCache()
+{
+    std::lock_guard<std::mutex> lock(customParamsMutex_);
+    customParamsCache_.clear();
+    ++customParamsVersion_;
+}
+
 void AppEventStore::CheckAndRepairDbStore(int errCode)
 {
     if (errCode != NativeRdb::E_SQLITE_CORRUPT) {
         return;
     }
+    stmtCache_ = nullptr;
     dbStore_ = nullptr;
+    ClearCustomParamsCache();
     if (int ret = NativeRdb::RdbHelper::DeleteRdbStore(dirPath_ + DATABASE_NAME); ret != NativeRdb::E_OK) {
         HILOG_ERROR(LOG_CORE, "errCode=%{public}d failed to delete db file, ret=%{public}d", errCode, ret);
         return;
@@ -289,7 +376,9 @@ int AppEventStore::DestroyDbStore()
     if (dbStore_ == nullptr) {
         return DB_SUCC;
     }
+    stmtCache_ = nullptr;
     dbStore_ = nullptr;
+    ClearCustomParamsCache();
     if (int ret = NativeRdb::RdbHelper::DeleteRdbStore(dirPath_ + DATABASE_NAME); ret != NativeRdb::E_OK) {
         HILOG_ERROR(LOG_CORE, "failed to destroy db store, ret=%{public}d", ret);
         return DB_FAILED;
@@ -302,7 +391,7 @@ int64_t AppEventStore::InsertEvent(std::shared_ptr<AppEventPack> event)
 {
     int64_t seq = 0;
     auto func = [this, &event, &seq] () {
-        return AppEventDao::Insert(dbStore_, event, seq);
+        return stmtCache_->InsertEvent(event, seq);
     };
     if (ExecuteDbOperation(func) == DB_FAILED) {
         return DB_FAILED;
@@ -325,7 +414,7 @@ int64_t AppEventStore::InsertObserver(const Observer& observer)
 int AppEventStore::InsertEventMapping(const std::vector<EventObserverInfo>& eventObservers)
 {
     auto func = [this, &eventObservers] () {
-        return AppEventMappingDao::Insert(dbStore_, eventObservers);
+        return stmtCache_->InsertEventMapping(eventObservers);
     };
     return ExecuteDbOperation(func);
 }
@@ -403,6 +492,7 @@ int AppEventStore::InsertCustomEventParams(std::shared_ptr<AppEventPack> event)
         return DB_SUCC;
     };
     int res = ExecuteDbOperation(func);
+    ClearCustomParamsCache();
     HILOG_INFO(LOG_CORE, "the event(%{public}s) current runningId is %{public}s, add %{public}zu custom params, "
         "ret=%{public}d", event->GetName().c_str(), event->GetRunningId().c_str(), newParams.size(), res);
     return errCode != DB_SUCC ? errCode : res;
@@ -512,7 +602,7 @@ int AppEventStore::TakeEvents(std::vector<std::shared_ptr<AppEventPack>>& events
     }
 
     auto func = [this, &observerSeq, &eventSeqs] () {
-        int ret = AppEventMappingDao::Delete(dbStore_, observerSeq, eventSeqs);
+        int ret = stmtCache_->DeleteEventMapping(observerSeq, eventSeqs);
         if (ret != NativeRdb::E_OK) {
             HILOG_WARN(LOG_CORE, "failed to delete the events mapping data ret=%{public}d, observer=%{public}" PRId64,
                 ret, observerSeq);
@@ -525,15 +615,7 @@ int AppEventStore::TakeEvents(std::vector<std::shared_ptr<AppEventPack>>& events
 int AppEventStore::QueryEvents(std::vector<std::shared_ptr<AppEventPack>>& events, int64_t observerSeq, uint32_t size)
 {
     auto func = [this, &events, &observerSeq, &size] () {
-        std::shared_ptr<NativeRdb::AbsSharedResultSet> resultSet = nullptr;
-        std::string sql = std::string("SELECT ") + Events::TABLE + ".* FROM " + AppEventMapping::TABLE + " INNER JOIN "
-            + Events::TABLE + " ON " + AppEventMapping::TABLE + "." + AppEventMapping::FIELD_EVENT_SEQ + "="
-            + Events::TABLE + "." + Events::FIELD_SEQ + " WHERE " + AppEventMapping::FIELD_OBSERVER_SEQ + "=?"
-            + " ORDER BY " + AppEventMapping::TABLE + "." + AppEventMapping::FIELD_EVENT_SEQ + " DESC ";
-        if (size > 0) {
-            sql += " LIMIT " + std::to_string(size);
-        }
-        resultSet = dbStore_->QuerySql(sql, std::vector<std::string>{std::to_string(observerSeq)});
+        auto resultSet = stmtCache_->QueryEvents(observerSeq, size);
         if (resultSet == nullptr) {
             HILOG_WARN(LOG_CORE, "result set is null, observer=%{public}" PRId64, observerSeq);
             return DB_FAILED;
@@ -543,10 +625,7 @@ int AppEventStore::QueryEvents(std::vector<std::shared_ptr<AppEventPack>>& event
             auto event = GetEventFromResultSet(resultSet);
             // query custom event params, and add to AppEventPack
             std::unordered_map<std::string, std::string> params;
-            // event name is not mandatory, query custom event params with event name is "" first
-            CustomEventParamDao::Query(dbStore_, params, CustomEvent(event->GetRunningId(), event->GetDomain(), ""));
-            CustomEventParamDao::Query(dbStore_, params,
-                CustomEvent(event->GetRunningId(), event->GetDomain(), event->GetName()));
+            stmtCache_->QueryCustomParams(params, event->GetRunningId(), event->GetDomain(), event->GetName());
             event->AddCustomParams(params);
             events.emplace_back(event);
             ret = resultSet->GoToNextRow();
@@ -562,20 +641,38 @@ int AppEventStore::QueryEvents(std::vector<std::shared_ptr<AppEventPack>>& event
 
 int AppEventStore::QueryCustomParamsAdd2EventPack(std::shared_ptr<AppEventPack> event)
 {
-    auto func = [this, &event] () {
-        std::unordered_map<std::string, std::string> params;
-        // event name is not mandatory, query custom event params with event name is "" first
-        CustomEventParamDao::Query(dbStore_, params, CustomEvent(event->GetRunningId(), event->GetDomain(), ""));
-        CustomEventParamDao::Query(dbStore_, params,
-            CustomEvent(event->GetRunningId(), event->GetDomain(), event->GetName()));
+    CustomParamsKey key(event->GetRunningId(), event->GetDomain(), event->GetName());
+    uint64_t version = 0;
+    {
+        std::lock_guard<std::mutex> lock(customParamsMutex_);
+        if (auto it = customParamsCache_.find(key); it != customParamsCache_.end()) {
+            event->AddCustomParams(it->second);
+            return DB_SUCC;
+        }
+        version = customParamsVersion_;
+    }
+    std::unordered_map<std::string, std::string> params;
+    auto func = [this, &event, &params] () {
+        stmtCache_->QueryCustomParams(params, event->GetRunningId(), event->GetDomain(), event->GetName());
         if (params.empty() && event->GetDomain() != "api_diagnostic") {
             HILOG_WARN(LOG_CORE, "the event(%{public}s) current runningId is %{public}s, the custom param is empty.",
                 event->GetName().c_str(), event->GetRunningId().c_str());
         }
-        event->AddCustomParams(params);
         return DB_SUCC;
     };
-    return ExecuteDbOperation(func);
+    if (int ret = ExecuteDbOperation(func); ret != DB_SUCC) {
+        return ret;
+    }
+    event->AddCustomParams(params);
+    std::lock_guard<std::mutex> lock(customParamsMutex_);
+    // the params queried before they are changed are not cached
+    if (version == customParamsVersion_) {
+        if (customParamsCache_.size() >= MAX_NUM_OF_CACHED_CUSTOM_PARAMS) {
+            customParamsCache_.clear();
+        }
+        customParamsCache_.emplace(std::move(key), std::move(params));
+    }
+    return DB_SUCC;
 }
 
 int64_t AppEventStore::QueryObserverSeq(const std::string& name, int64_t hashCode)
@@ -584,6 +681,14 @@ int64_t AppEventStore::QueryObserverSeq(const std::string& name, int64_t hashCod
     return QueryObserverSeqAndFilters(name, hashCode, filters);
 }
 
+int AppEventStore::QueryObserver(Observer& observer)
+{
+    auto func = [this, &observer] () {
+        return AppEventObserverDao::QueryObserver(dbStore_, observer);
+    };
+    return ExecuteDbOperation(func);
+}
+
 int64_t AppEventStore::QueryObserverSeqAndFilters(const std::string& name, int64_t hashCode, std::string& filters)
 {
     int64_t seq = 0;
@@ -627,6 +732,9 @@ int AppEventStore::DeleteObserver(int64_t observerSeq)
 int AppEventStore::DeleteEventMapping(int64_t observerSeq, const std::vector<int64_t>& eventSeqs)
 {
     auto func = [this, &observerSeq, &eventSeqs] () {
+        if (observerSeq > 0 && !eventSeqs.empty()) {
+            return stmtCache_->DeleteEventMapping(observerSeq, eventSeqs);
+        }
         return AppEventMappingDao::Delete(dbStore_, observerSeq, eventSeqs);
     };
     return ExecuteDbOperation(func);
@@ -645,7 +753,9 @@ int AppEventStore::DeleteCustomEventParams()
     auto func = [this] () {
         return CustomEventParamDao::Delete(dbStore_);
     };
-    return ExecuteDbOperation(func);
+    int ret = ExecuteDbOperation(func);
+    ClearCustomParamsCache();
+    return ret;
 }
 
 int AppEventStore::DeleteEvent(const std::vector<int64_t>& eventSeqs)
@@ -717,7 +827,9 @@ int AppEventStore::DeleteUnusedParamsExceptCurId(const std::string& curRunningId
         HILOG_INFO(LOG_CORE, "delete %{public}d params unused", deleteRows);
         return DB_SUCC;
     };
-    return ExecuteDbOperation(func);
+    int ret = ExecuteDbOperation(func);
+    ClearCustomParamsCache();
+    return ret;
 }
 
 int AppEventStore::DeleteUnusedEventMapping()
@@ -740,23 +852,7 @@ int AppEventStore::DeleteUnusedEventMapping()
 int AppEventStore::DeleteHistoryEvent(int reservedNum, int reservedNumOs)
 {
     auto func = [this, &reservedNum, &reservedNumOs] () {
-        int deleteRows = 0;
-        std::vector<std::string> whereArgs = {
-            DOMAIN_OS, std::to_string(reservedNum), DOMAIN_OS, std::to_string(reservedNumOs)
-        };
-        // delete history events, keep the latest reservedNum events,
-        // and keep the latest reservedNumOs events of OS domain
-        std::string whereClause
-            = std::string(Events::FIELD_SEQ) + " NOT IN (SELECT " + Events::FIELD_SEQ + " FROM " + Events::TABLE
-            + " WHERE " + Events::FIELD_DOMAIN + " != ? ORDER BY "+ Events::FIELD_SEQ + " DESC LIMIT 0,?) AND "
-            + Events::FIELD_SEQ + " NOT IN (SELECT " + Events::FIELD_SEQ + " FROM " + Events::TABLE
-            + " WHERE " + Events::FIELD_DOMAIN + " = ? ORDER BY " + Events::FIELD_SEQ + " DESC LIMIT 0,?)";
-        int ret = dbStore_->Delete(deleteRows, Events::TABLE, whereClause, whereArgs);
-        if (ret != NativeRdb::E_OK) {
-            return ret;
-        }
-        HILOG_INFO(LOG_CORE, "delete %{public}d events over limit", deleteRows);
-        return DB_SUCC;
+        return stmtCache_->DeleteHistoryEvent(reservedNum, reservedNumOs);
     };
     return ExecuteDbOperation(func);
 }
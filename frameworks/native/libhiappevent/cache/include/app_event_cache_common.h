@@ -42,6 +42,7 @@ constexpr const char* FIELD_TRACE_FLAG = "trace_flag";
 constexpr const char* FIELD_PARAMS = "params";
 constexpr const char* FIELD_SIZE = "size";
 constexpr const char* FIELD_RUNNING_ID = "running_id";
+constexpr const char* FIELD_PARAMS_CODEC = "params_codec";
 } // namespace Events
 
 namespace Observers {
@@ -50,6 +51,8 @@ constexpr const char* FIELD_SEQ = "seq";
 constexpr const char* FIELD_NAME = "name";
 constexpr const char* FIELD_HASH = "hash";
 constexpr const char* FIELD_FILTERS = "filters";
+constexpr const char* FIELD_EVENT_ROWS = "event_rows";
+constexpr const char* FIELD_EVENT_BYTES = "event_bytes";
 } // namespace Observers
 
 struct Observer {
@@ -62,6 +65,8 @@ struct Observer {
     std::string name;
     int64_t hashCode = 0;
     std::string filters;
+    int64_t eventRows = 0; // num of the events mapped to the observer
+    int64_t eventBytes = 0; // total size of the events mapped to the observer
 };
 
 namespace AppEventMapping {
@@ -69,12 +74,15 @@ const std::string TABLE = "event_observer_mapping";
 const std::string FIELD_SEQ = "seq";
 const std::string FIELD_EVENT_SEQ = "event_seq";
 const std::string FIELD_OBSERVER_SEQ = "observer_seq";
+const std::string FIELD_EVENT_SIZE = "event_size";
 } // namespace AppEventMapping
 
 struct EventObserverInfo {
-    EventObserverInfo(int64_t eventSeq, int64_t observerSeq) : eventSeq(eventSeq), observerSeq(observerSeq) {}
+    EventObserverInfo(int64_t eventSeq, int64_t observerSeq, int64_t eventSize = 0)
+        : eventSeq(eventSeq), observerSeq(observerSeq), eventSize(eventSize) {}
     int64_t eventSeq = 0;
     int64_t observerSeq = 0;
+    int64_t eventSize = 0;
 };
 
 namespace UserIds {
@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef HIAPPEVENT_FRAMEWORKS_NATIVE_LIB_HIAPPEVENT_CACHE_APP_EVENT_CRASH_RING_H
+#define HIAPPEVENT_FRAMEWORKS_NATIVE_LIB_HIAPPEVENT_CACHE_APP_EVENT_CRASH_RING_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "nocopyable.h"
+
+namespace OHOS {
+namespace HiviewDFX {
+class AppEventPack;
+
+/*
+ * Preallocated ring file mapped into memory, which keeps a copy of the events that are being written. The pages of
+ * a shared mapping survive the crash of the process, so the events left pending in the ring are recovered on the
+ * next startup and written again.
+ *
+ * Each process has its own ring file and holds a lock on it while it runs. The rings of the other processes are
+ * only recovered once their owners have released the lock, so the records of a live process are never taken. The
+ * recovered rings stay locked until their records are written and released, so a second crash loses nothing.
+ *
+ * Appending only reserves the space by an atomic operation and copies the record, so it is lock-free and
+ * async-signal-safe. Once the ring wraps, the oldest records are overwritten, so the newest events are kept.
+ */
+class AppEventCrashRing : public NoCopyable {
+public:
+    static constexpr uint32_t INVALID_TOKEN = 0;
+
+    static AppEventCrashRing& GetInstance();
+    uint32_t Append(const AppEventPack& event);
+    uint32_t Append(const char* data, uint32_t len);
+    void Complete(uint32_t token);
+    void TakeRecoveredEvents(std::vector<std::shared_ptr<AppEventPack>>& events);
+    void ReleaseRecoveredEvents();
+    bool IsReady() const;
+
+    // for test
+    bool Open(const std::string& dir, uint32_t capacity);
+    void Close();
+
+private:
+    AppEventCrashRing();
+    ~AppEventCrashRing();
+    void Unmap();
+    void Reset();
+    int CreateRingFile(const std::string& dir, std::string& path);
+    void RecoverOrphans(const std::string& dir, const std::string& ownPath);
+
+private:
+    std::mutex mutex_;
+    std::atomic<uint8_t*> base_ = nullptr;
+    uint32_t capacity_ = 0;
+    size_t mapSize_ = 0;
+    int fd_ = -1;
+    std::vector<std::string> recoveredRecords_;
+    std::vector<std::pair<std::string, int>> recoveredFiles_; // the path and the locked fd of the recovered rings
+};
+} // namespace HiviewDFX
+} // namespace OHOS
+#endif // HIAPPEVENT_FRAMEWORKS_NATIVE_LIB_HIAPPEVENT_CACHE_APP_EVENT_CRASH_RING_H
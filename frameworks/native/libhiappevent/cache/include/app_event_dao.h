@@ -25,6 +25,12 @@ namespace HiviewDFX {
 class AppEventPack;
 namespace AppEventDao {
 int Create(NativeRdb::RdbStore& dbStore);
+
+/*
+ * Makes the value stored in the params column, which is compressed if the params are large enough.
+ * Returns the codec stored in the params_codec column.
+ */
+int MakeParamsValue(const AppEventPack& event, NativeRdb::ValueObject& value);
 int Insert(std::shared_ptr<NativeRdb::RdbStore> dbStore, std::shared_ptr<AppEventPack> event, int64_t& seq);
 int Delete(std::shared_ptr<NativeRdb::RdbStore> dbStore, int64_t eventSeq);
 int Delete(std::shared_ptr<NativeRdb::RdbStore> dbStore, const std::vector<int64_t>& eventSeqs);
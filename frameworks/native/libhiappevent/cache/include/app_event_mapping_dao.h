@@ -26,6 +26,7 @@ namespace OHOS {
 namespace HiviewDFX {
 namespace AppEventMappingDao {
 int Create(NativeRdb::RdbStore& dbStore);
+int CreateCounterTriggers(NativeRdb::RdbStore& dbStore);
 int Insert(std::shared_ptr<NativeRdb::RdbStore> dbStore,
     const std::vector<AppEventCacheCommon::EventObserverInfo>& eventObservers);
 int Delete(std::shared_ptr<NativeRdb::RdbStore> dbStore, int64_t observerSeq, const std::vector<int64_t>& eventSeqs);
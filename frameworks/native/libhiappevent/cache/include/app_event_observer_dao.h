@@ -30,6 +30,7 @@ int Insert(std::shared_ptr<NativeRdb::RdbStore> dbStore, const AppEventCacheComm
 int Update(std::shared_ptr<NativeRdb::RdbStore> dbStore, int64_t seq, const std::string& filters);
 int QuerySeqAndFilters(std::shared_ptr<NativeRdb::RdbStore> dbStore, const AppEventCacheCommon::Observer& observer,
     int64_t& seq, std::string& filters);
+int QueryObserver(std::shared_ptr<NativeRdb::RdbStore> dbStore, AppEventCacheCommon::Observer& observer);
 int QuerySeqs(std::shared_ptr<NativeRdb::RdbStore> dbStore, const std::string& name,
     std::vector<int64_t>& observerSeqs);
 int QueryWatchers(std::shared_ptr<NativeRdb::RdbStore> dbStore, std::vector<AppEventCacheCommon::Observer>& observers);
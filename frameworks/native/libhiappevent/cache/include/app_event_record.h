@@ -0,0 +1,37 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef HIAPPEVENT_FRAMEWORKS_NATIVE_LIB_HIAPPEVENT_CACHE_APP_EVENT_RECORD_H
+#define HIAPPEVENT_FRAMEWORKS_NATIVE_LIB_HIAPPEVENT_CACHE_APP_EVENT_RECORD_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace OHOS {
+namespace HiviewDFX {
+class AppEventPack;
+
+/*
+ * Binary record of an event with the same fields as a row of the event table, which is used to keep the
+ * events in the ring files. The record is only read by the same version of the library.
+ */
+namespace AppEventRecord {
+std::string Encode(const AppEventPack& event);
+std::shared_ptr<AppEventPack> Decode(const std::string& buf);
+uint32_t GetChecksum(const uint8_t* data, uint32_t len);
+} // namespace AppEventRecord
+} // namespace HiviewDFX
+} // namespace OHOS
+#endif // HIAPPEVENT_FRAMEWORKS_NATIVE_LIB_HIAPPEVENT_CACHE_APP_EVENT_RECORD_H
@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef HIAPPEVENT_FRAMEWORKS_NATIVE_LIB_HIAPPEVENT_CACHE_APP_EVENT_STATEMENT_CACHE_H
+#define HIAPPEVENT_FRAMEWORKS_NATIVE_LIB_HIAPPEVENT_CACHE_APP_EVENT_STATEMENT_CACHE_H
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "app_event_cache_common.h"
+#include "nocopyable.h"
+#include "rdb_store.h"
+
+namespace OHOS {
+namespace HiviewDFX {
+class AppEventPack;
+
+/*
+ * Holds the SQL text of the hot statements for one db connection. The text of every statement is built
+ * once when the connection is opened and only the bind args change between calls, so the connection can
+ * reuse the compiled statement instead of building and parsing a new one for every event.
+ */
+class AppEventStatementCache : public NoCopyable {
+public:
+    explicit AppEventStatementCache(std::shared_ptr<NativeRdb::RdbStore> dbStore);
+    ~AppEventStatementCache() = default;
+
+    int InsertEvent(std::shared_ptr<AppEventPack> event, int64_t& seq);
+    int InsertEventMapping(const std::vector<AppEventCacheCommon::EventObserverInfo>& eventObservers);
+    std::shared_ptr<NativeRdb::AbsSharedResultSet> QueryEvents(int64_t observerSeq, uint32_t size);
+    int QueryCustomParams(std::unordered_map<std::string, std::string>& params,
+        const std::string& runningId, const std::string& domain, const std::string& name);
+    int DeleteEventMapping(int64_t observerSeq, const std::vector<int64_t>& eventSeqs);
+    int DeleteHistoryEvent(int reservedNum, int reservedNumOs);
+
+private:
+    void BuildStatements();
+    int ExecuteMappingInsert(const std::vector<AppEventCacheCommon::EventObserverInfo>& eventObservers,
+        size_t start, size_t num);
+    int ExecuteMappingDelete(int64_t observerSeq, const std::vector<int64_t>& eventSeqs, size_t start, size_t num);
+
+private:
+    std::shared_ptr<NativeRdb::RdbStore> dbStore_;
+    std::string insertEventSql_;
+    std::string queryEventsSql_;
+    std::string queryCustomParamsSql_;
+    std::string deleteHistoryEventSql_;
+
+    // indexed by the number of rows or seqs bound to the statement
+    std::vector<std::string> insertMappingSqls_;
+    std::vector<std::string> deleteMappingSqls_;
+};
+} // namespace HiviewDFX
+} // namespace OHOS
+#endif // HIAPPEVENT_FRAMEWORKS_NATIVE_LIB_HIAPPEVENT_CACHE_APP_EVENT_STATEMENT_CACHE_H
@@ -15,14 +15,19 @@
 #ifndef HIAPPEVENT_FRAMEWORKS_NATIVE_LIB_HIAPPEVENT_CACHE_APP_EVENT_STORE_H
 #define HIAPPEVENT_FRAMEWORKS_NATIVE_LIB_HIAPPEVENT_CACHE_APP_EVENT_STORE_H
 
+#include <map>
 #include <memory>
+#include <mutex>
 #include <shared_mutex>
 #include <string>
+#include <tuple>
+#include <unordered_map>
 #include <vector>
 
 #include "app_event_dao.h"
 #include "app_event_mapping_dao.h"
 #include "app_event_observer_dao.h"
+#include "app_event_statement_cache.h"
 #include "custom_event_param_dao.h"
 #include "nocopyable.h"
 #include "rdb_store.h"
@@ -39,6 +44,7 @@ class AppEventStore : public NoCopyable {
 public:
     static AppEventStore& GetInstance();
 
+    int OpenDbStore();
     int InitDbStore();
     int DestroyDbStore();
     int64_t InsertEvent(std::shared_ptr<AppEventPack> event);
@@ -54,6 +60,7 @@ public:
     int TakeEvents(std::vector<std::shared_ptr<AppEventPack>>& events, int64_t observerSeq, uint32_t eventSize = 0);
     int QueryEvents(std::vector<std::shared_ptr<AppEventPack>>& events, int64_t observerSeq, uint32_t eventSize = 0);
     int64_t QueryObserverSeq(const std::string& name, int64_t hashCode = 0);
+    int QueryObserver(AppEventCacheCommon::Observer& observer);
     int64_t QueryObserverSeqAndFilters(const std::string& name, int64_t hashCode, std::string& filters);
     int QueryObserverSeqs(const std::string& name, std::vector<int64_t>& observerSeqs);
     int QueryWatchers(std::vector<AppEventCacheCommon::Observer>& observers);
@@ -84,11 +91,19 @@ private:
     int ExecuteDbOperation(const std::function<int()>& func);
     int ExecuteReadOperation(const std::function<int()>& func, bool& isExecuted);
     int ExecuteWriteOperation(const std::function<int()>& func, const bool& isExecuted, int& OperationRes);
+    void ClearCustomParamsCache();
 
 private:
     std::shared_ptr<NativeRdb::RdbStore> dbStore_;
+    std::shared_ptr<AppEventStatementCache> stmtCache_;
     std::string dirPath_;
     std::shared_mutex dbMutex_;
+
+    // the custom params of (running_id, domain, name) queried from the db, cleared whenever the params are changed
+    using CustomParamsKey = std::tuple<std::string, std::string, std::string>;
+    std::map<CustomParamsKey, std::unordered_map<std::string, std::string>> customParamsCache_;
+    uint64_t customParamsVersion_ = 0;
+    std::mutex customParamsMutex_;
 };
 } // namespace HiviewDFX
 } // namespace OHOS
@@ -20,8 +20,11 @@
 #include <sstream>
 #include <string>
 #include <unistd.h>
+#include <utility>
 #include <vector>
 
+#include "app_event_params_codec.h"
+#include "compress_util.h"
 #include "hiappevent_config.h"
 #include "hilog/log.h"
 #include "hitrace/trace.h"
@@ -123,6 +126,37 @@ std::string GetParamValuesStrByType(const AppEventParamValue& value)
     return GetValuesStr(*ptr);
 }
 
+template<typename T>
+size_t GetValueSize(const T&)
+{
+    return sizeof(T);
+}
+
+size_t GetValueSize(const std::monostate&)
+{
+    return 0;
+}
+
+size_t GetValueSize(const std::string& value)
+{
+    return value.size();
+}
+
+template<typename T>
+size_t GetValueSize(const std::vector<T>& values)
+{
+    return values.size() * sizeof(T);
+}
+
+size_t GetValueSize(const std::vector<std::string>& values)
+{
+    size_t size = 0;
+    for (const auto& value : values) {
+        size += value.size();
+    }
+    return size;
+}
+
 std::string GetParamValueStr(const AppEventParam& param)
 {
     switch (param.value.index()) {
@@ -164,6 +198,89 @@ std::string GetParamValueStr(const AppEventParam& param)
             return "";
     }
 }
+
+size_t GetIntegerStrSize(int64_t value)
+{
+    size_t size = (value < 0) ? 2 : 1; // 2: '-' and the last digit
+    while (value / 10 != 0) { // 10: decimal
+        value /= 10; // 10: decimal
+        ++size;
+    }
+    return size;
+}
+
+template<typename T>
+size_t GetValueStrSize(const T& value)
+{
+    return GetValueStr(value).size();
+}
+
+size_t GetValueStrSize(const std::monostate&)
+{
+    return 0;
+}
+
+size_t GetValueStrSize(bool value)
+{
+    return value ? 4 : 5; // 4: "true", 5: "false"
+}
+
+size_t GetValueStrSize(int16_t value)
+{
+    return GetIntegerStrSize(value);
+}
+
+size_t GetValueStrSize(int value)
+{
+    return GetIntegerStrSize(value);
+}
+
+size_t GetValueStrSize(int64_t value)
+{
+    return GetIntegerStrSize(value);
+}
+
+size_t GetValueStrSize(const std::string& value)
+{
+    return value.size() + 2; // 2: the quotes
+}
+
+template<typename T>
+size_t GetValueStrSize(const std::vector<T>& values)
+{
+    size_t size = 2 + (values.empty() ? 0 : values.size() - 1); // 2: '[]', and the ',' between the values
+    for (size_t i = 0; i < values.size(); ++i) {
+        if constexpr (std::is_same_v<std::decay_t<T>, bool>) { // vector<bool> is stored as bit type
+            bool bValue = values[i];
+            size += GetValueStrSize(bValue);
+        } else {
+            size += GetValueStrSize(values[i]);
+        }
+    }
+    return size;
+}
+
+size_t GetParamsStrSize(const std::list<AppEventParam>& params)
+{
+    // the size of the text written by WriteParamsToJsonString, without rendering the values
+    size_t size = 0;
+    for (const auto& param : params) {
+        size += param.name.size() + 4; // 4: '"":' and ','
+        size += std::visit([](const auto& value) { return GetValueStrSize(value); }, param.value);
+    }
+    return params.empty() ? 0 : size - 1; // -1 for the last ','
+}
+
+void WriteParamsToJsonString(std::stringstream& jsonStr, const std::list<AppEventParam>& params)
+{
+    if (params.empty()) {
+        return;
+    }
+    for (const auto& param : params) {
+        jsonStr << "\"" << param.name << "\":" << GetParamValueStr(param) << ",";
+    }
+    jsonStr.seekp(-1, std::ios_base::end); // -1 for delete ','
+}
 }
 
 AppEventParam::AppEventParam(std::string n, AppEventParamValue v) : name(n), value(v)
@@ -356,11 +473,13 @@ void AppEventPack::AddCustomParams(const std::unordered_map<std::string, std::st
         customParamStr.erase(customParamStr.end() - 1); // -1 for delete ','
         paramStr.insert(paramStr.size() - 2, customParamStr); // 2 for '}\0'
         paramStr_ = paramStr;
+        baseParams_.clear();
     }
 }
 
 std::string AppEventPack::GetEventStr() const
 {
+    LoadStoredParams();
     std::stringstream jsonStr;
     jsonStr << "{";
     AddBaseInfoToJsonString(jsonStr);
@@ -369,12 +488,29 @@ std::string AppEventPack::GetEventStr() const
     return jsonStr.str();
 }
 
+size_t AppEventPack::GetEventSize() const
+{
+    // the size of GetEventStr(), counted from the param text or the typed params instead of building the text
+    LoadStoredParams();
+    std::stringstream baseInfo;
+    AddBaseInfoToJsonString(baseInfo);
+    size_t size = baseInfo.str().size() + MIN_PARAM_STR_LEN; // 3: '{', '}' and the line end
+    if (baseParams_.size() != 0) {
+        return size + 1 + GetParamsStrSize(baseParams_); // 1: ',' before the params
+    }
+    size_t paramStrLen = paramStr_.size();
+    if (paramStrLen > MIN_PARAM_STR_LEN) {
+        size += paramStrLen - MIN_PARAM_STR_LEN + 1; // 1: ',' before the params
+    }
+    return size;
+}
+
 std::string AppEventPack::GetParamStr() const
 {
+    LoadStoredParams();
     if (!paramStr_.empty()) {
         return paramStr_;
     }
-
     std::stringstream jsonStr;
     jsonStr << "{";
     AddParamsToJsonString(jsonStr);
@@ -382,6 +518,29 @@ std::string AppEventPack::GetParamStr() const
     return jsonStr.str();
 }
 
+std::string AppEventPack::GetParamValue(const std::string& key) const
+{
+    const AppEventParam* param = FindBaseParam(key);
+    return param == nullptr ? "" : GetParamValueStr(*param);
+}
+
+const AppEventParam* AppEventPack::FindBaseParam(const std::string& key) const
+{
+    LoadStoredParams();
+    for (const auto& param : baseParams_) {
+        if (param.name == key) {
+            return &param;
+        }
+    }
+    return nullptr;
+}
+
+bool AppEventPack::HasBaseParams() const
+{
+    LoadStoredParams();
+    return !baseParams_.empty();
+}
+
 void AppEventPack::AddBaseInfoToJsonString(std::stringstream& jsonStr) const
 {
     jsonStr << "\"" << "domain_" << "\":" << "\"" << domain_ << "\",";
@@ -423,17 +582,12 @@ void AppEventPack::AddParamsInfoToJsonString(std::stringstream& jsonStr) const
 
 void AppEventPack::AddParamsToJsonString(std::stringstream& jsonStr) const
 {
-    if (baseParams_.empty()) {
-        return;
-    }
-    for (const auto& param : baseParams_) {
-        jsonStr << "\"" << param.name << "\":" << GetParamValueStr(param) << ",";
-    }
-    jsonStr.seekp(-1, std::ios_base::end); // -1 for delete ','
+    WriteParamsToJsonString(jsonStr, baseParams_);
 }
 
 void AppEventPack::GetCustomParams(std::vector<CustomEventParam>& customParams) const
 {
+    LoadStoredParams();
     for (const auto& param : baseParams_) {
         CustomEventParam customParam = {
             .key = param.name,
@@ -509,11 +663,29 @@ std::string AppEventPack::GetRunningId() const
     return runningId_;
 }
 
+size_t AppEventPack::GetEstimatedSize() const
+{
+    // approximates the memory held by the event without building the json string, or inflating the stored params
+    size_t size = domain_.size() + name_.size() + paramStr_.size() + storedParams_.size();
+    for (const auto& param : baseParams_) {
+        size += param.name.size() + std::visit([](const auto& value) { return GetValueSize(value); }, param.value);
+    }
+    return size;
+}
+
 std::list<AppEventParam> AppEventPack::GetBaseParams() const
 {
+    LoadStoredParams();
     return baseParams_;
 }
 
+const std::list<AppEventParam>* AppEventPack::GetTypedParams() const
+{
+    // the params set as json text, which are the ones from the db or with the custom params, replace the typed ones
+    LoadStoredParams();
+    return paramStr_.empty() ? &baseParams_ : nullptr;
+}
+
 void AppEventPack::SetSeq(int64_t seq)
 {
     seq_ = seq;
@@ -589,6 +761,48 @@ void AppEventPack::SetBaseParams(const std::list<AppEventParam>& baseParams)
 void AppEventPack::SetParamStr(const std::string& paramStr)
 {
     paramStr_ = paramStr;
+    baseParams_.clear();
+    storedParams_.clear();
+}
+
+void AppEventPack::SetStoredParams(const std::vector<uint8_t>& params, int codec)
+{
+    paramStr_.clear();
+    baseParams_.clear();
+    storedParams_ = params;
+    storedCodec_ = codec;
+}
+
+void AppEventPack::LoadStoredParams() const
+{
+    // the stored params are inflated and decoded on the first read only, and the events read from the db belong
+    // to the one who queries them, so the params are filled in without a lock
+    if (storedParams_.empty()) {
+        return;
+    }
+    std::vector<uint8_t> params;
+    params.swap(storedParams_);
+    std::string buffer;
+    int compressCodec = storedCodec_ & AppEventParamsCodec::COMPRESS_CODEC_MASK;
+    if (compressCodec == CompressUtil::CODEC_NONE) {
+        buffer.assign(params.begin(), params.end());
+    } else if (!CompressUtil::Decompress(params.data(), params.size(), compressCodec, buffer)) {
+        HILOG_ERROR(LOG_CORE, "failed to decompress the stored params, codec=%{public}d, size=%{public}zu",
+            storedCodec_, params.size());
+        return;
+    }
+    if ((storedCodec_ & AppEventParamsCodec::FORMAT_BINARY) == 0) {
+        paramStr_ = std::move(buffer);
+        return;
+    }
+    // the params in the binary form are decoded as they are typed, so the event is read the same as a written one,
+    // and they go before the params added after the event is read
+    std::list<AppEventParam> storedParams;
+    if (!AppEventParamsCodec::Decode(reinterpret_cast<const uint8_t*>(buffer.data()), buffer.size(), storedParams)) {
+        HILOG_ERROR(LOG_CORE, "failed to decode the stored params, size=%{public}zu", buffer.size());
+        return;
+    }
+    baseParams_.splice(baseParams_.begin(), storedParams);
 }
 } // namespace HiviewDFX
 } // namespace OHOS
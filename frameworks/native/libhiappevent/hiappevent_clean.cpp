@@ -25,6 +25,8 @@
 #include "hiappevent_config.h"
 #include "hiappevent_userinfo.h"
 #include "hilog/log.h"
+#include "pipeline_metrics.h"
+#include "pipeline_trace.h"
 
 #undef LOG_DOMAIN
 #define LOG_DOMAIN 0xD002D07
@@ -65,20 +67,28 @@ bool IsStorageSpaceFull(const std::string& dir, uint64_t maxSize)
 bool ReleaseSomeStorageSpace(const std::string& dir, uint64_t maxSize)
 {
     HILOG_INFO(LOG_CORE, "start to clear the storage space");
+    PipelineTrace::ScopedTrace trace(PipelineTrace::CLEAN_STORAGE);
     std::vector<std::shared_ptr<AppEventCleaner>> cleaners;
     CreateCleaners(dir, cleaners);
-    auto curSize = GetCurStorageSize(dir);
+    PipelineMetrics::Add(PipelineMetrics::CLEAN_RUNS);
+    const auto beginSize = GetCurStorageSize(dir);
+    auto curSize = beginSize;
     for (auto it = cleaners.rbegin(); it != cleaners.rend(); ++it) { // clear the log space first
         curSize = (*it)->ClearSpace(curSize, maxSize);
         if (curSize <= maxSize) {
-            return true;
+            break;
         }
     }
+    if (beginSize > curSize) {
+        PipelineMetrics::Add(PipelineMetrics::CLEAN_BYTES_RECLAIMED, beginSize - curSize);
+        PipelineTrace::Count(PipelineTrace::CLEAN_BYTES, static_cast<int64_t>(beginSize - curSize));
+    }
     return curSize <= maxSize;
 }
 
 void ClearData(const std::string& dir)
 {
+    PipelineTrace::ScopedTrace trace(PipelineTrace::CLEAR_DATA);
     // reset the status of observers
     AppEventObserverMgr::GetInstance().HandleClearUp();
 
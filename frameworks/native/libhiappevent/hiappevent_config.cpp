@@ -17,11 +17,14 @@
 #include <algorithm>
 #include <cinttypes>
 #include <cstdlib>
+#include <cstring>
 #include <mutex>
 #include <regex>
 #include <sstream>
 #include <string>
+#include <unordered_map>
 
+#include "app_event_sampler.h"
 #include "application_context.h"
 #include "context.h"
 #include "hiappevent_base.h"
@@ -41,6 +44,14 @@ namespace HiviewDFX {
 namespace {
 constexpr const char* DISABLE = "disable";
 constexpr const char* MAX_STORAGE = "max_storage";
+constexpr const char* SAMPLING_RULE = "sampling_rule";
+constexpr const char* MULTI_PROCESS = "multi_process";
+constexpr const char* WRITE_QUEUE_PREFIX = "write_queue_";
+constexpr const char* WRITE_QUEUE_CAPACITY = "write_queue_capacity";
+constexpr const char* WRITE_QUEUE_MAX_SIZE = "write_queue_max_size";
+constexpr const char* WRITE_QUEUE_POLICY = "write_queue_policy";
+constexpr const char* WRITE_QUEUE_BLOCK_TIMEOUT = "write_queue_block_timeout";
+constexpr const char* WRITE_QUEUE_SAMPLE_RATE = "write_queue_sample_rate";
 constexpr const char* APP_EVENT_DIR = "/hiappevent/";
 constexpr uint64_t STORAGE_UNIT_KB = 1024;
 constexpr uint64_t STORAGE_UNIT_MB = STORAGE_UNIT_KB * 1024;
@@ -74,6 +85,80 @@ std::string TransUpperToUnderscoreAndLower(const std::string& str)
     return ss.str();
 }
 
+bool ParseStorageSize(const std::string& value, uint64_t& size)
+{
+    if (!std::regex_match(value, std::regex("[0-9]+[k|m|g|t]?[b]?"))) {
+        return false;
+    }
+
+    char* numEndIndex = nullptr;
+    uint64_t numValue = std::strtoull(value.c_str(), &numEndIndex, DECIMAL_UNIT);
+    if (errno == ERANGE) {
+        HILOG_ERROR(LOG_CORE, "value: %{public}s overflow.", value.c_str());
+        return false;
+    }
+    if (*numEndIndex == '\0') {
+        size = numValue;
+        return true;
+    }
+
+    uint32_t unitLen = std::strlen(numEndIndex);
+    auto len = value.length();
+    char unitChr = value[len - unitLen];
+    unsigned long long tempResult = 0;
+    uint64_t unitValue = 1;
+    switch (unitChr) {
+        case 'b':
+            break;
+        case 'k':
+            unitValue = STORAGE_UNIT_KB;
+            break;
+        case 'm':
+            unitValue = STORAGE_UNIT_MB;
+            break;
+        case 'g':
+            unitValue = STORAGE_UNIT_GB;
+            break;
+        case 't':
+            unitValue = STORAGE_UNIT_TB;
+            break;
+        default:
+            HILOG_ERROR(LOG_CORE, "invalid storage unit value=%{public}c.", unitChr);
+            return false;
+    }
+    if (__builtin_umulll_overflow(numValue, unitValue, &tempResult)) {
+        HILOG_ERROR(LOG_CORE, "storage size overflow. value=%{public}s", value.c_str());
+        return false;
+    }
+    size = static_cast<uint64_t>(tempResult);
+    return true;
+}
+
+bool ParsePositiveNum(const std::string& value, uint32_t& num)
+{
+    if (!std::regex_match(value, std::regex("[0-9]{1,9}"))) {
+        return false;
+    }
+    num = static_cast<uint32_t>(std::strtoul(value.c_str(), nullptr, DECIMAL_UNIT));
+    return num > 0;
+}
+
+bool ParseOverflowPolicy(const std::string& value, WriteOverflowPolicy& policy)
+{
+    static const std::unordered_map<std::string, WriteOverflowPolicy> policies = {
+        {"drop_newest", WriteOverflowPolicy::DROP_NEWEST},
+        {"drop_oldest", WriteOverflowPolicy::DROP_OLDEST},
+        {"block", WriteOverflowPolicy::BLOCK},
+        {"sample", WriteOverflowPolicy::SAMPLE},
+    };
+    auto it = policies.find(value);
+    if (it == policies.end()) {
+        return false;
+    }
+    policy = it->second;
+    return true;
+}
+
 sptr<OHOS::StorageManager::IStorageManager> GetStorageMgr()
 {
     auto systemAbilityManager = SystemAbilityManagerClient::GetInstance().GetSystemAbilityManager();
@@ -112,12 +197,20 @@ bool HiAppEventConfig::SetConfigurationItem(std::string name, std::string value)
         HILOG_ERROR(LOG_CORE, "item value can not be empty.");
         return false;
     }
+    // the domain and name of a sampling rule are case sensitive
+    if (name == SAMPLING_RULE) {
+        return AppEventSampler::GetInstance().SetRule(value);
+    }
     std::transform(value.begin(), value.end(), value.begin(), ::tolower);
 
     if (name == DISABLE) {
         return SetDisableItem(value);
     } else if (name == MAX_STORAGE) {
         return SetMaxStorageSizeItem(value);
+    } else if (name.compare(0, std::strlen(WRITE_QUEUE_PREFIX), WRITE_QUEUE_PREFIX) == 0) {
+        return SetWriteQueueItem(name, value);
+    } else if (name == MULTI_PROCESS) {
+        return SetMultiProcessItem(value);
     } else {
         HILOG_ERROR(LOG_CORE, "unrecognized configuration item name.");
         return false;
@@ -139,54 +232,58 @@ bool HiAppEventConfig::SetDisableItem(const std::string& value)
 
 bool HiAppEventConfig::SetMaxStorageSizeItem(const std::string& value)
 {
-    if (!std::regex_match(value, std::regex("[0-9]+[k|m|g|t]?[b]?"))) {
+    uint64_t maxStoSize = 0;
+    if (!ParseStorageSize(value, maxStoSize)) {
         HILOG_ERROR(LOG_CORE, "invalid value=%{public}s of the event file dir storage quota size.", value.c_str());
         return false;
     }
+    SetMaxStorageSize(maxStoSize);
+    return true;
+}
 
-    char* numEndIndex = nullptr;
-    uint64_t numValue = std::strtoull(value.c_str(), &numEndIndex, DECIMAL_UNIT);
-    if (errno == ERANGE) {
-        HILOG_ERROR(LOG_CORE, "value: %{public}s overflow.", value.c_str());
+bool HiAppEventConfig::SetWriteQueueItem(const std::string& name, const std::string& value)
+{
+    std::lock_guard<std::mutex> lockGuard(g_mutex);
+    WriteQueueConfig config = writeQueueConfig_;
+    bool isValid = false;
+    if (name == WRITE_QUEUE_CAPACITY) {
+        isValid = ParsePositiveNum(value, config.capacity);
+    } else if (name == WRITE_QUEUE_MAX_SIZE) {
+        isValid = ParseStorageSize(value, config.maxSize) && config.maxSize > 0;
+    } else if (name == WRITE_QUEUE_POLICY) {
+        isValid = ParseOverflowPolicy(value, config.policy);
+    } else if (name == WRITE_QUEUE_BLOCK_TIMEOUT) {
+        isValid = ParsePositiveNum(value, config.blockTimeout);
+    } else if (name == WRITE_QUEUE_SAMPLE_RATE) {
+        isValid = ParsePositiveNum(value, config.sampleRate);
+    } else {
+        HILOG_ERROR(LOG_CORE, "unrecognized configuration item name.");
         return false;
     }
-    if (*numEndIndex == '\0') {
-        SetMaxStorageSize(numValue);
-        return true;
+    if (!isValid) {
+        HILOG_ERROR(LOG_CORE, "invalid value=%{public}s of the item=%{public}s.", value.c_str(), name.c_str());
+        return false;
     }
+    writeQueueConfig_ = config;
+    queueCapacity_ = config.capacity;
+    queueMaxSize_ = config.maxSize;
+    queuePolicy_ = config.policy;
+    queueBlockTimeout_ = config.blockTimeout;
+    queueSampleRate_ = config.sampleRate;
+    return true;
+}
 
-    uint32_t unitLen = std::strlen(numEndIndex);
-    auto len = value.length();
-    char unitChr = value[len - unitLen];
-    uint64_t maxStoSize = 0;
-    unsigned long long tempResult = 0;
-    uint64_t unitValue = 1;
-    switch (unitChr) {
-        case 'b':
-            maxStoSize = numValue;
-            break;
-        case 'k':
-            unitValue = STORAGE_UNIT_KB;
-            break;
-        case 'm':
-            unitValue = STORAGE_UNIT_MB;
-            break;
-        case 'g':
-            unitValue = STORAGE_UNIT_GB;
-            break;
-        case 't':
-            unitValue = STORAGE_UNIT_TB;
-            break;
-        default:
-            HILOG_ERROR(LOG_CORE, "invalid storage unit value=%{public}c.", unitChr);
-            return false;
-    }
-    if (__builtin_umulll_overflow(numValue, unitValue, &tempResult)) {
-        HILOG_ERROR(LOG_CORE, "maxStoSize overflow. value=%{public}s", value.c_str());
+bool HiAppEventConfig::SetMultiProcessItem(const std::string& value)
+{
+    std::lock_guard<std::mutex> lockGuard(g_mutex);
+    if (value == "true") {
+        isMultiProcess_ = true;
+    } else if (value == "false") {
+        isMultiProcess_ = false;
+    } else {
+        HILOG_ERROR(LOG_CORE, "invalid bool value=%{public}s of the multi-process mode.", value.c_str());
         return false;
     }
-    maxStoSize = static_cast<uint64_t>(tempResult);
-    SetMaxStorageSize(maxStoSize);
     return true;
 }
 
@@ -219,6 +316,23 @@ uint64_t HiAppEventConfig::GetMaxStorageSize()
     return maxStorageSize_;
 }
 
+WriteQueueConfig HiAppEventConfig::GetWriteQueueConfig()
+{
+    WriteQueueConfig config;
+    config.capacity = queueCapacity_;
+    config.maxSize = queueMaxSize_;
+    config.policy = queuePolicy_;
+    config.blockTimeout = queueBlockTimeout_;
+    config.sampleRate = queueSampleRate_;
+    return config;
+}
+
+bool HiAppEventConfig::IsMultiProcess()
+{
+    std::lock_guard<std::mutex> lockGuard(g_mutex);
+    return isMultiProcess_;
+}
+
 std::string HiAppEventConfig::GetStorageDir()
 {
     std::lock_guard<std::mutex> lockGuard(g_mutex);
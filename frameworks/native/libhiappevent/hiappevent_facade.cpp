@@ -15,7 +15,10 @@
 
 #include "hiappevent_facade.h"
 
+#include "app_event_aggregator.h"
 #include "app_event_observer_mgr.h"
+#include "app_event_sampler.h"
+#include "app_event_shared_ring.h"
 #include "app_event_stat.h"
 #include "app_event_store.h"
 #include "event_policy_mgr.h"
@@ -25,6 +28,7 @@
 #include "hiappevent_userinfo.h"
 #include "hiappevent_verify.h"
 #include "hiappevent_write.h"
+#include "pipeline_metrics.h"
 #include "time_util.h"
 
 namespace OHOS {
@@ -66,6 +70,12 @@ void AppEventConfigFacade::RefreshFreeSize()
     return HiAppEventConfig::GetInstance().RefreshFreeSize();
 }
 
+void AppEventConfigFacade::GetPipelineMetrics(PipelineMetrics::Snapshot& snapshot)
+{
+    PipelineMetrics::GetSnapshot(snapshot);
+    AppEventObserverMgr::GetInstance().GetObserverBacklogs(snapshot.observers);
+}
+
 // AppEventWriteFacade
 int AppEventWriteFacade::FacadeSetEventParam(std::shared_ptr<AppEventPack> pack)
 {
@@ -74,9 +84,24 @@ int AppEventWriteFacade::FacadeSetEventParam(std::shared_ptr<AppEventPack> pack)
 
 void AppEventWriteFacade::FacadeWriteEvent(std::shared_ptr<AppEventPack> pack)
 {
+    if (pack != nullptr && !AppEventSampler::GetInstance().Sample(*pack)) {
+        return;
+    }
+    if (AppEventAggregator::GetInstance().Aggregate(pack)) {
+        return;
+    }
+    if (pack != nullptr && AppEventSharedRing::GetInstance().Publish(*pack)) {
+        PipelineMetrics::Add(PipelineMetrics::WRITE_PUBLISHED);
+        return;
+    }
     WriteEvent(pack);
 }
 
+void AppEventWriteFacade::FacadeSubmitWritingTask(std::shared_ptr<AppEventPack> pack, const std::string& taskName)
+{
+    SubmitWritingTask(pack, taskName);
+}
+
 int AppEventWriteFacade::SetEventPolicy(const std::string& name,
     const std::map<std::string, std::string>& configMap)
 {
@@ -293,6 +318,11 @@ bool AppEventVerifyFacade::VerifyIsValidBatchReport(int count)
     return IsValidBatchReport(count);
 }
 
+bool AppEventVerifyFacade::VerifyIsValidCondition(const std::string& condition)
+{
+    return IsValidCondition(condition);
+}
+
 bool AppEventVerifyFacade::VerifyIsValidConfigId(int configId)
 {
     return IsValidConfigId(configId);
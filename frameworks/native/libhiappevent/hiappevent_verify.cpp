@@ -15,15 +15,17 @@
 
 #include "hiappevent_verify.h"
 
-#include <cctype>
 #include <iterator>
 #include <unistd.h>
 #include <unordered_set>
 
+#include "app_event_predicate.h"
 #include "application_context.h"
 #include "hiappevent_base.h"
 #include "hiappevent_config.h"
 #include "hilog/log.h"
+#include "pipeline_metrics.h"
+#include "string_util.h"
 
 #undef LOG_DOMAIN
 #define LOG_DOMAIN 0xD002D07
@@ -62,16 +64,16 @@ bool IsValidName(const std::string& name, size_t maxSize, bool allowDollarSign =
         return false;
     }
     // start char is [$a-zA-Z] or [a-zA-Z]
-    if (!isalpha(name[0]) && (!allowDollarSign || name[0] != '$')) {
+    if (!StringUtil::IsAsciiAlpha(name[0]) && (!allowDollarSign || name[0] != '$')) {
         return false;
     }
     // end char is [a-zA-Z0-9]
-    if (name.length() > 1 && (!isalnum(name.back()))) {
+    if (name.length() > 1 && (!StringUtil::IsAsciiAlnum(name.back()))) {
         return false;
     }
     // middle char is [a-zA-Z0-9_]
     for (size_t i = 1; i < name.length() - 1; ++i) {
-        if (!isalnum(name[i]) && name[i] != '_') {
+        if (!StringUtil::IsAsciiAlnum(name[i]) && name[i] != '_') {
             return false;
         }
     }
@@ -83,40 +85,6 @@ bool CheckParamName(const std::string& paramName)
     return IsValidName(paramName, MAX_LENGTH_OF_PARAM_NAME);
 }
 
-void EscapeStringValue(std::string &value)
-{
-    std::string escapeValue;
-    for (auto it = value.begin(); it != value.end(); it++) {
-        switch (*it) {
-            case '\\':
-                escapeValue.append("\\\\");
-                break;
-            case '\"':
-                escapeValue.append("\\\"");
-                break;
-            case '\b':
-                escapeValue.append("\\b");
-                break;
-            case '\f':
-                escapeValue.append("\\f");
-                break;
-            case '\n':
-                escapeValue.append("\\n");
-                break;
-            case '\r':
-                escapeValue.append("\\r");
-                break;
-            case '\t':
-                escapeValue.append("\\t");
-                break;
-            default:
-                escapeValue.push_back(*it);
-                break;
-        }
-    }
-    value = escapeValue;
-}
-
 bool CheckStrParamLength(std::string& strParamValue, size_t maxLen = MAX_LENGTH_OF_STR_PARAM)
 {
     if (strParamValue.empty()) {
@@ -127,7 +95,7 @@ bool CheckStrParamLength(std::string& strParamValue, size_t maxLen = MAX_LENGTH_
         return false;
     }
 
-    EscapeStringValue(strParamValue);
+    StringUtil::EscapeJsonString(strParamValue);
     return true;
 }
 
@@ -426,6 +394,7 @@ bool IsValidEventType(int eventType)
 
 int VerifyAppEvent(std::shared_ptr<AppEventPack> event)
 {
+    PipelineMetrics::StageTimer timer(PipelineMetrics::VERIFY);
     if (HiAppEventConfig::GetInstance().GetDisable()) {
         HILOG_ERROR(LOG_CORE, "the HiAppEvent function is disabled.");
         return ERROR_HIAPPEVENT_DISABLE;
@@ -494,12 +463,12 @@ bool IsValidPropName(const std::string& name, size_t maxSize)
         return false;
     }
     // start char is [a-zA-Z_$]
-    if (!isalpha(name[0]) && name[0] != '_' && name[0] != '$') {
+    if (!StringUtil::IsAsciiAlpha(name[0]) && name[0] != '_' && name[0] != '$') {
         return false;
     }
     // other char is [a-zA-Z0-9_$]
     for (size_t i = 1; i < name.length(); ++i) {
-        if (!isalnum(name[i]) && name[i] != '_' && name[i] != '$') {
+        if (!StringUtil::IsAsciiAlnum(name[i]) && name[i] != '_' && name[i] != '$') {
             return false;
         }
     }
@@ -567,7 +536,12 @@ bool IsValidEventConfig(const EventConfig& eventCfg)
     if (!eventCfg.name.empty() && !IsValidEventName(eventCfg.name)) {
         return false;
     }
-    return true;
+    return IsValidCondition(eventCfg.condition);
+}
+
+bool IsValidCondition(const std::string& condition)
+{
+    return condition.empty() || HiAppEvent::AppEventPredicate::Compile(condition) != nullptr;
 }
 
 bool IsValidConfigId(int configId)
@@ -18,13 +18,19 @@
 #include <mutex>
 #include <string>
 
+#include "app_event_aggregator.h"
 #include "app_event_store.h"
+#include "app_event_write_queue.h"
 #include "app_event_observer_mgr.h"
+#include "app_event_sampler.h"
+#include "app_event_shared_ring.h"
 #include "file_util.h"
 #include "hiappevent_base.h"
 #include "hiappevent_clean.h"
 #include "hiappevent_config.h"
 #include "hilog/log.h"
+#include "pipeline_metrics.h"
+#include "pipeline_trace.h"
 #include "time_util.h"
 
 #undef LOG_DOMAIN
@@ -60,19 +66,36 @@ bool WriteEventToFile(const std::string& filePath, const std::string& event)
 
 void SubmitWritingTask(std::shared_ptr<AppEventPack> appEventPack, const std::string& taskName)
 {
-    AppEventObserverMgr::GetInstance().SubmitTaskToFFRTQueue([appEventPack]() {
-        WriteEvent(appEventPack);
-        }, taskName);
+    PipelineMetrics::Add(PipelineMetrics::WRITE_SUBMITTED);
+    if (appEventPack != nullptr && !AppEventSampler::GetInstance().Sample(*appEventPack)) {
+        return;
+    }
+    if (AppEventAggregator::GetInstance().Aggregate(appEventPack)) {
+        return;
+    }
+    QueueWritingTask(appEventPack, taskName);
+}
+
+void QueueWritingTask(std::shared_ptr<AppEventPack> appEventPack, const std::string& taskName)
+{
+    // in the multi-process mode, the events of a secondary process are stored by the owner process
+    if (appEventPack != nullptr && AppEventSharedRing::GetInstance().Publish(*appEventPack)) {
+        PipelineMetrics::Add(PipelineMetrics::WRITE_PUBLISHED);
+        return;
+    }
+    AppEventWriteQueue::GetInstance().Push(appEventPack, taskName);
 }
 
 void WriteEvent(std::shared_ptr<AppEventPack> appEventPack)
 {
     if (HiAppEventConfig::GetInstance().GetDisable()) {
         HILOG_WARN(LOG_CORE, "the HiAppEvent function is disabled.");
+        PipelineMetrics::Add(PipelineMetrics::WRITE_DROPPED_DISABLED);
         return;
     }
     if (HiAppEventConfig::GetInstance().IsFreeSizeOverLimit()) {
         HILOG_WARN(LOG_CORE, "Write:free size over limit.");
+        PipelineMetrics::Add(PipelineMetrics::WRITE_DROPPED_FREE_SIZE);
         return;
     }
     if (appEventPack == nullptr) {
@@ -88,6 +111,8 @@ void WriteEvent(std::shared_ptr<AppEventPack> appEventPack)
     HILOG_DEBUG(LOG_CORE, "WriteEvent domain=%{public}s, name=%{public}s.",
         appEventPack->GetDomain().c_str(), appEventPack->GetName().c_str());
     {
+        PipelineTrace::ScopedTrace trace(PipelineTrace::WRITE_EVENT, PipelineTrace::WRITE_BYTES,
+            static_cast<int64_t>(event.size()));
         std::lock_guard<std::mutex> lockGuard(g_mutex);
         if (!FileUtil::IsFileExists(dirPath) && !FileUtil::ForceCreateDirectory(dirPath)) {
             HILOG_ERROR(LOG_CORE, "failed to create hiappevent dir, errno=%{public}d.", errno);
@@ -95,10 +120,13 @@ void WriteEvent(std::shared_ptr<AppEventPack> appEventPack)
         }
         HiAppEventClean::CheckStorageSpace();
         std::string filePath = FileUtil::GetFilePathByDir(dirPath, GetStorageFileName());
+        PipelineMetrics::StageTimer timer(PipelineMetrics::FILE_APPEND);
         if (!WriteEventToFile(filePath, event)) {
             HILOG_ERROR(LOG_CORE, "failed to write event to log file, errno=%{public}d.", errno);
             return;
         }
+        PipelineMetrics::Add(PipelineMetrics::EVENTS_WRITTEN);
+        PipelineMetrics::Add(PipelineMetrics::BYTES_WRITTEN, event.size());
     }
     std::vector<std::shared_ptr<AppEventPack>> events;
     events.emplace_back(appEventPack);
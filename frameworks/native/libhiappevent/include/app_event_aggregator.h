@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef HIAPPEVENT_FRAMEWORKS_NATIVE_LIB_HIAPPEVENT_INCLUDE_APP_EVENT_AGGREGATOR_H
+#define HIAPPEVENT_FRAMEWORKS_NATIVE_LIB_HIAPPEVENT_INCLUDE_APP_EVENT_AGGREGATOR_H
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "nocopyable.h"
+
+namespace OHOS {
+namespace HiviewDFX {
+class AppEventPack;
+struct AggregationRule;
+
+/*
+ * Rolls up the identical events which match an aggregation rule before they are queued for writing. The first
+ * event of a key is held for the window of the rule, the later ones only update its counter, and then the first
+ * event is written with the params count, first_time and last_time.
+ *
+ * The held events are kept in the crash ring, flushed when the app goes to the background, and completed in the
+ * crash ring with their counters when the process exits, so they are not lost before the window ends.
+ */
+class AppEventAggregator : public NoCopyable {
+public:
+    static AppEventAggregator& GetInstance();
+    bool Aggregate(std::shared_ptr<AppEventPack> event);
+    void Flush(bool isForced = false);
+    void FlushToRing();
+
+private:
+    struct Entry {
+        std::shared_ptr<AppEventPack> event;
+        int64_t count = 0;
+        uint64_t firstTime = 0;
+        uint64_t lastTime = 0;
+        int64_t deadline = 0; // ms since boot
+        uint32_t ringToken = 0; // token of the copy in the crash ring
+    };
+
+    AppEventAggregator() = default;
+    ~AppEventAggregator() = default;
+    std::string GetKey(const AppEventPack& event, const AggregationRule& rule);
+    void AddAggregatedParams(AppEventPack& event, const Entry& entry);
+    void ScheduleFlush(int64_t deadline, int64_t now);
+
+private:
+    std::mutex mutex_;
+    std::unordered_map<std::string, Entry> entries_;
+    int64_t flushTime_ = 0; // deadline of the next flush task, 0 if there is none
+};
+} // namespace HiviewDFX
+} // namespace OHOS
+#endif // HIAPPEVENT_FRAMEWORKS_NATIVE_LIB_HIAPPEVENT_INCLUDE_APP_EVENT_AGGREGATOR_H
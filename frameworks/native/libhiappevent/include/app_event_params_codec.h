@@ -0,0 +1,46 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef HIAPPEVENT_FRAMEWORKS_NATIVE_LIB_HIAPPEVENT_INCLUDE_APP_EVENT_PARAMS_CODEC_H
+#define HIAPPEVENT_FRAMEWORKS_NATIVE_LIB_HIAPPEVENT_INCLUDE_APP_EVENT_PARAMS_CODEC_H
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <vector>
+
+#include "hiappevent_base.h"
+
+namespace OHOS {
+namespace HiviewDFX {
+namespace AppEventParamsCodec {
+// the stored params codec keeps the compression codec in the low byte and the format flag above it
+constexpr int FORMAT_BINARY = 0x100;
+constexpr int COMPRESS_CODEC_MASK = 0xff;
+
+/*
+ * Encodes the typed params into the binary form: a version byte and the num of params, then for each param its
+ * name, its AppEventParamType and its value. The integers are zigzag varints, the floats are kept in 4 or 8 bytes,
+ * and the arrays are packed after their sizes.
+ */
+void Encode(const std::list<AppEventParam>& params, std::vector<uint8_t>& out);
+
+/*
+ * Decodes the params encoded by Encode, returns false if the data is malformed or of an unknown version.
+ */
+bool Decode(const uint8_t* data, size_t len, std::list<AppEventParam>& params);
+} // namespace AppEventParamsCodec
+} // namespace HiviewDFX
+} // namespace OHOS
+#endif // HIAPPEVENT_FRAMEWORKS_NATIVE_LIB_HIAPPEVENT_INCLUDE_APP_EVENT_PARAMS_CODEC_H
@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef HIAPPEVENT_FRAMEWORKS_NATIVE_LIB_HIAPPEVENT_INCLUDE_APP_EVENT_PARAMS_DECODER_H
+#define HIAPPEVENT_FRAMEWORKS_NATIVE_LIB_HIAPPEVENT_INCLUDE_APP_EVENT_PARAMS_DECODER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace OHOS {
+namespace HiviewDFX {
+class AppEventPack;
+
+/*
+ * Receives the params of an event in a single pass. Each param is given as OnKey followed by its value, and the
+ * members of the nested objects are given the same way between OnObjectBegin and OnObjectEnd.
+ */
+class AppEventParamsHandler {
+public:
+    virtual ~AppEventParamsHandler() = default;
+
+    virtual void OnKey(const std::string& key) = 0;
+    virtual void OnNull() = 0;
+    virtual void OnBool(bool value) = 0;
+    virtual void OnInt(int64_t value) = 0;
+    virtual void OnDouble(double value) = 0;
+    virtual void OnString(const std::string& value) = 0;
+
+    // the non-empty arrays of one value type are given at once, and the ints are promoted to doubles when mixed
+    virtual void OnBoolArray(const std::vector<bool>& values) = 0;
+    virtual void OnIntArray(const std::vector<int64_t>& values) = 0;
+    virtual void OnDoubleArray(const std::vector<double>& values) = 0;
+    virtual void OnStringArray(const std::vector<std::string>& values) = 0;
+
+    // returns false to take the whole object as json text by OnRawValue, and OnObjectEnd is not called then
+    virtual bool OnObjectBegin() = 0;
+    virtual void OnObjectEnd() = 0;
+
+    // for the other arrays, returns false to take each element as json text by OnRawValue, and OnArrayEnd still ends
+    // the array then
+    virtual bool OnArrayBegin() = 0;
+    virtual void OnArrayEnd() = 0;
+
+    virtual void OnRawValue(const char* data, size_t len) = 0;
+};
+
+namespace AppEventParamsDecoder {
+/*
+ * Decodes the params from the typed values if the event still has them or has them stored in the binary form,
+ * otherwise from the json text.
+ * Returns false if the params are malformed, and the handler may have received part of them then.
+ */
+bool Decode(const AppEventPack& event, AppEventParamsHandler& handler);
+
+/*
+ * Decodes the params from the json text of an object, such as the one returned by AppEventPack::GetParamStr.
+ */
+bool Decode(const std::string& paramStr, AppEventParamsHandler& handler);
+} // namespace AppEventParamsDecoder
+} // namespace HiviewDFX
+} // namespace OHOS
+#endif // HIAPPEVENT_FRAMEWORKS_NATIVE_LIB_HIAPPEVENT_INCLUDE_APP_EVENT_PARAMS_DECODER_H
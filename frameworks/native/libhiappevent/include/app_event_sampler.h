@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef HIAPPEVENT_FRAMEWORKS_NATIVE_LIB_HIAPPEVENT_INCLUDE_APP_EVENT_SAMPLER_H
+#define HIAPPEVENT_FRAMEWORKS_NATIVE_LIB_HIAPPEVENT_INCLUDE_APP_EVENT_SAMPLER_H
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "nocopyable.h"
+#include "snapshot_holder.h"
+
+namespace OHOS {
+namespace HiviewDFX {
+class AppEventPack;
+
+enum class SamplingType {
+    NONE = 0,
+    ONE_IN_N,
+    RATIO,
+    TOKEN_BUCKET,
+};
+
+struct SamplingRule {
+    SamplingType type = SamplingType::NONE;
+    uint32_t interval = 1; // keep one of every interval events for ONE_IN_N
+    double ratio = 1.0; // probability to keep an event for RATIO
+    double rate = 0.0; // events per second for TOKEN_BUCKET
+    uint32_t burst = 1; // max events kept at once for TOKEN_BUCKET
+};
+
+/*
+ * Samples the events by the rules keyed by domain and name before they are queued for writing. The rules are
+ * published as an immutable table through a snapshot holder, so the check on the caller's thread takes no lock.
+ * A kept event that matched a rule carries the param sample_rate, the ratio of the events kept by the rule.
+ */
+class AppEventSampler : public NoCopyable {
+public:
+    static AppEventSampler& GetInstance();
+    bool SetRule(const std::string& ruleStr);
+    bool SetRule(const std::string& domain, const std::string& name, const SamplingRule& rule);
+    void ClearRules();
+    bool Sample(AppEventPack& event);
+
+private:
+    struct RuleState {
+        SamplingRule rule;
+        int64_t emissionInterval = 0; // ns
+        int64_t burstTolerance = 0; // ns
+        std::atomic<uint64_t> seenNum = 0;
+        std::atomic<uint64_t> keptNum = 0;
+        std::atomic<int64_t> arrivalTime = 0; // theoretical arrival time of the token bucket, ns
+    };
+    // rules of a domain, the name "*" matches all the events of the domain
+    using DomainRules = std::unordered_map<std::string, std::shared_ptr<RuleState>>;
+    using RuleTable = std::unordered_map<std::string, DomainRules>;
+
+    AppEventSampler() = default;
+    ~AppEventSampler() = default;
+    bool IsKept(RuleState& state, double& sampleRate);
+
+private:
+    SnapshotHolder<RuleTable> tables_;
+    std::mutex mutex_; // serializes the updates of the rules
+};
+} // namespace HiviewDFX
+} // namespace OHOS
+#endif // HIAPPEVENT_FRAMEWORKS_NATIVE_LIB_HIAPPEVENT_INCLUDE_APP_EVENT_SAMPLER_H
@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef HIAPPEVENT_FRAMEWORKS_NATIVE_LIB_HIAPPEVENT_INCLUDE_APP_EVENT_SHARED_RING_H
+#define HIAPPEVENT_FRAMEWORKS_NATIVE_LIB_HIAPPEVENT_INCLUDE_APP_EVENT_SHARED_RING_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "nocopyable.h"
+
+namespace OHOS {
+namespace HiviewDFX {
+class AppEventPack;
+
+/*
+ * Ring file shared by the processes of an application in the multi-process mode. The main process holds the owner
+ * lock, drains the ring and is the only one to store the events, run the cleaner and dispatch the events to the
+ * observers, while the secondary processes only publish their events into the ring. So the observers registered by
+ * the main process receive the events of all the processes. The events of the secondary processes wait in the ring
+ * while the main process is not running.
+ *
+ * Any number of processes append to the ring by an atomic reservation, and the owner consumes the records in the
+ * order of the reservation. A full ring does not overwrite the records, the event is written locally instead. A
+ * record left unfinished is skipped only after its writer has died, which is known by the pid in the record or,
+ * before the record has a header, by the writer lock that every appending process holds while it runs.
+ *
+ * The owner drains the ring on a thread sleeping on the doorbell in the ring file, which every append rings, so the
+ * owner only runs while the ring holds events.
+ */
+class AppEventSharedRing : public NoCopyable {
+public:
+    static AppEventSharedRing& GetInstance();
+    bool Publish(const AppEventPack& event);
+    // takes the ownership of the ring if this is the main process in the multi-process mode
+    void Elect();
+
+    // for test
+    bool Open(const std::string& dir, uint32_t capacity);
+    void Close();
+    bool IsOwner();
+    bool Append(const AppEventPack& event);
+    size_t Consume(std::vector<std::shared_ptr<AppEventPack>>& events, size_t maxNum);
+
+private:
+    AppEventSharedRing() = default;
+    ~AppEventSharedRing();
+    void Init();
+    bool InitRingFile(int fd, uint32_t capacity);
+    void CloseLockFiles();
+    bool AttachWriter();
+    bool HasLiveWriter() const;
+    void Poll();
+    void StopPoll();
+    bool Skip(uint32_t& tail, uint32_t head);
+
+private:
+    std::mutex mutex_;
+    std::atomic<uint8_t*> base_ = nullptr;
+    uint32_t capacity_ = 0;
+    size_t mapSize_ = 0;
+    int lockFd_ = -1;
+    int writerLockFd_ = -1;
+    std::string writerLockPath_;
+    std::atomic<bool> isInit_ = false;
+    std::atomic<bool> isOwner_ = false;
+    std::atomic<bool> isWriter_ = false;
+    std::atomic<uint64_t> electTime_ = 0;
+    std::unique_ptr<std::thread> pollThread_ = nullptr;
+};
+} // namespace HiviewDFX
+} // namespace OHOS
+#endif // HIAPPEVENT_FRAMEWORKS_NATIVE_LIB_HIAPPEVENT_INCLUDE_APP_EVENT_SHARED_RING_H
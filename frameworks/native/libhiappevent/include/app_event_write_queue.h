@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef HIAPPEVENT_FRAMEWORKS_NATIVE_LIB_HIAPPEVENT_INCLUDE_APP_EVENT_WRITE_QUEUE_H
+#define HIAPPEVENT_FRAMEWORKS_NATIVE_LIB_HIAPPEVENT_INCLUDE_APP_EVENT_WRITE_QUEUE_H
+
+#include <array>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "hiappevent_config.h"
+#include "nocopyable.h"
+#include "pipeline_trace.h"
+
+namespace OHOS {
+namespace HiviewDFX {
+class AppEventPack;
+
+/*
+ * Bounded ingress in front of the writing task queue. The events waiting to be written are limited by number
+ * and by size, and the configured overflow policy decides which event is dropped once the limit is reached.
+ * Every drop is counted by domain and name and reported later by a summary event.
+ *
+ * The events are queued in lanes by priority. Fault events and the events reported in real time by a processor
+ * take the urgent lane, which is always drained first, while the other lanes are drained in batches.
+ */
+class AppEventWriteQueue : public NoCopyable {
+public:
+    // a lane of a higher value is drained first and dropped last by the drop-oldest policy
+    enum Lane : size_t {
+        BEHAVIOR_LANE = 0,
+        STATISTIC_LANE,
+        SECURITY_LANE,
+        URGENT_LANE,
+        LANE_NUM,
+    };
+
+    static AppEventWriteQueue& GetInstance();
+    bool Push(std::shared_ptr<AppEventPack> event, const std::string& taskName);
+    size_t GetSize();
+    size_t GetSize(Lane lane);
+
+private:
+    struct Item {
+        std::shared_ptr<AppEventPack> event;
+        size_t size = 0;
+        Lane lane = BEHAVIOR_LANE;
+        uint64_t enqueueTime = 0;
+        uint32_t ringToken = 0; // the record in the crash ring, completed once the event is written
+        PipelineTrace::AsyncTrace queueTrace;
+    };
+
+    AppEventWriteQueue() = default;
+    ~AppEventWriteQueue() = default;
+    bool IsFull(const WriteQueueConfig& config, size_t size) const;
+    bool Admit(std::unique_lock<std::mutex>& lock, const WriteQueueConfig& config, size_t size, Lane lane);
+    bool EvictOldest(const WriteQueueConfig& config, size_t size, Lane maxLane);
+    void PopFront(std::vector<Item>& items, size_t num);
+    int GetDrainQos() const;
+    void RecordDrop(const AppEventPack& event);
+    std::shared_ptr<AppEventPack> TakeDropSummary(bool isDrained, WriteOverflowPolicy policy);
+    void SubmitDrainTask(const std::string& taskName);
+    void Drain(const std::string& taskName);
+
+private:
+    std::mutex mutex_;
+    std::condition_variable notFullCond_;
+    std::array<std::deque<Item>, LANE_NUM> lanes_;
+    size_t num_ = 0;
+    uint64_t size_ = 0;
+    bool isDraining_ = false;
+    uint64_t sampleCnt_ = 0;
+    std::map<std::pair<std::string, std::string>, uint64_t> dropNums_;
+    uint64_t dropNum_ = 0;
+    uint64_t lastSummaryTime_ = 0;
+};
+} // namespace HiviewDFX
+} // namespace OHOS
+#endif // HIAPPEVENT_FRAMEWORKS_NATIVE_LIB_HIAPPEVENT_INCLUDE_APP_EVENT_WRITE_QUEUE_H
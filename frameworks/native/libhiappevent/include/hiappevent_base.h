@@ -158,9 +158,15 @@ public:
     int64_t GetPspanId() const;
     int GetTraceFlag() const;
     std::string GetEventStr() const;
+    size_t GetEventSize() const;
     std::string GetParamStr() const;
+    std::string GetParamValue(const std::string& key) const;
+    const AppEventParam* FindBaseParam(const std::string& key) const;
+    bool HasBaseParams() const;
     std::string GetRunningId() const;
+    size_t GetEstimatedSize() const;
     std::list<AppEventParam> GetBaseParams() const;
+    const std::list<AppEventParam>* GetTypedParams() const;
     void GetCustomParams(std::vector<CustomEventParam>& customParams) const;
 
     void SetSeq(int64_t seq);
@@ -178,6 +184,7 @@ public:
     void SetRunningId(const std::string& runningId);
     void SetBaseParams(const std::list<AppEventParam>& baseParams);
     void SetParamStr(const std::string& paramStr);
+    void SetStoredParams(const std::vector<uint8_t>& params, int codec);
 
     friend int VerifyAppEvent(std::shared_ptr<AppEventPack> appEventPack);
     friend int VerifyCustomEventParams(std::shared_ptr<AppEventPack> event);
@@ -192,6 +199,7 @@ private:
     void AddTraceInfoToJsonString(std::stringstream& jsonStr) const;
     void AddParamsInfoToJsonString(std::stringstream& jsonStr) const;
     void AddParamsToJsonString(std::stringstream& jsonStr) const;
+    void LoadStoredParams() const;
 
 private:
     int64_t seq_ = 0;
@@ -207,8 +215,13 @@ private:
     int64_t pspanId_ = 0;
     int traceFlag_ = 0;
     std::string runningId_;
-    std::list<AppEventParam> baseParams_;
-    std::string paramStr_;
+    // the params of an event read from the db are filled in on the first read, so they are mutable
+    mutable std::list<AppEventParam> baseParams_;
+    mutable std::string paramStr_;
+
+    // the params read from the db as they are stored, which are inflated and decoded only when they are read
+    mutable std::vector<uint8_t> storedParams_;
+    int storedCodec_ = 0;
 };
 } // namespace HiviewDFX
 } // namespace OHOS
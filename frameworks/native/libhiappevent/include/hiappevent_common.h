@@ -36,6 +36,7 @@ constexpr const char* EVENT_SCROLL_ARKWEB_FLING_JANK = "SCROLL_ARKWEB_FLING_JANK
 const char DOMAIN_PROPERTY[] = "domain";
 const char NAMES_PROPERTY[] = "names";
 const char TYPES_PROPERTY[] = "types";
+const char CONDITION_PROPERTY[] = "condition";
 const char NAME_PROPERTY[] = "name";
 const char EVENT_TYPE_PROPERTY[] = "eventType";
 const char PARAM_PROPERTY[] = "params";
@@ -15,12 +15,29 @@
 #ifndef HI_APP_EVENT_CONFIG_H
 #define HI_APP_EVENT_CONFIG_H
 
+#include <atomic>
+#include <cstdint>
 #include <string>
 
 #include "nocopyable.h"
 
 namespace OHOS {
 namespace HiviewDFX {
+enum class WriteOverflowPolicy {
+    DROP_NEWEST = 0,
+    DROP_OLDEST,
+    BLOCK,
+    SAMPLE,
+};
+
+struct WriteQueueConfig {
+    uint32_t capacity = 10000; // max number of the events waiting to be written
+    uint64_t maxSize = 8 * 1024 * 1024; // max size of the events waiting to be written, 8M
+    WriteOverflowPolicy policy = WriteOverflowPolicy::DROP_OLDEST;
+    uint32_t blockTimeout = 100; // ms
+    uint32_t sampleRate = 10; // keep one of every 10 events once the queue is half full
+};
+
 class HiAppEventConfig : public NoCopyable {
 public:
     static HiAppEventConfig& GetInstance();
@@ -28,6 +45,8 @@ public:
     bool SetConfigurationItem(std::string name, std::string value);
     bool GetDisable();
     uint64_t GetMaxStorageSize();
+    WriteQueueConfig GetWriteQueueConfig();
+    bool IsMultiProcess();
     std::string GetStorageDir();
     std::string GetRunningId();
     bool IsFreeSizeOverLimit();
@@ -40,14 +59,24 @@ private:
     HiAppEventConfig& operator=(const HiAppEventConfig&);
     bool SetDisableItem(const std::string& value);
     bool SetMaxStorageSizeItem(const std::string& value);
+    bool SetWriteQueueItem(const std::string& name, const std::string& value);
+    bool SetMultiProcessItem(const std::string& value);
     void SetDisable(bool disable);
     void SetMaxStorageSize(uint64_t size);
 
 private:
     bool disable_ = false;
+    bool isMultiProcess_ = false; // the events of the secondary processes are stored by the owner process
     int64_t freeSize_ = -1;
     bool isInitFreeSize_ = false;
     uint64_t maxStorageSize_ = 10 * 1024 * 1024; // max storage size is 10M, 10 * 1024 * 1024 Byte
+    WriteQueueConfig writeQueueConfig_;
+    // copies of writeQueueConfig_ read by every write without g_mutex, which is held across the ipc of the free size
+    std::atomic<uint32_t> queueCapacity_ = WriteQueueConfig().capacity;
+    std::atomic<uint64_t> queueMaxSize_ = WriteQueueConfig().maxSize;
+    std::atomic<WriteOverflowPolicy> queuePolicy_ = WriteQueueConfig().policy;
+    std::atomic<uint32_t> queueBlockTimeout_ = WriteQueueConfig().blockTimeout;
+    std::atomic<uint32_t> queueSampleRate_ = WriteQueueConfig().sampleRate;
     std::string storageDir_ = "";
     std::string runningId_ = "";
 };
@@ -27,6 +27,7 @@
 #include "hiappevent_base.h"
 #include "app_event_processor.h"
 #include "app_event_watcher.h"
+#include "pipeline_metrics.h"
 
 namespace OHOS {
 namespace HiviewDFX {
@@ -40,12 +41,14 @@ public:
     static bool SetConfigurationItem(const std::string& name, const std::string& value);
     static std::string GetRunningId();
     static void RefreshFreeSize();
+    static void GetPipelineMetrics(PipelineMetrics::Snapshot& snapshot);
 };
 
 class AppEventWriteFacade {
 public:
     static int FacadeSetEventParam(std::shared_ptr<AppEventPack> pack);
     static void FacadeWriteEvent(std::shared_ptr<AppEventPack> pack);
+    static void FacadeSubmitWritingTask(std::shared_ptr<AppEventPack> pack, const std::string& taskName);
     static int SetEventPolicy(const std::string& name, const std::map<std::string, std::string>& configMap);
     static int SetEventPolicy(const std::string& name, const std::map<uint8_t, uint32_t>& configMap);
 };
@@ -103,6 +106,7 @@ public:
     static bool VerifyIsApp();
     static bool VerifyIsValidAppId(const std::string& name);
     static bool VerifyIsValidBatchReport(int count);
+    static bool VerifyIsValidCondition(const std::string& condition);
     static bool VerifyIsValidConfigId(int configId);
     static bool VerifyIsValidConfigNameLength(const std::string& configName);
     static bool VerifyIsValidCustomConfig(const std::string& name, const std::string& value);
@@ -43,6 +43,7 @@ bool IsValidUserIdName(const std::string& name);
 bool IsValidUserIdValue(const std::string& value);
 bool IsValidUserPropName(const std::string& name);
 bool IsValidUserPropValue(const std::string& value);
+bool IsValidCondition(const std::string& condition);
 bool IsValidEventConfig(const EventConfig& eventCfg);
 bool IsValidConfigId(int configId);
 bool IsValidCustomConfigsNum(size_t num);
@@ -22,6 +22,7 @@ namespace HiviewDFX {
 class AppEventPack;
 
 void SubmitWritingTask(std::shared_ptr<AppEventPack> appEventPack, const std::string& taskName);
+void QueueWritingTask(std::shared_ptr<AppEventPack> appEventPack, const std::string& taskName);
 void WriteEvent(std::shared_ptr<AppEventPack> appEventPack);
 int SetEventParam(std::shared_ptr<AppEventPack> appEventPack);
 } // namespace HiviewDFX
@@ -48,6 +48,7 @@ const char* const EVENT_CONFIGS = "eventConfigs";
 const char* const EVENT_CONFIG_DOMAIN = "domain";
 const char* const EVENT_CONFIG_NAME = "name";
 const char* const EVENT_CONFIG_REALTIME = "isRealTime";
+const char* const EVENT_CONFIG_CONDITION = "condition";
 const char* const CONFIG_ID = "configId";
 const char* const CUSTOM_CONFIG = "customConfigs";
 
@@ -194,6 +195,13 @@ int ProcessorConfigLoader::Impl::ParseConfigReportProp(const Json::Value& eventC
         }
         reportConf.isRealTime = eventConfig[EVENT_CONFIG_REALTIME].asBool();
     }
+    if (eventConfig.isMember(EVENT_CONFIG_CONDITION)) {
+        if (!eventConfig[EVENT_CONFIG_CONDITION].isString()) {
+            HILOG_WARN(LOG_CORE, "Parameter error. The event condition parameter is invalid.");
+            return ERR_CODE_PARAM_INVALID;
+        }
+        reportConf.condition = eventConfig[EVENT_CONFIG_CONDITION].asString();
+    }
     if (!IsValidEventConfig(reportConf)) {
         HILOG_WARN(LOG_CORE, "Parameter error. The event config is invalid, domain=%{public}s, name=%{public}s.",
             reportConf.domain.c_str(), reportConf.name.c_str());
@@ -72,9 +72,10 @@ AppEventFilter::AppEventFilter(const std::string& domain, const std::unordered_s
 AppEventFilter::AppEventFilter(const std::string& domain, uint32_t types) : domain(domain), types(types)
 {}
 
-bool AppEventFilter::IsValidEvent(std::shared_ptr<AppEventPack> event) const
+bool AppEventFilter::IsValidEvent(const std::shared_ptr<AppEventPack>& event) const
 {
-    return IsValidEvent(event->GetDomain(), event->GetName(), event->GetType());
+    return IsValidEvent(event->GetDomain(), event->GetName(), event->GetType())
+        && (predicate == nullptr || predicate->Evaluate(*event));
 }
 
 bool AppEventFilter::IsValidEvent(const std::string& eventDomain, const std::string& eventName, int eventType) const
@@ -105,16 +106,33 @@ uint64_t AppEventFilter::GetOsEventsMask() const
     return mask;
 }
 
-bool AppEventObserver::VerifyEvent(std::shared_ptr<AppEventPack> event)
+bool AppEventFilter::SetCondition(const std::string& condition)
 {
-    std::lock_guard<std::mutex> lockGuard(mutex_);
-    if (filters_.empty()) {
+    if (condition.empty()) {
+        predicate = nullptr;
         return true;
     }
-    auto it = std::find_if(filters_.begin(), filters_.end(), [event](const auto& filter) {
-        return filter.IsValidEvent(event);
-    });
-    return it != filters_.end();
+    predicate = AppEventPredicate::Compile(condition);
+    return predicate != nullptr;
+}
+
+std::string AppEventFilter::GetCondition() const
+{
+    return predicate == nullptr ? "" : predicate->ToString();
+}
+
+bool AppEventObserver::VerifyEvent(std::shared_ptr<AppEventPack> event)
+{
+    {
+        std::lock_guard<std::mutex> lockGuard(mutex_);
+        auto it = std::find_if(filters_.begin(), filters_.end(), [event](const auto& filter) {
+            return filter.IsValidEvent(event);
+        });
+        if (!filters_.empty() && it == filters_.end()) {
+            return false;
+        }
+    }
+    return ValidateEvent(event);
 }
 
 void AppEventObserver::ProcessEvent(std::shared_ptr<AppEventPack> event)
@@ -122,7 +140,7 @@ void AppEventObserver::ProcessEvent(std::shared_ptr<AppEventPack> event)
     HILOG_DEBUG(LOG_CORE, "observer=%{public}s start to process event", name_.c_str());
     std::lock_guard<std::mutex> lockGuard(condMutex_);
     ++currCond_.row;
-    currCond_.size += static_cast<int>(event->GetEventStr().size());
+    currCond_.size += static_cast<int>(event->GetEventSize());
     if (MeetNumberCondition(currCond_.row, triggerCond_.row)
         || MeetNumberCondition(currCond_.size, triggerCond_.size)) {
         OnTrigger(currCond_);
@@ -194,6 +212,18 @@ void AppEventObserver::SetCurrCondition(const TriggerCondition& triggerCond)
     currCond_ = triggerCond;
 }
 
+TriggerCondition AppEventObserver::GetCurrCondition()
+{
+    std::lock_guard<std::mutex> lockGuard(condMutex_);
+    return currCond_;
+}
+
+TriggerCondition AppEventObserver::GetTriggerCond()
+{
+    std::lock_guard<std::mutex> lockGuard(condMutex_);
+    return triggerCond_;
+}
+
 void AppEventObserver::SetTriggerCond(const TriggerCondition& triggerCond)
 {
     std::lock_guard<std::mutex> lockGuard(condMutex_);
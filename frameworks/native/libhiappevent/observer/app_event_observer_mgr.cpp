@@ -14,16 +14,25 @@
  */
 #include "app_event_observer_mgr.h"
 
+#include <algorithm>
+#include <climits>
+#include <iterator>
+
 #include "app_state_callback.h"
+#include "app_event_aggregator.h"
+#include "app_event_crash_ring.h"
 #include "app_event_processor_proxy.h"
+#include "app_event_shared_ring.h"
 #include "app_event_store.h"
 #include "app_event_watcher.h"
 #include "application_context.h"
 #include "ffrt_inner.h"
 #include "hiappevent_base.h"
 #include "hiappevent_config.h"
+#include "hiappevent_write.h"
 #include "hilog/log.h"
 #include "os_event_listener.h"
+#include "pipeline_trace.h"
 
 #undef LOG_DOMAIN
 #define LOG_DOMAIN 0xD002D07
@@ -40,12 +49,102 @@ namespace {
 constexpr int REFRESH_FREE_SIZE_INTERVAL = 10 * 60 * 1000; // 10 minutes
 constexpr int TIMEOUT_INTERVAL_MILLI = HiAppEvent::TIMEOUT_STEP * 1000; // 30s
 constexpr int MAX_SIZE_OF_INIT = 100;
-constexpr int TIMEOUT_LIMIT_FOR_ADDPROCESSOR = 500;
-constexpr int CHECK_DB_INTERVAL = 1;
+constexpr int64_t PENDING_SEQ_BASE = 1LL << 40; // provisional seqs never collide with the seqs of db
+
+// the indexes of the events an observer matches, split by how the events reach the observer
+struct ObserverEvents {
+    std::vector<size_t> mapped; // the events stored and mapped to the observer
+    std::vector<size_t> sent; // the events sent to the observer after they are stored
+};
+
+std::vector<ObserverEvents> MatchEvents(const std::vector<std::shared_ptr<AppEventPack>>& events,
+    const std::vector<ObserverEntry>& entries)
+{
+    std::vector<ObserverEvents> matches(entries.size());
+    for (size_t i = 0; i < entries.size(); ++i) {
+        for (size_t j = 0; j < events.size(); ++j) {
+            if (entries[i].VerifyEvent(events[j])) {
+                matches[i].mapped.emplace_back(j);
+                matches[i].sent.emplace_back(j);
+            }
+        }
+    }
+    return matches;
+}
 
-void StoreEventsToDb(std::vector<std::shared_ptr<AppEventPack>>& events)
+std::shared_ptr<AppEventPack> CreateMemoryEvent(const std::shared_ptr<AppEventPack>& event)
 {
-    for (auto& event : events) {
+    // the custom params are added to a copy, so the event stored when the delivery fails is kept without them.
+    // they are taken from the cache of the store, which is only filled from the db once per (runningId, domain, name)
+    auto memoryEvent = std::make_shared<AppEventPack>(*event);
+    AppEventStore::GetInstance().QueryCustomParamsAdd2EventPack(memoryEvent);
+    return memoryEvent;
+}
+
+// delivers the real-time events to the observers which can take them from memory, the delivered events are
+// neither stored nor mapped for these observers, and the ones failed to be delivered are only mapped
+void DeliverEventsFromMemory(const std::vector<std::shared_ptr<AppEventPack>>& events,
+    const std::vector<ObserverEntry>& entries, std::vector<ObserverEvents>& matches)
+{
+    std::vector<std::shared_ptr<AppEventPack>> memoryEvents(events.size());
+    for (size_t i = 0; i < entries.size(); ++i) {
+        const auto& observer = entries[i].observer;
+        if (!entries[i].canDeliverFromMemory) {
+            continue;
+        }
+        std::vector<size_t> realTimeIndexes;
+        std::vector<size_t> otherIndexes;
+        for (auto index : matches[i].sent) {
+            if (observer->IsRealTimeEvent(events[index])) {
+                realTimeIndexes.emplace_back(index);
+            } else {
+                otherIndexes.emplace_back(index);
+            }
+        }
+        if (realTimeIndexes.empty()) {
+            continue;
+        }
+        std::vector<std::shared_ptr<AppEventPack>> realTimeEvents;
+        for (auto index : realTimeIndexes) {
+            if (memoryEvents[index] == nullptr) {
+                memoryEvents[index] = CreateMemoryEvent(events[index]);
+            }
+            realTimeEvents.emplace_back(memoryEvents[index]);
+        }
+        matches[i].sent = std::move(otherIndexes);
+        PipelineMetrics::Add(PipelineMetrics::EVENTS_DISPATCHED, realTimeEvents.size());
+        if (!observer->OnEventsFromMemory(realTimeEvents)) {
+            HILOG_DEBUG(LOG_CORE, "failed to deliver events from memory, seq=%{public}" PRId64 ", num=%{public}zu",
+                entries[i].seq, realTimeEvents.size());
+            continue;
+        }
+        PipelineMetrics::Add(PipelineMetrics::EVENTS_DELIVERED_FROM_MEMORY, realTimeEvents.size());
+        std::vector<size_t> mappedIndexes;
+        std::set_difference(matches[i].mapped.begin(), matches[i].mapped.end(), realTimeIndexes.begin(),
+            realTimeIndexes.end(), std::back_inserter(mappedIndexes));
+        matches[i].mapped = std::move(mappedIndexes);
+    }
+}
+
+// stores only the events mapped to at least one observer. the events are only read from the db through the
+// mapping, and the ones without any mapping used to be deleted right after they were sent, so the events matched
+// by no observer, or only delivered from memory, are not stored at all and keep the seq of 0
+void StoreEventsToDb(std::vector<std::shared_ptr<AppEventPack>>& events, const std::vector<ObserverEvents>& matches)
+{
+    std::vector<bool> isNeedStored(events.size(), false);
+    for (const auto& match : matches) {
+        for (auto index : match.mapped) {
+            isNeedStored[index] = true;
+        }
+    }
+    PipelineTrace::ScopedTrace trace(PipelineTrace::STORE_EVENTS, PipelineTrace::STORE_BATCH,
+        static_cast<int64_t>(events.size()));
+    PipelineMetrics::StageTimer timer(PipelineMetrics::DB_INSERT);
+    for (size_t i = 0; i < events.size(); ++i) {
+        if (!isNeedStored[i]) {
+            continue;
+        }
+        auto& event = events[i];
         int64_t eventSeq = AppEventStore::GetInstance().InsertEvent(event);
         if (eventSeq <= 0) {
             HILOG_WARN(LOG_CORE, "failed to store event to db");
@@ -53,18 +152,33 @@ void StoreEventsToDb(std::vector<std::shared_ptr<AppEventPack>>& events)
         }
         event->SetSeq(eventSeq);
         AppEventStore::GetInstance().QueryCustomParamsAdd2EventPack(event);
+        PipelineMetrics::Add(PipelineMetrics::EVENTS_STORED);
     }
 }
 
 void StoreEventMappingToDb(const std::vector<std::shared_ptr<AppEventPack>>& events,
-    const std::vector<std::shared_ptr<AppEventObserver>>& observers)
+    const std::vector<ObserverEntry>& entries, const std::vector<ObserverEvents>& matches)
 {
+    size_t mappingNum = 0;
+    for (const auto& match : matches) {
+        mappingNum += match.mapped.size();
+    }
+    if (mappingNum == 0) {
+        return;
+    }
+    PipelineTrace::ScopedTrace trace(PipelineTrace::STORE_MAPPING, PipelineTrace::MAPPING_BATCH,
+        static_cast<int64_t>(mappingNum));
+    PipelineMetrics::StageTimer timer(PipelineMetrics::DB_MAPPING);
+    // the sizes are only computed for the mapped events, -1 for the ones not computed yet
+    std::vector<int64_t> eventSizes(events.size(), -1);
     std::vector<EventObserverInfo> eventObserverInfos;
-    for (const auto& observer : observers) {
-        for (const auto& event : events) {
-            if (observer->VerifyEvent(event)) {
-                eventObserverInfos.emplace_back(EventObserverInfo(event->GetSeq(), observer->GetSeq()));
+    for (size_t i = 0; i < entries.size(); ++i) {
+        for (auto index : matches[i].mapped) {
+            if (eventSizes[index] < 0) {
+                eventSizes[index] = static_cast<int64_t>(events[index]->GetEventSize());
             }
+            eventObserverInfos.emplace_back(EventObserverInfo(events[index]->GetSeq(), entries[i].seq,
+                eventSizes[index]));
         }
     }
     if (AppEventStore::GetInstance().InsertEventMapping(eventObserverInfos) < 0) {
@@ -72,14 +186,22 @@ void StoreEventMappingToDb(const std::vector<std::shared_ptr<AppEventPack>>& eve
     }
 }
 
-void SendEventsToObserver(const std::vector<std::shared_ptr<AppEventPack>>& events,
-    std::shared_ptr<AppEventObserver> observer)
+void StoreEventMappingToDb(const std::vector<std::shared_ptr<AppEventPack>>& events,
+    const std::vector<ObserverEntry>& entries)
 {
+    StoreEventMappingToDb(events, entries, MatchEvents(events, entries));
+}
+
+void SendEventsToObserver(const std::vector<std::shared_ptr<AppEventPack>>& events, const ObserverEntry& entry,
+    const std::vector<size_t>& indexes)
+{
+    PipelineTrace::ScopedTrace trace(PipelineTrace::SEND_EVENTS, PipelineTrace::SEND_BATCH,
+        static_cast<int64_t>(indexes.size()));
+    const auto& observer = entry.observer;
     std::vector<std::shared_ptr<AppEventPack>> realTimeEvents;
-    for (const auto& event : events) {
-        if (!observer->VerifyEvent(event)) {
-            continue;
-        }
+    for (auto index : indexes) {
+        const auto& event = events[index];
+        PipelineMetrics::Add(PipelineMetrics::EVENTS_DISPATCHED);
         if (observer->IsRealTimeEvent(event)) {
             realTimeEvents.emplace_back(event);
         } else {
@@ -91,6 +213,17 @@ void SendEventsToObserver(const std::vector<std::shared_ptr<AppEventPack>>& even
     }
 }
 
+void SendEventsToObserver(const std::vector<std::shared_ptr<AppEventPack>>& events, const ObserverEntry& entry)
+{
+    std::vector<size_t> indexes;
+    for (size_t i = 0; i < events.size(); ++i) {
+        if (entry.VerifyEvent(events[i])) {
+            indexes.emplace_back(i);
+        }
+    }
+    SendEventsToObserver(events, entry, indexes);
+}
+
 int64_t StoreObserverToDb(std::shared_ptr<AppEventObserver> observer, const std::string& filters, int64_t hashCode)
 {
     std::string name = observer->GetName();
@@ -103,13 +236,12 @@ int64_t StoreObserverToDb(std::shared_ptr<AppEventObserver> observer, const std:
     return observerSeq;
 }
 
-int64_t InitObserverFromDb(std::shared_ptr<AppEventObserver> observer, const std::string& filters, int64_t hashCode = 0)
+int64_t InitObserverFromDb(std::shared_ptr<AppEventObserver> observer, const std::string& filters)
 {
     int64_t observerSeq = observer->GetSeq();
     if (observerSeq <= 0) {
-        HILOG_INFO(LOG_CORE, "the observer does not exist in database, name=%{public}s, hash=%{public}" PRId64,
-            observer->GetName().c_str(), hashCode);
-        return StoreObserverToDb(observer, filters, hashCode);
+        HILOG_INFO(LOG_CORE, "the observer does not exist in database, name=%{public}s", observer->GetName().c_str());
+        return StoreObserverToDb(observer, filters, 0);
     }
     std::vector<std::shared_ptr<AppEventPack>> events;
     if (AppEventStore::GetInstance().QueryEvents(events, observerSeq, MAX_SIZE_OF_INIT) < 0) {
@@ -117,20 +249,60 @@ int64_t InitObserverFromDb(std::shared_ptr<AppEventObserver> observer, const std
         return -1;
     }
     if (!events.empty()) {
-        if (hashCode == 0) {
-            // send old events to watcher where init
-            SendEventsToObserver(events, observer);
-        } else {
-            TriggerCondition triggerCond;
-            for (auto event : events) {
-                triggerCond.row++;
-                triggerCond.size += static_cast<int>(event->GetEventStr().size());
-            }
-            observer->SetCurrCondition(triggerCond);
-        }
+        // send old events to watcher where init
+        SendEventsToObserver(events, ObserverEntry(observer));
     }
     return observerSeq;
 }
+
+int64_t InitProcessorFromDb(std::shared_ptr<AppEventObserver> processor, int64_t hashCode)
+{
+    Observer observer(processor->GetName(), hashCode);
+    if (AppEventStore::GetInstance().QueryObserver(observer) < 0) {
+        HILOG_ERROR(LOG_CORE, "failed to query processor=%{public}s", observer.name.c_str());
+        return -1;
+    }
+    if (observer.seq <= 0) {
+        HILOG_INFO(LOG_CORE, "the processor does not exist in database, name=%{public}s, hash=%{public}" PRId64,
+            observer.name.c_str(), hashCode);
+        return StoreObserverToDb(processor, "", hashCode);
+    }
+    processor->SetSeq(observer.seq);
+    // the counters in db cover all the events mapped to the processor
+    TriggerCondition triggerCond;
+    triggerCond.row = static_cast<int>(std::min<int64_t>(observer.eventRows, INT_MAX));
+    triggerCond.size = static_cast<int>(std::min<int64_t>(observer.eventBytes, INT_MAX));
+    processor->SetCurrCondition(triggerCond);
+    return observer.seq;
+}
+}
+
+ObserverEntry::ObserverEntry(std::shared_ptr<AppEventObserver> observer) : observer(observer)
+{
+    seq = observer->GetSeq();
+    auto observerFilters = observer->GetFilters();
+    isMatchAll = observerFilters.empty();
+    for (auto& filter : observerFilters) {
+        // the filter without domain never matches any event
+        if (!filter.domain.empty()) {
+            filters.emplace_back(std::move(filter));
+        }
+    }
+    hasTimeoutTrigger = observer->GetTriggerCond().timeout > 0;
+    canDeliverFromMemory = observer->CanDeliverFromMemory();
+}
+
+bool ObserverEntry::VerifyEvent(const std::shared_ptr<AppEventPack>& event) const
+{
+    if (!isMatchAll) {
+        auto it = std::find_if(filters.begin(), filters.end(), [&event](const auto& filter) {
+            return filter.IsValidEvent(event);
+        });
+        if (it == filters.end()) {
+            return false;
+        }
+    }
+    return observer->ValidateEvent(event);
 }
 
 AppEventObserverMgr& AppEventObserverMgr::GetInstance()
@@ -145,6 +317,32 @@ AppEventObserverMgr::AppEventObserverMgr()
     moduleLoader_ = std::make_unique<ModuleLoader>();
     queue_ = std::make_shared<ffrt::queue>("AppEventQueue");
     SendRefreshFreeSizeTask();
+    SendInitDbStoreTask();
+}
+
+void AppEventObserverMgr::SendInitDbStoreTask()
+{
+    // open the db in the queue, and the tasks submitted later will run after the db is ready
+    SubmitTaskToFFRTQueue([this] {
+        (void)AppEventStore::GetInstance().OpenDbStore();
+        InitWatchers();
+        isDbInit_ = true;
+        HILOG_INFO(LOG_CORE, "init db store finished");
+        // replay the events left unwritten by the last crash once the restored observers are ready, they are
+        // written to the log file as well as to the observers
+        std::vector<std::shared_ptr<AppEventPack>> events;
+        AppEventCrashRing::GetInstance().TakeRecoveredEvents(events);
+        if (!events.empty()) {
+            HILOG_INFO(LOG_CORE, "replay %{public}zu events from the crash ring", events.size());
+        }
+        for (const auto& event : events) {
+            WriteEvent(event);
+        }
+        // the rings of the recovered events are removed only after the events have been written
+        AppEventCrashRing::GetInstance().ReleaseRecoveredEvents();
+        // the main process drains the events of the secondary processes even if it writes none itself
+        AppEventSharedRing::GetInstance().Elect();
+        }, "init_db_store");
 }
 
 void AppEventObserverMgr::RegisterAppStateCallback()
@@ -189,13 +387,35 @@ void AppEventObserverMgr::UnregisterAppStateCallback()
     HILOG_INFO(LOG_CORE, "succ to unregister application state callback");
 }
 
-void AppEventObserverMgr::SubmitTaskToFFRTQueue(std::function<void()>&& task, const std::string& taskName)
+void AppEventObserverMgr::SubmitTaskToFFRTQueue(std::function<void()>&& task, const std::string& taskName,
+    int qos)
 {
     if (queue_ == nullptr) {
         HILOG_ERROR(LOG_CORE, "queue is null, failed to submit task=%{public}s", taskName.c_str());
         return;
     }
-    queue_->submit(task, ffrt::task_attr().name(taskName.c_str()));
+    // the depth and the waiting time of the queue are tracked by the wrapper of the task
+    PipelineMetrics::UpdateGauge(PipelineMetrics::QUEUE_DEPTH, 1);
+    queue_->submit([task = std::move(task), enqueueTime = PipelineMetrics::NowUs()] {
+        PipelineMetrics::UpdateGauge(PipelineMetrics::QUEUE_DEPTH, -1);
+        PipelineMetrics::Observe(PipelineMetrics::QUEUE_WAIT, PipelineMetrics::NowUs() - enqueueTime);
+        task();
+        }, ffrt::task_attr().name(taskName.c_str()).qos(qos));
+}
+
+bool AppEventObserverMgr::IsRealTimeEvent(std::shared_ptr<AppEventPack> event)
+{
+    SnapshotReader<ObserverSnapshot> snapshot(snapshots_);
+    if (snapshot.Get() == nullptr) {
+        return false;
+    }
+    auto it = snapshot->realTimeFilters.find(event->GetDomain());
+    if (it == snapshot->realTimeFilters.end()) {
+        return false;
+    }
+    return std::any_of(it->second.begin(), it->second.end(), [&event](const auto& filter) {
+        return filter.IsValidEvent(event);
+    });
 }
 
 int64_t AppEventObserverMgr::GetSeqFromWatchers(const std::string& name, std::string& filters)
@@ -214,13 +434,44 @@ int64_t AppEventObserverMgr::GetSeqFromProcessors(const std::string& name, int64
 {
     std::shared_lock<std::shared_mutex> lock(processorMutex_);
     for (auto it = processors_.cbegin(); it != processors_.cend(); ++it) {
+        if (it->second->GetName() != name || it->second->GenerateHashCode() != hashCode) {
+            continue;
+        }
+        // keep returning the provisional seq if the processor was registered with it
+        for (auto seqIt = pendingSeqs_.cbegin(); seqIt != pendingSeqs_.cend(); ++seqIt) {
+            if (seqIt->second == it->first) {
+                return seqIt->first;
+            }
+        }
+        return it->second->GetSeq();
+    }
+    for (auto it = pendingProcessors_.cbegin(); it != pendingProcessors_.cend(); ++it) {
         if (it->second->GetName() == name && it->second->GenerateHashCode() == hashCode) {
-            return it->second->GetSeq();
+            return it->first;
         }
     }
     return -1;
 }
 
+int64_t AppEventObserverMgr::GetBoundSeq(int64_t observerSeq)
+{
+    std::shared_lock<std::shared_mutex> lock(processorMutex_);
+    auto it = pendingSeqs_.find(observerSeq);
+    return it == pendingSeqs_.cend() ? observerSeq : it->second;
+}
+
+std::shared_ptr<AppEventProcessorProxy> AppEventObserverMgr::GetProcessor(int64_t observerSeq)
+{
+    if (auto it = pendingProcessors_.find(observerSeq); it != pendingProcessors_.cend()) {
+        return it->second;
+    }
+    if (auto it = pendingSeqs_.find(observerSeq); it != pendingSeqs_.cend()) {
+        observerSeq = it->second;
+    }
+    auto it = processors_.find(observerSeq);
+    return it == processors_.cend() ? nullptr : it->second;
+}
+
 void AppEventObserverMgr::DeleteWatcher(int64_t observerSeq)
 {
     std::unique_lock<std::shared_mutex> lock(watcherMutex_);
@@ -232,6 +483,23 @@ void AppEventObserverMgr::DeleteProcessor(int64_t observerSeq)
 {
     std::unique_lock<std::shared_mutex> lock(processorMutex_);
     processors_.erase(observerSeq);
+    for (auto it = pendingSeqs_.begin(); it != pendingSeqs_.end();) {
+        it = (it->second == observerSeq) ? pendingSeqs_.erase(it) : std::next(it);
+    }
+}
+
+bool AppEventObserverMgr::DeletePendingProcessor(int64_t pendingSeq)
+{
+    std::unique_lock<std::shared_mutex> lock(processorMutex_);
+    return pendingProcessors_.erase(pendingSeq) > 0;
+}
+
+void AppEventObserverMgr::DeletePendingProcessors(const std::string& name)
+{
+    std::unique_lock<std::shared_mutex> lock(processorMutex_);
+    for (auto it = pendingProcessors_.begin(); it != pendingProcessors_.end();) {
+        it = (it->second->GetName() == name) ? pendingProcessors_.erase(it) : std::next(it);
+    }
 }
 
 bool AppEventObserverMgr::IsExistInWatchers(int64_t observerSeq)
@@ -246,22 +514,30 @@ bool AppEventObserverMgr::IsExistInProcessors(int64_t observerSeq)
     return processors_.find(observerSeq) != processors_.cend();
 }
 
-std::vector<std::shared_ptr<AppEventObserver>> AppEventObserverMgr::GetObservers()
+void AppEventObserverMgr::PublishSnapshot()
 {
-    std::vector<std::shared_ptr<AppEventObserver>> observers;
+    // serialize the publishers, so that the last published snapshot always contains the latest observers
+    std::lock_guard<std::mutex> lockGuard(snapshotMutex_);
+    auto snapshot = std::make_unique<ObserverSnapshot>();
     {
         std::shared_lock<std::shared_mutex> watcherLock(watcherMutex_);
         for (auto it = watchers_.cbegin(); it != watchers_.cend(); ++it) {
-            observers.emplace_back(it->second);
+            snapshot->entries.emplace_back(it->second);
         }
     }
     {
         std::shared_lock<std::shared_mutex> processorLock(processorMutex_);
         for (auto it = processors_.cbegin(); it != processors_.cend(); ++it) {
-            observers.emplace_back(it->second);
+            snapshot->entries.emplace_back(it->second);
+            for (auto& filter : it->second->GetRealTimeFilters()) {
+                snapshot->realTimeFilters[filter.domain].emplace_back(std::move(filter));
+            }
         }
     }
-    return observers;
+    for (const auto& entry : snapshot->entries) {
+        snapshot->hasTimeoutTrigger |= entry.hasTimeoutTrigger;
+    }
+    snapshots_.Publish(std::move(snapshot));
 }
 
 void AppEventObserverMgr::InitWatchers()
@@ -273,13 +549,16 @@ void AppEventObserverMgr::InitWatchers()
             HILOG_WARN(LOG_CORE, "failed to query observers from db");
             return;
         }
-        std::unique_lock<std::shared_mutex> lock(watcherMutex_);
-        for (const auto& observer : observers) {
-            auto watcherPtr = std::make_shared<AppEventWatcher>(observer.name);
-            watcherPtr->SetSeq(observer.seq);
-            watcherPtr->SetFiltersStr(observer.filters);
-            watchers_[observer.seq] = watcherPtr;
+        {
+            std::unique_lock<std::shared_mutex> lock(watcherMutex_);
+            for (const auto& observer : observers) {
+                auto watcherPtr = std::make_shared<AppEventWatcher>(observer.name);
+                watcherPtr->SetSeq(observer.seq);
+                watcherPtr->SetFiltersStr(observer.filters);
+                watchers_[observer.seq] = watcherPtr;
+            }
         }
+        PublishSnapshot();
         HILOG_INFO(LOG_CORE, "init watchers");
     });
 }
@@ -313,46 +592,68 @@ int64_t AppEventObserverMgr::AddWatcher(std::shared_ptr<AppEventWatcher> watcher
         return -1;
     }
     watchers_[observerSeq] = watcher;
+    lock.unlock();
+    PublishSnapshot();
     HILOG_INFO(LOG_CORE, "register watcher=%{public}" PRId64 " successfully", observerSeq);
     return observerSeq;
 }
 
-int64_t AppEventObserverMgr::AddProcessorWithTimeLimited(const std::string& name, int64_t hashCode,
-    std::shared_ptr<AppEventProcessorProxy> processor)
-{
-    if (isFirstAddProcessor_) {
-        isFirstAddProcessor_ = false;
-        auto syncPromise = std::make_shared<ffrt::promise<int64_t>>();
-        if (syncPromise == nullptr) {
-            HILOG_ERROR(LOG_CORE, "Failed to create syncPromise.");
-            return -1;
-        }
-        ffrt::future syncFuture = syncPromise->get_future();
-        ffrt::submit([this, syncPromise, processor, name, hashCode]() {
-            processor->SetSeq(AppEventStore::GetInstance().QueryObserverSeq(name, hashCode));
-            this->isDbInit_ = true;
-            syncPromise->set_value(InitObserverFromDb(processor, "", hashCode));
-            }, ffrt::task_attr()
-                .name("ADD_PROCESSOR_TASK")
-                .qos(static_cast<int>(ffrt_qos_user_initiated)));
-        ffrt::future_status wait = syncFuture.wait_for(std::chrono::milliseconds(TIMEOUT_LIMIT_FOR_ADDPROCESSOR));
-        if (wait != ffrt::future_status::ready) {
-            HILOG_WARN(LOG_CORE, "AddProcessor first task execution timeout");
-            return -1;
-        }
-        return syncFuture.get();
-    }
-    int remainTime = TIMEOUT_LIMIT_FOR_ADDPROCESSOR;
-    while (!isDbInit_ && remainTime >= 0) {
-        remainTime -= CHECK_DB_INTERVAL;
-        std::this_thread::sleep_for(std::chrono::milliseconds(CHECK_DB_INTERVAL));
-    }
-    if (remainTime < 0) {
-        HILOG_WARN(LOG_CORE, "AddProcessor subsequent task execution timeout");
+int64_t AppEventObserverMgr::BindProcessor(std::shared_ptr<AppEventProcessorProxy> processor, int64_t hashCode)
+{
+    int64_t observerSeq = InitProcessorFromDb(processor, hashCode);
+    if (observerSeq <= 0) {
         return -1;
     }
-    processor->SetSeq(AppEventStore::GetInstance().QueryObserverSeq(name, hashCode));
-    return InitObserverFromDb(processor, "", hashCode);
+    processor->ProcessStartup();
+    return observerSeq;
+}
+
+int64_t AppEventObserverMgr::AddPendingProcessor(std::shared_ptr<AppEventProcessorProxy> processor, int64_t hashCode)
+{
+    int64_t pendingSeq = 0;
+    {
+        std::unique_lock<std::shared_mutex> lock(processorMutex_);
+        pendingSeq = PENDING_SEQ_BASE + (++pendingSeqCnt_);
+        pendingProcessors_[pendingSeq] = processor;
+    }
+    SubmitTaskToFFRTQueue([this, pendingSeq, hashCode] {
+        BindPendingProcessor(pendingSeq, hashCode);
+        }, "bind_processor");
+    HILOG_INFO(LOG_CORE, "register processor=%{public}" PRId64 " pending", pendingSeq);
+    return pendingSeq;
+}
+
+void AppEventObserverMgr::BindPendingProcessor(int64_t pendingSeq, int64_t hashCode)
+{
+    std::shared_ptr<AppEventProcessorProxy> processor;
+    {
+        std::shared_lock<std::shared_mutex> lock(processorMutex_);
+        auto it = pendingProcessors_.find(pendingSeq);
+        if (it == pendingProcessors_.cend()) {
+            HILOG_INFO(LOG_CORE, "processor=%{public}" PRId64 " was removed before binding", pendingSeq);
+            return;
+        }
+        processor = it->second;
+    }
+    int64_t observerSeq = BindProcessor(processor, hashCode);
+    std::unique_lock<std::shared_mutex> lock(processorMutex_);
+    if (pendingProcessors_.erase(pendingSeq) == 0) {
+        // the processor was removed while binding, so drop the record of db
+        lock.unlock();
+        if (observerSeq > 0) {
+            (void)AppEventStore::GetInstance().DeleteObserver(observerSeq);
+        }
+        return;
+    }
+    if (observerSeq <= 0) {
+        HILOG_ERROR(LOG_CORE, "failed to bind processor=%{public}" PRId64, pendingSeq);
+        return;
+    }
+    pendingSeqs_[pendingSeq] = observerSeq;
+    processors_[observerSeq] = processor;
+    lock.unlock();
+    PublishSnapshot();
+    HILOG_INFO(LOG_CORE, "bind processor=%{public}" PRId64 " to seq=%{public}" PRId64, pendingSeq, observerSeq);
 }
 
 int64_t AppEventObserverMgr::AddProcessor(const std::string& name, const ReportConfig& config)
@@ -376,19 +677,29 @@ int64_t AppEventObserverMgr::AddProcessor(const std::string& name, const ReportC
         return seq;
     }
 
-    int64_t observerSeq = AddProcessorWithTimeLimited(name, hashCode, processor);
+    // before the db is ready, the processor is bound to the seq of db in the queue
+    if (!isDbInit_) {
+        return AddPendingProcessor(processor, hashCode);
+    }
+    int64_t observerSeq = BindProcessor(processor, hashCode);
     if (observerSeq <= 0) {
         return -1;
     }
-    processor->ProcessStartup();
     std::unique_lock<std::shared_mutex> lock(processorMutex_);
     processors_[observerSeq] = processor;
+    lock.unlock();
+    PublishSnapshot();
     HILOG_INFO(LOG_CORE, "register processor=%{public}" PRId64 " successfully", observerSeq);
     return observerSeq;
 }
 
 int AppEventObserverMgr::RemoveObserver(int64_t observerSeq)
 {
+    if (DeletePendingProcessor(observerSeq)) {
+        HILOG_INFO(LOG_CORE, "unregister pending processor seq=%{public}" PRId64 " successfully", observerSeq);
+        return 0;
+    }
+    observerSeq = GetBoundSeq(observerSeq);
     if (!IsExistInWatchers(observerSeq) && !IsExistInProcessors(observerSeq)) {
         HILOG_WARN(LOG_CORE, "observer seq=%{public}" PRId64 " is not exist", observerSeq);
         return 0;
@@ -399,12 +710,14 @@ int AppEventObserverMgr::RemoveObserver(int64_t observerSeq)
     }
     DeleteProcessor(observerSeq);
     DeleteWatcher(observerSeq);
+    PublishSnapshot();
     HILOG_INFO(LOG_CORE, "unregister observer seq=%{public}" PRId64 " successfully", observerSeq);
     return 0;
 }
 
 int AppEventObserverMgr::RemoveObserver(const std::string& observerName)
 {
+    DeletePendingProcessors(observerName);
     std::vector<int64_t> deleteSeqs;
     if (int ret = AppEventStore::GetInstance().QueryObserverSeqs(observerName, deleteSeqs); ret < 0) {
         HILOG_ERROR(LOG_CORE, "failed to query observer=%{public}s seqs", observerName.c_str());
@@ -437,19 +750,30 @@ int AppEventObserverMgr::UnregisterProcessor(const std::string& name)
 
 void AppEventObserverMgr::HandleEvents(std::vector<std::shared_ptr<AppEventPack>>& events)
 {
-    InitWatchers();
-    auto observers = GetObservers();
-    if (observers.empty() || events.empty()) {
+    if (!isDbInit_) {
+        InitWatchers();
+    }
+    SnapshotReader<ObserverSnapshot> snapshot(snapshots_);
+    if (snapshot.Get() == nullptr || snapshot->entries.empty() || events.empty()) {
         return;
     }
     HILOG_DEBUG(LOG_CORE, "start to handle events size=%{public}zu", events.size());
-    StoreEventsToDb(events);
-    StoreEventMappingToDb(events, observers);
+    const auto& entries = snapshot->entries;
+    auto matches = MatchEvents(events, entries);
+    {
+        PipelineMetrics::StageTimer timer(PipelineMetrics::DISPATCH);
+        DeliverEventsFromMemory(events, entries, matches);
+    }
+    StoreEventsToDb(events, matches);
+    StoreEventMappingToDb(events, entries, matches);
     bool isNeedSend = false;
-    for (const auto& observer : observers) {
-        // send events to observer, and then delete events not in event mapping
-        SendEventsToObserver(events, observer);
-        isNeedSend |= observer->HasTimeoutCondition();
+    {
+        PipelineMetrics::StageTimer timer(PipelineMetrics::DISPATCH);
+        for (size_t i = 0; i < entries.size(); ++i) {
+            // send events to observer, and then delete events not in event mapping
+            SendEventsToObserver(events, entries[i], matches[i].sent);
+            isNeedSend |= entries[i].hasTimeoutTrigger && entries[i].observer->HasTimeoutCondition();
+        }
     }
     // timeout condition > 0 and the current event row > 0, send timeout task.
     // There can be only one timeout task.
@@ -462,11 +786,13 @@ void AppEventObserverMgr::HandleEvents(std::vector<std::shared_ptr<AppEventPack>
 
 void AppEventObserverMgr::HandleTimeout()
 {
-    auto observers = GetObservers();
+    SnapshotReader<ObserverSnapshot> snapshot(snapshots_);
     bool isNeedSend = false;
-    for (const auto& observer : observers) {
-        observer->ProcessTimeout();
-        isNeedSend |= observer->HasTimeoutCondition();
+    if (snapshot.Get() != nullptr && snapshot->hasTimeoutTrigger) {
+        for (const auto& entry : snapshot->entries) {
+            entry.observer->ProcessTimeout();
+            isNeedSend |= entry.observer->HasTimeoutCondition();
+        }
     }
     if (isNeedSend) {
         SendTimeoutTask();
@@ -496,42 +822,72 @@ void AppEventObserverMgr::SendRefreshFreeSizeTask()
 void AppEventObserverMgr::HandleBackground()
 {
     HILOG_INFO(LOG_CORE, "start to handle background");
+    // the app may be killed in the background, so the events held for aggregation are not held any longer
+    AppEventAggregator::GetInstance().Flush(true);
     SubmitTaskToFFRTQueue([this] {
-        auto observers = GetObservers();
-        for (const auto& observer : observers) {
-            observer->ProcessBackground();
+        SnapshotReader<ObserverSnapshot> snapshot(snapshots_);
+        if (snapshot.Get() == nullptr) {
+            return;
+        }
+        for (const auto& entry : snapshot->entries) {
+            entry.observer->ProcessBackground();
         }
         }, "app_background");
 }
 
+void AppEventObserverMgr::GetObserverBacklogs(std::vector<PipelineMetrics::ObserverBacklog>& backlogs)
+{
+    SnapshotReader<ObserverSnapshot> snapshot(snapshots_);
+    if (snapshot.Get() == nullptr) {
+        return;
+    }
+    for (const auto& entry : snapshot->entries) {
+        // the current condition holds the events received but not triggered yet
+        TriggerCondition currCond = entry.observer->GetCurrCondition();
+        PipelineMetrics::ObserverBacklog backlog;
+        backlog.name = entry.observer->GetName();
+        backlog.seq = entry.seq;
+        backlog.rows = currCond.row;
+        backlog.bytes = currCond.size;
+        backlogs.emplace_back(std::move(backlog));
+    }
+}
+
 void AppEventObserverMgr::HandleClearUp()
 {
     HILOG_INFO(LOG_CORE, "start to handle clear up");
-    auto observers = GetObservers();
-    for (const auto& observer : observers) {
-        observer->ResetCurrCondition();
+    SnapshotReader<ObserverSnapshot> snapshot(snapshots_);
+    if (snapshot.Get() == nullptr) {
+        return;
+    }
+    for (const auto& entry : snapshot->entries) {
+        entry.observer->ResetCurrCondition();
     }
 }
 
 int AppEventObserverMgr::SetReportConfig(int64_t observerSeq, const ReportConfig& config)
 {
     std::unique_lock<std::shared_mutex> lock(processorMutex_);
-    if (processors_.find(observerSeq) == processors_.cend()) {
+    auto processor = GetProcessor(observerSeq);
+    if (processor == nullptr) {
         HILOG_WARN(LOG_CORE, "failed to set config, seq=%{public}" PRId64, observerSeq);
         return -1;
     }
-    processors_[observerSeq]->SetReportConfig(config);
+    processor->SetReportConfig(config);
+    lock.unlock();
+    PublishSnapshot();
     return 0;
 }
 
 int AppEventObserverMgr::GetReportConfig(int64_t observerSeq, ReportConfig& config)
 {
     std::shared_lock<std::shared_mutex> lock(processorMutex_);
-    if (processors_.find(observerSeq) == processors_.cend()) {
+    auto processor = GetProcessor(observerSeq);
+    if (processor == nullptr) {
         HILOG_WARN(LOG_CORE, "failed to get config, seq=%{public}" PRId64, observerSeq);
         return -1;
     }
-    config = processors_[observerSeq]->GetReportConfig();
+    config = processor->GetReportConfig();
     return 0;
 }
 
@@ -554,12 +910,12 @@ bool AppEventObserverMgr::InitWatcherFromListener(std::shared_ptr<AppEventWatche
         std::vector<std::shared_ptr<AppEventPack>> events;
         listener_->GetEvents(events);
         if (!events.empty()) {
-            std::vector<std::shared_ptr<AppEventObserver>> curWatchers;
+            std::vector<ObserverEntry> curWatchers;
             for (auto it = watchers_.cbegin(); it != watchers_.cend(); ++it) {
                 curWatchers.emplace_back(it->second);
             }
             StoreEventMappingToDb(events, curWatchers);
-            SendEventsToObserver(events, watcher);  // send history events to current observer
+            SendEventsToObserver(events, ObserverEntry(watcher));  // send history events to current observer
         }
     }
     return true;
@@ -0,0 +1,540 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "app_event_predicate.h"
+
+#include <array>
+#include <cstdlib>
+#include <type_traits>
+
+#include "app_event_params_decoder.h"
+#include "hiappevent_base.h"
+#include "hilog/log.h"
+
+#undef LOG_DOMAIN
+#define LOG_DOMAIN 0xD002D07
+
+#undef LOG_TAG
+#define LOG_TAG "Predicate"
+
+namespace OHOS {
+namespace HiviewDFX {
+namespace HiAppEvent {
+namespace {
+using OpCode = AppEventPredicate::OpCode;
+using LiteralType = AppEventPredicate::LiteralType;
+using Instruction = AppEventPredicate::Instruction;
+
+constexpr size_t MAX_CONDITION_LEN = 1024;
+constexpr size_t MAX_INSTRUCTION_NUM = 64;
+constexpr size_t MAX_NESTING_DEPTH = 16;
+
+struct ParamValue {
+    bool isPresent = false;
+    LiteralType type = LiteralType::NONE; // NONE for the values which are not comparable, e.g. arrays
+    bool boolValue = false;
+    double numValue = 0.0;
+    std::string strValue;
+};
+
+char CharAt(const std::string& str, size_t pos)
+{
+    return pos < str.size() ? str[pos] : '\0';
+}
+
+bool IsSpace(char ch)
+{
+    return ch == ' ' || ch == '\t' || ch == '\n' || ch == '\r';
+}
+
+bool IsDigit(char ch)
+{
+    return ch >= '0' && ch <= '9';
+}
+
+bool IsIdentStart(char ch)
+{
+    return (ch >= 'a' && ch <= 'z') || (ch >= 'A' && ch <= 'Z') || ch == '_' || ch == '$';
+}
+
+bool IsIdentChar(char ch)
+{
+    return IsIdentStart(ch) || IsDigit(ch);
+}
+
+size_t SkipSpaces(const std::string& str, size_t pos)
+{
+    while (pos < str.size() && IsSpace(str[pos])) {
+        ++pos;
+    }
+    return pos;
+}
+
+bool ParseNum(const std::string& str, double& num)
+{
+    char* end = nullptr;
+    num = std::strtod(str.c_str(), &end);
+    return !str.empty() && end != nullptr && *end == '\0';
+}
+
+void GetTypedValue(const AppEventParam& param, ParamValue& value)
+{
+    value.isPresent = true;
+    std::visit([&value](const auto& arg) {
+        using T = std::decay_t<decltype(arg)>;
+        if constexpr (std::is_same_v<T, std::monostate>) {
+            value.isPresent = false;
+        } else if constexpr (std::is_same_v<T, bool>) {
+            value.type = LiteralType::BOOL;
+            value.boolValue = arg;
+        } else if constexpr (std::is_arithmetic_v<T>) {
+            value.type = LiteralType::NUMBER;
+            value.numValue = static_cast<double>(arg);
+        } else if constexpr (std::is_same_v<T, std::string>) {
+            value.type = LiteralType::STRING;
+            value.strValue = arg;
+        }
+    }, param.value);
+}
+
+// captures the top-level params referenced by the condition in a single pass over the decoded params
+class ParamFinder : public AppEventParamsHandler {
+public:
+    ParamFinder(const std::vector<std::string>& names, std::vector<ParamValue>& values)
+        : names_(names), values_(values) {}
+    ~ParamFinder() override = default;
+
+    void OnKey(const std::string& key) override
+    {
+        if (depth_ > 0) {
+            return;
+        }
+        current_ = nullptr;
+        for (size_t i = 0; i < names_.size(); ++i) {
+            if (names_[i] == key) {
+                current_ = &values_[i];
+                break;
+            }
+        }
+    }
+
+    void OnNull() override {}
+
+    void OnBool(bool value) override
+    {
+        if (ParamValue* param = Take(LiteralType::BOOL); param != nullptr) {
+            param->boolValue = value;
+        }
+    }
+
+    void OnInt(int64_t value) override
+    {
+        OnDouble(static_cast<double>(value));
+    }
+
+    void OnDouble(double value) override
+    {
+        if (ParamValue* param = Take(LiteralType::NUMBER); param != nullptr) {
+            param->numValue = value;
+        }
+    }
+
+    void OnString(const std::string& value) override
+    {
+        if (ParamValue* param = Take(LiteralType::STRING); param != nullptr) {
+            param->strValue = value;
+        }
+    }
+
+    void OnBoolArray(const std::vector<bool>&) override
+    {
+        Take(LiteralType::NONE);
+    }
+
+    void OnIntArray(const std::vector<int64_t>&) override
+    {
+        Take(LiteralType::NONE);
+    }
+
+    void OnDoubleArray(const std::vector<double>&) override
+    {
+        Take(LiteralType::NONE);
+    }
+
+    void OnStringArray(const std::vector<std::string>&) override
+    {
+        Take(LiteralType::NONE);
+    }
+
+    bool OnObjectBegin() override
+    {
+        return false; // the objects are not comparable, so they are skipped as json text
+    }
+
+    void OnObjectEnd() override {}
+
+    bool OnArrayBegin() override
+    {
+        Take(LiteralType::NONE);
+        ++depth_;
+        return false;
+    }
+
+    void OnArrayEnd() override
+    {
+        --depth_;
+    }
+
+    void OnRawValue(const char*, size_t) override
+    {
+        Take(LiteralType::NONE);
+    }
+
+private:
+    ParamValue* Take(LiteralType type)
+    {
+        if (depth_ > 0 || current_ == nullptr) {
+            return nullptr;
+        }
+        ParamValue* param = current_;
+        current_ = nullptr;
+        param->isPresent = true;
+        param->type = type;
+        return param;
+    }
+
+private:
+    const std::vector<std::string>& names_;
+    std::vector<ParamValue>& values_;
+    ParamValue* current_ = nullptr;
+    size_t depth_ = 0;
+};
+
+class ParamReader {
+public:
+    ParamReader(const AppEventPack& event, const std::vector<std::string>& names) : event_(event), names_(names) {}
+
+    void Read(size_t index, ParamValue& value)
+    {
+        if (event_.HasBaseParams()) {
+            const AppEventParam* param = event_.FindBaseParam(names_[index]);
+            if (param != nullptr) {
+                GetTypedValue(*param, value);
+            }
+            return;
+        }
+        // the stored or json params are decoded once for all the params referenced by the condition
+        if (values_.empty()) {
+            values_.resize(names_.size());
+            ParamFinder finder(names_, values_);
+            AppEventParamsDecoder::Decode(event_, finder);
+        }
+        value = values_[index];
+    }
+
+private:
+    const AppEventPack& event_;
+    const std::vector<std::string>& names_;
+    std::vector<ParamValue> values_;
+};
+
+bool IsTruthy(const ParamValue& value)
+{
+    if (!value.isPresent) {
+        return false;
+    }
+    switch (value.type) {
+        case LiteralType::BOOL:
+            return value.boolValue;
+        case LiteralType::NUMBER:
+            return value.numValue != 0.0;
+        case LiteralType::STRING:
+            return !value.strValue.empty();
+        default:
+            return true;
+    }
+}
+
+template<typename T>
+bool CompareValue(OpCode op, const T& lhs, const T& rhs)
+{
+    switch (op) {
+        case OpCode::EQ:
+            return lhs == rhs;
+        case OpCode::NE:
+            return lhs != rhs;
+        case OpCode::LT:
+            return lhs < rhs;
+        case OpCode::LE:
+            return lhs <= rhs;
+        case OpCode::GT:
+            return lhs > rhs;
+        case OpCode::GE:
+            return lhs >= rhs;
+        default:
+            return false;
+    }
+}
+
+bool Compare(const ParamValue& value, const Instruction& instruction)
+{
+    if (!value.isPresent || value.type != instruction.literalType) {
+        return false;
+    }
+    switch (value.type) {
+        case LiteralType::BOOL:
+            return (instruction.op == OpCode::EQ || instruction.op == OpCode::NE)
+                && CompareValue(instruction.op, value.boolValue, instruction.boolValue);
+        case LiteralType::NUMBER:
+            return CompareValue(instruction.op, value.numValue, instruction.numValue);
+        case LiteralType::STRING:
+            return CompareValue(instruction.op, value.strValue, instruction.strValue);
+        default:
+            return false;
+    }
+}
+}
+
+class AppEventPredicate::Compiler {
+public:
+    Compiler(const std::string& condition, AppEventPredicate& predicate)
+        : condition_(condition), predicate_(predicate) {}
+
+    bool Compile()
+    {
+        if (!ParseOr(0)) {
+            return false;
+        }
+        pos_ = SkipSpaces(condition_, pos_);
+        return pos_ == condition_.size() && predicate_.instructions_.size() <= MAX_INSTRUCTION_NUM;
+    }
+
+private:
+    bool Consume(const char* token)
+    {
+        pos_ = SkipSpaces(condition_, pos_);
+        size_t len = std::char_traits<char>::length(token);
+        if (condition_.compare(pos_, len, token) != 0) {
+            return false;
+        }
+        pos_ += len;
+        return true;
+    }
+
+    void Emit(OpCode op)
+    {
+        Instruction instruction;
+        instruction.op = op;
+        predicate_.instructions_.emplace_back(std::move(instruction));
+    }
+
+    bool ParseOr(size_t depth)
+    {
+        if (!ParseAnd(depth)) {
+            return false;
+        }
+        while (Consume("||")) {
+            if (!ParseAnd(depth)) {
+                return false;
+            }
+            Emit(OpCode::OR);
+        }
+        return true;
+    }
+
+    bool ParseAnd(size_t depth)
+    {
+        if (!ParseNot(depth)) {
+            return false;
+        }
+        while (Consume("&&")) {
+            if (!ParseNot(depth)) {
+                return false;
+            }
+            Emit(OpCode::AND);
+        }
+        return true;
+    }
+
+    bool ParseNot(size_t depth)
+    {
+        if (depth > MAX_NESTING_DEPTH) {
+            return false;
+        }
+        pos_ = SkipSpaces(condition_, pos_);
+        if (CharAt(condition_, pos_) == '!' && CharAt(condition_, pos_ + 1) != '=') {
+            ++pos_;
+            if (!ParseNot(depth + 1)) {
+                return false;
+            }
+            Emit(OpCode::NOT);
+            return true;
+        }
+        if (Consume("(")) {
+            return ParseOr(depth + 1) && Consume(")");
+        }
+        return ParseComparison();
+    }
+
+    bool ParseComparison()
+    {
+        Instruction instruction;
+        std::string paramName;
+        if (!ParseIdent(paramName)) {
+            return false;
+        }
+        instruction.paramIndex = GetParamIndex(paramName);
+        // the longer operators go first so that "<=" is not taken as "<"
+        const std::pair<const char*, OpCode> ops[] = {
+            {"==", OpCode::EQ}, {"!=", OpCode::NE}, {"<=", OpCode::LE},
+            {">=", OpCode::GE}, {"<", OpCode::LT}, {">", OpCode::GT},
+        };
+        for (const auto& [token, op] : ops) {
+            if (Consume(token)) {
+                instruction.op = op;
+                if (!ParseLiteral(instruction)) {
+                    return false;
+                }
+                break;
+            }
+        }
+        predicate_.instructions_.emplace_back(std::move(instruction));
+        return true;
+    }
+
+    bool ParseIdent(std::string& ident)
+    {
+        pos_ = SkipSpaces(condition_, pos_);
+        if (!IsIdentStart(CharAt(condition_, pos_))) {
+            return false;
+        }
+        size_t start = pos_;
+        while (IsIdentChar(CharAt(condition_, pos_))) {
+            ++pos_;
+        }
+        ident = condition_.substr(start, pos_ - start);
+        return true;
+    }
+
+    bool ParseLiteral(Instruction& instruction)
+    {
+        pos_ = SkipSpaces(condition_, pos_);
+        char ch = CharAt(condition_, pos_);
+        if (ch == '"' || ch == '\'') {
+            instruction.literalType = LiteralType::STRING;
+            return ParseStrLiteral(ch, instruction.strValue);
+        }
+        if (ch == '-' || ch == '+' || ch == '.' || IsDigit(ch)) {
+            size_t start = pos_;
+            while (pos_ < condition_.size() && (IsIdentChar(condition_[pos_]) || condition_[pos_] == '.'
+                || ((condition_[pos_] == '-' || condition_[pos_] == '+') && (pos_ == start
+                || condition_[pos_ - 1] == 'e' || condition_[pos_ - 1] == 'E')))) {
+                ++pos_;
+            }
+            instruction.literalType = LiteralType::NUMBER;
+            return ParseNum(condition_.substr(start, pos_ - start), instruction.numValue);
+        }
+        std::string ident;
+        if (!ParseIdent(ident) || (ident != "true" && ident != "false")) {
+            return false;
+        }
+        instruction.literalType = LiteralType::BOOL;
+        instruction.boolValue = (ident == "true");
+        return true;
+    }
+
+    bool ParseStrLiteral(char quote, std::string& str)
+    {
+        for (size_t i = pos_ + 1; i < condition_.size(); ++i) {
+            if (condition_[i] == quote) {
+                pos_ = i + 1;
+                return true;
+            }
+            if (condition_[i] == '\\' && i + 1 < condition_.size()) {
+                ++i;
+            }
+            str.push_back(condition_[i]);
+        }
+        return false;
+    }
+
+    size_t GetParamIndex(const std::string& paramName)
+    {
+        auto& paramNames = predicate_.paramNames_;
+        for (size_t i = 0; i < paramNames.size(); ++i) {
+            if (paramNames[i] == paramName) {
+                return i;
+            }
+        }
+        paramNames.emplace_back(paramName);
+        return paramNames.size() - 1;
+    }
+
+private:
+    const std::string& condition_;
+    AppEventPredicate& predicate_;
+    size_t pos_ = 0;
+};
+
+std::shared_ptr<const AppEventPredicate> AppEventPredicate::Compile(const std::string& condition)
+{
+    if (condition.empty() || condition.size() > MAX_CONDITION_LEN) {
+        HILOG_ERROR(LOG_CORE, "invalid length of the condition=%{public}zu.", condition.size());
+        return nullptr;
+    }
+    auto predicate = std::make_shared<AppEventPredicate>();
+    predicate->condition_ = condition;
+    if (!Compiler(predicate->condition_, *predicate).Compile()) {
+        HILOG_ERROR(LOG_CORE, "failed to compile the condition=%{public}s.", condition.c_str());
+        return nullptr;
+    }
+    return predicate;
+}
+
+bool AppEventPredicate::Evaluate(const AppEventPack& event) const
+{
+    std::array<bool, MAX_INSTRUCTION_NUM> stack {};
+    size_t top = 0;
+    ParamReader reader(event, paramNames_);
+    for (const auto& instruction : instructions_) {
+        switch (instruction.op) {
+            case OpCode::NOT:
+                stack[top - 1] = !stack[top - 1];
+                break;
+            case OpCode::AND:
+                --top;
+                stack[top - 1] = stack[top - 1] && stack[top];
+                break;
+            case OpCode::OR:
+                --top;
+                stack[top - 1] = stack[top - 1] || stack[top];
+                break;
+            default: {
+                ParamValue value;
+                reader.Read(instruction.paramIndex, value);
+                stack[top++] = (instruction.op == OpCode::TEST) ? IsTruthy(value) : Compare(value, instruction);
+                break;
+            }
+        }
+    }
+    return top == 1 && stack[0];
+}
+
+std::string AppEventPredicate::ToString() const
+{
+    return condition_;
+}
+} // namespace HiAppEvent
+} // namespace HiviewDFX
+} // namespace OHOS
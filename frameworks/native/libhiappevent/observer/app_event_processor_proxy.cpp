@@ -21,6 +21,8 @@
 #include "hiappevent_base.h"
 #include "hiappevent_userinfo.h"
 #include "hilog/log.h"
+#include "pipeline_metrics.h"
+#include "pipeline_trace.h"
 
 #undef LOG_DOMAIN
 #define LOG_DOMAIN 0xD002D07
@@ -108,7 +110,12 @@ bool EventConfig::IsRealTimeEvent(std::shared_ptr<AppEventPack> event) const
 std::string EventConfig::ToString() const
 {
     std::stringstream strStream;
-    strStream << "{" << domain << "," << name << "," << isRealTime << "}";
+    strStream << "{" << domain << "," << name << "," << isRealTime;
+    // the condition is only appended when it is set, so the hash codes of the existing processors are kept
+    if (!condition.empty()) {
+        strStream << "," << condition;
+    }
+    strStream << "}";
     return strStream.str();
 }
 
@@ -134,26 +141,51 @@ void AppEventProcessorProxy::OnEvents(const std::vector<std::shared_ptr<AppEvent
         return;
     }
 
+    int64_t observerSeq = GetSeq();
+    if (ReportEvents(events) != 0) {
+        return;
+    }
+    std::vector<int64_t> eventSeqs;
+    for (const auto& event : events) {
+        eventSeqs.emplace_back(event->GetSeq());
+    }
+    if (!AppEventStore::GetInstance().DeleteData(observerSeq, eventSeqs)) {
+        HILOG_ERROR(LOG_CORE, "failed to delete mapping data, seq=%{public}" PRId64 ", event num=%{public}zu",
+            observerSeq, eventSeqs.size());
+    }
+}
+
+bool AppEventProcessorProxy::OnEventsFromMemory(const std::vector<std::shared_ptr<AppEventPack>>& events)
+{
+    // the events from memory are not stored, so there is no data to delete after they are reported
+    return !events.empty() && ReportEvents(events) == 0;
+}
+
+int AppEventProcessorProxy::ReportEvents(const std::vector<std::shared_ptr<AppEventPack>>& events)
+{
     std::vector<UserId> userIds;
     GetValidUserIds(userIds);
     std::vector<UserProperty> userProperties;
     GetValidUserProperties(userProperties);
     int64_t observerSeq = GetSeq();
     std::vector<AppEventInfo> eventInfos;
-    std::vector<int64_t> eventSeqs;
     for (const auto& event : events) {
         eventInfos.emplace_back(CreateAppEventInfo(event));
-        eventSeqs.emplace_back(event->GetSeq());
     }
-    if (processor_->OnReport(observerSeq, userIds, userProperties, eventInfos) == 0) {
-        if (!AppEventStore::GetInstance().DeleteData(observerSeq, eventSeqs)) {
-            HILOG_ERROR(LOG_CORE, "failed to delete mapping data, seq=%{public}" PRId64 ", event num=%{public}zu",
-                observerSeq, eventSeqs.size());
-        }
-    } else {
+    int ret = 0;
+    {
+        PipelineTrace::ScopedTrace trace(PipelineTrace::ON_REPORT, PipelineTrace::REPORT_BATCH,
+            static_cast<int64_t>(eventInfos.size()));
+        PipelineMetrics::StageTimer timer(PipelineMetrics::ON_REPORT);
+        ret = processor_->OnReport(observerSeq, userIds, userProperties, eventInfos);
+    }
+    PipelineMetrics::Add(PipelineMetrics::REPORTS);
+    if (ret != 0) {
+        PipelineMetrics::Add(PipelineMetrics::REPORT_FAILURES);
         HILOG_DEBUG(LOG_CORE, "failed to report event, seq=%{public}" PRId64 ", event num=%{public}zu",
-            observerSeq, eventSeqs.size());
+            observerSeq, events.size());
     }
+    return ret;
 }
 
 void AppEventProcessorProxy::GetValidUserIds(std::vector<UserId>& userIds)
@@ -196,23 +228,24 @@ void AppEventProcessorProxy::GetValidUserProperties(std::vector<UserProperty>& u
     userPropertyVersion_ = userPropertyVerForAll;
 }
 
-bool AppEventProcessorProxy::VerifyEvent(std::shared_ptr<AppEventPack> event)
+bool AppEventProcessorProxy::ValidateEvent(std::shared_ptr<AppEventPack> event)
 {
-    return AppEventObserver::VerifyEvent(event)
-        && (processor_->ValidateEvent(CreateAppEventInfo(event)) == 0);
+    return processor_->ValidateEvent(CreateAppEventInfo(event)) == 0;
 }
 
 bool AppEventProcessorProxy::IsRealTimeEvent(std::shared_ptr<AppEventPack> event)
 {
     std::lock_guard<std::mutex> lockGuard(mutex_);
-    const auto& eventConfigs = reportConfig_.eventConfigs;
-    if (eventConfigs.empty()) {
-        return false;
-    }
-    auto it = std::find_if(eventConfigs.begin(), eventConfigs.end(), [event](const auto& config) {
-        return config.IsRealTimeEvent(event);
+    auto it = std::find_if(realTimeFilters_.begin(), realTimeFilters_.end(), [&event](const auto& filter) {
+        return filter.IsValidEvent(event);
     });
-    return it != eventConfigs.end();
+    return it != realTimeFilters_.end();
+}
+
+std::vector<AppEventFilter> AppEventProcessorProxy::GetRealTimeFilters()
+{
+    std::lock_guard<std::mutex> lockGuard(mutex_);
+    return realTimeFilters_;
 }
 
 ReportConfig AppEventProcessorProxy::GetReportConfig()
@@ -230,10 +263,12 @@ void AppEventProcessorProxy::SetReportConfig(const ReportConfig& reportConfig)
     SetTriggerCond(reportConfig.triggerCond);
 
     std::vector<AppEventFilter> filters;
+    std::vector<AppEventFilter> realTimeFilters;
     // if event configs is empty, do not report event
     if (reportConfig.eventConfigs.empty()) {
         filters.emplace_back(AppEventFilter()); // invalid filter
         SetFilters(filters);
+        SetRealTimeFilters(realTimeFilters);
         return;
     }
 
@@ -245,9 +280,25 @@ void AppEventProcessorProxy::SetReportConfig(const ReportConfig& reportConfig)
         if (!eventConfig.name.empty()) {
             names.emplace(eventConfig.name);
         }
-        filters.emplace_back(AppEventFilter(eventConfig.domain, names));
+        AppEventFilter filter(eventConfig.domain, names);
+        if (!filter.SetCondition(eventConfig.condition)) {
+            HILOG_WARN(LOG_CORE, "invalid condition of event config, domain=%{public}s, name=%{public}s",
+                eventConfig.domain.c_str(), eventConfig.name.c_str());
+            continue;
+        }
+        if (eventConfig.isRealTime) {
+            realTimeFilters.emplace_back(filter);
+        }
+        filters.emplace_back(std::move(filter));
     }
     SetFilters(filters);
+    SetRealTimeFilters(realTimeFilters);
+}
+
+void AppEventProcessorProxy::SetRealTimeFilters(const std::vector<AppEventFilter>& realTimeFilters)
+{
+    std::lock_guard<std::mutex> lockGuard(mutex_);
+    realTimeFilters_ = realTimeFilters;
 }
 
 int64_t AppEventProcessorProxy::GenerateHashCode()
@@ -61,6 +61,9 @@ std::string AppEventWatcher::GetFiltersStr()
         }
         filterJson[HiAppEvent::NAMES_PROPERTY] = namesJson;
         filterJson[HiAppEvent::TYPES_PROPERTY] = filter.types;
+        if (filter.predicate != nullptr) {
+            filterJson[HiAppEvent::CONDITION_PROPERTY] = filter.GetCondition();
+        }
         filtersJson.append(filterJson);
     }
     filtersStr_ = Json::FastWriter().write(filtersJson);
@@ -89,7 +92,14 @@ void AppEventWatcher::SetFiltersStr(const std::string& jsonStr)
             std::unordered_set<std::string> names;
             EventJsonUtil::ParseStrings(filtersJson[i], HiAppEvent::NAMES_PROPERTY, names);
             uint32_t types = EventJsonUtil::ParseUInt32(filtersJson[i], HiAppEvent::TYPES_PROPERTY);
-            filters.emplace_back(AppEventFilter(domain, names, types));
+            AppEventFilter filter(domain, names, types);
+            if (!filter.SetCondition(EventJsonUtil::ParseString(filtersJson[i], HiAppEvent::CONDITION_PROPERTY))) {
+                // keep an invalid filter rather than dropping it, so that the watcher does not match all events
+                HILOG_ERROR(LOG_CORE, "failed to restore the condition of the filter, domain=%{public}s",
+                    domain.c_str());
+                filter = AppEventFilter();
+            }
+            filters.emplace_back(std::move(filter));
         }
     }
     SetFilters(filters);
@@ -15,12 +15,14 @@
 #ifndef HIAPPEVENT_FRAMEWORKS_NATIVE_LIB_HIAPPEVENT_INCLUDE_APP_EVENT_OBSERVER_H
 #define HIAPPEVENT_FRAMEWORKS_NATIVE_LIB_HIAPPEVENT_INCLUDE_APP_EVENT_OBSERVER_H
 
+#include <memory>
 #include <mutex>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
+#include "app_event_predicate.h"
 #include "base_type.h"
 
 namespace OHOS {
@@ -38,15 +40,20 @@ struct AppEventFilter {
     /* Filtering events by event types, stored in bits */
     uint32_t types = 0;
 
+    /* Filtering events by the condition on the event params, null if there is no condition */
+    std::shared_ptr<const AppEventPredicate> predicate;
+
     AppEventFilter(
         const std::string& domain = "",
         const std::unordered_set<std::string>& names = {},
         uint32_t types = 0);
     AppEventFilter(const std::string& domain, uint32_t types);
 
-    bool IsValidEvent(std::shared_ptr<AppEventPack> event) const;
+    bool IsValidEvent(const std::shared_ptr<AppEventPack>& event) const;
     bool IsValidEvent(const std::string& eventDomain, const std::string& eventName, int eventType) const;
     uint64_t GetOsEventsMask() const;
+    bool SetCondition(const std::string& condition);
+    std::string GetCondition() const;
 };
 
 class AppEventObserver {
@@ -59,7 +66,14 @@ public:
     virtual ~AppEventObserver() = default;
     virtual void OnEvents(const std::vector<std::shared_ptr<AppEventPack>>& events) {}
     virtual bool VerifyEvent(std::shared_ptr<AppEventPack> event);
+    // extra check after the event matches the filters
+    virtual bool ValidateEvent(std::shared_ptr<AppEventPack> event) { return true; }
     virtual bool IsRealTimeEvent(std::shared_ptr<AppEventPack> event) { return false; }
+    // the observer which reports the result of the real-time delivery at once can take the real-time events from
+    // memory before they are stored, and only the events failed to be delivered are stored for it then
+    virtual bool CanDeliverFromMemory() { return false; }
+    // returns true if the events are delivered, the events are not stored, so their seqs are 0
+    virtual bool OnEventsFromMemory(const std::vector<std::shared_ptr<AppEventPack>>& events) { return false; }
     virtual void OnTrigger(const TriggerCondition& triggerCond) {}
     void ProcessEvent(std::shared_ptr<AppEventPack> event);
     void ProcessTimeout();
@@ -71,8 +85,10 @@ public:
     int64_t GetSeq();
     void SetSeq(int64_t seq);
     void SetCurrCondition(const TriggerCondition& triggerCond);
+    TriggerCondition GetCurrCondition();
     // used to reset the current status when condition is met or data is cleared.
     void ResetCurrCondition();
+    TriggerCondition GetTriggerCond();
     void SetTriggerCond(const TriggerCondition& triggerCond);
     std::vector<AppEventFilter> GetFilters();
     void SetFilters(const std::vector<AppEventFilter>& filters);
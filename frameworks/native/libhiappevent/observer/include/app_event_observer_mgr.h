@@ -17,8 +17,10 @@
 
 #include <atomic>
 #include <memory>
+#include <mutex>
 #include <shared_mutex>
 #include <unordered_map>
+#include <vector>
 
 #include "app_event_observer.h"
 #include "app_event_processor.h"
@@ -26,6 +28,8 @@
 #include "app_event_watcher.h"
 #include "ffrt.h"
 #include "module_loader.h"
+#include "pipeline_metrics.h"
+#include "snapshot_holder.h"
 #include "timer.h"
 #include "nocopyable.h"
 
@@ -42,6 +46,27 @@ using HiAppEvent::ModuleLoader;
 using HiAppEvent::ReportConfig;
 using HiAppEvent::AppEventProcessorProxy;
 
+struct ObserverEntry {
+    explicit ObserverEntry(std::shared_ptr<AppEventObserver> observer);
+    bool VerifyEvent(const std::shared_ptr<AppEventPack>& event) const;
+
+    std::shared_ptr<AppEventObserver> observer;
+    int64_t seq = 0;
+    // filters compiled when the entry is built, the filters which never match any event are dropped
+    std::vector<HiAppEvent::AppEventFilter> filters;
+    bool isMatchAll = false;
+    bool hasTimeoutTrigger = false;
+    bool canDeliverFromMemory = false;
+};
+
+// immutable view of all the observers, rebuilt and published whenever the observers change
+struct ObserverSnapshot {
+    std::vector<ObserverEntry> entries;
+    bool hasTimeoutTrigger = false;
+    // the real-time filters of the processors by domain, to choose the write lane of an event without locks
+    std::unordered_map<std::string, std::vector<HiAppEvent::AppEventFilter>> realTimeFilters;
+};
+
 class AppEventObserverMgr : public NoCopyable {
 public:
     static AppEventObserverMgr& GetInstance();
@@ -59,15 +84,21 @@ public:
     void HandleClearUp();
     int SetReportConfig(int64_t observerSeq, const ReportConfig& config);
     int GetReportConfig(int64_t observerSeq, ReportConfig& config);
-    void SubmitTaskToFFRTQueue(std::function<void()>&& task, const std::string& taskName);
+    void SubmitTaskToFFRTQueue(std::function<void()>&& task, const std::string& taskName,
+        int qos = ffrt_qos_default);
+    // checks only the real-time event configs of the processors, to choose the write lane of an event
+    bool IsRealTimeEvent(std::shared_ptr<AppEventPack> event);
+    void GetObserverBacklogs(std::vector<PipelineMetrics::ObserverBacklog>& backlogs);
 
 private:
     AppEventObserverMgr();
     ~AppEventObserverMgr();
-    int64_t AddProcessorWithTimeLimited(const std::string& name, int64_t hashCode,
-        std::shared_ptr<AppEventProcessorProxy> processor);
+    int64_t BindProcessor(std::shared_ptr<AppEventProcessorProxy> processor, int64_t hashCode);
+    int64_t AddPendingProcessor(std::shared_ptr<AppEventProcessorProxy> processor, int64_t hashCode);
+    void BindPendingProcessor(int64_t pendingSeq, int64_t hashCode);
     void SendTimeoutTask();
     void SendRefreshFreeSizeTask();
+    void SendInitDbStoreTask();
     void RegisterAppStateCallback();
     void UnregisterAppStateCallback();
     bool InitWatcherFromListener(std::shared_ptr<AppEventWatcher> watcher, bool sendFlag);
@@ -76,9 +107,13 @@ private:
     void InitWatcherFromCache(std::shared_ptr<AppEventWatcher> watcher, bool& isExist);
     int64_t GetSeqFromWatchers(const std::string& name, std::string& filters);
     int64_t GetSeqFromProcessors(const std::string& name, int64_t hashCode);
-    std::vector<std::shared_ptr<AppEventObserver>> GetObservers();
+    int64_t GetBoundSeq(int64_t observerSeq);
+    std::shared_ptr<AppEventProcessorProxy> GetProcessor(int64_t observerSeq);
+    void PublishSnapshot();
     void DeleteWatcher(int64_t observerSeq);
     void DeleteProcessor(int64_t observerSeq);
+    bool DeletePendingProcessor(int64_t pendingSeq);
+    void DeletePendingProcessors(const std::string& name);
     bool IsExistInWatchers(int64_t observerSeq);
     bool IsExistInProcessors(int64_t observerSeq);
 
@@ -86,14 +121,20 @@ private:
     std::unique_ptr<ModuleLoader> moduleLoader_; // moduleLoader_ must declared before observers_, or lead to crash
     std::unordered_map<int64_t, std::shared_ptr<AppEventWatcher>> watchers_;
     std::unordered_map<int64_t, std::shared_ptr<AppEventProcessorProxy>> processors_;
+    // processors registered before the db is ready, key is the provisional seq returned to the caller
+    std::unordered_map<int64_t, std::shared_ptr<AppEventProcessorProxy>> pendingProcessors_;
+    // provisional seq -> seq of db, filled after the pending processor is bound
+    std::unordered_map<int64_t, int64_t> pendingSeqs_;
+    int64_t pendingSeqCnt_ = 0;
     std::shared_mutex watcherMutex_;
     std::shared_mutex processorMutex_;
+    SnapshotHolder<ObserverSnapshot> snapshots_;
+    std::mutex snapshotMutex_;
     std::shared_ptr<ffrt::queue> queue_ = nullptr;
     std::shared_ptr<AppStateCallback> appStateCallback_;
     std::shared_ptr<OsEventListener> listener_ = nullptr;
     bool isTimeoutTaskExist_ = false;
     std::mutex isTimeoutTaskExistMutex_;
-    std::atomic<bool> isFirstAddProcessor_ = true;
     std::atomic<bool> isDbInit_ = false;
     std::atomic<ffrt_timer_t> refreshTimer_ = ffrt_error;
     std::atomic<ffrt_timer_t> timeoutTimer_ = ffrt_error;
@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef HIAPPEVENT_FRAMEWORKS_NATIVE_LIB_HIAPPEVENT_OBSERVER_APP_EVENT_PREDICATE_H
+#define HIAPPEVENT_FRAMEWORKS_NATIVE_LIB_HIAPPEVENT_OBSERVER_APP_EVENT_PREDICATE_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace OHOS {
+namespace HiviewDFX {
+class AppEventPack;
+
+namespace HiAppEvent {
+/*
+ * Condition on the top-level params of an event, e.g. "foreground == true && (duration > 500 || tag == 'x')".
+ * The condition supports ==, !=, <, <=, >, >=, &&, ||, ! and parentheses; the literals are numbers, quoted
+ * strings, true and false; a bare param name is true when the param is present and not false, 0 or "".
+ * A comparison with an absent param or a value of another type is false, so is its != form.
+ * The condition is compiled once into postfix instructions and evaluated on the typed params of the event,
+ * or on the params json of the events from the os or the db, scanned only for the referenced params.
+ */
+class AppEventPredicate {
+public:
+    static std::shared_ptr<const AppEventPredicate> Compile(const std::string& condition);
+    bool Evaluate(const AppEventPack& event) const;
+    std::string ToString() const;
+
+public:
+    enum class OpCode : uint8_t {
+        TEST = 0, // push whether the param is present and truthy
+        EQ,
+        NE,
+        LT,
+        LE,
+        GT,
+        GE,
+        NOT,
+        AND,
+        OR,
+    };
+
+    enum class LiteralType : uint8_t {
+        NONE = 0,
+        BOOL,
+        NUMBER,
+        STRING,
+    };
+
+    struct Instruction {
+        OpCode op = OpCode::TEST;
+        LiteralType literalType = LiteralType::NONE;
+        bool boolValue = false;
+        double numValue = 0.0;
+        std::string strValue;
+        size_t paramIndex = 0;
+    };
+
+private:
+    class Compiler;
+
+    std::string condition_;
+    std::vector<std::string> paramNames_; // params referenced by the instructions
+    std::vector<Instruction> instructions_;
+};
+} // namespace HiAppEvent
+} // namespace HiviewDFX
+} // namespace OHOS
+#endif // HIAPPEVENT_FRAMEWORKS_NATIVE_LIB_HIAPPEVENT_OBSERVER_APP_EVENT_PREDICATE_H
@@ -30,8 +30,11 @@ public:
     ~AppEventProcessorProxy() = default;
 
     void OnEvents(const std::vector<std::shared_ptr<AppEventPack>>& events) override;
-    bool VerifyEvent(std::shared_ptr<AppEventPack> event) override;
+    bool CanDeliverFromMemory() override { return true; }
+    bool OnEventsFromMemory(const std::vector<std::shared_ptr<AppEventPack>>& events) override;
+    bool ValidateEvent(std::shared_ptr<AppEventPack> event) override;
     bool IsRealTimeEvent(std::shared_ptr<AppEventPack> event) override;
+    std::vector<AppEventFilter> GetRealTimeFilters();
     void OnTrigger(const TriggerCondition& triggerCond) override;
     ReportConfig GetReportConfig();
     void SetReportConfig(const ReportConfig& reportConfig);
@@ -39,9 +42,11 @@ public:
     int64_t GenerateHashCode();
 
 private:
+    int ReportEvents(const std::vector<std::shared_ptr<AppEventPack>>& events);
     void GetValidUserIds(std::vector<UserId>& userIds);
     void GetValidUserProperties(std::vector<UserProperty>& userProperties);
     void QueryEventsFromDb(std::vector<std::shared_ptr<AppEventPack>>& events);
+    void SetRealTimeFilters(const std::vector<AppEventFilter>& realTimeFilters);
 
 private:
     std::shared_ptr<AppEventProcessor> processor_;
@@ -50,6 +55,8 @@ private:
     std::vector<UserId> userIds_;
     std::vector<UserProperty> userProperties_;
     ReportConfig reportConfig_;
+    // compiled from the real-time event configs, with their conditions
+    std::vector<AppEventFilter> realTimeFilters_;
     int64_t hashCode_ = 0;
     std::mutex mutex_;
 };
@@ -29,6 +29,7 @@
 #include "hilog/log.h"
 #include "page_switch_log.h"
 #include "parameters.h"
+#include "pipeline_trace.h"
 #include "storage_acl.h"
 
 #undef LOG_DOMAIN
@@ -237,8 +238,10 @@ void OsEventListener::HandleDirEvent()
 
 void OsEventListener::HandleInotify(const std::string& file)
 {
+    PipelineTrace::ScopedTrace trace(PipelineTrace::HANDLE_INOTIFY);
     std::vector<std::shared_ptr<AppEventPack>> events;
     GetEventsFromFiles({file}, events);
+    PipelineTrace::Count(PipelineTrace::INOTIFY_EVENTS, static_cast<int64_t>(events.size()));
     AppEventObserverMgr::GetInstance().HandleEvents(events);
     (void)FileUtil::RemoveFile(file);
 }
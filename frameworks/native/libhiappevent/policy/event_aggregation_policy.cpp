@@ -0,0 +1,201 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "event_aggregation_policy.h"
+
+#include <atomic>
+#include <cinttypes>
+#include <cstdlib>
+#include <hilog/log.h>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <unordered_map>
+
+#include "hiappevent_base.h"
+#include "snapshot_holder.h"
+
+#undef LOG_DOMAIN
+#define LOG_DOMAIN 0xD002D07
+
+#undef LOG_TAG
+#define LOG_TAG "EventAggregationPolicy"
+
+namespace OHOS {
+namespace HiviewDFX {
+namespace {
+constexpr const char* const DOMAIN_KEY = "domain";
+constexpr const char* const NAME_KEY = "name";
+constexpr const char* const WINDOW_KEY = "window";
+constexpr const char* const KEYS_KEY = "keys";
+constexpr const char* const ALL_NAMES = "*";
+constexpr uint64_t MAX_WINDOW = 60 * 60 * 1000; // 1h
+constexpr size_t MAX_RULE_NUM = 100;
+constexpr size_t MAX_KEY_NUM = 8;
+constexpr int INVALID_PARAM = -1;
+
+// the rules are read by every write, so they are published as an immutable table which is read without a lock
+class AggregationRules {
+public:
+    static AggregationRules& GetInstance()
+    {
+        static AggregationRules instance;
+        return instance;
+    }
+
+    bool HasRules() const
+    {
+        return ruleNum_.load(std::memory_order_acquire) != 0;
+    }
+
+    bool GetRule(const std::string& domain, const std::string& name, AggregationRule& rule)
+    {
+        SnapshotReader<RuleTable> rules(rules_);
+        if (rules.Get() == nullptr) {
+            return false;
+        }
+        auto domainIt = rules->find(domain);
+        if (domainIt == rules->end()) {
+            return false;
+        }
+        auto ruleIt = domainIt->second.find(name);
+        if (ruleIt == domainIt->second.end()) {
+            ruleIt = domainIt->second.find(ALL_NAMES);
+            if (ruleIt == domainIt->second.end()) {
+                return false;
+            }
+        }
+        rule = ruleIt->second;
+        return true;
+    }
+
+    bool SetRule(const std::string& domain, const std::string& name, const AggregationRule& rule)
+    {
+        std::lock_guard<std::mutex> lockGuard(mutex_);
+        SnapshotReader<RuleTable> curRules(rules_);
+        auto rules = curRules.Get() == nullptr ? std::make_unique<RuleTable>() :
+            std::make_unique<RuleTable>(*(curRules.Get()));
+        auto& domainRules = (*rules)[domain];
+        if (rule.window == 0) {
+            domainRules.erase(name);
+            if (domainRules.empty()) {
+                rules->erase(domain);
+            }
+        } else {
+            if (ruleNum_.load(std::memory_order_relaxed) >= MAX_RULE_NUM && domainRules.count(name) == 0) {
+                return false;
+            }
+            domainRules[name] = rule;
+        }
+        Publish(std::move(rules));
+        return true;
+    }
+
+    void ClearRules()
+    {
+        std::lock_guard<std::mutex> lockGuard(mutex_);
+        Publish(std::make_unique<RuleTable>());
+    }
+
+private:
+    using RuleTable = std::unordered_map<std::string, std::unordered_map<std::string, AggregationRule>>;
+
+    void Publish(std::unique_ptr<RuleTable> rules)
+    {
+        size_t ruleNum = 0;
+        for (const auto& domainRules : *rules) {
+            ruleNum += domainRules.second.size();
+        }
+        rules_.Publish(ruleNum == 0 ? nullptr : std::move(rules));
+        ruleNum_.store(ruleNum, std::memory_order_release);
+    }
+
+private:
+    std::mutex mutex_; // serializes the updates of the rules
+    SnapshotHolder<RuleTable> rules_;
+    std::atomic<size_t> ruleNum_ = 0;
+};
+
+std::string GetConfigValue(const std::map<std::string, std::string>& configMap, const std::string& key)
+{
+    auto it = configMap.find(key);
+    return it == configMap.end() ? "" : it->second;
+}
+
+bool ParseWindow(const std::string& str, uint64_t& window)
+{
+    char* end = nullptr;
+    unsigned long long num = std::strtoull(str.c_str(), &end, 10); // 10: decimal
+    if (str.empty() || str[0] == '-' || end == nullptr || *end != '\0' || num > MAX_WINDOW) {
+        return false;
+    }
+    window = static_cast<uint64_t>(num);
+    return true;
+}
+
+bool ParseKeys(const std::string& str, std::vector<std::string>& keys)
+{
+    std::stringstream ss(str);
+    std::string key;
+    while (std::getline(ss, key, ',')) {
+        if (key.empty()) {
+            return false;
+        }
+        keys.emplace_back(key);
+    }
+    return keys.size() <= MAX_KEY_NUM;
+}
+}
+
+int EventAggregationPolicy::SetEventPolicy(const std::map<std::string, std::string>& configMap)
+{
+    std::string domain = GetConfigValue(configMap, DOMAIN_KEY);
+    std::string name = GetConfigValue(configMap, NAME_KEY);
+    AggregationRule rule;
+    if (domain.empty() || name.empty() || !ParseWindow(GetConfigValue(configMap, WINDOW_KEY), rule.window)
+        || !ParseKeys(GetConfigValue(configMap, KEYS_KEY), rule.keys)) {
+        HILOG_ERROR(LOG_CORE, "invalid aggregation policy of domain=%{public}s, name=%{public}s.",
+            domain.c_str(), name.c_str());
+        return ErrorCode::ERROR_INVALID_PARAM_VALUE;
+    }
+    if (!AggregationRules::GetInstance().SetRule(domain, name, rule)) {
+        HILOG_ERROR(LOG_CORE, "the number of aggregation rules exceeds the limit %{public}zu.", MAX_RULE_NUM);
+        return ErrorCode::ERROR_INVALID_PARAM_VALUE;
+    }
+    HILOG_INFO(LOG_CORE, "set aggregation policy of domain=%{public}s, name=%{public}s, window=%{public}" PRIu64 ".",
+        domain.c_str(), name.c_str(), rule.window);
+    return ErrorCode::HIAPPEVENT_VERIFY_SUCCESSFUL;
+}
+
+int EventAggregationPolicy::SetEventPolicy(const std::map<uint8_t, uint32_t>& configMap)
+{
+    return INVALID_PARAM;
+}
+
+bool EventAggregationPolicy::HasRules()
+{
+    return AggregationRules::GetInstance().HasRules();
+}
+
+bool EventAggregationPolicy::GetRule(const std::string& domain, const std::string& name, AggregationRule& rule)
+{
+    return AggregationRules::GetInstance().GetRule(domain, name, rule);
+}
+
+void EventAggregationPolicy::ClearRules()
+{
+    AggregationRules::GetInstance().ClearRules();
+}
+}  // HiviewDFX
+}  // OHOS
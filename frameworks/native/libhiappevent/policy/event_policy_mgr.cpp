@@ -22,6 +22,7 @@
 #include "app_crash_policy.h"
 #include "app_freeze_policy.h"
 #include "cpu_usage_high_policy.h"
+#include "event_aggregation_policy.h"
 #include "main_thread_jank_policy.h"
 #include "resource_overlimit_policy.h"
 
@@ -46,6 +47,7 @@ void EventPolicyMgr::InitializePolicies()
     RegisterPolicy("APP_CRASH", std::make_shared<AppCrashPolicy>());
     RegisterPolicy("appFreezePolicy", std::make_shared<AppFreezePolicy>());
     RegisterPolicy("cpuUsageHighPolicy", std::make_shared<CpuUsageHighPolicy>());
+    RegisterPolicy("eventAggregationPolicy", std::make_shared<EventAggregationPolicy>());
     RegisterPolicy("MAIN_THREAD_JANK", std::make_shared<MainThreadJankConfig>());
     RegisterPolicy("MAIN_THREAD_JANK_V2", std::make_shared<MainThreadJankPolicy>());
     RegisterPolicy("mainThreadJankPolicy", std::make_shared<MainThreadJankPolicy>());
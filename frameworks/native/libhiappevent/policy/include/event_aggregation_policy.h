@@ -0,0 +1,50 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef HIAPPEVENT_FRAMEWORKS_NATIVE_LIB_HIAPPEVENT_POLICY_EVENT_AGGREGATION_POLICY_H
+#define HIAPPEVENT_FRAMEWORKS_NATIVE_LIB_HIAPPEVENT_POLICY_EVENT_AGGREGATION_POLICY_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "event_policy_base.h"
+
+namespace OHOS {
+namespace HiviewDFX {
+struct AggregationRule {
+    uint64_t window = 0; // ms
+    std::vector<std::string> keys; // names of the params in the aggregation key, all the params if empty
+};
+
+/*
+ * Configures the rollup of the identical events written within a window, e.g.
+ * {"domain": "com_demo", "name": "click", "window": "1000", "keys": "page,button"}.
+ * The name "*" matches all the events of the domain, and the window "0" removes the rule.
+ */
+class EventAggregationPolicy : public EventPolicyBase {
+public:
+    EventAggregationPolicy() = default;
+    ~EventAggregationPolicy() override = default;
+
+    int SetEventPolicy(const std::map<std::string, std::string>& configMap) override;
+    int SetEventPolicy(const std::map<uint8_t, uint32_t> &configMap) override;
+
+    static bool HasRules();
+    static bool GetRule(const std::string& domain, const std::string& name, AggregationRule& rule);
+    static void ClearRules();
+};
+}  // HiviewDFX
+}  // OHOS
+#endif  // HIAPPEVENT_FRAMEWORKS_NATIVE_LIB_HIAPPEVENT_POLICY_EVENT_AGGREGATION_POLICY_H
@@ -0,0 +1,143 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "api_latency_sketch.h"
+
+#include <cmath>
+
+namespace OHOS {
+namespace HiviewDFX {
+namespace HiAppEvent {
+namespace {
+const double GAMMA = (1 + ApiLatencySketch::RELATIVE_ACCURACY) / (1 - ApiLatencySketch::RELATIVE_ACCURACY);
+const double LOG_GAMMA = std::log(GAMMA);
+constexpr int MAX_BUCKET_INDEX = 4096;
+
+int GetBucketIndex(int64_t value)
+{
+    return static_cast<int>(std::ceil(std::log(static_cast<double>(value)) / LOG_GAMMA));
+}
+
+int64_t GetBucketValue(int index)
+{
+    // the middle of the bucket (gamma^(i-1), gamma^i] in the sense of relative error
+    return static_cast<int64_t>(std::llround(2 * std::pow(GAMMA, index) / (GAMMA + 1))); // 2: double of the mid
+}
+}
+
+void ApiLatencySketch::Add(int64_t value)
+{
+    if (value < 0) {
+        return;
+    }
+    count_++;
+    if (value == 0) {
+        zeroCount_++;
+        return;
+    }
+    AddToBucket(GetBucketIndex(value), 1);
+}
+
+void ApiLatencySketch::Merge(const ApiLatencySketch& other)
+{
+    count_ += other.count_;
+    zeroCount_ += other.zeroCount_;
+    for (const auto& [index, count] : other.buckets_) {
+        AddToBucket(index, count);
+    }
+}
+
+int64_t ApiLatencySketch::Quantile(double quantile) const
+{
+    if (count_ <= 0 || quantile < 0 || quantile > 1) {
+        return 0;
+    }
+    int64_t rank = static_cast<int64_t>(quantile * (count_ - 1));
+    if (rank < zeroCount_) {
+        return 0;
+    }
+    int64_t accumulated = zeroCount_;
+    for (const auto& [index, count] : buckets_) {
+        accumulated += count;
+        if (accumulated > rank) {
+            return GetBucketValue(index);
+        }
+    }
+    return buckets_.empty() ? 0 : GetBucketValue(buckets_.rbegin()->first);
+}
+
+int64_t ApiLatencySketch::Count() const
+{
+    return count_;
+}
+
+bool ApiLatencySketch::IsEmpty() const
+{
+    return count_ == 0;
+}
+
+std::vector<int64_t> ApiLatencySketch::Encode() const
+{
+    std::vector<int64_t> values;
+    values.reserve(1 + buckets_.size() * 2); // 2: index and count of each bucket
+    values.emplace_back(zeroCount_);
+    for (const auto& [index, count] : buckets_) {
+        values.emplace_back(index);
+        values.emplace_back(count);
+    }
+    return values;
+}
+
+bool ApiLatencySketch::Decode(const std::vector<int64_t>& values)
+{
+    // 2: index and count of each bucket
+    if (values.empty() || values[0] < 0 || values.size() % 2 != 1) {
+        return false;
+    }
+    ApiLatencySketch sketch;
+    sketch.zeroCount_ = values[0];
+    sketch.count_ = values[0];
+    for (size_t i = 1; i + 1 < values.size(); i += 2) { // 2: index and count of each bucket
+        if (values[i] < 0 || values[i] > MAX_BUCKET_INDEX || values[i + 1] <= 0) {
+            return false;
+        }
+        sketch.count_ += values[i + 1];
+        sketch.AddToBucket(static_cast<int>(values[i]), values[i + 1]);
+    }
+    *this = std::move(sketch);
+    return true;
+}
+
+void ApiLatencySketch::AddToBucket(int index, int64_t count)
+{
+    buckets_[index] += count;
+    if (buckets_.size() > MAX_BUCKET_NUM) {
+        CollapseLowestBuckets();
+    }
+}
+
+void ApiLatencySketch::CollapseLowestBuckets()
+{
+    while (buckets_.size() > MAX_BUCKET_NUM) {
+        auto lowest = buckets_.begin();
+        int64_t count = lowest->second;
+        lowest = buckets_.erase(lowest);
+        lowest->second += count;
+    }
+}
+
+} // namespace HiAppEvent
+} // namespace HiviewDFX
+} // namespace OHOS
@@ -15,9 +15,10 @@
 
 #include "api_stats_aggregator.h"
 #include "hilog/log.h"
+#include "shard_util.h"
 #include "time_util.h"
 
-#include <limits>
+#include <algorithm>
 
 #undef LOG_DOMAIN
 #define LOG_DOMAIN 0xD002D07
@@ -28,51 +29,114 @@
 namespace OHOS {
 namespace HiviewDFX {
 namespace HiAppEvent {
+namespace {
+constexpr double P50 = 0.5;
+constexpr double P90 = 0.9;
+constexpr double P99 = 0.99;
 
-void ApiStatsAggregator::Record(ApiDescriptor descriptor, ApiMetric metric)
+int64_t GetCostTimeQuantile(const ApiStats& stats, double quantile)
 {
-    HILOG_DEBUG(LOG_CORE, "Record: kitName=%{public}s, apiName=%{public}s",
-        descriptor.KitName().c_str(), descriptor.ApiName().c_str());
-    apiMetricsMap_[descriptor].emplace_back(metric);
-    MarkAsUpdated();
+    if (stats.costTimeSketch.IsEmpty()) {
+        return 0;
+    }
+    return std::clamp(stats.costTimeSketch.Quantile(quantile), stats.minCostTime, stats.maxCostTime);
+}
 }
 
-void ApiStatsAggregator::ClearRecord()
+ApiStatsAggregator::Shard& ApiStatsAggregator::GetShard()
 {
-    HILOG_DEBUG(LOG_CORE, "ClearRecord");
-    apiMetricsMap_.clear();
-    MarkAsBackuped();
+    return shards_[ShardUtil::GetThreadShardIndex(SHARD_NUM)];
 }
 
-void ApiStatsAggregator::MarkAsUpdated()
+void ApiStatsAggregator::Record(const ApiDescriptor& descriptor, const ApiMetric& metric)
 {
-    updatedAfterLastBackup_ = true;
+    Shard& shard = GetShard();
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    shard.apiStats[descriptor].Add(metric);
+    shard.updatedAfterLastBackup = true;
+}
+
+void ApiStatsAggregator::ClearRecord()
+{
+    HILOG_DEBUG(LOG_CORE, "ClearRecord");
+    for (auto& shard : shards_) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        shard.apiStats.clear();
+        shard.updatedAfterLastBackup = false;
+    }
 }
 
 void ApiStatsAggregator::MarkAsBackuped()
 {
-    updatedAfterLastBackup_ = false;
+    for (auto& shard : shards_) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        shard.updatedAfterLastBackup = false;
+    }
 }
 
 bool ApiStatsAggregator::IsUpdatedAfterLastBackup()
 {
-    return updatedAfterLastBackup_;
+    for (auto& shard : shards_) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        if (shard.updatedAfterLastBackup) {
+            return true;
+        }
+    }
+    return false;
 }
 
-ApiMetricsMap ApiStatsAggregator::GetApiMetrics() const
+ApiStatsMap ApiStatsAggregator::GetApiStats() const
 {
-    return apiMetricsMap_;
+    ApiStatsMap apiStats;
+    for (const auto& shard : shards_) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        for (const auto& [descriptor, stats] : shard.apiStats) {
+            apiStats[descriptor].Merge(stats);
+        }
+    }
+    return apiStats;
 }
 
-std::vector<ApiStatsReport> ApiStatsAggregator::AggregateStats(const ApiMetricsMap& apiMetrics)
+ApiStatsMap ApiStatsAggregator::TakeApiStats()
 {
-    HILOG_DEBUG(LOG_CORE, "AggregateStats: input count=%{public}zu", apiMetrics.size());
+    ApiStatsMap apiStats;
+    for (auto& shard : shards_) {
+        std::unordered_map<ApiDescriptor, ApiStats, ApiDescriptor::ApiDescriptorHasher> shardStats;
+        {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            shardStats.swap(shard.apiStats);
+            shard.updatedAfterLastBackup = false;
+        }
+        for (const auto& [descriptor, stats] : shardStats) {
+            apiStats[descriptor].Merge(stats);
+        }
+    }
+    HILOG_DEBUG(LOG_CORE, "TakeApiStats: count=%{public}zu", apiStats.size());
+    return apiStats;
+}
+
+void ApiStatsAggregator::RestoreApiStats(const ApiStatsMap& apiStats)
+{
+    HILOG_DEBUG(LOG_CORE, "RestoreApiStats: count=%{public}zu", apiStats.size());
+    Shard& shard = GetShard();
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    for (const auto& [descriptor, stats] : apiStats) {
+        shard.apiStats[descriptor].Merge(stats);
+    }
+    if (!apiStats.empty()) {
+        shard.updatedAfterLastBackup = true;
+    }
+}
+
+std::vector<ApiStatsReport> ApiStatsAggregator::AggregateStats(const ApiStatsMap& apiStats)
+{
+    HILOG_DEBUG(LOG_CORE, "AggregateStats: input count=%{public}zu", apiStats.size());
     static int64_t SIXTY_SECONDS_MS = 60 * 1000;
     int64_t beginTime = TimeUtil::GetMilliSecondsTimestamp(CLOCK_REALTIME) - SIXTY_SECONDS_MS;
     std::vector<ApiStatsReport> reports;
     
-    for (const auto& [descriptor, metrics] : apiMetrics) {
-        if (metrics.empty()) {
+    for (const auto& [descriptor, stats] : apiStats) {
+        if (stats.callTimes <= 0) {
             continue;
         }
         
@@ -80,28 +144,15 @@ std::vector<ApiStatsReport> ApiStatsAggregator::AggregateStats(const ApiMetricsM
         report.kitName = descriptor.KitName();
         report.apiName = descriptor.ApiName();
         report.beginTime = beginTime;
-        report.callTimes = static_cast<int>(metrics.size());
-        report.successTimes = 0;
-        report.maxCostTime = 0;
-        report.minCostTime = std::numeric_limits<int64_t>::max();
-        report.totalCostTime = 0;
-        std::map<int, int> errorCodeMap;
-        
-        for (const auto& metric : metrics) {
-            if (metric.successful) {
-                report.successTimes++;
-            }
-            report.totalCostTime += metric.duration;
-            if (metric.duration > report.maxCostTime) {
-                report.maxCostTime = metric.duration;
-            }
-            if (metric.duration < report.minCostTime) {
-                report.minCostTime = metric.duration;
-            }
-            errorCodeMap[metric.errCode]++;
-        }
-        
-        for (const auto& [errCode, count] : errorCodeMap) {
+        report.callTimes = stats.callTimes;
+        report.successTimes = stats.successTimes;
+        report.maxCostTime = stats.maxCostTime;
+        report.minCostTime = stats.minCostTime;
+        report.totalCostTime = stats.totalCostTime;
+        report.p50CostTime = GetCostTimeQuantile(stats, P50);
+        report.p90CostTime = GetCostTimeQuantile(stats, P90);
+        report.p99CostTime = GetCostTimeQuantile(stats, P99);
+        for (const auto& [errCode, count] : stats.errorCodeNums) {
             report.errorCodeTypes.push_back(std::to_string(errCode));
             report.errorCodeNum.push_back(count);
         }
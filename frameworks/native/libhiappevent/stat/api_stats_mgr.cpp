@@ -48,11 +48,8 @@ ApiStatsManager::~ApiStatsManager()
     timer_.Stop();
 }
 
-void ApiStatsManager::AddRecord(ApiDescriptor descriptor, ApiMetric metric)
+void ApiStatsManager::AddRecord(const ApiDescriptor& descriptor, const ApiMetric& metric)
 {
-    HILOG_DEBUG(LOG_CORE, "AddRecord: kitName=%{public}s, apiName=%{public}s",
-        descriptor.KitName().c_str(), descriptor.ApiName().c_str());
-    std::lock_guard<std::mutex> lock(mut_);
     aggregator_.Record(descriptor, metric);
 }
 
@@ -63,13 +60,13 @@ void ApiStatsManager::ScheduleBackUpInner()
         return;
     }
 
-    auto apiMetrics = aggregator_.GetApiMetrics();
-    HILOG_INFO(LOG_CORE, "ScheduleBackUpInner: backup count=%{public}zu", apiMetrics.size());
-    if (ApiStatsStorage::GetInstance().Backup(apiMetrics) == 0) {
-        aggregator_.ClearRecord();
+    auto apiStats = aggregator_.TakeApiStats();
+    HILOG_INFO(LOG_CORE, "ScheduleBackUpInner: backup count=%{public}zu", apiStats.size());
+    if (ApiStatsStorage::GetInstance().Backup(apiStats) == 0) {
         HILOG_DEBUG(LOG_CORE, "ScheduleBackUpInner success");
     } else {
         HILOG_ERROR(LOG_CORE, "ScheduleBackUpInner failed to backup api stats");
+        aggregator_.RestoreApiStats(apiStats);
     }
 }
 
@@ -86,14 +83,14 @@ void ApiStatsManager::ScheduleReport()
     std::lock_guard<std::mutex> lock(mut_);
     ApiStatsManager::ScheduleBackUpInner();
     
-    ApiMetricsMap apiMetrics;
-    if (ApiStatsStorage::GetInstance().QueryAll(apiMetrics) != 0) {
+    ApiStatsMap apiStats;
+    if (ApiStatsStorage::GetInstance().QueryAll(apiStats) != 0) {
         HILOG_ERROR(LOG_CORE, "failed to query api stats for report");
         return;
     }
     
-    HILOG_DEBUG(LOG_CORE, "ScheduleReport: query count=%{public}zu", apiMetrics.size());
-    auto reports = ApiStatsAggregator::AggregateStats(apiMetrics);
+    HILOG_DEBUG(LOG_CORE, "ScheduleReport: query count=%{public}zu", apiStats.size());
+    auto reports = ApiStatsAggregator::AggregateStats(apiStats);
     
     ReportStats(reports);
     
@@ -117,6 +114,9 @@ std::shared_ptr<AppEventPack> ApiStatsManager::ConvertReportToEventPack(const Ap
     appEventPack->AddParam("max_cost_time", report.maxCostTime);
     appEventPack->AddParam("min_cost_time", report.minCostTime);
     appEventPack->AddParam("total_cost_time", report.totalCostTime);
+    appEventPack->AddParam("p50_cost_time", report.p50CostTime);
+    appEventPack->AddParam("p90_cost_time", report.p90CostTime);
+    appEventPack->AddParam("p99_cost_time", report.p99CostTime);
     appEventPack->AddParam("error_code_types", report.errorCodeTypes);
     appEventPack->AddParam("error_code_num", report.errorCodeNum);
 
@@ -137,9 +137,11 @@ void ApiStatsManager::ReportStats(const std::vector<ApiStatsReport>& reports)
         SubmitWritingTask(eventPack, "api_stats_report");
         HILOG_INFO(LOG_CORE, "report api stats: kitName=%{public}s, apiName=%{public}s, callTimes=%{public}d, "
             "successTimes=%{public}d, maxCostTime=%{public}" PRId64 ", minCostTime=%{public}" PRId64 ", "
-            "totalCostTime=%{public}" PRId64 ", errorCodeCount=%{public}zu",
+            "totalCostTime=%{public}" PRId64 ", p50CostTime=%{public}" PRId64 ", p90CostTime=%{public}" PRId64 ", "
+            "p99CostTime=%{public}" PRId64 ", errorCodeCount=%{public}zu",
             report.kitName.c_str(), report.apiName.c_str(), report.callTimes, report.successTimes,
-            report.maxCostTime, report.minCostTime, report.totalCostTime, report.errorCodeTypes.size());
+            report.maxCostTime, report.minCostTime, report.totalCostTime, report.p50CostTime, report.p90CostTime,
+            report.p99CostTime, report.errorCodeTypes.size());
     }
     
     HILOG_INFO(LOG_CORE, "report api stats success");
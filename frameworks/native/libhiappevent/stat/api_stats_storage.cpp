@@ -34,6 +34,92 @@ namespace HiAppEvent {
 namespace {
 constexpr int DB_FAILED = -1;
 constexpr int DB_SUCC = 0;
+const std::string KEY_CALL_TIMES = "callTimes";
+const std::string KEY_SUCCESS_TIMES = "successTimes";
+const std::string KEY_MAX_COST_TIME = "maxCostTime";
+const std::string KEY_MIN_COST_TIME = "minCostTime";
+const std::string KEY_TOTAL_COST_TIME = "totalCostTime";
+const std::string KEY_ERROR_CODES = "errorCodes";
+const std::string KEY_COST_TIME_SKETCH = "costTimeSketch";
+
+std::string StatsToJson(const ApiStats& stats)
+{
+    Json::Value statsObj(Json::objectValue);
+    statsObj[KEY_CALL_TIMES] = stats.callTimes;
+    statsObj[KEY_SUCCESS_TIMES] = stats.successTimes;
+    statsObj[KEY_MAX_COST_TIME] = static_cast<Json::Int64>(stats.maxCostTime);
+    statsObj[KEY_MIN_COST_TIME] = static_cast<Json::Int64>(stats.minCostTime);
+    statsObj[KEY_TOTAL_COST_TIME] = static_cast<Json::Int64>(stats.totalCostTime);
+    Json::Value errCodesObj(Json::arrayValue);
+    for (const auto& [errCode, num] : stats.errorCodeNums) {
+        Json::Value errCodeObj(Json::arrayValue);
+        errCodeObj.append(errCode);
+        errCodeObj.append(num);
+        errCodesObj.append(errCodeObj);
+    }
+    statsObj[KEY_ERROR_CODES] = errCodesObj;
+    Json::Value sketchObj(Json::arrayValue);
+    for (auto value : stats.costTimeSketch.Encode()) {
+        sketchObj.append(static_cast<Json::Int64>(value));
+    }
+    statsObj[KEY_COST_TIME_SKETCH] = sketchObj;
+    return Json::FastWriter().write(statsObj);
+}
+
+bool ParseStats(const Json::Value& jsonValue, ApiStats& stats)
+{
+    if (!jsonValue[KEY_CALL_TIMES].isInt() || !jsonValue[KEY_SUCCESS_TIMES].isInt()
+        || !jsonValue[KEY_MAX_COST_TIME].isInt64() || !jsonValue[KEY_MIN_COST_TIME].isInt64()
+        || !jsonValue[KEY_TOTAL_COST_TIME].isInt64() || !jsonValue[KEY_ERROR_CODES].isArray()) {
+        return false;
+    }
+    stats.callTimes = jsonValue[KEY_CALL_TIMES].asInt();
+    stats.successTimes = jsonValue[KEY_SUCCESS_TIMES].asInt();
+    stats.maxCostTime = jsonValue[KEY_MAX_COST_TIME].asInt64();
+    stats.minCostTime = jsonValue[KEY_MIN_COST_TIME].asInt64();
+    stats.totalCostTime = jsonValue[KEY_TOTAL_COST_TIME].asInt64();
+    if (stats.callTimes <= 0 || stats.successTimes < 0 || stats.successTimes > stats.callTimes
+        || stats.minCostTime < 0 || stats.maxCostTime < stats.minCostTime || stats.totalCostTime < 0) {
+        return false;
+    }
+    for (const auto& errCodeObj : jsonValue[KEY_ERROR_CODES]) {
+        if (!errCodeObj.isArray() || errCodeObj.size() != 2 || !errCodeObj[0].isInt() || !errCodeObj[1].isInt()) {
+            return false;
+        }
+        stats.errorCodeNums[errCodeObj[0].asInt()] += errCodeObj[1].asInt();
+    }
+    // the sketch is optional, stats without it are still counted but have no cost time quantiles
+    if (!jsonValue.isMember(KEY_COST_TIME_SKETCH)) {
+        return true;
+    }
+    const auto& sketchObj = jsonValue[KEY_COST_TIME_SKETCH];
+    if (!sketchObj.isArray()) {
+        return false;
+    }
+    std::vector<int64_t> sketchValues;
+    sketchValues.reserve(sketchObj.size());
+    for (const auto& value : sketchObj) {
+        if (!value.isInt64()) {
+            return false;
+        }
+        sketchValues.emplace_back(value.asInt64());
+    }
+    return stats.costTimeSketch.Decode(sketchValues);
+}
+
+// rows backed up by the older version hold a single metric each
+bool ParseMetric(const Json::Value& jsonValue, ApiStats& stats)
+{
+    if (!jsonValue["errCode"].isInt() || !jsonValue["duration"].isInt() || !jsonValue["successful"].isBool()) {
+        return false;
+    }
+    ApiMetric metric{jsonValue["errCode"].asInt(), jsonValue["duration"].asInt(), jsonValue["successful"].asBool()};
+    if (metric.duration < 0) {
+        return false;
+    }
+    stats.Add(metric);
+    return true;
+}
 }
 
 ApiStatsStorage::ApiStatsStorage()
@@ -50,48 +136,41 @@ ApiStatsStorage& ApiStatsStorage::GetInstance()
     return instance;
 }
 
-int ApiStatsStorage::Backup(const ApiMetricsMap& apiMetrics)
+int ApiStatsStorage::Backup(const ApiStatsMap& apiStats)
 {
-    HILOG_DEBUG(LOG_CORE, "Backup start: input count=%{public}zu", apiMetrics.size());
-    if (apiMetrics.empty()) {
-        HILOG_DEBUG(LOG_CORE, "api metrics map is empty, nothing to backup");
+    HILOG_DEBUG(LOG_CORE, "Backup start: input count=%{public}zu", apiStats.size());
+    if (apiStats.empty()) {
+        HILOG_DEBUG(LOG_CORE, "api stats map is empty, nothing to backup");
         return DB_SUCC;
     }
 
     auto& appEventStore = AppEventStore::GetInstance();
-    for (const auto& [descriptor, metrics] : apiMetrics) {
+    for (const auto& [descriptor, stats] : apiStats) {
         std::string kitName = descriptor.KitName();
         std::string apiName = descriptor.ApiName();
 
-        HILOG_DEBUG(LOG_CORE, "Backup: kitName=%{public}s, apiName=%{public}s, metrics=%{public}zu",
-            kitName.c_str(), apiName.c_str(), metrics.size());
-
-        for (const auto& metric : metrics) {
-            Json::Value metricObj(Json::objectValue);
-            metricObj["errCode"] = metric.errCode;
-            metricObj["duration"] = metric.duration;
-            metricObj["successful"] = metric.successful;
-            std::string metricJson = Json::FastWriter().write(metricObj);
-
-            int ret = appEventStore.InsertApiMetricInfo(kitName, apiName, metricJson);
-            HILOG_DEBUG(LOG_CORE, "insert metric, kitName=%{public}s, apiName=%{public}s, ret=%{public}d",
-                kitName.c_str(), apiName.c_str(), ret);
-            if (ret != NativeRdb::E_OK) {
-                HILOG_ERROR(LOG_CORE, "failed to backup api metric, kitName=%{public}s, apiName=%{public}s, \
-                    ret=%{public}d", kitName.c_str(), apiName.c_str(), ret);
-                return DB_FAILED;
-            }
+        HILOG_DEBUG(LOG_CORE, "Backup: kitName=%{public}s, apiName=%{public}s, callTimes=%{public}d",
+            kitName.c_str(), apiName.c_str(), stats.callTimes);
+        if (stats.callTimes <= 0) {
+            continue;
+        }
+
+        int ret = appEventStore.InsertApiMetricInfo(kitName, apiName, StatsToJson(stats));
+        if (ret != NativeRdb::E_OK) {
+            HILOG_ERROR(LOG_CORE, "failed to backup api stats, kitName=%{public}s, apiName=%{public}s, "
+                "ret=%{public}d", kitName.c_str(), apiName.c_str(), ret);
+            return DB_FAILED;
         }
     }
-    HILOG_INFO(LOG_CORE, "backup api stats success, count=%{public}zu", apiMetrics.size());
+    HILOG_INFO(LOG_CORE, "backup api stats success, count=%{public}zu", apiStats.size());
     return DB_SUCC;
 }
 
-int ApiStatsStorage::QueryAll(ApiMetricsMap& apiMetrics)
+int ApiStatsStorage::QueryAll(ApiStatsMap& apiStats)
 {
     HILOG_DEBUG(LOG_CORE, "QueryAll start");
     auto& appEventStore = AppEventStore::GetInstance();
-    apiMetrics.clear();
+    apiStats.clear();
 
     std::map<std::pair<std::string, std::string>, std::vector<std::string>> results;
     int ret = appEventStore.QueryApiMetricInfoAll(results);
@@ -101,39 +180,34 @@ int ApiStatsStorage::QueryAll(ApiMetricsMap& apiMetrics)
     }
 
     HILOG_DEBUG(LOG_CORE, "QueryAll: db result count=%{public}zu", results.size());
-    for (const auto& [key, metricJsons] : results) {
+    for (const auto& [key, statsJsons] : results) {
         const auto& [kitName, apiName] = key;
-        std::vector<ApiMetric> metrics;
-        for (const auto& metricJson : metricJsons) {
+        ApiStats mergedStats;
+        for (const auto& statsJson : statsJsons) {
             Json::Value jsonValue;
             Json::Reader reader(Json::Features::strictMode());
-            if (!reader.parse(metricJson, jsonValue)) {
-                HILOG_WARN(LOG_CORE, "failed to parse metric json, kitName=%{public}s, apiName=%{public}s",
+            if (!reader.parse(statsJson, jsonValue) || !jsonValue.isObject()) {
+                HILOG_WARN(LOG_CORE, "failed to parse stats json, kitName=%{public}s, apiName=%{public}s",
                     kitName.c_str(), apiName.c_str());
                 continue;
             }
-            if (!jsonValue["errCode"].isInt() || !jsonValue["duration"].isInt() || !jsonValue["successful"].isBool()) {
-                HILOG_ERROR(LOG_CORE, "query all failed to parse json");
-                continue;
-            }
-            int errCode = jsonValue["errCode"].asInt();
-            int duration = jsonValue["duration"].asInt();
-            bool successful = jsonValue["successful"].asBool();
-            if (duration < 0) {
-                HILOG_ERROR(LOG_CORE, "query all, duration param error");
+            ApiStats stats;
+            if (!ParseStats(jsonValue, stats) && !ParseMetric(jsonValue, stats)) {
+                HILOG_ERROR(LOG_CORE, "query all, invalid stats, kitName=%{public}s, apiName=%{public}s",
+                    kitName.c_str(), apiName.c_str());
                 continue;
             }
-            HILOG_DEBUG(LOG_CORE, "parse metric, kitName=%{public}s, apiName=%{public}s, errCode=%{public}d, \
-                duration=%{public}d, successful=%{public}d",
-                kitName.c_str(), apiName.c_str(), errCode, duration, successful);
-            metrics.emplace_back(ApiMetric{errCode, duration, successful});
+            mergedStats.Merge(stats);
+        }
+        if (mergedStats.callTimes <= 0) {
+            continue;
         }
 
         ApiDescriptor descriptor(kitName, apiName);
-        apiMetrics[descriptor] = std::move(metrics);
+        apiStats.emplace(descriptor, std::move(mergedStats));
     }
 
-    HILOG_INFO(LOG_CORE, "query all api stats success, count=%{public}zu", apiMetrics.size());
+    HILOG_INFO(LOG_CORE, "query all api stats success, count=%{public}zu", apiStats.size());
     return DB_SUCC;
 }
 
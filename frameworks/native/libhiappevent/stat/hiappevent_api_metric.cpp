@@ -38,14 +38,10 @@ ApiMetricProcessor& ApiMetricProcessor::GetInstance()
 
 int ApiMetricProcessor::ProcessApiMetric(const HiAppEvent::ApiInfo& apiInfo, const HiAppEvent::ApiMetric& metric)
 {
-    HILOG_DEBUG(LOG_CORE, "ProcessApiMetric: kitName=%{public}s, apiName=%{public}s",
-        apiInfo.kit.c_str(), apiInfo.api.c_str());
-
     if (metric.duration < 0 || apiInfo.kit.empty() || apiInfo.api.empty()) {
         return ErrorCode::ERROR_INVALID_PARAM_VALUE;
     }
-    ApiDescriptor descriptor(apiInfo.kit, apiInfo.api);
-    apiStatsMgr_.AddRecord(descriptor, metric);
+    apiStatsMgr_.AddRecord(ApiDescriptor(apiInfo.kit, apiInfo.api), metric);
     return ErrorCode::HIAPPEVENT_VERIFY_SUCCESSFUL;
 }
 
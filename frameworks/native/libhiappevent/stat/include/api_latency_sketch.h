@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef HIAPPEVENT_FRAMEWORKS_NATIVE_LIB_HIAPPEVENT_STAT_INCLUDE_API_LATENCY_SKETCH_H
+#define HIAPPEVENT_FRAMEWORKS_NATIVE_LIB_HIAPPEVENT_STAT_INCLUDE_API_LATENCY_SKETCH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <vector>
+
+namespace OHOS {
+namespace HiviewDFX {
+namespace HiAppEvent {
+
+/*
+ * Mergeable quantile sketch of api cost times. Values are counted in logarithmic buckets, so every quantile
+ * is estimated within RELATIVE_ACCURACY of the real value. When more than MAX_BUCKET_NUM buckets are used the
+ * lowest buckets are collapsed, which keeps the size fixed and preserves the accuracy of the high quantiles.
+ */
+class ApiLatencySketch {
+public:
+    static constexpr double RELATIVE_ACCURACY = 0.02;
+    static constexpr size_t MAX_BUCKET_NUM = 256;
+
+    void Add(int64_t value);
+    void Merge(const ApiLatencySketch& other);
+    int64_t Quantile(double quantile) const;
+    int64_t Count() const;
+    bool IsEmpty() const;
+
+    // encoded as [zeroCount, index1, count1, index2, count2, ...]
+    std::vector<int64_t> Encode() const;
+    bool Decode(const std::vector<int64_t>& values);
+
+private:
+    void AddToBucket(int index, int64_t count);
+    void CollapseLowestBuckets();
+
+    int64_t zeroCount_ = 0;
+    int64_t count_ = 0;
+    std::map<int, int64_t> buckets_;
+};
+
+} // namespace HiAppEvent
+} // namespace HiviewDFX
+} // namespace OHOS
+
+#endif // HIAPPEVENT_FRAMEWORKS_NATIVE_LIB_HIAPPEVENT_STAT_INCLUDE_API_LATENCY_SKETCH_H
@@ -16,7 +16,10 @@
 #ifndef HIAPPEVENT_FRAMEWORKS_NATIVE_LIB_HIAPPEVENT_STAT_INCLUDE_API_STATS_AGGREGATOR_H
 #define HIAPPEVENT_FRAMEWORKS_NATIVE_LIB_HIAPPEVENT_STAT_INCLUDE_API_STATS_AGGREGATOR_H
 
+#include <array>
+#include <mutex>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "api_stats_types.h"
@@ -34,24 +37,41 @@ struct ApiStatsReport {
     int64_t maxCostTime;
     int64_t minCostTime;
     int64_t totalCostTime;
+    int64_t p50CostTime;
+    int64_t p90CostTime;
+    int64_t p99CostTime;
     std::vector<std::string> errorCodeTypes;
     std::vector<int> errorCodeNum;
 };
 
+/*
+ * Records api metrics into a fixed number of shards. Every thread is bound to one shard on its first record,
+ * so concurrent callers rarely share a lock, and the shards are only merged when the stats are backed up.
+ */
 class ApiStatsAggregator {
 public:
-    void Record(ApiDescriptor descriptor, ApiMetric metric);
+    void Record(const ApiDescriptor& descriptor, const ApiMetric& metric);
     void ClearRecord();
     void MarkAsBackuped();
     bool IsUpdatedAfterLastBackup();
-    ApiMetricsMap GetApiMetrics() const;
-    static std::vector<ApiStatsReport> AggregateStats(const ApiMetricsMap& apiMetrics);
- 
+    ApiStatsMap GetApiStats() const;
+    ApiStatsMap TakeApiStats();
+    void RestoreApiStats(const ApiStatsMap& apiStats);
+    static std::vector<ApiStatsReport> AggregateStats(const ApiStatsMap& apiStats);
+
 private:
-    ApiMetricsMap apiMetricsMap_;
-    bool updatedAfterLastBackup_ = false;
- 
-    void MarkAsUpdated();
+    static constexpr size_t SHARD_NUM = 16;
+    static constexpr size_t CACHE_LINE_SIZE = 64;
+
+    struct alignas(CACHE_LINE_SIZE) Shard {
+        mutable std::mutex mutex;
+        std::unordered_map<ApiDescriptor, ApiStats, ApiDescriptor::ApiDescriptorHasher> apiStats;
+        bool updatedAfterLastBackup = false;
+    };
+
+    Shard& GetShard();
+
+    std::array<Shard, SHARD_NUM> shards_;
 };
 
 } // namespace HiAppEvent
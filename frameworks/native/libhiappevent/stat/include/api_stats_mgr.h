@@ -34,7 +34,7 @@ class ApiStatsManager {
 public:
     ApiStatsManager();
     ~ApiStatsManager();
-    void AddRecord(ApiDescriptor descriptor, ApiMetric metric);
+    void AddRecord(const ApiDescriptor& descriptor, const ApiMetric& metric);
 
 private:
     void ScheduleBackUp();
@@ -45,6 +45,8 @@ private:
 
     ApiStatsAggregator aggregator_;
     ApiStatsTimer timer_;
+
+    // serializes the backup and report tasks, records go to the sharded aggregator without it
     std::mutex mut_;
 };
 
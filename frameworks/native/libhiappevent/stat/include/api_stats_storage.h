@@ -27,8 +27,8 @@ class ApiStatsStorage : public NoCopyable {
 public:
     static ApiStatsStorage& GetInstance();
 
-    int Backup(const ApiMetricsMap& apiMetrics);
-    int QueryAll(ApiMetricsMap& apiMetrics);
+    int Backup(const ApiStatsMap& apiStats);
+    int QueryAll(ApiStatsMap& apiStats);
     int Clear();
 
 private:
@@ -16,10 +16,15 @@
 #ifndef HIAPPEVENT_FRAMEWORKS_NATIVE_LIB_HIAPPEVENT_STAT_INCLUDE_API_STATS_TYPES_H
 #define HIAPPEVENT_FRAMEWORKS_NATIVE_LIB_HIAPPEVENT_STAT_INCLUDE_API_STATS_TYPES_H
 
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <functional>
 #include <map>
 #include <string>
 #include <vector>
 
+#include "api_latency_sketch.h"
 #include "base_type.h"
 
 namespace OHOS {
@@ -28,16 +33,22 @@ namespace HiAppEvent {
 
 class ApiDescriptor {
 public:
-    ApiDescriptor(const std::string& kitName, const std::string& apiName) : kitName_(kitName), apiName_(apiName) {}
+    ApiDescriptor(const std::string& kitName, const std::string& apiName)
+        : kitName_(kitName), apiName_(apiName), hash_(HashOf(kitName, apiName)) {}
     
-    std::string KitName() const
+    const std::string& KitName() const
     {
-        return std::string(kitName_);
+        return kitName_;
     }
     
-    std::string ApiName() const
+    const std::string& ApiName() const
     {
-        return std::string(apiName_);
+        return apiName_;
+    }
+
+    size_t Hash() const
+    {
+        return hash_;
     }
 
     std::string Description() const
@@ -45,19 +56,84 @@ public:
         return kitName_ + ':' + apiName_;
     }
 
+    bool operator==(const ApiDescriptor& other) const
+    {
+        return hash_ == other.hash_ && kitName_ == other.kitName_ && apiName_ == other.apiName_;
+    }
+
     struct ApiDescriptorComparator {
         bool operator() (const ApiDescriptor& lApi, const ApiDescriptor& rApi) const
         {
-            return lApi.Description() < rApi.Description();
+            int ret = lApi.kitName_.compare(rApi.kitName_);
+            return ret != 0 ? ret < 0 : lApi.apiName_ < rApi.apiName_;
+        }
+    };
+
+    struct ApiDescriptorHasher {
+        size_t operator() (const ApiDescriptor& api) const
+        {
+            return api.hash_;
         }
     };
     
 private:
+    static size_t HashOf(const std::string& kitName, const std::string& apiName)
+    {
+        constexpr size_t hashSeed = 0x9e3779b9;
+        size_t hash = std::hash<std::string>{}(kitName);
+        return hash ^ (std::hash<std::string>{}(apiName) + hashSeed + (hash << 6) + (hash >> 2)); // 6, 2: mix bits
+    }
+
     const std::string kitName_;
     const std::string apiName_;
+    const size_t hash_;
+};
+
+/*
+ * Running statistics of one api. Every metric is folded in when it is recorded, so the size of the stats
+ * only depends on the number of distinct error codes and the fixed size of the cost time sketch, not on the
+ * number of calls.
+ */
+struct ApiStats {
+    int callTimes = 0;
+    int successTimes = 0;
+    int64_t maxCostTime = 0;
+    int64_t minCostTime = std::numeric_limits<int64_t>::max();
+    int64_t totalCostTime = 0;
+    std::map<int, int> errorCodeNums;
+    ApiLatencySketch costTimeSketch;
+
+    void Add(const ApiMetric& metric)
+    {
+        callTimes++;
+        if (metric.successful) {
+            successTimes++;
+        }
+        maxCostTime = std::max(maxCostTime, static_cast<int64_t>(metric.duration));
+        minCostTime = std::min(minCostTime, static_cast<int64_t>(metric.duration));
+        totalCostTime += metric.duration;
+        errorCodeNums[metric.errCode]++;
+        costTimeSketch.Add(metric.duration);
+    }
+
+    void Merge(const ApiStats& other)
+    {
+        if (other.callTimes <= 0) {
+            return;
+        }
+        callTimes += other.callTimes;
+        successTimes += other.successTimes;
+        maxCostTime = std::max(maxCostTime, other.maxCostTime);
+        minCostTime = std::min(minCostTime, other.minCostTime);
+        totalCostTime += other.totalCostTime;
+        for (const auto& [errCode, num] : other.errorCodeNums) {
+            errorCodeNums[errCode] += num;
+        }
+        costTimeSketch.Merge(other.costTimeSketch);
+    }
 };
 
-using ApiMetricsMap = std::map<ApiDescriptor, std::vector<ApiMetric>, ApiDescriptor::ApiDescriptorComparator>;
+using ApiStatsMap = std::map<ApiDescriptor, ApiStats, ApiDescriptor::ApiDescriptorComparator>;
 
 } // namespace HiAppEvent
 } // namespace HiviewDFX
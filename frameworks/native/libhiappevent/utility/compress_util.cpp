@@ -0,0 +1,152 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "compress_util.h"
+
+#include <zlib.h>
+
+namespace OHOS {
+namespace HiviewDFX {
+namespace CompressUtil {
+namespace {
+constexpr size_t MIN_COMPRESS_SIZE = 512;
+constexpr size_t SIZE_HEADER_LEN = 4; // the original size is kept in 4 bytes ahead of the deflate stream
+constexpr uint32_t MAX_ORIGINAL_SIZE = 64 * 1024 * 1024; // 64M, reject the corrupted header before allocating
+constexpr uint32_t BYTE_BITS = 8;
+constexpr uint32_t BYTE_MASK = 0xff;
+constexpr int RAW_DEFLATE_WINDOW_BITS = -15; // no zlib header and checksum, the codec is stored aside
+constexpr int DEFLATE_MEM_LEVEL = 8;
+constexpr int DEFLATE_LEVEL = 1;
+const char* const OS_DOMAIN = "OS";
+
+// the strings found in most of the OS events, the more frequent ones are put closer to the end.
+// the stored data can only be inflated with the same dictionary it is deflated with, so the dictionary is frozen:
+// any change of it, even of a single byte, requires a new codec instead of CODEC_DEFLATE_OS_DICT.
+constexpr char OS_DICT[] =
+    "\"sys_total_mem\":\"sys_avail_mem\":\"sys_free_mem\":\"vss\":\"rss\":\"pss\":\"memory\":{"
+    "\"process_life_time\":\"log_over_limit\":false,\"is_system_error\":false,\"page_switch_log\":["
+    "\"resource_type\":\"pss_memory\",\"js_heap\",\"fd\",\"thread\",\"ion\",\"gpu\",\"leak_time\":"
+    "\"fault_message\":\"peer_binder\":\"event_handler\":\"event_handler_size_3s\":\"event_handler_size_6s\":"
+    "\"main_stack\":\"APP_INPUT_BLOCK\",\"THREAD_BLOCK_6S\",\"LIFECYCLE_TIMEOUT\",\"APP_FREEZE\",\"APP_CRASH\","
+    "\"crash_type\":\"NativeCrash\",\"JsError\",\"CppCrash\",\"AppFreeze\",\"foreground\":true,\"background\":"
+    "\"bundle_version\":\"bundle_name\":\"pid\":\"uid\":\"uuid\":\"app_running_unique_id\":\"time\":"
+    "\"exception\":{\"name\":\"SIGSEGV\",\"SIGABRT\",\"SIGBUS\",\"message\":\"stack\":\"signal\":{\"signo\":"
+    "\"code\":\"address\":\"0x\",\"thread_name\":\"OS_FFRT_\",\"tid\":\"threads\":[{\"hilog\":["
+    "/system/lib64/platformsdk/libace_napi.z.so/system/lib64/libark_jsruntime.so/system/lib64/libc.so"
+    "/system/lib64/chipset-pub-sdk/libeventhandler.z.so/data/storage/el1/bundle/libs/arm64/"
+    "OHOS::AppExecFwk::EventRunner::Run OHOS::AppExecFwk::EventQueue::GetEvent panda::ecmascript::"
+    "\"external_log\":[\"/data/storage/el2/log/hiappevent/.log\"],"
+    "\"frames\":[{\"symbol\":\"\",\"file\":\"\",\"buildId\":\"\",\"pc\":\"\",\"offset\":},{\"symbol\":\"";
+
+bool SetDictionary(z_stream& stream, int codec, bool isInflate)
+{
+    if (codec != CODEC_DEFLATE_OS_DICT) {
+        return true;
+    }
+    const auto* dict = reinterpret_cast<const Bytef*>(OS_DICT);
+    uInt dictLen = sizeof(OS_DICT) - 1; // 1 for '\0'
+    int ret = isInflate ? inflateSetDictionary(&stream, dict, dictLen) : deflateSetDictionary(&stream, dict, dictLen);
+    return ret == Z_OK;
+}
+
+bool IsValidCodec(int codec)
+{
+    return codec == CODEC_DEFLATE || codec == CODEC_DEFLATE_OS_DICT;
+}
+}
+
+int SelectCodec(const std::string& domain, size_t size)
+{
+    if (size < MIN_COMPRESS_SIZE) {
+        return CODEC_NONE;
+    }
+    return domain == OS_DOMAIN ? CODEC_DEFLATE_OS_DICT : CODEC_DEFLATE;
+}
+
+bool Compress(const uint8_t* data, size_t len, int codec, std::vector<uint8_t>& out)
+{
+    if (!IsValidCodec(codec) || data == nullptr || len <= SIZE_HEADER_LEN || len > MAX_ORIGINAL_SIZE) {
+        return false;
+    }
+    z_stream stream = {};
+    if (deflateInit2(&stream, DEFLATE_LEVEL, Z_DEFLATED, RAW_DEFLATE_WINDOW_BITS, DEFLATE_MEM_LEVEL,
+        Z_DEFAULT_STRATEGY) != Z_OK) {
+        return false;
+    }
+    if (!SetDictionary(stream, codec, false)) {
+        deflateEnd(&stream);
+        return false;
+    }
+    // the result larger than data is useless, so the buffer is limited to the size of data
+    out.resize(len);
+    uint32_t size = static_cast<uint32_t>(len);
+    for (size_t i = 0; i < SIZE_HEADER_LEN; ++i) {
+        out[i] = static_cast<uint8_t>((size >> (i * BYTE_BITS)) & BYTE_MASK);
+    }
+    stream.next_in = const_cast<Bytef*>(data);
+    stream.avail_in = static_cast<uInt>(len);
+    stream.next_out = out.data() + SIZE_HEADER_LEN;
+    stream.avail_out = static_cast<uInt>(out.size() - SIZE_HEADER_LEN);
+    int ret = deflate(&stream, Z_FINISH);
+    size_t outLen = SIZE_HEADER_LEN + stream.total_out;
+    deflateEnd(&stream);
+    if (ret != Z_STREAM_END) {
+        out.clear();
+        return false;
+    }
+    out.resize(outLen);
+    return true;
+}
+
+bool Compress(const std::string& data, int codec, std::vector<uint8_t>& out)
+{
+    return Compress(reinterpret_cast<const uint8_t*>(data.data()), data.size(), codec, out);
+}
+
+bool Decompress(const uint8_t* data, size_t len, int codec, std::string& out)
+{
+    if (!IsValidCodec(codec) || data == nullptr || len <= SIZE_HEADER_LEN) {
+        return false;
+    }
+    uint32_t size = 0;
+    for (size_t i = 0; i < SIZE_HEADER_LEN; ++i) {
+        size |= static_cast<uint32_t>(data[i]) << (i * BYTE_BITS);
+    }
+    if (size > MAX_ORIGINAL_SIZE) {
+        return false;
+    }
+    z_stream stream = {};
+    if (inflateInit2(&stream, RAW_DEFLATE_WINDOW_BITS) != Z_OK) {
+        return false;
+    }
+    if (!SetDictionary(stream, codec, true)) {
+        inflateEnd(&stream);
+        return false;
+    }
+    out.resize(size);
+    stream.next_in = const_cast<Bytef*>(data + SIZE_HEADER_LEN);
+    stream.avail_in = static_cast<uInt>(len - SIZE_HEADER_LEN);
+    stream.next_out = reinterpret_cast<Bytef*>(out.data());
+    stream.avail_out = size;
+    int ret = inflate(&stream, Z_FINISH);
+    bool isComplete = (ret == Z_STREAM_END) && (stream.total_out == size);
+    inflateEnd(&stream);
+    if (!isComplete) {
+        out.clear();
+    }
+    return isComplete;
+}
+} // namespace CompressUtil
+} // namespace HiviewDFX
+} // namespace OHOS
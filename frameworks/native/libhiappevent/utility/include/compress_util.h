@@ -0,0 +1,51 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef HIAPPEVENT_FRAMEWORKS_NATIVE_LIB_HIAPPEVENT_UTILITY_COMPRESS_UTIL_H
+#define HIAPPEVENT_FRAMEWORKS_NATIVE_LIB_HIAPPEVENT_UTILITY_COMPRESS_UTIL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace OHOS {
+namespace HiviewDFX {
+namespace CompressUtil {
+// the codecs are persisted with the compressed data, so the values must not be changed
+enum Codec : int {
+    CODEC_NONE = 0,
+    CODEC_DEFLATE = 1,
+    CODEC_DEFLATE_OS_DICT = 2, // deflate primed with the keys and the log text common in the OS events
+};
+
+/*
+ * Returns the codec for data of the domain, or CODEC_NONE if the data is too small to be worth compressing.
+ */
+int SelectCodec(const std::string& domain, size_t size);
+
+/*
+ * Compresses data with the codec, returns false if it fails or the result is not smaller than data.
+ */
+bool Compress(const uint8_t* data, size_t len, int codec, std::vector<uint8_t>& out);
+bool Compress(const std::string& data, int codec, std::vector<uint8_t>& out);
+
+/*
+ * Decompresses the data compressed by Compress with the same codec, returns false if the data is malformed.
+ */
+bool Decompress(const uint8_t* data, size_t len, int codec, std::string& out);
+} // namespace CompressUtil
+} // namespace HiviewDFX
+} // namespace OHOS
+#endif // HIAPPEVENT_FRAMEWORKS_NATIVE_LIB_HIAPPEVENT_UTILITY_COMPRESS_UTIL_H
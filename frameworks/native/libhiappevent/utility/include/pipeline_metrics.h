@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef HIAPPEVENT_FRAMEWORKS_NATIVE_LIB_HIAPPEVENT_UTILITY_PIPELINE_METRICS_H
+#define HIAPPEVENT_FRAMEWORKS_NATIVE_LIB_HIAPPEVENT_UTILITY_PIPELINE_METRICS_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace OHOS {
+namespace HiviewDFX {
+namespace PipelineMetrics {
+enum Counter : uint32_t {
+    WRITE_SUBMITTED = 0,
+    WRITE_DROPPED_DISABLED,
+    WRITE_DROPPED_FREE_SIZE,
+    WRITE_DROPPED_OVERFLOW,
+    WRITE_DROPPED_SAMPLING,
+    WRITE_AGGREGATED,
+    WRITE_PUBLISHED,
+    EVENTS_WRITTEN,
+    BYTES_WRITTEN,
+    EVENTS_STORED,
+    EVENTS_DISPATCHED,
+    EVENTS_DELIVERED_FROM_MEMORY,
+    REPORTS,
+    REPORT_FAILURES,
+    DB_OPS,
+    DB_OP_FAILURES,
+    CLEAN_RUNS,
+    CLEAN_BYTES_RECLAIMED,
+    COUNTER_NUM,
+};
+
+enum Gauge : uint32_t {
+    QUEUE_DEPTH = 0,
+    WRITE_QUEUE_EVENTS,
+    GAUGE_NUM,
+};
+
+enum Histogram : uint32_t {
+    QUEUE_WAIT = 0,
+    VERIFY,
+    FILE_APPEND,
+    DB_INSERT,
+    DB_MAPPING,
+    DISPATCH,
+    ON_REPORT,
+    DB_OP,
+    // the waiting time of the events in each lane of the write queue, in the order of AppEventWriteQueue::Lane
+    LANE_WAIT_BEHAVIOR,
+    LANE_WAIT_STATISTIC,
+    LANE_WAIT_SECURITY,
+    LANE_WAIT_URGENT,
+    HISTOGRAM_NUM,
+};
+
+// bucket 0 counts the costs below 1us, bucket i counts [2^(i-1), 2^i) us and the last one counts the rest
+constexpr size_t BUCKET_NUM = 20;
+
+struct HistogramSnapshot {
+    uint64_t count = 0;
+    uint64_t sumUs = 0;
+    std::array<uint64_t, BUCKET_NUM> buckets {};
+};
+
+struct ObserverBacklog {
+    std::string name;
+    int64_t seq = 0;
+    int rows = 0;
+    int bytes = 0;
+};
+
+struct Snapshot {
+    std::array<uint64_t, COUNTER_NUM> counters {};
+    std::array<int64_t, GAUGE_NUM> gauges {};
+    std::array<HistogramSnapshot, HISTOGRAM_NUM> histograms {};
+    std::vector<ObserverBacklog> observers;
+};
+
+/*
+ * The metrics are recorded with relaxed atomics into a few shards shared by the threads round-robin, so recording
+ * never takes a lock and the threads rarely write the same cache line. The shards are only summed up when a
+ * snapshot is taken.
+ */
+void Add(Counter counter, uint64_t value = 1);
+void UpdateGauge(Gauge gauge, int64_t delta);
+void Observe(Histogram histogram, uint64_t costUs);
+uint64_t NowUs();
+void GetSnapshot(Snapshot& snapshot);
+void Reset();
+const char* GetName(Counter counter);
+const char* GetName(Gauge gauge);
+const char* GetName(Histogram histogram);
+
+class StageTimer {
+public:
+    explicit StageTimer(Histogram histogram) : histogram_(histogram), beginUs_(NowUs()) {}
+    ~StageTimer()
+    {
+        Observe(histogram_, NowUs() - beginUs_);
+    }
+    StageTimer(const StageTimer&) = delete;
+    StageTimer& operator=(const StageTimer&) = delete;
+
+private:
+    Histogram histogram_;
+    uint64_t beginUs_;
+};
+} // namespace PipelineMetrics
+} // namespace HiviewDFX
+} // namespace OHOS
+#endif // HIAPPEVENT_FRAMEWORKS_NATIVE_LIB_HIAPPEVENT_UTILITY_PIPELINE_METRICS_H
@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef HIAPPEVENT_FRAMEWORKS_NATIVE_LIB_HIAPPEVENT_UTILITY_PIPELINE_TRACE_H
+#define HIAPPEVENT_FRAMEWORKS_NATIVE_LIB_HIAPPEVENT_UTILITY_PIPELINE_TRACE_H
+
+#include <cstdint>
+
+namespace OHOS {
+namespace HiviewDFX {
+namespace PipelineTrace {
+// span names of the pipeline stages
+constexpr const char* WRITE_QUEUE = "HiAppEvent::WriteQueue";
+constexpr const char* WRITE_EVENT = "HiAppEvent::WriteEvent";
+constexpr const char* STORE_EVENTS = "HiAppEvent::StoreEventsToDb";
+constexpr const char* STORE_MAPPING = "HiAppEvent::StoreEventMappingToDb";
+constexpr const char* SEND_EVENTS = "HiAppEvent::SendEventsToObserver";
+constexpr const char* ON_REPORT = "HiAppEvent::OnReport";
+constexpr const char* HANDLE_INOTIFY = "HiAppEvent::HandleInotify";
+constexpr const char* CLEAN_STORAGE = "HiAppEvent::ReleaseStorageSpace";
+constexpr const char* CLEAR_DATA = "HiAppEvent::ClearData";
+
+// counter names shown beside the spans
+constexpr const char* WRITE_BYTES = "HiAppEvent.WriteBytes";
+constexpr const char* STORE_BATCH = "HiAppEvent.StoreBatch";
+constexpr const char* MAPPING_BATCH = "HiAppEvent.MappingBatch";
+constexpr const char* SEND_BATCH = "HiAppEvent.SendBatch";
+constexpr const char* REPORT_BATCH = "HiAppEvent.ReportBatch";
+constexpr const char* INOTIFY_EVENTS = "HiAppEvent.InotifyEvents";
+constexpr const char* CLEAN_BYTES = "HiAppEvent.CleanBytes";
+
+/*
+ * The trace points are compiled in only when HIAPPEVENT_TRACE_ENABLE is defined, otherwise every call below
+ * is an empty inline function and costs nothing.
+ */
+#ifdef HIAPPEVENT_TRACE_ENABLE
+void Begin(const char* name);
+void End();
+void Count(const char* name, int64_t value);
+int32_t BeginAsync(const char* name);
+void EndAsync(const char* name, int32_t taskId);
+#else
+inline void Begin(const char*) {}
+inline void End() {}
+inline void Count(const char*, int64_t) {}
+inline int32_t BeginAsync(const char*)
+{
+    return 0;
+}
+inline void EndAsync(const char*, int32_t) {}
+#endif
+
+class ScopedTrace {
+public:
+    explicit ScopedTrace(const char* name)
+    {
+        Begin(name);
+    }
+    ScopedTrace(const char* name, const char* counterName, int64_t value)
+    {
+        Count(counterName, value);
+        Begin(name);
+    }
+    ~ScopedTrace()
+    {
+        End();
+    }
+    ScopedTrace(const ScopedTrace&) = delete;
+    ScopedTrace& operator=(const ScopedTrace&) = delete;
+};
+
+// spans a task from the time it is queued to the time it starts running
+class AsyncTrace {
+public:
+    explicit AsyncTrace(const char* name) : name_(name), taskId_(BeginAsync(name)) {}
+    void Finish() const
+    {
+        EndAsync(name_, taskId_);
+    }
+
+private:
+    const char* name_;
+    int32_t taskId_;
+};
+} // namespace PipelineTrace
+} // namespace HiviewDFX
+} // namespace OHOS
+#endif // HIAPPEVENT_FRAMEWORKS_NATIVE_LIB_HIAPPEVENT_UTILITY_PIPELINE_TRACE_H
@@ -0,0 +1,37 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef HIAPPEVENT_FRAMEWORKS_NATIVE_LIB_HIAPPEVENT_UTILITY_SHARD_UTIL_H
+#define HIAPPEVENT_FRAMEWORKS_NATIVE_LIB_HIAPPEVENT_UTILITY_SHARD_UTIL_H
+
+#include <atomic>
+#include <cstddef>
+
+namespace OHOS {
+namespace HiviewDFX {
+namespace ShardUtil {
+/*
+ * Returns the index of the shard the calling thread records into. The threads are bound to the shards round-robin
+ * on their first call, so a shard is shared by every shardNum-th thread instead of being owned by one thread.
+ */
+inline size_t GetThreadShardIndex(size_t shardNum)
+{
+    static std::atomic<size_t> nextThreadIndex {0};
+    thread_local size_t threadIndex = nextThreadIndex.fetch_add(1, std::memory_order_relaxed);
+    return threadIndex % shardNum;
+}
+} // namespace ShardUtil
+} // namespace HiviewDFX
+} // namespace OHOS
+#endif // HIAPPEVENT_FRAMEWORKS_NATIVE_LIB_HIAPPEVENT_UTILITY_SHARD_UTIL_H
@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef HIAPPEVENT_FRAMEWORKS_NATIVE_LIB_HIAPPEVENT_UTILITY_SNAPSHOT_HOLDER_H
+#define HIAPPEVENT_FRAMEWORKS_NATIVE_LIB_HIAPPEVENT_UTILITY_SNAPSHOT_HOLDER_H
+
+#include <atomic>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "nocopyable.h"
+
+namespace OHOS {
+namespace HiviewDFX {
+/*
+ * Publishes immutable snapshots to the readers without locking them. The readers only count themselves in and
+ * out, and a replaced snapshot is freed once no reader is active, either by the next publisher or by the last
+ * reader, so the snapshots read on the hot paths are neither locked nor leaked.
+ */
+template<typename T>
+class SnapshotHolder : public NoCopyable {
+public:
+    void Publish(std::unique_ptr<const T> snapshot)
+    {
+        std::vector<std::unique_ptr<const T>> retired;
+        {
+            std::lock_guard<std::mutex> lockGuard(mutex_);
+            current_ = snapshot.get();
+            snapshots_.emplace_back(std::move(snapshot));
+            hasRetired_ = snapshots_.size() > 1;
+            TakeRetired(retired);
+        }
+        // the retired snapshots are released out of the lock
+    }
+
+    const T* Acquire()
+    {
+        // counted before loading, so that the snapshot loaded is not freed until the reader is released
+        ++readers_;
+        return current_.load();
+    }
+
+    void Release()
+    {
+        if (--readers_ != 0 || !hasRetired_) {
+            return;
+        }
+        std::vector<std::unique_ptr<const T>> retired;
+        std::lock_guard<std::mutex> lockGuard(mutex_);
+        TakeRetired(retired);
+    }
+
+private:
+    void TakeRetired(std::vector<std::unique_ptr<const T>>& retired)
+    {
+        // the retired snapshots are no longer loaded by the new readers, so they are freed when no reader is active
+        if (snapshots_.size() <= 1 || readers_ != 0) {
+            return;
+        }
+        auto last = std::prev(snapshots_.end());
+        retired.insert(retired.end(), std::make_move_iterator(snapshots_.begin()), std::make_move_iterator(last));
+        snapshots_.erase(snapshots_.begin(), last);
+        hasRetired_ = false;
+    }
+
+private:
+    std::atomic<const T*> current_ = nullptr;
+    std::atomic<int> readers_ = 0;
+    std::atomic<bool> hasRetired_ = false;
+    std::mutex mutex_;
+    std::vector<std::unique_ptr<const T>> snapshots_; // the retired ones and the current one
+};
+
+// holds the current snapshot for the scope of the reader
+template<typename T>
+class SnapshotReader : public NoCopyable {
+public:
+    explicit SnapshotReader(SnapshotHolder<T>& holder) : holder_(holder), snapshot_(holder.Acquire()) {}
+    ~SnapshotReader()
+    {
+        holder_.Release();
+    }
+
+    const T* Get() const
+    {
+        return snapshot_;
+    }
+
+    const T* operator->() const
+    {
+        return snapshot_;
+    }
+
+private:
+    SnapshotHolder<T>& holder_;
+    const T* snapshot_;
+};
+} // namespace HiviewDFX
+} // namespace OHOS
+#endif // HIAPPEVENT_FRAMEWORKS_NATIVE_LIB_HIAPPEVENT_UTILITY_SNAPSHOT_HOLDER_H
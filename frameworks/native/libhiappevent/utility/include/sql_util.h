@@ -22,6 +22,7 @@ namespace HiviewDFX {
 namespace SqlUtil {
 constexpr const char* SQL_TEXT_TYPE = "TEXT NOT NULL";
 constexpr const char* SQL_INT_TYPE = "INTEGER";
+constexpr const char* SQL_INT_ZERO_TYPE = "INTEGER NOT NULL DEFAULT 0";
 
 std::string CreateTable(const std::string& table,
     const std::vector<std::pair<std::string, std::string>>& fields);
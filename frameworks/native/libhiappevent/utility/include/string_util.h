@@ -0,0 +1,55 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef HIAPPEVENT_FRAMEWORKS_NATIVE_LIB_HIAPPEVENT_UTILITY_STRING_UTIL_H
+#define HIAPPEVENT_FRAMEWORKS_NATIVE_LIB_HIAPPEVENT_UTILITY_STRING_UTIL_H
+
+#include <cstddef>
+#include <string>
+
+namespace OHOS {
+namespace HiviewDFX {
+namespace StringUtil {
+/*
+ * Returns the index of the first char which has to be escaped in a json string, or len if there is none.
+ * The chars are checked 32 bytes at a time with SSE2 or NEON where they are available.
+ */
+size_t FindFirstEscapeChar(const char* data, size_t len);
+
+/*
+ * Escapes the backslash, the quotation mark and the \b \f \n \r \t chars in place. Nothing is allocated if the
+ * string has no char to be escaped, otherwise the result is built in a buffer of the exact size.
+ */
+void EscapeJsonString(std::string& str);
+
+/*
+ * Appends the chars of a json string to out with the escapes resolved, including the \uXXXX ones which are appended
+ * in utf-8. Returns false if an escape is malformed.
+ */
+bool UnescapeJsonChars(const char* data, size_t len, std::string& out);
+
+inline bool IsAsciiAlpha(char c)
+{
+    // 0x20 folds the upper case letters into the lower case ones
+    return static_cast<unsigned char>((static_cast<unsigned char>(c) | 0x20) - 'a') < 26; // 26 letters
+}
+
+inline bool IsAsciiAlnum(char c)
+{
+    return IsAsciiAlpha(c) || static_cast<unsigned char>(c - '0') < 10; // 10 digits
+}
+} // namespace StringUtil
+} // namespace HiviewDFX
+} // namespace OHOS
+#endif // HIAPPEVENT_FRAMEWORKS_NATIVE_LIB_HIAPPEVENT_UTILITY_STRING_UTIL_H
@@ -0,0 +1,186 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "pipeline_metrics.h"
+
+#include <atomic>
+#include <chrono>
+
+#include "shard_util.h"
+
+namespace OHOS {
+namespace HiviewDFX {
+namespace PipelineMetrics {
+namespace {
+constexpr size_t SHARD_NUM = 8;
+
+struct HistogramCells {
+    std::atomic<uint64_t> count {0};
+    std::atomic<uint64_t> sumUs {0};
+    std::array<std::atomic<uint64_t>, BUCKET_NUM> buckets {};
+};
+
+struct alignas(64) Shard { // 64 means the size of cache line
+    std::array<std::atomic<uint64_t>, COUNTER_NUM> counters {};
+    std::array<std::atomic<int64_t>, GAUGE_NUM> gauges {};
+    std::array<HistogramCells, HISTOGRAM_NUM> histograms {};
+};
+
+std::array<Shard, SHARD_NUM> g_shards;
+
+Shard& GetShard()
+{
+    return g_shards[ShardUtil::GetThreadShardIndex(SHARD_NUM)];
+}
+
+size_t GetBucketIndex(uint64_t costUs)
+{
+    if (costUs == 0) {
+        return 0;
+    }
+    size_t index = static_cast<size_t>(64 - __builtin_clzll(costUs)); // 64 means the bits of uint64_t
+    return index < BUCKET_NUM ? index : (BUCKET_NUM - 1);
+}
+
+constexpr std::array<const char*, COUNTER_NUM> COUNTER_NAMES = {
+    "write_submitted",
+    "write_dropped_disabled",
+    "write_dropped_free_size",
+    "write_dropped_overflow",
+    "write_dropped_sampling",
+    "write_aggregated",
+    "write_published",
+    "events_written",
+    "bytes_written",
+    "events_stored",
+    "events_dispatched",
+    "events_delivered_from_memory",
+    "reports",
+    "report_failures",
+    "db_ops",
+    "db_op_failures",
+    "clean_runs",
+    "clean_bytes_reclaimed",
+};
+
+constexpr std::array<const char*, GAUGE_NUM> GAUGE_NAMES = {
+    "queue_depth",
+    "write_queue_events",
+};
+
+constexpr std::array<const char*, HISTOGRAM_NUM> HISTOGRAM_NAMES = {
+    "queue_wait",
+    "verify",
+    "file_append",
+    "db_insert",
+    "db_mapping",
+    "dispatch",
+    "on_report",
+    "db_op",
+    "lane_wait_behavior",
+    "lane_wait_statistic",
+    "lane_wait_security",
+    "lane_wait_urgent",
+};
+}
+
+void Add(Counter counter, uint64_t value)
+{
+    if (counter >= COUNTER_NUM) {
+        return;
+    }
+    GetShard().counters[counter].fetch_add(value, std::memory_order_relaxed);
+}
+
+void UpdateGauge(Gauge gauge, int64_t delta)
+{
+    if (gauge >= GAUGE_NUM) {
+        return;
+    }
+    GetShard().gauges[gauge].fetch_add(delta, std::memory_order_relaxed);
+}
+
+void Observe(Histogram histogram, uint64_t costUs)
+{
+    if (histogram >= HISTOGRAM_NUM) {
+        return;
+    }
+    auto& cells = GetShard().histograms[histogram];
+    cells.count.fetch_add(1, std::memory_order_relaxed);
+    cells.sumUs.fetch_add(costUs, std::memory_order_relaxed);
+    cells.buckets[GetBucketIndex(costUs)].fetch_add(1, std::memory_order_relaxed);
+}
+
+uint64_t NowUs()
+{
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+void GetSnapshot(Snapshot& snapshot)
+{
+    snapshot = Snapshot();
+    for (const auto& shard : g_shards) {
+        for (size_t i = 0; i < COUNTER_NUM; ++i) {
+            snapshot.counters[i] += shard.counters[i].load(std::memory_order_relaxed);
+        }
+        for (size_t i = 0; i < GAUGE_NUM; ++i) {
+            snapshot.gauges[i] += shard.gauges[i].load(std::memory_order_relaxed);
+        }
+        for (size_t i = 0; i < HISTOGRAM_NUM; ++i) {
+            const auto& cells = shard.histograms[i];
+            auto& histogram = snapshot.histograms[i];
+            histogram.count += cells.count.load(std::memory_order_relaxed);
+            histogram.sumUs += cells.sumUs.load(std::memory_order_relaxed);
+            for (size_t j = 0; j < BUCKET_NUM; ++j) {
+                histogram.buckets[j] += cells.buckets[j].load(std::memory_order_relaxed);
+            }
+        }
+    }
+}
+
+void Reset()
+{
+    // the gauges track the live state, so only the counters and histograms are reset
+    for (auto& shard : g_shards) {
+        for (auto& counter : shard.counters) {
+            counter.store(0, std::memory_order_relaxed);
+        }
+        for (auto& cells : shard.histograms) {
+            cells.count.store(0, std::memory_order_relaxed);
+            cells.sumUs.store(0, std::memory_order_relaxed);
+            for (auto& bucket : cells.buckets) {
+                bucket.store(0, std::memory_order_relaxed);
+            }
+        }
+    }
+}
+
+const char* GetName(Counter counter)
+{
+    return counter < COUNTER_NUM ? COUNTER_NAMES[counter] : "";
+}
+
+const char* GetName(Gauge gauge)
+{
+    return gauge < GAUGE_NUM ? GAUGE_NAMES[gauge] : "";
+}
+
+const char* GetName(Histogram histogram)
+{
+    return histogram < HISTOGRAM_NUM ? HISTOGRAM_NAMES[histogram] : "";
+}
+} // namespace PipelineMetrics
+} // namespace HiviewDFX
+} // namespace OHOS
@@ -0,0 +1,58 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "pipeline_trace.h"
+
+#ifdef HIAPPEVENT_TRACE_ENABLE
+#include <atomic>
+
+#include "hitrace_meter.h"
+
+namespace OHOS {
+namespace HiviewDFX {
+namespace PipelineTrace {
+namespace {
+std::atomic<int32_t> g_taskId = 0;
+}
+
+void Begin(const char* name)
+{
+    StartTrace(HITRACE_TAG_APP, name);
+}
+
+void End()
+{
+    FinishTrace(HITRACE_TAG_APP);
+}
+
+void Count(const char* name, int64_t value)
+{
+    CountTrace(HITRACE_TAG_APP, name, value);
+}
+
+int32_t BeginAsync(const char* name)
+{
+    int32_t taskId = g_taskId.fetch_add(1, std::memory_order_relaxed);
+    StartAsyncTrace(HITRACE_TAG_APP, name, taskId);
+    return taskId;
+}
+
+void EndAsync(const char* name, int32_t taskId)
+{
+    FinishAsyncTrace(HITRACE_TAG_APP, name, taskId);
+}
+} // namespace PipelineTrace
+} // namespace HiviewDFX
+} // namespace OHOS
+#endif // HIAPPEVENT_TRACE_ENABLE
@@ -0,0 +1,317 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "string_util.h"
+
+#include <cstdint>
+#include <cstring>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace OHOS {
+namespace HiviewDFX {
+namespace StringUtil {
+namespace {
+constexpr size_t STRIDE = 16;
+
+// \b \t \n are 8, 9 and 10, \f \r are 12 and 13, so the control chars are [8, 13] except the vertical tab 11
+constexpr unsigned char CTRL_MIN = '\b';
+constexpr unsigned char CTRL_RANGE = '\r' - '\b';
+constexpr unsigned char VERTICAL_TAB = '\v';
+
+constexpr size_t UNICODE_HEX_LEN = 4; // 4: XXXX of \uXXXX
+constexpr size_t UNICODE_ESCAPE_PREFIX_LEN = 2; // 2: \u
+constexpr uint32_t HEX_BASE = 16;
+constexpr uint32_t HEX_LETTER_OFFSET = 10;
+constexpr uint32_t HIGH_SURROGATE_MIN = 0xD800;
+constexpr uint32_t HIGH_SURROGATE_MAX = 0xDBFF;
+constexpr uint32_t LOW_SURROGATE_MIN = 0xDC00;
+constexpr uint32_t LOW_SURROGATE_MAX = 0xDFFF;
+constexpr uint32_t SURROGATE_OFFSET = 0x10000;
+constexpr uint32_t SURROGATE_SHIFT = 10;
+constexpr uint32_t UTF8_ONE_BYTE_MAX = 0x7F;
+constexpr uint32_t UTF8_TWO_BYTES_MAX = 0x7FF;
+constexpr uint32_t UTF8_THREE_BYTES_MAX = 0xFFFF;
+constexpr uint32_t UTF8_TWO_BYTES_LEAD = 0xC0;
+constexpr uint32_t UTF8_THREE_BYTES_LEAD = 0xE0;
+constexpr uint32_t UTF8_FOUR_BYTES_LEAD = 0xF0;
+constexpr uint32_t UTF8_CONTINUATION = 0x80;
+constexpr uint32_t UTF8_CONTINUATION_MASK = 0x3F;
+constexpr uint32_t UTF8_BITS_PER_BYTE = 6;
+
+inline bool NeedEscape(char c)
+{
+    auto uc = static_cast<unsigned char>(c);
+    return uc == '\\' || uc == '\"' || (static_cast<unsigned char>(uc - CTRL_MIN) <= CTRL_RANGE && uc != VERTICAL_TAB);
+}
+
+const char* GetEscapeStr(char c)
+{
+    switch (c) {
+        case '\\':
+            return "\\\\";
+        case '\"':
+            return "\\\"";
+        case '\b':
+            return "\\b";
+        case '\f':
+            return "\\f";
+        case '\n':
+            return "\\n";
+        case '\r':
+            return "\\r";
+        case '\t':
+            return "\\t";
+        default:
+            return "";
+    }
+}
+
+#if defined(__SSE2__)
+inline __m128i MatchEscapeChars(__m128i chunk)
+{
+    __m128i hit = _mm_or_si128(_mm_cmpeq_epi8(chunk, _mm_set1_epi8('\\')), _mm_cmpeq_epi8(chunk, _mm_set1_epi8('\"')));
+    // an unsigned x <= CTRL_RANGE is the same as min(x, CTRL_RANGE) == x
+    __m128i offset = _mm_sub_epi8(chunk, _mm_set1_epi8(CTRL_MIN));
+    __m128i ctrl = _mm_cmpeq_epi8(_mm_min_epu8(offset, _mm_set1_epi8(CTRL_RANGE)), offset);
+    ctrl = _mm_andnot_si128(_mm_cmpeq_epi8(chunk, _mm_set1_epi8(VERTICAL_TAB)), ctrl);
+    return _mm_or_si128(hit, ctrl);
+}
+
+size_t FindFirstEscapeCharSimd(const char* data, size_t len)
+{
+    size_t i = 0;
+    for (; i + STRIDE * 2 <= len; i += STRIDE * 2) { // 2 vectors, 32 bytes each round
+        __m128i low = MatchEscapeChars(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i)));
+        __m128i high = MatchEscapeChars(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i + STRIDE)));
+        uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(low))
+            | (static_cast<uint32_t>(_mm_movemask_epi8(high)) << STRIDE);
+        if (mask != 0) {
+            return i + static_cast<size_t>(__builtin_ctz(mask));
+        }
+    }
+    for (; i + STRIDE <= len; i += STRIDE) {
+        uint32_t mask = static_cast<uint32_t>(
+            _mm_movemask_epi8(MatchEscapeChars(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i)))));
+        if (mask != 0) {
+            return i + static_cast<size_t>(__builtin_ctz(mask));
+        }
+    }
+    return i;
+}
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+inline uint8x16_t MatchEscapeChars(uint8x16_t chunk)
+{
+    uint8x16_t hit = vorrq_u8(vceqq_u8(chunk, vdupq_n_u8('\\')), vceqq_u8(chunk, vdupq_n_u8('\"')));
+    uint8x16_t ctrl = vcleq_u8(vsubq_u8(chunk, vdupq_n_u8(CTRL_MIN)), vdupq_n_u8(CTRL_RANGE));
+    ctrl = vbicq_u8(ctrl, vceqq_u8(chunk, vdupq_n_u8(VERTICAL_TAB)));
+    return vorrq_u8(hit, ctrl);
+}
+
+size_t FindFirstEscapeCharSimd(const char* data, size_t len)
+{
+    const auto* bytes = reinterpret_cast<const uint8_t*>(data);
+    size_t i = 0;
+    for (; i + STRIDE * 2 <= len; i += STRIDE * 2) { // 2 vectors, 32 bytes each round
+        uint8x16_t hit = vorrq_u8(MatchEscapeChars(vld1q_u8(bytes + i)),
+            MatchEscapeChars(vld1q_u8(bytes + i + STRIDE)));
+        if (vmaxvq_u8(hit) != 0) {
+            return i; // the exact index is found by the scalar loop
+        }
+    }
+    for (; i + STRIDE <= len; i += STRIDE) {
+        if (vmaxvq_u8(MatchEscapeChars(vld1q_u8(bytes + i))) != 0) {
+            return i;
+        }
+    }
+    return i;
+}
+#else
+size_t FindFirstEscapeCharSimd(const char* data, size_t len)
+{
+    (void)data;
+    (void)len;
+    return 0;
+}
+#endif
+}
+
+size_t FindFirstEscapeChar(const char* data, size_t len)
+{
+    if (data == nullptr) {
+        return 0;
+    }
+    for (size_t i = FindFirstEscapeCharSimd(data, len); i < len; ++i) {
+        if (NeedEscape(data[i])) {
+            return i;
+        }
+    }
+    return len;
+}
+
+namespace {
+bool ReadHex(const char*& cur, const char* end, uint32_t& codePoint)
+{
+    if (static_cast<size_t>(end - cur) < UNICODE_HEX_LEN) {
+        return false;
+    }
+    codePoint = 0;
+    for (size_t i = 0; i < UNICODE_HEX_LEN; ++i, ++cur) {
+        uint32_t digit = 0;
+        if (*cur >= '0' && *cur <= '9') {
+            digit = static_cast<uint32_t>(*cur - '0');
+        } else if (*cur >= 'a' && *cur <= 'f') {
+            digit = static_cast<uint32_t>(*cur - 'a') + HEX_LETTER_OFFSET;
+        } else if (*cur >= 'A' && *cur <= 'F') {
+            digit = static_cast<uint32_t>(*cur - 'A') + HEX_LETTER_OFFSET;
+        } else {
+            return false;
+        }
+        codePoint = codePoint * HEX_BASE + digit;
+    }
+    return true;
+}
+
+void AppendUtf8(uint32_t codePoint, std::string& out)
+{
+    if (codePoint <= UTF8_ONE_BYTE_MAX) {
+        out += static_cast<char>(codePoint);
+        return;
+    }
+    uint32_t continuationNum = 1;
+    uint32_t lead = UTF8_TWO_BYTES_LEAD;
+    if (codePoint > UTF8_THREE_BYTES_MAX) {
+        continuationNum = 3; // 3: the continuation bytes of a 4 bytes char
+        lead = UTF8_FOUR_BYTES_LEAD;
+    } else if (codePoint > UTF8_TWO_BYTES_MAX) {
+        continuationNum = 2; // 2: the continuation bytes of a 3 bytes char
+        lead = UTF8_THREE_BYTES_LEAD;
+    }
+    out += static_cast<char>(lead | (codePoint >> (UTF8_BITS_PER_BYTE * continuationNum)));
+    for (uint32_t i = continuationNum; i > 0; --i) {
+        uint32_t bits = (codePoint >> (UTF8_BITS_PER_BYTE * (i - 1))) & UTF8_CONTINUATION_MASK;
+        out += static_cast<char>(UTF8_CONTINUATION | bits);
+    }
+}
+
+bool AppendUnicodeChar(const char*& cur, const char* end, std::string& out)
+{
+    uint32_t codePoint = 0;
+    if (!ReadHex(cur, end, codePoint)) {
+        return false;
+    }
+    if (codePoint >= HIGH_SURROGATE_MIN && codePoint <= HIGH_SURROGATE_MAX) {
+        // a high surrogate must be followed by a low one
+        uint32_t lowSurrogate = 0;
+        if (static_cast<size_t>(end - cur) < UNICODE_ESCAPE_PREFIX_LEN || cur[0] != '\\' || cur[1] != 'u') {
+            return false;
+        }
+        cur += UNICODE_ESCAPE_PREFIX_LEN;
+        if (!ReadHex(cur, end, lowSurrogate) || lowSurrogate < LOW_SURROGATE_MIN || lowSurrogate > LOW_SURROGATE_MAX) {
+            return false;
+        }
+        codePoint = SURROGATE_OFFSET + ((codePoint - HIGH_SURROGATE_MIN) << SURROGATE_SHIFT) +
+            (lowSurrogate - LOW_SURROGATE_MIN);
+    }
+    AppendUtf8(codePoint, out);
+    return true;
+}
+
+char GetUnescapedChar(char c)
+{
+    switch (c) {
+        case 'b':
+            return '\b';
+        case 'f':
+            return '\f';
+        case 'n':
+            return '\n';
+        case 'r':
+            return '\r';
+        case 't':
+            return '\t';
+        case '\"':
+        case '\\':
+        case '/':
+            return c;
+        default:
+            return '\0';
+    }
+}
+}
+
+void EscapeJsonString(std::string& str)
+{
+    const char* data = str.data();
+    size_t len = str.size();
+    size_t pos = FindFirstEscapeChar(data, len);
+    if (pos == len) {
+        return;
+    }
+    // each escaped char takes one more byte, so they are counted first to allocate the result only once
+    size_t escapeNum = 0;
+    for (size_t i = pos; i < len; ++escapeNum) {
+        ++i;
+        i += FindFirstEscapeChar(data + i, len - i);
+    }
+    std::string result;
+    result.reserve(len + escapeNum);
+    result.append(data, pos);
+    while (pos < len) {
+        result.append(GetEscapeStr(data[pos]));
+        ++pos;
+        size_t cleanLen = FindFirstEscapeChar(data + pos, len - pos);
+        result.append(data + pos, cleanLen);
+        pos += cleanLen;
+    }
+    str.swap(result);
+}
+
+bool UnescapeJsonChars(const char* data, size_t len, std::string& out)
+{
+    const char* cur = data;
+    const char* end = data + len;
+    while (cur < end) {
+        const char* slash = static_cast<const char*>(std::memchr(cur, '\\', end - cur));
+        if (slash == nullptr) {
+            out.append(cur, end - cur);
+            return true;
+        }
+        out.append(cur, slash - cur);
+        cur = slash + 1;
+        if (cur == end) {
+            return false;
+        }
+        char escapedChar = *cur++;
+        if (escapedChar == 'u') {
+            if (!AppendUnicodeChar(cur, end, out)) {
+                return false;
+            }
+            continue;
+        }
+        char unescapedChar = GetUnescapedChar(escapedChar);
+        if (unescapedChar == '\0') {
+            return false;
+        }
+        out += unescapedChar;
+    }
+    return true;
+}
+} // namespace StringUtil
+} // namespace HiviewDFX
+} // namespace OHOS
@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef HIAPPEVENT_NDK_APPEVENT_ARENA_H
+#define HIAPPEVENT_NDK_APPEVENT_ARENA_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "hiappevent/hiappevent.h"
+
+namespace OHOS {
+namespace HiviewDFX {
+class AppEventPack;
+
+/*
+ * Lays out the C structs and the strings of the events delivered to the native callbacks in one buffer, which is
+ * reused by the next delivery of the same watcher. The returned pointers are valid until the next build.
+ */
+class NdkAppEventArena {
+public:
+    NdkAppEventArena() = default;
+    ~NdkAppEventArena() = default;
+    NdkAppEventArena(const NdkAppEventArena&) = delete;
+    NdkAppEventArena& operator=(const NdkAppEventArena&) = delete;
+
+    // the events are grouped by name in the order of the names, returns the num of groups
+    uint32_t BuildEventGroups(const std::vector<std::shared_ptr<AppEventPack>>& events,
+        const HiAppEvent_AppEventGroup*& groups);
+    const char* const* BuildEventStrs(const std::vector<std::shared_ptr<AppEventPack>>& events);
+
+    // releases the buffer grown too large by a big batch, called after the callback returns
+    void Trim();
+
+private:
+    size_t Reserve(size_t size);
+    size_t AppendStr(const std::string& str);
+
+    template<typename T>
+    T* At(size_t offset)
+    {
+        return reinterpret_cast<T*>(buffer_.data() + offset);
+    }
+
+private:
+    std::vector<char> buffer_;
+    size_t used_ = 0;
+    std::vector<std::string> names_;
+    std::vector<uint32_t> order_;
+    std::vector<size_t> strOffsets_;
+};
+} // namespace HiviewDFX
+} // namespace OHOS
+#endif // HIAPPEVENT_NDK_APPEVENT_ARENA_H
@@ -20,6 +20,7 @@
 
 #include "app_event_watcher.h"
 #include "hiappevent/hiappevent.h"
+#include "ndk_app_event_arena.h"
 
 namespace OHOS {
 namespace HiviewDFX {
@@ -28,6 +29,8 @@ public:
     explicit NdkAppEventWatcher(const std::string& name);
 
     void OnEvents(const std::vector<std::shared_ptr<AppEventPack>>& events) override;
+    bool CanDeliverFromMemory() override;
+    bool OnEventsFromMemory(const std::vector<std::shared_ptr<AppEventPack>>& events) override;
     bool IsRealTimeEvent(std::shared_ptr<AppEventPack> event) override;
     void SetTriggerCondition(int row, int size, int timeOut);
     int AddAppEventFilter(const char* domain, uint8_t eventTypes, const char* const *names, int namesLen);
@@ -37,9 +40,14 @@ public:
 protected:
     void OnTrigger(const HiAppEvent::TriggerCondition& triggerCond) override;
 
+private:
+    void DeliverEvents(const std::vector<std::shared_ptr<AppEventPack>>& events, bool isStored);
+
 private:
     OH_HiAppEvent_OnTrigger onTrigger_{nullptr};
     OH_HiAppEvent_OnReceive onReceive_{nullptr};
+    // the events given to onReceive are laid out in it, guarded by mutex_
+    NdkAppEventArena arena_;
     std::mutex mutex_;
 };
 } // namespace HiviewDFX
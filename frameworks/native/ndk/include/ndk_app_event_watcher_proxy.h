@@ -17,7 +17,9 @@
 #define HIAPPEVENT_NDK_APPEVENT_WATCHER_PROXY_H
 
 #include <memory>
+#include <mutex>
 
+#include "ndk_app_event_arena.h"
 #include "ndk_app_event_watcher.h"
 
 namespace OHOS {
@@ -39,6 +41,9 @@ public:
     int RemoveWatcher();
 private:
     std::shared_ptr<NdkAppEventWatcher> watcher_;
+    // the events given to onTake are laid out in it, guarded by takeMutex_
+    NdkAppEventArena takeArena_;
+    std::mutex takeMutex_;
 };
 
 } // namespace HiviewDFX
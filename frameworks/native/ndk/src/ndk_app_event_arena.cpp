@@ -0,0 +1,155 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "ndk_app_event_arena.h"
+
+#include <algorithm>
+
+#include "hiappevent_base.h"
+
+namespace OHOS {
+namespace HiviewDFX {
+namespace {
+// the buffer grown beyond it by a big batch is not kept for the next delivery
+constexpr size_t MAX_RETAINED_SIZE = 1024 * 1024; // 1M
+constexpr size_t STRUCT_ALIGN = alignof(std::max_align_t);
+// the offsets of the domain, the name and the params of each event
+constexpr size_t STR_NUM_PER_EVENT = 3;
+
+size_t AlignUp(size_t size)
+{
+    return (size + STRUCT_ALIGN - 1) & ~(STRUCT_ALIGN - 1);
+}
+}
+
+uint32_t NdkAppEventArena::BuildEventGroups(const std::vector<std::shared_ptr<AppEventPack>>& events,
+    const HiAppEvent_AppEventGroup*& groups)
+{
+    used_ = 0;
+    size_t eventNum = events.size();
+    names_.resize(eventNum);
+    order_.resize(eventNum);
+    for (size_t i = 0; i < eventNum; ++i) {
+        names_[i] = events[i]->GetName();
+        order_[i] = static_cast<uint32_t>(i);
+    }
+    std::stable_sort(order_.begin(), order_.end(), [this](uint32_t lhs, uint32_t rhs) {
+        return names_[lhs] < names_[rhs];
+    });
+    uint32_t groupNum = 0;
+    for (size_t i = 0; i < eventNum; ++i) {
+        if (i == 0 || names_[order_[i]] != names_[order_[i - 1]]) {
+            ++groupNum;
+        }
+    }
+
+    // the structs come first, and the strings follow them, the offsets are turned into pointers at last since the
+    // buffer may be grown by the strings
+    size_t groupsOffset = Reserve(groupNum * sizeof(HiAppEvent_AppEventGroup));
+    size_t infosOffset = Reserve(eventNum * sizeof(HiAppEvent_AppEventInfo));
+    strOffsets_.resize(eventNum * STR_NUM_PER_EVENT);
+    std::string domain;
+    size_t domainOffset = 0;
+    size_t nameOffset = 0;
+    for (size_t i = 0; i < eventNum; ++i) {
+        const auto& event = events[order_[i]];
+        if (i == 0 || names_[order_[i]] != names_[order_[i - 1]]) {
+            nameOffset = AppendStr(names_[order_[i]]);
+        }
+        std::string eventDomain = event->GetDomain();
+        if (i == 0 || eventDomain != domain) {
+            domain = std::move(eventDomain);
+            domainOffset = AppendStr(domain);
+        }
+        size_t* offsets = &strOffsets_[i * STR_NUM_PER_EVENT];
+        offsets[0] = domainOffset; // 0: domain
+        offsets[1] = nameOffset; // 1: name
+        offsets[2] = AppendStr(event->GetParamStr()); // 2: params
+    }
+
+    auto* infos = At<HiAppEvent_AppEventInfo>(infosOffset);
+    auto* eventGroups = At<HiAppEvent_AppEventGroup>(groupsOffset);
+    uint32_t groupIndex = 0;
+    for (size_t i = 0; i < eventNum; ++i) {
+        const size_t* offsets = &strOffsets_[i * STR_NUM_PER_EVENT];
+        infos[i].domain = At<const char>(offsets[0]); // 0: domain
+        infos[i].name = At<const char>(offsets[1]); // 1: name
+        infos[i].type = EventType(events[order_[i]]->GetType());
+        infos[i].params = At<const char>(offsets[2]); // 2: params
+        if (i == 0 || names_[order_[i]] != names_[order_[i - 1]]) {
+            eventGroups[groupIndex].name = infos[i].name;
+            eventGroups[groupIndex].appEventInfos = &infos[i];
+            eventGroups[groupIndex].infoLen = 0;
+            ++groupIndex;
+        }
+        ++eventGroups[groupIndex - 1].infoLen;
+    }
+    groups = eventGroups;
+    return groupNum;
+}
+
+const char* const* NdkAppEventArena::BuildEventStrs(const std::vector<std::shared_ptr<AppEventPack>>& events)
+{
+    used_ = 0;
+    size_t eventNum = events.size();
+    size_t strsOffset = Reserve(eventNum * sizeof(const char*));
+    strOffsets_.resize(eventNum);
+    for (size_t i = 0; i < eventNum; ++i) {
+        strOffsets_[i] = AppendStr(events[i]->GetEventStr());
+    }
+    auto* eventStrs = At<const char*>(strsOffset);
+    for (size_t i = 0; i < eventNum; ++i) {
+        eventStrs[i] = At<const char>(strOffsets_[i]);
+    }
+    return eventStrs;
+}
+
+void NdkAppEventArena::Trim()
+{
+    if (buffer_.size() <= MAX_RETAINED_SIZE) {
+        return;
+    }
+    std::vector<char>().swap(buffer_);
+    std::vector<std::string>().swap(names_);
+    std::vector<uint32_t>().swap(order_);
+    std::vector<size_t>().swap(strOffsets_);
+    used_ = 0;
+}
+
+size_t NdkAppEventArena::Reserve(size_t size)
+{
+    size_t offset = AlignUp(used_);
+    size_t end = offset + size;
+    if (end > buffer_.size()) {
+        // grown to the high-water mark of the deliveries, and kept for the next ones
+        buffer_.resize(std::max(end, buffer_.size() * 2)); // 2: double the buffer to amortize the growth
+    }
+    used_ = end;
+    return offset;
+}
+
+size_t NdkAppEventArena::AppendStr(const std::string& str)
+{
+    size_t offset = used_;
+    size_t end = offset + str.size() + 1; // 1: '\0'
+    if (end > buffer_.size()) {
+        buffer_.resize(std::max(end, buffer_.size() * 2)); // 2: double the buffer to amortize the growth
+    }
+    std::copy(str.begin(), str.end(), buffer_.begin() + offset);
+    buffer_[end - 1] = '\0';
+    used_ = end;
+    return offset;
+}
+} // namespace HiviewDFX
+} // namespace OHOS
@@ -77,38 +77,44 @@ void NdkAppEventWatcher::OnEvents(const std::vector<std::shared_ptr<AppEventPack
     if (events.empty() || onReceive_ == nullptr) {
         return;
     }
-    std::unordered_map<std::string, std::vector<HiAppEvent_AppEventInfo>> eventMap;
-    constexpr size_t strNumPieceEvent = 3;
-    std::vector<std::string> strings(strNumPieceEvent * events.size());
-    size_t strIndex = 0;
-    std::vector<int64_t> eventSeqs;
-    for (const auto &event : events) {
-        auto& appEventInfo = eventMap[event->GetName()].emplace_back();
-        strings[strIndex] = event->GetDomain();
-        appEventInfo.domain = strings[strIndex++].c_str();
-        strings[strIndex] = event->GetName();
-        appEventInfo.name = strings[strIndex++].c_str();
-        strings[strIndex] = event->GetParamStr();
-        appEventInfo.params = strings[strIndex++].c_str();
-        appEventInfo.type = EventType(event->GetType());
-        eventSeqs.emplace_back(event->GetSeq());
-    }
-    std::vector<HiAppEvent_AppEventGroup> appEventGroup(eventMap.size());
-    uint32_t appEventIndex = 0;
-    for (const auto &[k, v] : eventMap) {
-        appEventGroup[appEventIndex].name = k.c_str();
-        appEventGroup[appEventIndex].appEventInfos = v.data();
-        appEventGroup[appEventIndex].infoLen = v.size();
-        appEventIndex++;
+    DeliverEvents(events, true);
+}
+
+bool NdkAppEventWatcher::CanDeliverFromMemory()
+{
+    // onReceive is called synchronously, so the events are delivered once it is set
+    return true;
+}
+
+bool NdkAppEventWatcher::OnEventsFromMemory(const std::vector<std::shared_ptr<AppEventPack>> &events)
+{
+    std::lock_guard<std::mutex> lockGuard(mutex_);
+    if (events.empty() || onReceive_ == nullptr) {
+        return false;
     }
-    int64_t observerSeq = GetSeq();
-    if (!AppEventStoreFacade::DeleteData(observerSeq, eventSeqs)) {
-        HILOG_ERROR(LOG_CORE, "failed to delete mapping data, seq=%{public}" PRId64 ", event num=%{public}zu",
-            observerSeq, eventSeqs.size());
+    DeliverEvents(events, false);
+    return true;
+}
+
+void NdkAppEventWatcher::DeliverEvents(const std::vector<std::shared_ptr<AppEventPack>> &events, bool isStored)
+{
+    const HiAppEvent_AppEventGroup* appEventGroups = nullptr;
+    uint32_t groupLen = arena_.BuildEventGroups(events, appEventGroups);
+    if (isStored) {
+        std::vector<int64_t> eventSeqs;
+        for (const auto &event : events) {
+            eventSeqs.emplace_back(event->GetSeq());
+        }
+        int64_t observerSeq = GetSeq();
+        if (!AppEventStoreFacade::DeleteData(observerSeq, eventSeqs)) {
+            HILOG_ERROR(LOG_CORE, "failed to delete mapping data, seq=%{public}" PRId64 ", event num=%{public}zu",
+                observerSeq, eventSeqs.size());
+        }
     }
     AppEventUtil::ReportAppEventReceive(events, GetName(), "onReceive");
     std::string domain = events[0]->GetDomain();
-    onReceive_(domain.c_str(), appEventGroup.data(), static_cast<uint32_t>(eventMap.size()));
+    onReceive_(domain.c_str(), appEventGroups, groupLen);
+    arena_.Trim();
 }
 
 void NdkAppEventWatcher::OnTrigger(const HiAppEvent::TriggerCondition &triggerCond)
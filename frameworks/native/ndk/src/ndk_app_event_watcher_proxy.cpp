@@ -79,14 +79,11 @@ int NdkAppEventWatcherProxy::TakeWatcherData(uint32_t size, OH_HiAppEvent_OnTake
         HILOG_WARN(LOG_CORE, "failed to query events, seq=%{public}" PRId64, watcher_->GetSeq());
         return ErrorCode::ERROR_UNKNOWN;
     }
-    std::vector<std::string> eventStrs(events.size());
-    std::vector<const char*> retEvents(events.size());
-    for (size_t t = 0; t < events.size(); ++t) {
-        eventStrs[t] = events[t]->GetEventStr();
-        retEvents[t] = eventStrs[t].c_str();
-    }
+    std::lock_guard<std::mutex> lockGuard(takeMutex_);
+    const char* const* eventStrs = takeArena_.BuildEventStrs(events);
     AppEventUtil::ReportAppEventReceive(events, watcher_->GetName(), "takeNext");
-    onTake(retEvents.data(), static_cast<int32_t>(eventStrs.size()));
+    onTake(eventStrs, static_cast<uint32_t>(events.size()));
+    takeArena_.Trim();
     return 0;
 }
 
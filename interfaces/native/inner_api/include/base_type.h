@@ -73,6 +73,9 @@ struct EventConfig {
     /* Specifies whether the event is a real-time report event */
     bool isRealTime = false;
 
+    /* Specifies the condition on the event params that can be reported, e.g. "foreground == true" */
+    std::string condition;
+
     bool IsValidEvent(std::shared_ptr<AppEventPack> event) const;
 
     bool IsRealTimeEvent(std::shared_ptr<AppEventPack> event) const;
@@ -82,10 +82,7 @@ int Write(const Event& event)
     }
     int ret = AppEventVerifyFacade::VerifyTheAppEvent(event.eventPack_);
     if (ret >= 0) {
-        auto appEventPack = event.eventPack_;
-        AppEventObserverFacade::SubmitTaskToFFRTQueue([appEventPack] () {
-            AppEventWriteFacade::FacadeWriteEvent(appEventPack);
-            }, "app_event");
+        AppEventWriteFacade::FacadeSubmitWritingTask(event.eventPack_, "app_event");
     }
     return ret;
 }
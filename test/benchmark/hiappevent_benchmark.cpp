@@ -0,0 +1,341 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "api_stats_mgr.h"
+#include "app_event_observer_mgr.h"
+#include "app_event_store.h"
+#include "app_event_watcher.h"
+#include "hiappevent_base.h"
+#include "hiappevent_config.h"
+#include "hiappevent_verify.h"
+#include "string_util.h"
+
+using namespace OHOS::HiviewDFX;
+using namespace OHOS::HiviewDFX::HiAppEvent;
+
+namespace {
+const std::string TEST_DIR = "/data/test/hiappevent/";
+const std::string TEST_DOMAIN = "bench_domain";
+const std::string TEST_NAME = "bench_name";
+const std::string TEST_KEY = "bench_key";
+const std::string TEST_STR = "bench_string_value";
+const std::string TEST_OBSERVER = "bench_observer";
+constexpr int TEST_TYPE = 1;
+constexpr uint32_t TAKE_BATCH_SIZE = 100;
+
+std::shared_ptr<AppEventPack> CreateEvent()
+{
+    auto event = std::make_shared<AppEventPack>(TEST_DOMAIN, TEST_NAME, TEST_TYPE);
+    event->AddParam("bool_key", true);
+    event->AddParam("int_key", 1);
+    event->AddParam("int64_key", static_cast<int64_t>(1));
+    event->AddParam("double_key", 1.0);
+    event->AddParam("str_key", TEST_STR);
+    event->AddParam("int_arr_key", std::vector<int>{1, 2, 3});
+    event->AddParam("str_arr_key", std::vector<std::string>{TEST_STR, TEST_STR});
+    return event;
+}
+
+// the params of the crash events are tens of KB of the repetitive stack frames and log lines
+std::shared_ptr<AppEventPack> CreateCrashEvent()
+{
+    constexpr int frameNum = 200;
+    constexpr int logLineNum = 100;
+    auto event = std::make_shared<AppEventPack>("OS", "APP_CRASH", TEST_TYPE);
+    std::vector<std::string> frames;
+    for (int i = 0; i < frameNum; ++i) {
+        frames.emplace_back("#" + std::to_string(i) + " pc 00000000000" + std::to_string(i * 7919) // 7919 for pc
+            + " /system/lib64/platformsdk/libace_napi.z.so(napi_call_function+" + std::to_string(i) + ")");
+    }
+    std::vector<std::string> hilog(logLineNum, "10-19 12:00:00.123 1234 1234 I C01234/AppMgr: process died");
+    event->AddParam("crash_type", std::string("NativeCrash"));
+    event->AddParam("bundle_name", std::string("com.example.myapplication"));
+    event->AddParam("frames", frames);
+    event->AddParam("hilog", hilog);
+    return event;
+}
+
+void ResetDbStore()
+{
+    HiAppEventConfig::GetInstance().SetStorageDir(TEST_DIR);
+    AppEventStore::GetInstance().DestroyDbStore();
+    AppEventStore::GetInstance().InitDbStore();
+}
+
+// prepares the db with the rows mapped to one observer, and returns the seq of the observer
+int64_t PrepareRows(int64_t rowNum)
+{
+    ResetDbStore();
+    auto& store = AppEventStore::GetInstance();
+    int64_t observerSeq = store.InsertObserver(AppEventCacheCommon::Observer(TEST_OBSERVER, 0));
+    auto event = CreateEvent();
+    std::vector<AppEventCacheCommon::EventObserverInfo> eventObservers;
+    for (int64_t i = 0; i < rowNum; ++i) {
+        eventObservers.emplace_back(store.InsertEvent(event), observerSeq);
+    }
+    store.InsertEventMapping(eventObservers);
+    return observerSeq;
+}
+
+void BM_AppEventPackConstruct(benchmark::State& state)
+{
+    for (auto _ : state) {
+        AppEventPack event(TEST_DOMAIN, TEST_NAME, TEST_TYPE);
+        benchmark::DoNotOptimize(event);
+    }
+}
+BENCHMARK(BM_AppEventPackConstruct);
+
+template<typename T>
+void RegisterAddParamBenchmark(const std::string& typeName, const T& value)
+{
+    std::string name = "BM_AppEventPackAddParam/" + typeName;
+    benchmark::RegisterBenchmark(name.c_str(), [value](benchmark::State& state) {
+        for (auto _ : state) {
+            AppEventPack event(TEST_DOMAIN, TEST_NAME, TEST_TYPE);
+            event.AddParam(TEST_KEY, value);
+            benchmark::DoNotOptimize(event);
+        }
+    });
+}
+
+void RegisterAddParamBenchmarks()
+{
+    constexpr size_t arrSize = 10;
+    RegisterAddParamBenchmark("bool", true);
+    RegisterAddParamBenchmark("int8", static_cast<int8_t>(1));
+    RegisterAddParamBenchmark("char", 'c');
+    RegisterAddParamBenchmark("int16", static_cast<int16_t>(1));
+    RegisterAddParamBenchmark("int", 1);
+    RegisterAddParamBenchmark("int64", static_cast<int64_t>(1));
+    RegisterAddParamBenchmark("float", 1.0f);
+    RegisterAddParamBenchmark("double", 1.0);
+    RegisterAddParamBenchmark("cstring", TEST_STR.c_str());
+    RegisterAddParamBenchmark("string", TEST_STR);
+    RegisterAddParamBenchmark("bool_array", std::vector<bool>(arrSize, true));
+    RegisterAddParamBenchmark("int8_array", std::vector<int8_t>(arrSize, 1));
+    RegisterAddParamBenchmark("char_array", std::vector<char>(arrSize, 'c'));
+    RegisterAddParamBenchmark("int16_array", std::vector<int16_t>(arrSize, 1));
+    RegisterAddParamBenchmark("int_array", std::vector<int>(arrSize, 1));
+    RegisterAddParamBenchmark("int64_array", std::vector<int64_t>(arrSize, 1));
+    RegisterAddParamBenchmark("float_array", std::vector<float>(arrSize, 1.0f));
+    RegisterAddParamBenchmark("double_array", std::vector<double>(arrSize, 1.0));
+    RegisterAddParamBenchmark("cstring_array", std::vector<const char*>(arrSize, TEST_STR.c_str()));
+    RegisterAddParamBenchmark("string_array", std::vector<std::string>(arrSize, TEST_STR));
+}
+
+void BM_VerifyAppEvent(benchmark::State& state)
+{
+    auto event = CreateEvent();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(VerifyAppEvent(event));
+    }
+}
+BENCHMARK(BM_VerifyAppEvent);
+
+void BM_GetEventStr(benchmark::State& state)
+{
+    auto event = CreateEvent();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(event->GetEventStr());
+    }
+}
+BENCHMARK(BM_GetEventStr);
+
+void BM_GetParamStr(benchmark::State& state)
+{
+    auto event = CreateEvent();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(event->GetParamStr());
+    }
+}
+BENCHMARK(BM_GetParamStr);
+
+// strings without any char to escape, which is the common case of the param values
+void BM_FindFirstEscapeChar(benchmark::State& state)
+{
+    std::string str(state.range(0), 'a');
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(StringUtil::FindFirstEscapeChar(str.data(), str.size()));
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_FindFirstEscapeChar)->RangeMultiplier(8)->Range(16, 1 << 20);
+
+// one char of every 16 chars needs to be escaped
+void BM_EscapeJsonString(benchmark::State& state)
+{
+    constexpr size_t dirtyStep = 16;
+    std::string origin(state.range(0), 'a');
+    for (size_t i = 0; i < origin.size(); i += dirtyStep) {
+        origin[i] = '"';
+    }
+    for (auto _ : state) {
+        std::string str = origin;
+        StringUtil::EscapeJsonString(str);
+        benchmark::DoNotOptimize(str);
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_EscapeJsonString)->RangeMultiplier(8)->Range(16, 1 << 20);
+
+void BM_StoreInsertEvent(benchmark::State& state)
+{
+    PrepareRows(state.range(0));
+    auto event = CreateEvent();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(AppEventStore::GetInstance().InsertEvent(event));
+    }
+    AppEventStore::GetInstance().DestroyDbStore();
+}
+BENCHMARK(BM_StoreInsertEvent)->Arg(1000)->Arg(10000)->Arg(100000)->Unit(benchmark::kMicrosecond);
+
+void BM_StoreQueryEvents(benchmark::State& state)
+{
+    int64_t observerSeq = PrepareRows(state.range(0));
+    for (auto _ : state) {
+        std::vector<std::shared_ptr<AppEventPack>> events;
+        AppEventStore::GetInstance().QueryEvents(events, observerSeq, TAKE_BATCH_SIZE);
+        benchmark::DoNotOptimize(events);
+    }
+    AppEventStore::GetInstance().DestroyDbStore();
+}
+BENCHMARK(BM_StoreQueryEvents)->Arg(1000)->Arg(10000)->Arg(100000)->Unit(benchmark::kMicrosecond);
+
+void BM_StoreTakeEvents(benchmark::State& state)
+{
+    int64_t observerSeq = PrepareRows(state.range(0));
+    auto& store = AppEventStore::GetInstance();
+    for (auto _ : state) {
+        std::vector<std::shared_ptr<AppEventPack>> events;
+        store.TakeEvents(events, observerSeq, TAKE_BATCH_SIZE);
+
+        // map the taken events again so that every iteration takes from the same number of rows
+        state.PauseTiming();
+        std::vector<AppEventCacheCommon::EventObserverInfo> eventObservers;
+        for (const auto& event : events) {
+            eventObservers.emplace_back(event->GetSeq(), observerSeq);
+        }
+        store.InsertEventMapping(eventObservers);
+        state.ResumeTiming();
+    }
+    store.DestroyDbStore();
+}
+BENCHMARK(BM_StoreTakeEvents)->Arg(1000)->Arg(10000)->Arg(100000)->Unit(benchmark::kMicrosecond);
+
+void BM_StoreInsertCrashEvent(benchmark::State& state)
+{
+    ResetDbStore();
+    auto event = CreateCrashEvent();
+    size_t paramSize = event->GetParamStr().size();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(AppEventStore::GetInstance().InsertEvent(event));
+    }
+    state.SetBytesProcessed(state.iterations() * paramSize);
+    AppEventStore::GetInstance().DestroyDbStore();
+}
+BENCHMARK(BM_StoreInsertCrashEvent)->Unit(benchmark::kMicrosecond);
+
+// the params of the crash events are decompressed when they are read
+void BM_StoreQueryCrashEvents(benchmark::State& state)
+{
+    ResetDbStore();
+    auto& store = AppEventStore::GetInstance();
+    int64_t observerSeq = store.InsertObserver(AppEventCacheCommon::Observer(TEST_OBSERVER, 0));
+    auto event = CreateCrashEvent();
+    std::vector<AppEventCacheCommon::EventObserverInfo> eventObservers;
+    for (uint32_t i = 0; i < TAKE_BATCH_SIZE; ++i) {
+        eventObservers.emplace_back(store.InsertEvent(event), observerSeq);
+    }
+    store.InsertEventMapping(eventObservers);
+    size_t paramSize = event->GetParamStr().size();
+    for (auto _ : state) {
+        std::vector<std::shared_ptr<AppEventPack>> events;
+        store.QueryEvents(events, observerSeq, TAKE_BATCH_SIZE);
+        for (const auto& queriedEvent : events) {
+            benchmark::DoNotOptimize(queriedEvent->GetParamStr());
+        }
+    }
+    state.SetBytesProcessed(state.iterations() * TAKE_BATCH_SIZE * paramSize);
+    store.DestroyDbStore();
+}
+BENCHMARK(BM_StoreQueryCrashEvents)->Unit(benchmark::kMicrosecond);
+
+void BM_HandleEvents(benchmark::State& state)
+{
+    ResetDbStore();
+    auto& observerMgr = AppEventObserverMgr::GetInstance();
+    std::vector<int64_t> observerSeqs;
+    for (int64_t i = 0; i < state.range(0); ++i) {
+        std::vector<AppEventFilter> filters = { AppEventFilter(TEST_DOMAIN) };
+        auto watcher = std::make_shared<AppEventWatcher>(TEST_OBSERVER + std::to_string(i), filters,
+            TriggerCondition());
+        observerSeqs.emplace_back(observerMgr.AddWatcher(watcher));
+    }
+    for (auto _ : state) {
+        std::vector<std::shared_ptr<AppEventPack>> events = { CreateEvent() };
+        observerMgr.HandleEvents(events);
+    }
+    for (auto observerSeq : observerSeqs) {
+        observerMgr.RemoveObserver(observerSeq);
+    }
+    AppEventStore::GetInstance().DestroyDbStore();
+}
+BENCHMARK(BM_HandleEvents)->Arg(1)->Arg(8)->Arg(32)->Unit(benchmark::kMicrosecond);
+
+void BM_ApiStatsAddRecord(benchmark::State& state)
+{
+    static ApiStatsManager apiStatsMgr;
+    ApiDescriptor descriptor("bench_kit", "bench_api_" + std::to_string(state.thread_index()));
+    ApiMetric metric{0, 100, true};
+    for (auto _ : state) {
+        apiStatsMgr.AddRecord(descriptor, metric);
+    }
+}
+BENCHMARK(BM_ApiStatsAddRecord)->ThreadRange(1, 16);
+}
+
+// the results are printed as json by default, so that they can be compared across releases
+int main(int argc, char** argv)
+{
+    const char* jsonFormatArg = "--benchmark_format=json";
+    std::vector<char*> args(argv, argv + argc);
+    bool hasFormatArg = false;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strncmp(argv[i], "--benchmark_format", std::strlen("--benchmark_format")) == 0) {
+            hasFormatArg = true;
+        }
+    }
+    if (!hasFormatArg) {
+        args.emplace_back(const_cast<char*>(jsonFormatArg));
+    }
+    int argNum = static_cast<int>(args.size());
+    RegisterAddParamBenchmarks();
+    benchmark::Initialize(&argNum, args.data());
+    if (benchmark::ReportUnrecognizedArguments(argNum, args.data())) {
+        return 1;
+    }
+    benchmark::AddCustomContext("component", "hiappevent");
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
@@ -0,0 +1,166 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <future>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "app_event_observer_mgr.h"
+#include "app_event_store.h"
+#include "app_event_watcher.h"
+#include "hiappevent_base.h"
+#include "hiappevent_verify.h"
+#include "hiappevent_write.h"
+
+using namespace OHOS::HiviewDFX;
+using namespace OHOS::HiviewDFX::HiAppEvent;
+
+namespace {
+const std::string HOST_DOMAIN = "host_domain";
+const std::string HOST_NAME = "host_name";
+const std::string HOST_WATCHER = "host_watcher";
+constexpr int HOST_TYPE = 1;
+
+struct PipelineOptions {
+    int eventNum = 10000;
+    int watcherNum = 4;
+    int triggerRow = 100;
+};
+
+class HostWatcher : public AppEventWatcher {
+public:
+    HostWatcher(const std::string& name, const std::vector<AppEventFilter>& filters, TriggerCondition cond)
+        : AppEventWatcher(name, filters, cond) {}
+
+    void OnTrigger(const TriggerCondition& triggerCond) override
+    {
+        std::vector<std::shared_ptr<AppEventPack>> events;
+        if (AppEventStore::GetInstance().TakeEvents(events, GetSeq()) == 0) {
+            takenNum_ += static_cast<int64_t>(events.size());
+        }
+    }
+
+    int64_t GetTakenNum() const
+    {
+        return takenNum_;
+    }
+
+private:
+    std::atomic<int64_t> takenNum_ = 0;
+};
+
+void PrintUsage(const char* name)
+{
+    printf("usage: %s [--events N] [--watchers N] [--row N]\n", name);
+}
+
+bool ParseOptions(int argc, char* argv[], PipelineOptions& options)
+{
+    for (int i = 1; i + 1 < argc; i += 2) { // 2 means the option and its value
+        int value = atoi(argv[i + 1]);
+        if (strcmp(argv[i], "--events") == 0 && value > 0) {
+            options.eventNum = value;
+        } else if (strcmp(argv[i], "--watchers") == 0 && value >= 0) {
+            options.watcherNum = value;
+        } else if (strcmp(argv[i], "--row") == 0 && value > 0) {
+            options.triggerRow = value;
+        } else {
+            return false;
+        }
+    }
+    return argc % 2 == 1; // each option must have a value
+}
+
+std::shared_ptr<AppEventPack> CreateEvent(int index)
+{
+    auto event = std::make_shared<AppEventPack>(HOST_DOMAIN, HOST_NAME, HOST_TYPE);
+    event->AddParam("int_key", index);
+    event->AddParam("str_key", "host_string_value");
+    event->AddParam("int_arr_key", std::vector<int>{1, 2, 3});
+    return event;
+}
+
+// waits for the tasks submitted before to finish, the writing tasks run in order on the queue of the mgr
+void WaitForWritingTasks()
+{
+    auto done = std::make_shared<std::promise<void>>();
+    auto future = done->get_future();
+    AppEventObserverMgr::GetInstance().SubmitTaskToFFRTQueue([done] { done->set_value(); }, "host_wait");
+    future.wait();
+}
+}
+
+/*
+ * Drives the write pipeline of libhiappevent on a host machine: the events are verified, written by the
+ * writing tasks, stored into the db and taken by the watchers.
+ */
+int main(int argc, char* argv[])
+{
+    PipelineOptions options;
+    if (!ParseOptions(argc, argv, options)) {
+        PrintUsage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    auto& observerMgr = AppEventObserverMgr::GetInstance();
+    std::vector<std::shared_ptr<HostWatcher>> watchers;
+    std::vector<int64_t> observerSeqs;
+    for (int i = 0; i < options.watcherNum; ++i) {
+        TriggerCondition cond;
+        cond.row = options.triggerRow;
+        auto watcher = std::make_shared<HostWatcher>(HOST_WATCHER + std::to_string(i),
+            std::vector<AppEventFilter>{ AppEventFilter(HOST_DOMAIN) }, cond);
+        observerSeqs.emplace_back(observerMgr.AddWatcher(watcher));
+        watchers.emplace_back(watcher);
+    }
+    WaitForWritingTasks();
+
+    auto beginTime = std::chrono::steady_clock::now();
+    int failedNum = 0;
+    for (int i = 0; i < options.eventNum; ++i) {
+        auto event = CreateEvent(i);
+        if (VerifyAppEvent(event) != 0) {
+            ++failedNum;
+            continue;
+        }
+        SubmitWritingTask(event, "host_write");
+    }
+    auto submitTime = std::chrono::steady_clock::now();
+    WaitForWritingTasks();
+    auto endTime = std::chrono::steady_clock::now();
+
+    auto submitUs = std::chrono::duration_cast<std::chrono::microseconds>(submitTime - beginTime).count();
+    auto totalUs = std::chrono::duration_cast<std::chrono::microseconds>(endTime - beginTime).count();
+    printf("events=%d, watchers=%d, row=%d, verify_failed=%d\n", options.eventNum, options.watcherNum,
+        options.triggerRow, failedNum);
+    printf("submit: %" PRId64 " us, write: %" PRId64 " us, %.1f events/s\n", static_cast<int64_t>(submitUs),
+        static_cast<int64_t>(totalUs), totalUs > 0 ? options.eventNum * 1e6 / totalUs : 0.0);
+    for (const auto& watcher : watchers) {
+        printf("%s: taken=%" PRId64 "\n", watcher->GetName().c_str(), watcher->GetTakenNum());
+    }
+
+    for (auto observerSeq : observerSeqs) {
+        observerMgr.RemoveObserver(observerSeq);
+    }
+    WaitForWritingTasks();
+    return failedNum == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef HIAPPEVENT_TEST_HOST_INCLUDE_APPLICATION_CONTEXT_H
+#define HIAPPEVENT_TEST_HOST_INCLUDE_APPLICATION_CONTEXT_H
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace OHOS {
+namespace AbilityRuntime {
+class AbilityLifecycleCallbackArgs {};
+
+class AbilityLifecycleCallback {
+public:
+    virtual ~AbilityLifecycleCallback() = default;
+    virtual void OnAbilityCreate(const AbilityLifecycleCallbackArgs& ability) {}
+    virtual void OnWindowStageCreate(const AbilityLifecycleCallbackArgs& ability,
+        const AbilityLifecycleCallbackArgs& windowStage) {}
+    virtual void OnWindowStageDestroy(const AbilityLifecycleCallbackArgs& ability,
+        const AbilityLifecycleCallbackArgs& windowStage) {}
+    virtual void OnWindowStageActive(const AbilityLifecycleCallbackArgs& ability,
+        const AbilityLifecycleCallbackArgs& windowStage) {}
+    virtual void OnWindowStageInactive(const AbilityLifecycleCallbackArgs& ability,
+        const AbilityLifecycleCallbackArgs& windowStage) {}
+    virtual void OnAbilityDestroy(const AbilityLifecycleCallbackArgs& ability) {}
+    virtual void OnAbilityForeground(const AbilityLifecycleCallbackArgs& ability) {}
+    virtual void OnAbilityBackground(const AbilityLifecycleCallbackArgs& ability) {}
+    virtual void OnAbilityContinue(const AbilityLifecycleCallbackArgs& ability) {}
+};
+
+/*
+ * Host stand-in of the application context. The sandbox dirs are placed under
+ * $HIAPPEVENT_HOST_DIR, or under /tmp/hiappevent_host when it is not set.
+ */
+class ApplicationContext {
+public:
+    static std::shared_ptr<ApplicationContext> GetInstance();
+
+    std::string GetBundleName() const;
+    std::string GetFilesDir() const;
+    std::string GetCacheDir() const;
+    std::string GetAppRunningUniqueId() const;
+    void RegisterAbilityLifecycleCallback(const std::shared_ptr<AbilityLifecycleCallback>& callback);
+    void UnregisterAbilityLifecycleCallback(const std::shared_ptr<AbilityLifecycleCallback>& callback);
+
+    // notifies the registered callbacks as if the app were moved to background
+    void DispatchOnAbilityBackground();
+
+private:
+    std::mutex mutex_;
+    std::vector<std::shared_ptr<AbilityLifecycleCallback>> callbacks_;
+};
+
+class Context {
+public:
+    static std::shared_ptr<ApplicationContext> GetApplicationContext()
+    {
+        return ApplicationContext::GetInstance();
+    }
+};
+} // namespace AbilityRuntime
+} // namespace OHOS
+#endif // HIAPPEVENT_TEST_HOST_INCLUDE_APPLICATION_CONTEXT_H
@@ -0,0 +1,43 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef HIAPPEVENT_TEST_HOST_INCLUDE_BUNDLE_MGR_INTERFACE_H
+#define HIAPPEVENT_TEST_HOST_INCLUDE_BUNDLE_MGR_INTERFACE_H
+
+#include <cstdint>
+#include <string>
+
+#include "errors.h"
+#include "refbase.h"
+
+namespace OHOS {
+namespace AppExecFwk {
+enum class GetBundleInfoFlag {
+    GET_BUNDLE_INFO_DEFAULT = 0x00000000,
+    GET_BUNDLE_INFO_WITH_REQUESTED_PERMISSION = 0x00000004,
+};
+
+struct BundleInfo {
+    std::string name;
+    std::string versionName;
+};
+
+class IBundleMgr : public IRemoteObject {
+public:
+    virtual ErrCode GetBundleInfoForSelf(int32_t flags, BundleInfo& bundleInfo) = 0;
+};
+} // namespace AppExecFwk
+} // namespace OHOS
+#endif // HIAPPEVENT_TEST_HOST_INCLUDE_BUNDLE_MGR_INTERFACE_H
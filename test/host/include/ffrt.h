@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef HIAPPEVENT_TEST_HOST_INCLUDE_FFRT_H
+#define HIAPPEVENT_TEST_HOST_INCLUDE_FFRT_H
+
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <memory>
+#include <string>
+
+// host stand-in of ffrt: tasks run on a fixed thread pool, queues run their tasks in order on one thread each
+typedef int ffrt_timer_t;
+typedef int ffrt_qos_t;
+typedef void (*ffrt_timer_cb)(void* data);
+
+typedef enum {
+    ffrt_error = -1,
+    ffrt_success = 0,
+} ffrt_error_t;
+
+typedef enum {
+    ffrt_qos_inherit = -1,
+    ffrt_qos_background,
+    ffrt_qos_utility,
+    ffrt_qos_default,
+    ffrt_qos_user_initiated,
+} ffrt_qos_default_t;
+
+ffrt_timer_t ffrt_timer_start(ffrt_qos_t qos, uint64_t timeout, void* data, ffrt_timer_cb cb, bool repeat);
+int ffrt_timer_stop(ffrt_qos_t qos, ffrt_timer_t handle);
+
+namespace ffrt {
+using std::future;
+using std::future_status;
+using std::promise;
+
+class task_attr {
+public:
+    task_attr& name(const char* name)
+    {
+        name_ = name == nullptr ? "" : name;
+        return *this;
+    }
+
+    task_attr& qos(int qos)
+    {
+        qos_ = qos;
+        return *this;
+    }
+
+    // delay in microseconds
+    task_attr& delay(uint64_t delayUs)
+    {
+        delayUs_ = delayUs;
+        return *this;
+    }
+
+    const std::string& name() const
+    {
+        return name_;
+    }
+
+    uint64_t delay() const
+    {
+        return delayUs_;
+    }
+
+private:
+    std::string name_;
+    int qos_ = ffrt_qos_default;
+    uint64_t delayUs_ = 0;
+};
+
+class queue_attr {
+public:
+    queue_attr& qos(int qos)
+    {
+        qos_ = qos;
+        return *this;
+    }
+
+private:
+    int qos_ = ffrt_qos_default;
+};
+
+class queue {
+public:
+    explicit queue(const char* name, const queue_attr& attr = {});
+    ~queue();
+    queue(const queue&) = delete;
+    queue& operator=(const queue&) = delete;
+
+    void submit(const std::function<void()>& func, const task_attr& attr = {});
+    void submit(std::function<void()>&& func, const task_attr& attr = {});
+
+private:
+    class QueueImpl;
+    std::shared_ptr<QueueImpl> impl_;
+};
+
+void submit(const std::function<void()>& func, const task_attr& attr = {});
+void submit(std::function<void()>&& func, const task_attr& attr = {});
+} // namespace ffrt
+#endif // HIAPPEVENT_TEST_HOST_INCLUDE_FFRT_H
@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef HIAPPEVENT_TEST_HOST_INCLUDE_HIAPPEVENT_HOST_COMPAT_H
+#define HIAPPEVENT_TEST_HOST_INCLUDE_HIAPPEVENT_HOST_COMPAT_H
+
+/*
+ * Force included into every host translation unit. It provides the musl extensions used by the
+ * sources and the std headers which the device toolchain pulls in transitively.
+ */
+#ifdef __cplusplus
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#endif
+
+#include <stdint.h>
+#include <sys/types.h>
+#include <time.h>
+#include <unistd.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+enum fdsan_owner_type {
+    FDSAN_OWNER_TYPE_DEFAULT = 0,
+    FDSAN_OWNER_TYPE_FILE = 1,
+};
+
+// glibc has no fd ownership tracking, the tags are ignored
+static inline uint64_t fdsan_create_owner_tag(enum fdsan_owner_type type, uint64_t tag)
+{
+    return tag;
+}
+
+static inline void fdsan_exchange_owner_tag(int fd, uint64_t expectedTag, uint64_t newTag) {}
+
+static inline int fdsan_close_with_tag(int fd, uint64_t tag)
+{
+    return close(fd);
+}
+
+static inline pid_t getprocpid(void)
+{
+    return getpid();
+}
+
+static inline pid_t getproctid(void)
+{
+    return gettid();
+}
+
+static inline struct tm* localtime_noenv_r(const time_t* timep, struct tm* result)
+{
+    return localtime_r(timep, result);
+}
+#ifdef __cplusplus
+}
+#endif
+#endif // HIAPPEVENT_TEST_HOST_INCLUDE_HIAPPEVENT_HOST_COMPAT_H
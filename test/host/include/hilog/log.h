@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef HIAPPEVENT_TEST_HOST_INCLUDE_HILOG_LOG_H
+#define HIAPPEVENT_TEST_HOST_INCLUDE_HILOG_LOG_H
+
+#include <cinttypes>
+
+// host stand-in of hilog, the logs are printed to stderr
+typedef enum {
+    LOG_APP = 0,
+    LOG_INIT = 1,
+    LOG_CORE = 3,
+    LOG_KMSG = 4,
+} LogType;
+
+typedef enum {
+    LOG_DEBUG = 3,
+    LOG_INFO = 4,
+    LOG_WARN = 5,
+    LOG_ERROR = 6,
+    LOG_FATAL = 7,
+} LogLevel;
+
+#ifndef LOG_DOMAIN
+#define LOG_DOMAIN 0
+#endif
+
+#ifndef LOG_TAG
+#define LOG_TAG nullptr
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+// the privacy flags like %{public}s are dropped before the message is formatted
+int HiLogPrint(LogType type, LogLevel level, unsigned int domain, const char* tag, const char* fmt, ...);
+bool HiLogIsLoggable(unsigned int domain, const char* tag, LogLevel level);
+#ifdef __cplusplus
+}
+#endif
+
+#define HILOG_IMPL(type, level, domain, tag, ...) HiLogPrint(type, level, domain, tag, ##__VA_ARGS__)
+#define HILOG_DEBUG(type, ...) ((void)HILOG_IMPL((type), LOG_DEBUG, LOG_DOMAIN, LOG_TAG, __VA_ARGS__))
+#define HILOG_INFO(type, ...) ((void)HILOG_IMPL((type), LOG_INFO, LOG_DOMAIN, LOG_TAG, __VA_ARGS__))
+#define HILOG_WARN(type, ...) ((void)HILOG_IMPL((type), LOG_WARN, LOG_DOMAIN, LOG_TAG, __VA_ARGS__))
+#define HILOG_ERROR(type, ...) ((void)HILOG_IMPL((type), LOG_ERROR, LOG_DOMAIN, LOG_TAG, __VA_ARGS__))
+#define HILOG_FATAL(type, ...) ((void)HILOG_IMPL((type), LOG_FATAL, LOG_DOMAIN, LOG_TAG, __VA_ARGS__))
+
+#endif // HIAPPEVENT_TEST_HOST_INCLUDE_HILOG_LOG_H
@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef HIAPPEVENT_TEST_HOST_INCLUDE_HISYSEVENT_C_H
+#define HIAPPEVENT_TEST_HOST_INCLUDE_HISYSEVENT_C_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+#define MAX_LENGTH_OF_PARAM_NAME 49
+
+typedef enum HiSysEventEventType {
+    HISYSEVENT_FAULT = 1,
+    HISYSEVENT_STATISTIC = 2,
+    HISYSEVENT_SECURITY = 3,
+    HISYSEVENT_BEHAVIOR = 4,
+} HiSysEventEventType;
+
+typedef enum HiSysEventParamType {
+    HISYSEVENT_INVALID = 0,
+    HISYSEVENT_BOOL = 1,
+    HISYSEVENT_INT8 = 2,
+    HISYSEVENT_UINT8 = 3,
+    HISYSEVENT_INT16 = 4,
+    HISYSEVENT_UINT16 = 5,
+    HISYSEVENT_INT32 = 6,
+    HISYSEVENT_UINT32 = 7,
+    HISYSEVENT_INT64 = 8,
+    HISYSEVENT_UINT64 = 9,
+    HISYSEVENT_FLOAT = 10,
+    HISYSEVENT_DOUBLE = 11,
+    HISYSEVENT_STRING = 12,
+} HiSysEventParamType;
+
+typedef union HiSysEventParamValue {
+    bool b;
+    int8_t i8;
+    uint8_t ui8;
+    int16_t i16;
+    uint16_t ui16;
+    int32_t i32;
+    uint32_t ui32;
+    int64_t i64;
+    uint64_t ui64;
+    float f;
+    double d;
+    char* s;
+    void* array;
+} HiSysEventParamValue;
+
+typedef struct HiSysEventParam {
+    char name[MAX_LENGTH_OF_PARAM_NAME];
+    HiSysEventParamType t;
+    HiSysEventParamValue v;
+    size_t arraySize;
+} HiSysEventParam;
+
+// there is no hiview on host, the events are dropped
+static inline int OH_HiSysEvent_Write(const char* domain, const char* name, HiSysEventEventType type,
+    const HiSysEventParam params[], size_t size)
+{
+    return 0;
+}
+#ifdef __cplusplus
+}
+#endif
+#endif // HIAPPEVENT_TEST_HOST_INCLUDE_HISYSEVENT_C_H
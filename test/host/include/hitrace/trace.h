@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef HIAPPEVENT_TEST_HOST_INCLUDE_HITRACE_TRACE_H
+#define HIAPPEVENT_TEST_HOST_INCLUDE_HITRACE_TRACE_H
+
+#include <cstdint>
+
+namespace OHOS {
+namespace HiviewDFX {
+// there is no trace chain on host, every id is invalid
+class HiTraceId {
+public:
+    bool IsValid() const
+    {
+        return false;
+    }
+
+    uint64_t GetChainId() const
+    {
+        return 0;
+    }
+
+    uint64_t GetSpanId() const
+    {
+        return 0;
+    }
+
+    uint64_t GetParentSpanId() const
+    {
+        return 0;
+    }
+
+    int GetFlags() const
+    {
+        return 0;
+    }
+};
+
+class HiTraceChain {
+public:
+    static HiTraceId GetId()
+    {
+        return HiTraceId();
+    }
+};
+} // namespace HiviewDFX
+} // namespace OHOS
+#endif // HIAPPEVENT_TEST_HOST_INCLUDE_HITRACE_TRACE_H
@@ -0,0 +1,47 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef HIAPPEVENT_TEST_HOST_INCLUDE_ISERVICE_REGISTRY_H
+#define HIAPPEVENT_TEST_HOST_INCLUDE_ISERVICE_REGISTRY_H
+
+#include <cstdint>
+
+#include "refbase.h"
+
+namespace OHOS {
+class ISystemAbilityManager {
+public:
+    virtual ~ISystemAbilityManager() = default;
+    sptr<IRemoteObject> GetSystemAbility(int32_t systemAbilityId)
+    {
+        return nullptr;
+    }
+};
+
+class SystemAbilityManagerClient {
+public:
+    static SystemAbilityManagerClient& GetInstance()
+    {
+        static SystemAbilityManagerClient instance;
+        return instance;
+    }
+
+    sptr<ISystemAbilityManager> GetSystemAbilityManager()
+    {
+        return nullptr;
+    }
+};
+} // namespace OHOS
+#endif // HIAPPEVENT_TEST_HOST_INCLUDE_ISERVICE_REGISTRY_H
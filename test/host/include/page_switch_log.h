@@ -0,0 +1,34 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef HIAPPEVENT_TEST_HOST_INCLUDE_PAGE_SWITCH_LOG_H
+#define HIAPPEVENT_TEST_HOST_INCLUDE_PAGE_SWITCH_LOG_H
+
+#include <cstdint>
+#include <string>
+
+namespace OHOS {
+namespace HiviewDFX {
+// there are no page switches on host, the snapshot is always empty
+inline int CreatePageSwitchSnapshot(uint64_t faultTime, bool isAppFreeze, std::string& pageSwitchLog)
+{
+    pageSwitchLog.clear();
+    return 0;
+}
+
+inline void SetPageSwitchStatus(bool isEnable) {}
+} // namespace HiviewDFX
+} // namespace OHOS
+#endif // HIAPPEVENT_TEST_HOST_INCLUDE_PAGE_SWITCH_LOG_H
@@ -0,0 +1,48 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef HIAPPEVENT_TEST_HOST_INCLUDE_PARAMETERS_H
+#define HIAPPEVENT_TEST_HOST_INCLUDE_PARAMETERS_H
+
+#include <cstdlib>
+#include <string>
+
+namespace OHOS {
+namespace system {
+// the system parameters are read from the environment, e.g. const.logsystem.versiontype -> const_logsystem_versiontype
+inline std::string GetParameter(const std::string& key, const std::string& def)
+{
+    std::string envName = key;
+    for (auto& ch : envName) {
+        ch = (ch == '.') ? '_' : ch;
+    }
+    const char* value = std::getenv(envName.c_str());
+    return value == nullptr ? def : std::string(value);
+}
+
+inline bool GetBoolParameter(const std::string& key, bool def)
+{
+    std::string value = GetParameter(key, "");
+    if (value == "true" || value == "1") {
+        return true;
+    }
+    if (value == "false" || value == "0") {
+        return false;
+    }
+    return def;
+}
+} // namespace system
+} // namespace OHOS
+#endif // HIAPPEVENT_TEST_HOST_INCLUDE_PARAMETERS_H
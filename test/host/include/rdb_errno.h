@@ -0,0 +1,29 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef HIAPPEVENT_TEST_HOST_INCLUDE_RDB_ERRNO_H
+#define HIAPPEVENT_TEST_HOST_INCLUDE_RDB_ERRNO_H
+
+namespace OHOS {
+namespace NativeRdb {
+constexpr int E_OK = 0;
+constexpr int E_BASE = 14800000;
+constexpr int E_ERROR = E_BASE;
+constexpr int E_INVALID_ARGS = E_BASE + 1;
+constexpr int E_SQLITE_ERROR = E_BASE + 1000;
+constexpr int E_SQLITE_CORRUPT = E_BASE + 1011;
+} // namespace NativeRdb
+} // namespace OHOS
+#endif // HIAPPEVENT_TEST_HOST_INCLUDE_RDB_ERRNO_H
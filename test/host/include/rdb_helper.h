@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef HIAPPEVENT_TEST_HOST_INCLUDE_RDB_HELPER_H
+#define HIAPPEVENT_TEST_HOST_INCLUDE_RDB_HELPER_H
+
+#include <memory>
+#include <string>
+
+#include "rdb_errno.h"
+#include "rdb_open_callback.h"
+#include "rdb_store.h"
+
+namespace OHOS {
+namespace NativeRdb {
+enum class SecurityLevel : int32_t {
+    S1 = 1,
+    S2,
+    S3,
+    S4,
+};
+
+class RdbStoreConfig {
+public:
+    explicit RdbStoreConfig(const std::string& path) : path_(path) {}
+
+    void SetSecurityLevel(SecurityLevel level)
+    {
+        level_ = level;
+    }
+
+    const std::string& GetPath() const
+    {
+        return path_;
+    }
+
+private:
+    std::string path_;
+    SecurityLevel level_ = SecurityLevel::S1;
+};
+
+class RdbHelper {
+public:
+    static std::shared_ptr<RdbStore> GetRdbStore(const RdbStoreConfig& config, int version,
+        RdbOpenCallback& openCallback, int& errCode);
+    static int DeleteRdbStore(const std::string& path);
+};
+} // namespace NativeRdb
+} // namespace OHOS
+#endif // HIAPPEVENT_TEST_HOST_INCLUDE_RDB_HELPER_H
@@ -0,0 +1,36 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef HIAPPEVENT_TEST_HOST_INCLUDE_RDB_OPEN_CALLBACK_H
+#define HIAPPEVENT_TEST_HOST_INCLUDE_RDB_OPEN_CALLBACK_H
+
+#include "rdb_errno.h"
+#include "rdb_store.h"
+
+namespace OHOS {
+namespace NativeRdb {
+class RdbOpenCallback {
+public:
+    virtual ~RdbOpenCallback() = default;
+    virtual int OnCreate(RdbStore& rdbStore) = 0;
+    virtual int OnUpgrade(RdbStore& rdbStore, int currentVersion, int targetVersion) = 0;
+    virtual int OnOpen(RdbStore& rdbStore)
+    {
+        return E_OK;
+    }
+};
+} // namespace NativeRdb
+} // namespace OHOS
+#endif // HIAPPEVENT_TEST_HOST_INCLUDE_RDB_OPEN_CALLBACK_H
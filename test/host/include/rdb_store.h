@@ -0,0 +1,218 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef HIAPPEVENT_TEST_HOST_INCLUDE_RDB_STORE_H
+#define HIAPPEVENT_TEST_HOST_INCLUDE_RDB_STORE_H
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <variant>
+#include <vector>
+
+#include "rdb_errno.h"
+
+struct sqlite3;
+struct sqlite3_stmt;
+
+namespace OHOS {
+namespace NativeRdb {
+// host stand-in of the relational store, backed by the system sqlite3 library
+class ValueObject {
+public:
+    using Type = std::variant<std::monostate, int64_t, double, std::string, std::vector<uint8_t>>;
+
+    ValueObject() = default;
+    ValueObject(int val) : value(static_cast<int64_t>(val)) {}
+    ValueObject(int64_t val) : value(val) {}
+    ValueObject(uint32_t val) : value(static_cast<int64_t>(val)) {}
+    ValueObject(uint64_t val) : value(static_cast<int64_t>(val)) {}
+    ValueObject(double val) : value(val) {}
+    ValueObject(bool val) : value(static_cast<int64_t>(val)) {}
+    ValueObject(const char* val) : value(std::string(val)) {}
+    ValueObject(const std::string& val) : value(val) {}
+    ValueObject(std::string&& val) : value(std::move(val)) {}
+    ValueObject(const std::vector<uint8_t>& val) : value(val) {}
+    ValueObject(std::vector<uint8_t>&& val) : value(std::move(val)) {}
+
+    Type value;
+};
+
+class ValuesBucket {
+public:
+    void PutString(const std::string& columnName, const std::string& value)
+    {
+        values_[columnName] = ValueObject(value);
+    }
+
+    void PutInt(const std::string& columnName, int value)
+    {
+        values_[columnName] = ValueObject(value);
+    }
+
+    void PutLong(const std::string& columnName, int64_t value)
+    {
+        values_[columnName] = ValueObject(value);
+    }
+
+    void PutDouble(const std::string& columnName, double value)
+    {
+        values_[columnName] = ValueObject(value);
+    }
+
+    void Put(const std::string& columnName, const ValueObject& value)
+    {
+        values_[columnName] = value;
+    }
+
+    void PutBlob(const std::string& columnName, const std::vector<uint8_t>& value)
+    {
+        values_[columnName] = ValueObject(value);
+    }
+
+    void PutNull(const std::string& columnName)
+    {
+        values_[columnName] = ValueObject();
+    }
+
+    const std::map<std::string, ValueObject>& GetAll() const
+    {
+        return values_;
+    }
+
+private:
+    std::map<std::string, ValueObject> values_;
+};
+
+class AbsRdbPredicates {
+public:
+    explicit AbsRdbPredicates(const std::string& tableName) : tableName_(tableName) {}
+
+    AbsRdbPredicates* EqualTo(const std::string& field, const ValueObject& value)
+    {
+        AppendCondition(field + " = ?");
+        bindArgs_.emplace_back(value);
+        return this;
+    }
+
+    AbsRdbPredicates* In(const std::string& field, const std::vector<std::string>& values)
+    {
+        std::string condition = field + " IN (";
+        for (size_t i = 0; i < values.size(); ++i) {
+            condition += (i == 0 ? "?" : ", ?");
+            bindArgs_.emplace_back(ValueObject(values[i]));
+        }
+        AppendCondition(condition + ")");
+        return this;
+    }
+
+    const std::string& GetTableName() const
+    {
+        return tableName_;
+    }
+
+    const std::string& GetWhereClause() const
+    {
+        return whereClause_;
+    }
+
+    const std::vector<ValueObject>& GetBindArgs() const
+    {
+        return bindArgs_;
+    }
+
+private:
+    void AppendCondition(const std::string& condition)
+    {
+        whereClause_ += whereClause_.empty() ? condition : (" AND " + condition);
+    }
+
+private:
+    std::string tableName_;
+    std::string whereClause_;
+    std::vector<ValueObject> bindArgs_;
+};
+
+class AbsSharedResultSet {
+public:
+    AbsSharedResultSet(sqlite3_stmt* stmt, std::shared_ptr<std::recursive_mutex> dbMutex);
+    ~AbsSharedResultSet();
+    AbsSharedResultSet(const AbsSharedResultSet&) = delete;
+    AbsSharedResultSet& operator=(const AbsSharedResultSet&) = delete;
+
+    int GoToNextRow();
+    int GetColumnIndex(const std::string& columnName, int& columnIndex);
+    int GetInt(int columnIndex, int& value);
+    int GetLong(int columnIndex, int64_t& value);
+    int GetDouble(int columnIndex, double& value);
+    int GetString(int columnIndex, std::string& value);
+    int GetBlob(int columnIndex, std::vector<uint8_t>& value);
+    int Close();
+
+private:
+    int CheckColumn(int columnIndex) const;
+
+private:
+    sqlite3_stmt* stmt_ = nullptr;
+    std::shared_ptr<std::recursive_mutex> dbMutex_;
+    bool hasRow_ = false;
+};
+
+class RdbStore {
+public:
+    explicit RdbStore(sqlite3* db);
+    virtual ~RdbStore();
+    RdbStore(const RdbStore&) = delete;
+    RdbStore& operator=(const RdbStore&) = delete;
+
+    int Insert(int64_t& outRowId, const std::string& table, const ValuesBucket& values);
+    int BatchInsert(int64_t& outInsertNum, const std::string& table, const std::vector<ValuesBucket>& values);
+    int Update(int& changedRows, const ValuesBucket& values, const AbsRdbPredicates& predicates);
+    int Delete(int& deletedRows, const AbsRdbPredicates& predicates);
+    int Delete(int& deletedRows, const std::string& table, const std::string& whereClause = "",
+        const std::vector<std::string>& whereArgs = {});
+    std::shared_ptr<AbsSharedResultSet> Query(const AbsRdbPredicates& predicates,
+        const std::vector<std::string>& columns = {});
+    std::shared_ptr<AbsSharedResultSet> QuerySql(const std::string& sql,
+        const std::vector<ValueObject>& bindArgs = {});
+    std::shared_ptr<AbsSharedResultSet> QuerySql(const std::string& sql, const std::vector<std::string>& bindArgs);
+    int ExecuteSql(const std::string& sql, const std::vector<ValueObject>& bindArgs = {});
+    int ExecuteForLastInsertedRowId(int64_t& outValue, const std::string& sql,
+        const std::vector<ValueObject>& bindArgs = {});
+    int ExecuteForChangedRowCount(int64_t& outValue, const std::string& sql,
+        const std::vector<ValueObject>& bindArgs = {});
+    int BeginTransaction();
+    int Commit();
+    int RollBack();
+
+    int GetVersion(int& version);
+    int SetVersion(int version);
+
+private:
+    int Prepare(const std::string& sql, const std::vector<ValueObject>& bindArgs, sqlite3_stmt*& stmt);
+    int Execute(const std::string& sql, const std::vector<ValueObject>& bindArgs);
+    int InsertInner(int64_t& outRowId, const std::string& table, const ValuesBucket& values);
+
+private:
+    sqlite3* db_ = nullptr;
+    std::shared_ptr<std::recursive_mutex> dbMutex_;
+    std::map<std::string, sqlite3_stmt*> stmtCache_;
+    int transactionDepth_ = 0;
+};
+} // namespace NativeRdb
+} // namespace OHOS
+#endif // HIAPPEVENT_TEST_HOST_INCLUDE_RDB_STORE_H
@@ -0,0 +1,37 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef HIAPPEVENT_TEST_HOST_INCLUDE_REFBASE_H
+#define HIAPPEVENT_TEST_HOST_INCLUDE_REFBASE_H
+
+#include <memory>
+
+namespace OHOS {
+// on host there is no ipc, so the remote objects are plain shared pointers which are always null
+template<typename T>
+using sptr = std::shared_ptr<T>;
+
+class IRemoteObject {
+public:
+    virtual ~IRemoteObject() = default;
+};
+
+template<typename T>
+sptr<T> iface_cast(const sptr<IRemoteObject>& object)
+{
+    return std::dynamic_pointer_cast<T>(object);
+}
+} // namespace OHOS
+#endif // HIAPPEVENT_TEST_HOST_INCLUDE_REFBASE_H
@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef HIAPPEVENT_TEST_HOST_INCLUDE_SINGLETON_H
+#define HIAPPEVENT_TEST_HOST_INCLUDE_SINGLETON_H
+
+#include <memory>
+#include <mutex>
+
+#include "nocopyable.h"
+
+namespace OHOS {
+#define DECLARE_DELAYED_SINGLETON(MyClass) \
+public: \
+    ~MyClass(); \
+private: \
+    friend DelayedSingleton<MyClass>; \
+    MyClass();
+
+#define DECLARE_SINGLETON(MyClass) \
+private: \
+    friend Singleton<MyClass>; \
+    MyClass& operator=(const MyClass&) = delete; \
+    MyClass(const MyClass&) = delete; \
+    MyClass(); \
+    ~MyClass();
+
+template<typename T>
+class DelayedSingleton : public NoCopyable {
+public:
+    static std::shared_ptr<T> GetInstance()
+    {
+        static std::shared_ptr<T> instance(new T());
+        return instance;
+    }
+};
+
+template<typename T>
+class Singleton : public NoCopyable {
+public:
+    static T& GetInstance()
+    {
+        static T instance;
+        return instance;
+    }
+};
+} // namespace OHOS
+#endif // HIAPPEVENT_TEST_HOST_INCLUDE_SINGLETON_H
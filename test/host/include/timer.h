@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef HIAPPEVENT_TEST_HOST_INCLUDE_TIMER_H
+#define HIAPPEVENT_TEST_HOST_INCLUDE_TIMER_H
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+
+#include "ffrt.h"
+
+namespace OHOS {
+namespace Utils {
+// host stand-in of the c_utils timer, built on the ffrt timer stand-in
+class Timer {
+public:
+    using TimerCallback = std::function<void()>;
+
+    explicit Timer(const std::string& name, int timeoutMs = 1000) : name_(name) {}
+    virtual ~Timer()
+    {
+        Shutdown();
+    }
+
+    uint32_t Setup()
+    {
+        return 0;
+    }
+
+    void Shutdown(bool useJoin = true)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (const auto& [timerId, handle] : handles_) {
+            ffrt_timer_stop(ffrt_qos_default, handle);
+        }
+        handles_.clear();
+        callbacks_.clear();
+    }
+
+    uint32_t Register(const TimerCallback& callback, uint32_t interval, bool once = false)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        uint32_t timerId = ++nextTimerId_;
+        auto holder = std::make_unique<TimerCallback>(callback);
+        auto handle = ffrt_timer_start(ffrt_qos_default, interval, holder.get(), [](void* data) {
+            (*static_cast<TimerCallback*>(data))();
+        }, !once);
+        callbacks_[timerId] = std::move(holder);
+        handles_[timerId] = handle;
+        return timerId;
+    }
+
+    void Unregister(uint32_t timerId)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (auto it = handles_.find(timerId); it != handles_.end()) {
+            ffrt_timer_stop(ffrt_qos_default, it->second);
+            handles_.erase(it);
+        }
+        callbacks_.erase(timerId);
+    }
+
+private:
+    std::string name_;
+    std::mutex mutex_;
+    uint32_t nextTimerId_ = 0;
+    std::map<uint32_t, std::unique_ptr<TimerCallback>> callbacks_;
+    std::map<uint32_t, ffrt_timer_t> handles_;
+};
+} // namespace Utils
+} // namespace OHOS
+#endif // HIAPPEVENT_TEST_HOST_INCLUDE_TIMER_H
@@ -0,0 +1,45 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef HIAPPEVENT_TEST_HOST_INCLUDE_XCOLLIE_WATCHDOG_H
+#define HIAPPEVENT_TEST_HOST_INCLUDE_XCOLLIE_WATCHDOG_H
+
+#include <map>
+#include <string>
+
+namespace OHOS {
+namespace HiviewDFX {
+// there is no main thread to watch on host, the configs are accepted and ignored
+class Watchdog {
+public:
+    static Watchdog& GetInstance()
+    {
+        static Watchdog instance;
+        return instance;
+    }
+
+    int ConfigEventPolicy(const std::map<std::string, std::string>& configMap)
+    {
+        return 0;
+    }
+
+    int SetEventConfig(const std::map<std::string, std::string>& configMap)
+    {
+        return 0;
+    }
+};
+} // namespace HiviewDFX
+} // namespace OHOS
+#endif // HIAPPEVENT_TEST_HOST_INCLUDE_XCOLLIE_WATCHDOG_H
@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "application_context.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace OHOS {
+namespace AbilityRuntime {
+namespace {
+const std::string DEFAULT_HOST_DIR = "/tmp/hiappevent_host";
+const std::string DEFAULT_BUNDLE_NAME = "com.example.hiappevent.host";
+
+std::string GetEnvOrDefault(const char* name, const std::string& def)
+{
+    const char* value = std::getenv(name);
+    return (value == nullptr || value[0] == '\0') ? def : std::string(value);
+}
+
+std::string GetSandboxDir(const std::string& subDir)
+{
+    std::string dir = GetEnvOrDefault("HIAPPEVENT_HOST_DIR", DEFAULT_HOST_DIR);
+    mkdir(dir.c_str(), S_IRWXU);
+    dir += subDir;
+    mkdir(dir.c_str(), S_IRWXU);
+    return dir;
+}
+}
+
+std::shared_ptr<ApplicationContext> ApplicationContext::GetInstance()
+{
+    static auto instance = std::make_shared<ApplicationContext>();
+    return instance;
+}
+
+std::string ApplicationContext::GetBundleName() const
+{
+    return GetEnvOrDefault("HIAPPEVENT_HOST_BUNDLE_NAME", DEFAULT_BUNDLE_NAME);
+}
+
+std::string ApplicationContext::GetFilesDir() const
+{
+    static const std::string filesDir = GetSandboxDir("/files");
+    return filesDir;
+}
+
+std::string ApplicationContext::GetCacheDir() const
+{
+    static const std::string cacheDir = GetSandboxDir("/cache");
+    return cacheDir;
+}
+
+std::string ApplicationContext::GetAppRunningUniqueId() const
+{
+    static const std::string runningId = "host_" + std::to_string(getpid());
+    return runningId;
+}
+
+void ApplicationContext::RegisterAbilityLifecycleCallback(const std::shared_ptr<AbilityLifecycleCallback>& callback)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    callbacks_.emplace_back(callback);
+}
+
+void ApplicationContext::UnregisterAbilityLifecycleCallback(const std::shared_ptr<AbilityLifecycleCallback>& callback)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    callbacks_.erase(std::remove(callbacks_.begin(), callbacks_.end(), callback), callbacks_.end());
+}
+
+void ApplicationContext::DispatchOnAbilityBackground()
+{
+    std::vector<std::shared_ptr<AbilityLifecycleCallback>> callbacks;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        callbacks = callbacks_;
+    }
+    AbilityLifecycleCallbackArgs ability;
+    for (const auto& callback : callbacks) {
+        callback->OnAbilityBackground(ability);
+    }
+}
+} // namespace AbilityRuntime
+} // namespace OHOS
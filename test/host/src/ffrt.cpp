@@ -0,0 +1,298 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ffrt.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace {
+using Clock = std::chrono::steady_clock;
+constexpr unsigned int MIN_WORKER_NUM = 2;
+constexpr unsigned int MAX_WORKER_NUM = 8;
+
+/*
+ * The workers of all the tasks, the queues and the timers. The delayed tasks are kept ordered by the due
+ * time and an idle worker moves them to the ready list once they are due.
+ */
+class Executor {
+public:
+    static Executor& GetInstance()
+    {
+        static Executor instance;
+        return instance;
+    }
+
+    ~Executor()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        cond_.notify_all();
+        for (auto& worker : workers_) {
+            worker.join();
+        }
+    }
+
+    void Submit(std::function<void()>&& task, uint64_t delayUs = 0)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (delayUs == 0) {
+                ready_.emplace_back(std::move(task));
+            } else {
+                delayed_.emplace(Clock::now() + std::chrono::microseconds(delayUs), std::move(task));
+            }
+        }
+        cond_.notify_one();
+    }
+
+private:
+    Executor()
+    {
+        unsigned int workerNum = std::clamp(std::thread::hardware_concurrency(), MIN_WORKER_NUM, MAX_WORKER_NUM);
+        for (unsigned int i = 0; i < workerNum; ++i) {
+            workers_.emplace_back([this] { Run(); });
+        }
+    }
+
+    void Run()
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (!stop_) {
+            while (!delayed_.empty() && delayed_.begin()->first <= Clock::now()) {
+                ready_.emplace_back(std::move(delayed_.begin()->second));
+                delayed_.erase(delayed_.begin());
+            }
+            if (ready_.empty()) {
+                if (delayed_.empty()) {
+                    cond_.wait(lock);
+                } else {
+                    cond_.wait_until(lock, delayed_.begin()->first);
+                }
+                continue;
+            }
+            auto task = std::move(ready_.front());
+            ready_.pop_front();
+            lock.unlock();
+            task();
+            lock.lock();
+        }
+    }
+
+private:
+    std::mutex mutex_;
+    std::condition_variable cond_;
+    std::deque<std::function<void()>> ready_;
+    std::multimap<Clock::time_point, std::function<void()>> delayed_;
+    std::vector<std::thread> workers_;
+    bool stop_ = false;
+};
+
+struct TimerEntry {
+    void* data = nullptr;
+    ffrt_timer_cb cb = nullptr;
+    uint64_t timeoutMs = 0;
+    bool repeat = false;
+    bool running = false;
+    std::thread::id runningThread;
+};
+
+class TimerMgr {
+public:
+    static TimerMgr& GetInstance()
+    {
+        static TimerMgr instance;
+        return instance;
+    }
+
+    ffrt_timer_t Start(uint64_t timeoutMs, void* data, ffrt_timer_cb cb, bool repeat)
+    {
+        if (cb == nullptr) {
+            return ffrt_error;
+        }
+        std::lock_guard<std::mutex> lock(mutex_);
+        ffrt_timer_t handle = nextHandle_++;
+        timers_[handle] = TimerEntry { data, cb, timeoutMs, repeat };
+        Schedule(handle, timeoutMs);
+        return handle;
+    }
+
+    int Stop(ffrt_timer_t handle)
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        auto it = timers_.find(handle);
+        if (it == timers_.end()) {
+            return ffrt_error;
+        }
+        // wait for the running callback unless it is the callback itself which stops the timer
+        cond_.wait(lock, [this, handle] {
+            auto it = timers_.find(handle);
+            return it == timers_.end() || !it->second.running ||
+                it->second.runningThread == std::this_thread::get_id();
+        });
+        timers_.erase(handle);
+        return ffrt_success;
+    }
+
+private:
+    void Schedule(ffrt_timer_t handle, uint64_t timeoutMs)
+    {
+        Executor::GetInstance().Submit([this, handle] { Fire(handle); }, timeoutMs * 1000); // 1000 means ms to us
+    }
+
+    void Fire(ffrt_timer_t handle)
+    {
+        TimerEntry entry;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto it = timers_.find(handle);
+            if (it == timers_.end()) {
+                return;
+            }
+            it->second.running = true;
+            it->second.runningThread = std::this_thread::get_id();
+            entry = it->second;
+        }
+        entry.cb(entry.data);
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto it = timers_.find(handle);
+            if (it != timers_.end()) {
+                it->second.running = false;
+                if (entry.repeat) {
+                    Schedule(handle, entry.timeoutMs);
+                } else {
+                    timers_.erase(it);
+                }
+            }
+        }
+        cond_.notify_all();
+    }
+
+private:
+    std::mutex mutex_;
+    std::condition_variable cond_;
+    std::map<ffrt_timer_t, TimerEntry> timers_;
+    ffrt_timer_t nextHandle_ = 0;
+};
+}
+
+ffrt_timer_t ffrt_timer_start(ffrt_qos_t qos, uint64_t timeout, void* data, ffrt_timer_cb cb, bool repeat)
+{
+    return TimerMgr::GetInstance().Start(timeout, data, cb, repeat);
+}
+
+int ffrt_timer_stop(ffrt_qos_t qos, ffrt_timer_t handle)
+{
+    return TimerMgr::GetInstance().Stop(handle);
+}
+
+namespace ffrt {
+// runs the tasks in submission order, at most one at a time
+class queue::QueueImpl : public std::enable_shared_from_this<queue::QueueImpl> {
+public:
+    void Submit(std::function<void()>&& task, uint64_t delayUs)
+    {
+        if (delayUs > 0) {
+            auto self = shared_from_this();
+            Executor::GetInstance().Submit([self, task = std::move(task)] () mutable {
+                self->Submit(std::move(task), 0);
+            }, delayUs);
+            return;
+        }
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (stop_) {
+            return;
+        }
+        tasks_.emplace_back(std::move(task));
+        if (!running_) {
+            running_ = true;
+            auto self = shared_from_this();
+            Executor::GetInstance().Submit([self] { self->Drain(); });
+        }
+    }
+
+    void Stop()
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        stop_ = true;
+        tasks_.clear();
+        if (runningThread_ != std::this_thread::get_id()) {
+            cond_.wait(lock, [this] { return !running_; });
+        }
+    }
+
+private:
+    void Drain()
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        runningThread_ = std::this_thread::get_id();
+        while (!tasks_.empty()) {
+            auto task = std::move(tasks_.front());
+            tasks_.pop_front();
+            lock.unlock();
+            task();
+            lock.lock();
+        }
+        runningThread_ = std::thread::id();
+        running_ = false;
+        cond_.notify_all();
+    }
+
+private:
+    std::mutex mutex_;
+    std::condition_variable cond_;
+    std::deque<std::function<void()>> tasks_;
+    std::thread::id runningThread_;
+    bool running_ = false;
+    bool stop_ = false;
+};
+
+queue::queue(const char* name, const queue_attr& attr) : impl_(std::make_shared<QueueImpl>()) {}
+
+queue::~queue()
+{
+    impl_->Stop();
+}
+
+void queue::submit(const std::function<void()>& func, const task_attr& attr)
+{
+    impl_->Submit(std::function<void()>(func), attr.delay());
+}
+
+void queue::submit(std::function<void()>&& func, const task_attr& attr)
+{
+    impl_->Submit(std::move(func), attr.delay());
+}
+
+void submit(const std::function<void()>& func, const task_attr& attr)
+{
+    Executor::GetInstance().Submit(std::function<void()>(func), attr.delay());
+}
+
+void submit(std::function<void()>&& func, const task_attr& attr)
+{
+    Executor::GetInstance().Submit(std::move(func), attr.delay());
+}
+} // namespace ffrt
@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "hilog/log.h"
+
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace {
+LogLevel GetMinLevel()
+{
+    // HIAPPEVENT_HOST_LOG_LEVEL=debug|info|warn|error|fatal, warn by default
+    static const LogLevel minLevel = [] () {
+        const char* level = std::getenv("HIAPPEVENT_HOST_LOG_LEVEL");
+        if (level == nullptr) {
+            return LOG_WARN;
+        }
+        if (strcmp(level, "debug") == 0) {
+            return LOG_DEBUG;
+        }
+        if (strcmp(level, "info") == 0) {
+            return LOG_INFO;
+        }
+        if (strcmp(level, "error") == 0) {
+            return LOG_ERROR;
+        }
+        if (strcmp(level, "fatal") == 0) {
+            return LOG_FATAL;
+        }
+        return LOG_WARN;
+    }();
+    return minLevel;
+}
+
+char GetLevelChar(LogLevel level)
+{
+    switch (level) {
+        case LOG_DEBUG:
+            return 'D';
+        case LOG_INFO:
+            return 'I';
+        case LOG_WARN:
+            return 'W';
+        case LOG_ERROR:
+            return 'E';
+        default:
+            return 'F';
+    }
+}
+
+std::string StripPrivacyFlags(const char* fmt)
+{
+    std::string result(fmt);
+    for (const char* flag : {"{public}", "{private}"}) {
+        size_t flagLen = strlen(flag);
+        for (size_t pos = result.find(flag); pos != std::string::npos; pos = result.find(flag, pos)) {
+            result.erase(pos, flagLen);
+        }
+    }
+    return result;
+}
+}
+
+bool HiLogIsLoggable(unsigned int domain, const char* tag, LogLevel level)
+{
+    return level >= GetMinLevel();
+}
+
+int HiLogPrint(LogType type, LogLevel level, unsigned int domain, const char* tag, const char* fmt, ...)
+{
+    if (fmt == nullptr || !HiLogIsLoggable(domain, tag, level)) {
+        return 0;
+    }
+    std::string format = StripPrivacyFlags(fmt);
+    char msg[1024] = {0}; // 1024 means max length of one log line
+    va_list args;
+    va_start(args, fmt);
+    vsnprintf(msg, sizeof(msg), format.c_str(), args);
+    va_end(args);
+
+    // format the whole line first so that the lines of different threads are not interleaved
+    char line[1200] = {0}; // 1200 means the max length of the line with the prefix
+    int len = snprintf(line, sizeof(line), "%c %05X/%s [%ld]: %s\n", GetLevelChar(level), domain,
+        tag == nullptr ? "" : tag, static_cast<long>(syscall(SYS_gettid)), msg);
+    fputs(line, stderr);
+    return len;
+}
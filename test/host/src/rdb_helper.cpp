@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "rdb_helper.h"
+
+#include <cerrno>
+#include <sqlite3.h>
+#include <unistd.h>
+
+#include "hilog/log.h"
+
+#undef LOG_DOMAIN
+#define LOG_DOMAIN 0xD002D07
+
+#undef LOG_TAG
+#define LOG_TAG "HostRdb"
+
+namespace OHOS {
+namespace NativeRdb {
+namespace {
+constexpr int BUSY_TIMEOUT_MS = 2000;
+
+int InitVersion(RdbStore& store, int version, RdbOpenCallback& openCallback)
+{
+    int curVersion = 0;
+    if (int ret = store.GetVersion(curVersion); ret != E_OK) {
+        return ret;
+    }
+    if (curVersion == version) {
+        return E_OK;
+    }
+    int ret = (curVersion == 0) ? openCallback.OnCreate(store) : openCallback.OnUpgrade(store, curVersion, version);
+    if (ret != E_OK) {
+        return ret;
+    }
+    return store.SetVersion(version);
+}
+}
+
+std::shared_ptr<RdbStore> RdbHelper::GetRdbStore(const RdbStoreConfig& config, int version,
+    RdbOpenCallback& openCallback, int& errCode)
+{
+    sqlite3* db = nullptr;
+    int ret = sqlite3_open_v2(config.GetPath().c_str(), &db,
+        SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE | SQLITE_OPEN_FULLMUTEX, nullptr);
+    if (ret != SQLITE_OK) {
+        HILOG_ERROR(LOG_CORE, "failed to open db, ret=%{public}d", ret);
+        sqlite3_close_v2(db);
+        errCode = (ret == SQLITE_CORRUPT || ret == SQLITE_NOTADB) ? E_SQLITE_CORRUPT : E_SQLITE_ERROR;
+        return nullptr;
+    }
+    sqlite3_busy_timeout(db, BUSY_TIMEOUT_MS);
+    auto store = std::make_shared<RdbStore>(db);
+
+    // the device store runs in wal mode with full sync, keep the same cost on host
+    if (errCode = store->ExecuteSql("PRAGMA journal_mode = WAL"); errCode != E_OK) {
+        return nullptr;
+    }
+    if (errCode = store->ExecuteSql("PRAGMA synchronous = FULL"); errCode != E_OK) {
+        return nullptr;
+    }
+    if (errCode = InitVersion(*store, version, openCallback); errCode != E_OK) {
+        HILOG_ERROR(LOG_CORE, "failed to init db version, ret=%{public}d", errCode);
+        return nullptr;
+    }
+    if (errCode = openCallback.OnOpen(*store); errCode != E_OK) {
+        return nullptr;
+    }
+    return store;
+}
+
+int RdbHelper::DeleteRdbStore(const std::string& path)
+{
+    for (const char* suffix : {"", "-wal", "-shm", "-journal"}) {
+        std::string file = path + suffix;
+        if (unlink(file.c_str()) != 0 && errno != ENOENT) {
+            HILOG_ERROR(LOG_CORE, "failed to remove db file, errno=%{public}d", errno);
+            return E_ERROR;
+        }
+    }
+    return E_OK;
+}
+} // namespace NativeRdb
+} // namespace OHOS
@@ -0,0 +1,453 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "rdb_store.h"
+
+#include <sqlite3.h>
+
+#include "hilog/log.h"
+
+#undef LOG_DOMAIN
+#define LOG_DOMAIN 0xD002D07
+
+#undef LOG_TAG
+#define LOG_TAG "HostRdb"
+
+namespace OHOS {
+namespace NativeRdb {
+namespace {
+int ConvertErrCode(int sqliteCode)
+{
+    switch (sqliteCode) {
+        case SQLITE_OK:
+        case SQLITE_ROW:
+        case SQLITE_DONE:
+            return E_OK;
+        case SQLITE_CORRUPT:
+        case SQLITE_NOTADB:
+            return E_SQLITE_CORRUPT;
+        default:
+            return E_SQLITE_ERROR;
+    }
+}
+
+int BindArgs(sqlite3_stmt* stmt, const std::vector<ValueObject>& bindArgs)
+{
+    for (size_t i = 0; i < bindArgs.size(); ++i) {
+        int index = static_cast<int>(i) + 1;
+        int ret = SQLITE_OK;
+        const auto& value = bindArgs[i].value;
+        if (auto intVal = std::get_if<int64_t>(&value); intVal != nullptr) {
+            ret = sqlite3_bind_int64(stmt, index, *intVal);
+        } else if (auto doubleVal = std::get_if<double>(&value); doubleVal != nullptr) {
+            ret = sqlite3_bind_double(stmt, index, *doubleVal);
+        } else if (auto strVal = std::get_if<std::string>(&value); strVal != nullptr) {
+            ret = sqlite3_bind_text(stmt, index, strVal->c_str(), static_cast<int>(strVal->size()), SQLITE_TRANSIENT);
+        } else if (auto blobVal = std::get_if<std::vector<uint8_t>>(&value); blobVal != nullptr) {
+            ret = sqlite3_bind_blob(stmt, index, blobVal->data(), static_cast<int>(blobVal->size()), SQLITE_TRANSIENT);
+        } else {
+            ret = sqlite3_bind_null(stmt, index);
+        }
+        if (ret != SQLITE_OK) {
+            return ret;
+        }
+    }
+    return SQLITE_OK;
+}
+
+std::vector<ValueObject> ToValueObjects(const std::vector<std::string>& args)
+{
+    return std::vector<ValueObject>(args.begin(), args.end());
+}
+}
+
+AbsSharedResultSet::AbsSharedResultSet(sqlite3_stmt* stmt, std::shared_ptr<std::recursive_mutex> dbMutex)
+    : stmt_(stmt), dbMutex_(dbMutex)
+{}
+
+AbsSharedResultSet::~AbsSharedResultSet()
+{
+    Close();
+}
+
+int AbsSharedResultSet::GoToNextRow()
+{
+    if (stmt_ == nullptr) {
+        return E_ERROR;
+    }
+    std::lock_guard<std::recursive_mutex> lock(*dbMutex_);
+    int ret = sqlite3_step(stmt_);
+    hasRow_ = (ret == SQLITE_ROW);
+    if (ret == SQLITE_DONE) {
+        return E_ERROR;
+    }
+    return hasRow_ ? E_OK : ConvertErrCode(ret);
+}
+
+int AbsSharedResultSet::GetColumnIndex(const std::string& columnName, int& columnIndex)
+{
+    if (stmt_ == nullptr) {
+        return E_ERROR;
+    }
+    int count = sqlite3_column_count(stmt_);
+    for (int i = 0; i < count; ++i) {
+        const char* name = sqlite3_column_name(stmt_, i);
+        if (name != nullptr && columnName == name) {
+            columnIndex = i;
+            return E_OK;
+        }
+    }
+    return E_ERROR;
+}
+
+int AbsSharedResultSet::CheckColumn(int columnIndex) const
+{
+    if (stmt_ == nullptr || !hasRow_ || columnIndex < 0 || columnIndex >= sqlite3_column_count(stmt_)) {
+        return E_ERROR;
+    }
+    return E_OK;
+}
+
+int AbsSharedResultSet::GetInt(int columnIndex, int& value)
+{
+    if (int ret = CheckColumn(columnIndex); ret != E_OK) {
+        return ret;
+    }
+    value = sqlite3_column_int(stmt_, columnIndex);
+    return E_OK;
+}
+
+int AbsSharedResultSet::GetLong(int columnIndex, int64_t& value)
+{
+    if (int ret = CheckColumn(columnIndex); ret != E_OK) {
+        return ret;
+    }
+    value = sqlite3_column_int64(stmt_, columnIndex);
+    return E_OK;
+}
+
+int AbsSharedResultSet::GetDouble(int columnIndex, double& value)
+{
+    if (int ret = CheckColumn(columnIndex); ret != E_OK) {
+        return ret;
+    }
+    value = sqlite3_column_double(stmt_, columnIndex);
+    return E_OK;
+}
+
+int AbsSharedResultSet::GetString(int columnIndex, std::string& value)
+{
+    if (int ret = CheckColumn(columnIndex); ret != E_OK) {
+        return ret;
+    }
+    const unsigned char* text = sqlite3_column_text(stmt_, columnIndex);
+    int len = sqlite3_column_bytes(stmt_, columnIndex);
+    value = (text == nullptr) ? "" : std::string(reinterpret_cast<const char*>(text), len);
+    return E_OK;
+}
+
+int AbsSharedResultSet::GetBlob(int columnIndex, std::vector<uint8_t>& value)
+{
+    if (int ret = CheckColumn(columnIndex); ret != E_OK) {
+        return ret;
+    }
+    const auto* blob = static_cast<const uint8_t*>(sqlite3_column_blob(stmt_, columnIndex));
+    int len = sqlite3_column_bytes(stmt_, columnIndex);
+    value = (blob == nullptr) ? std::vector<uint8_t>() : std::vector<uint8_t>(blob, blob + len);
+    return E_OK;
+}
+
+int AbsSharedResultSet::Close()
+{
+    if (stmt_ != nullptr) {
+        std::lock_guard<std::recursive_mutex> lock(*dbMutex_);
+        sqlite3_finalize(stmt_);
+        stmt_ = nullptr;
+    }
+    return E_OK;
+}
+
+RdbStore::RdbStore(sqlite3* db) : db_(db), dbMutex_(std::make_shared<std::recursive_mutex>())
+{}
+
+RdbStore::~RdbStore()
+{
+    std::lock_guard<std::recursive_mutex> lock(*dbMutex_);
+    for (const auto& [sql, stmt] : stmtCache_) {
+        sqlite3_finalize(stmt);
+    }
+    stmtCache_.clear();
+    sqlite3_close_v2(db_);
+}
+
+int RdbStore::Prepare(const std::string& sql, const std::vector<ValueObject>& bindArgs, sqlite3_stmt*& stmt)
+{
+    int ret = sqlite3_prepare_v2(db_, sql.c_str(), static_cast<int>(sql.size()), &stmt, nullptr);
+    if (ret != SQLITE_OK) {
+        HILOG_ERROR(LOG_CORE, "failed to prepare sql, ret=%{public}d, err=%{public}s", ret, sqlite3_errmsg(db_));
+        return ConvertErrCode(ret);
+    }
+    if (ret = BindArgs(stmt, bindArgs); ret != SQLITE_OK) {
+        HILOG_ERROR(LOG_CORE, "failed to bind args, ret=%{public}d", ret);
+        sqlite3_finalize(stmt);
+        stmt = nullptr;
+        return ConvertErrCode(ret);
+    }
+    return E_OK;
+}
+
+int RdbStore::Execute(const std::string& sql, const std::vector<ValueObject>& bindArgs)
+{
+    // the statements executed repeatedly are kept compiled, as the device store does
+    sqlite3_stmt* stmt = nullptr;
+    if (auto it = stmtCache_.find(sql); it != stmtCache_.end()) {
+        stmt = it->second;
+        if (int ret = BindArgs(stmt, bindArgs); ret != SQLITE_OK) {
+            sqlite3_clear_bindings(stmt);
+            return ConvertErrCode(ret);
+        }
+    } else {
+        if (int ret = Prepare(sql, bindArgs, stmt); ret != E_OK) {
+            return ret;
+        }
+        stmtCache_[sql] = stmt;
+    }
+    int ret = sqlite3_step(stmt);
+    sqlite3_reset(stmt);
+    sqlite3_clear_bindings(stmt);
+    if (ret != SQLITE_DONE && ret != SQLITE_ROW) {
+        HILOG_ERROR(LOG_CORE, "failed to execute sql, ret=%{public}d, err=%{public}s", ret, sqlite3_errmsg(db_));
+        return ConvertErrCode(ret);
+    }
+    return E_OK;
+}
+
+int RdbStore::InsertInner(int64_t& outRowId, const std::string& table, const ValuesBucket& values)
+{
+    std::string sql = "INSERT INTO " + table + " (";
+    std::string placeholders;
+    std::vector<ValueObject> bindArgs;
+    for (const auto& [column, value] : values.GetAll()) {
+        sql += bindArgs.empty() ? column : (", " + column);
+        placeholders += bindArgs.empty() ? "?" : ", ?";
+        bindArgs.emplace_back(value);
+    }
+    sql += ") VALUES (" + placeholders + ")";
+    if (int ret = Execute(sql, bindArgs); ret != E_OK) {
+        return ret;
+    }
+    outRowId = sqlite3_last_insert_rowid(db_);
+    return E_OK;
+}
+
+int RdbStore::Insert(int64_t& outRowId, const std::string& table, const ValuesBucket& values)
+{
+    std::lock_guard<std::recursive_mutex> lock(*dbMutex_);
+    return InsertInner(outRowId, table, values);
+}
+
+int RdbStore::BatchInsert(int64_t& outInsertNum, const std::string& table, const std::vector<ValuesBucket>& values)
+{
+    std::lock_guard<std::recursive_mutex> lock(*dbMutex_);
+    outInsertNum = 0;
+    if (int ret = BeginTransaction(); ret != E_OK) {
+        return ret;
+    }
+    for (const auto& bucket : values) {
+        int64_t rowId = 0;
+        if (int ret = InsertInner(rowId, table, bucket); ret != E_OK) {
+            RollBack();
+            return ret;
+        }
+    }
+    if (int ret = Commit(); ret != E_OK) {
+        return ret;
+    }
+    outInsertNum = static_cast<int64_t>(values.size());
+    return E_OK;
+}
+
+int RdbStore::Update(int& changedRows, const ValuesBucket& values, const AbsRdbPredicates& predicates)
+{
+    std::string sql = "UPDATE " + predicates.GetTableName() + " SET ";
+    std::vector<ValueObject> bindArgs;
+    for (const auto& [column, value] : values.GetAll()) {
+        sql += (bindArgs.empty() ? "" : ", ") + column + " = ?";
+        bindArgs.emplace_back(value);
+    }
+    if (!predicates.GetWhereClause().empty()) {
+        sql += " WHERE " + predicates.GetWhereClause();
+        bindArgs.insert(bindArgs.end(), predicates.GetBindArgs().begin(), predicates.GetBindArgs().end());
+    }
+    std::lock_guard<std::recursive_mutex> lock(*dbMutex_);
+    if (int ret = Execute(sql, bindArgs); ret != E_OK) {
+        return ret;
+    }
+    changedRows = sqlite3_changes(db_);
+    return E_OK;
+}
+
+int RdbStore::Delete(int& deletedRows, const AbsRdbPredicates& predicates)
+{
+    std::string sql = "DELETE FROM " + predicates.GetTableName();
+    if (!predicates.GetWhereClause().empty()) {
+        sql += " WHERE " + predicates.GetWhereClause();
+    }
+    std::lock_guard<std::recursive_mutex> lock(*dbMutex_);
+    if (int ret = Execute(sql, predicates.GetBindArgs()); ret != E_OK) {
+        return ret;
+    }
+    deletedRows = sqlite3_changes(db_);
+    return E_OK;
+}
+
+int RdbStore::Delete(int& deletedRows, const std::string& table, const std::string& whereClause,
+    const std::vector<std::string>& whereArgs)
+{
+    std::string sql = "DELETE FROM " + table;
+    if (!whereClause.empty()) {
+        sql += " WHERE " + whereClause;
+    }
+    std::lock_guard<std::recursive_mutex> lock(*dbMutex_);
+    if (int ret = Execute(sql, ToValueObjects(whereArgs)); ret != E_OK) {
+        return ret;
+    }
+    deletedRows = sqlite3_changes(db_);
+    return E_OK;
+}
+
+std::shared_ptr<AbsSharedResultSet> RdbStore::Query(const AbsRdbPredicates& predicates,
+    const std::vector<std::string>& columns)
+{
+    std::string sql = "SELECT ";
+    if (columns.empty()) {
+        sql += "*";
+    }
+    for (size_t i = 0; i < columns.size(); ++i) {
+        sql += (i == 0 ? "" : ", ") + columns[i];
+    }
+    sql += " FROM " + predicates.GetTableName();
+    if (!predicates.GetWhereClause().empty()) {
+        sql += " WHERE " + predicates.GetWhereClause();
+    }
+    return QuerySql(sql, predicates.GetBindArgs());
+}
+
+std::shared_ptr<AbsSharedResultSet> RdbStore::QuerySql(const std::string& sql,
+    const std::vector<ValueObject>& bindArgs)
+{
+    // every result set owns its statement since several of them may be alive at the same time
+    std::lock_guard<std::recursive_mutex> lock(*dbMutex_);
+    sqlite3_stmt* stmt = nullptr;
+    if (Prepare(sql, bindArgs, stmt) != E_OK) {
+        return nullptr;
+    }
+    return std::make_shared<AbsSharedResultSet>(stmt, dbMutex_);
+}
+
+std::shared_ptr<AbsSharedResultSet> RdbStore::QuerySql(const std::string& sql,
+    const std::vector<std::string>& bindArgs)
+{
+    return QuerySql(sql, ToValueObjects(bindArgs));
+}
+
+int RdbStore::ExecuteSql(const std::string& sql, const std::vector<ValueObject>& bindArgs)
+{
+    std::lock_guard<std::recursive_mutex> lock(*dbMutex_);
+    return Execute(sql, bindArgs);
+}
+
+int RdbStore::ExecuteForLastInsertedRowId(int64_t& outValue, const std::string& sql,
+    const std::vector<ValueObject>& bindArgs)
+{
+    std::lock_guard<std::recursive_mutex> lock(*dbMutex_);
+    if (int ret = Execute(sql, bindArgs); ret != E_OK) {
+        return ret;
+    }
+    outValue = sqlite3_last_insert_rowid(db_);
+    return E_OK;
+}
+
+int RdbStore::ExecuteForChangedRowCount(int64_t& outValue, const std::string& sql,
+    const std::vector<ValueObject>& bindArgs)
+{
+    std::lock_guard<std::recursive_mutex> lock(*dbMutex_);
+    if (int ret = Execute(sql, bindArgs); ret != E_OK) {
+        return ret;
+    }
+    outValue = sqlite3_changes(db_);
+    return E_OK;
+}
+
+int RdbStore::BeginTransaction()
+{
+    // the nested transactions are mapped to savepoints, the lock is held until the outermost one ends
+    dbMutex_->lock();
+    int ret = Execute(transactionDepth_ == 0 ? "BEGIN IMMEDIATE" :
+        ("SAVEPOINT sp" + std::to_string(transactionDepth_)), {});
+    if (ret != E_OK) {
+        dbMutex_->unlock();
+        return ret;
+    }
+    ++transactionDepth_;
+    return E_OK;
+}
+
+int RdbStore::Commit()
+{
+    std::lock_guard<std::recursive_mutex> lock(*dbMutex_);
+    if (transactionDepth_ <= 0) {
+        return E_ERROR;
+    }
+    --transactionDepth_;
+    int ret = Execute(transactionDepth_ == 0 ? "COMMIT" : ("RELEASE sp" + std::to_string(transactionDepth_)), {});
+    dbMutex_->unlock();
+    return ret;
+}
+
+int RdbStore::RollBack()
+{
+    std::lock_guard<std::recursive_mutex> lock(*dbMutex_);
+    if (transactionDepth_ <= 0) {
+        return E_ERROR;
+    }
+    --transactionDepth_;
+    int ret = E_OK;
+    if (transactionDepth_ == 0) {
+        ret = Execute("ROLLBACK", {});
+    } else {
+        std::string savepoint = "sp" + std::to_string(transactionDepth_);
+        ret = Execute("ROLLBACK TO " + savepoint, {});
+        Execute("RELEASE " + savepoint, {});
+    }
+    dbMutex_->unlock();
+    return ret;
+}
+
+int RdbStore::GetVersion(int& version)
+{
+    auto resultSet = QuerySql("PRAGMA user_version");
+    if (resultSet == nullptr || resultSet->GoToNextRow() != E_OK) {
+        return E_ERROR;
+    }
+    return resultSet->GetInt(0, version);
+}
+
+int RdbStore::SetVersion(int version)
+{
+    return ExecuteSql("PRAGMA user_version = " + std::to_string(version));
+}
+} // namespace NativeRdb
+} // namespace OHOS
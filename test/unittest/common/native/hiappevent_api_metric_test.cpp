@@ -15,12 +15,15 @@
 
 #include "hiappevent_api_metric_test.h"
 
+#include <chrono>
 #include <iostream>
+#include <thread>
 
 #define private public
 #include "api_stats_mgr.h"
 #include "api_stats_timer.h"
 #undef private
+#include "api_latency_sketch.h"
 #include "api_stats_types.h"
 #include "app_api_metric.h"
 #include "api_stats_aggregator.h"
@@ -304,17 +307,17 @@ HWTEST_F(HiAppEventApiMetricTest, ApiStatsAggregatorTest001, TestSize.Level0)
     /**
      * @tc.steps: step1. create ApiStatsAggregator.
      * @tc.steps: step2. call Record() with single metric.
-     * @tc.steps: step3. check the result with GetApiMetrics().
+     * @tc.steps: step3. check the result with GetApiStats().
      */
     ApiStatsAggregator aggregator;
     ApiDescriptor descriptor(TEST_KIT, TEST_API);
     ApiMetric metric{TEST_ERR_CODE, TEST_DURATION, TEST_SUCCESSFUL};
     aggregator.Record(descriptor, metric);
     
-    auto apiMetrics = aggregator.GetApiMetrics();
-    EXPECT_EQ(apiMetrics.size(), 1);
-    EXPECT_TRUE(apiMetrics.find(descriptor) != apiMetrics.end());
-    EXPECT_EQ(apiMetrics[descriptor].size(), 1);
+    auto apiStats = aggregator.GetApiStats();
+    EXPECT_EQ(apiStats.size(), 1);
+    EXPECT_TRUE(apiStats.find(descriptor) != apiStats.end());
+    EXPECT_EQ(apiStats[descriptor].callTimes, 1);
 }
 
 /**
@@ -336,9 +339,13 @@ HWTEST_F(HiAppEventApiMetricTest, ApiStatsAggregatorTest002, TestSize.Level0)
     aggregator.Record(descriptor, metric1);
     aggregator.Record(descriptor, metric2);
     
-    auto apiMetrics = aggregator.GetApiMetrics();
-    EXPECT_EQ(apiMetrics.size(), 1);
-    EXPECT_EQ(apiMetrics[descriptor].size(), 2);
+    auto apiStats = aggregator.GetApiStats();
+    EXPECT_EQ(apiStats.size(), 1);
+    EXPECT_EQ(apiStats[descriptor].callTimes, 2);
+    EXPECT_EQ(apiStats[descriptor].successTimes, 1);
+    EXPECT_EQ(apiStats[descriptor].maxCostTime, TEST_DURATION2);
+    EXPECT_EQ(apiStats[descriptor].minCostTime, TEST_DURATION);
+    EXPECT_EQ(apiStats[descriptor].errorCodeNums.size(), 2);
 }
 
 /**
@@ -360,10 +367,10 @@ HWTEST_F(HiAppEventApiMetricTest, ApiStatsAggregatorTest003, TestSize.Level0)
     aggregator.Record(descriptor1, metric);
     aggregator.Record(descriptor2, metric);
     
-    auto apiMetrics = aggregator.GetApiMetrics();
-    EXPECT_EQ(apiMetrics.size(), 2);
-    EXPECT_EQ(apiMetrics[descriptor1].size(), 1);
-    EXPECT_EQ(apiMetrics[descriptor2].size(), 1);
+    auto apiStats = aggregator.GetApiStats();
+    EXPECT_EQ(apiStats.size(), 2);
+    EXPECT_EQ(apiStats[descriptor1].callTimes, 1);
+    EXPECT_EQ(apiStats[descriptor2].callTimes, 1);
 }
 
 /**
@@ -376,7 +383,7 @@ HWTEST_F(HiAppEventApiMetricTest, ApiStatsAggregatorTest004, TestSize.Level0)
     /**
      * @tc.steps: step1. create ApiStatsEntity and add records.
      * @tc.steps: step2. call ClearRecord().
-     * @tc.steps: step3. check GetApiMetrics() is empty.
+     * @tc.steps: step3. check GetApiStats() is empty.
      */
     ApiStatsAggregator aggregator;
     ApiDescriptor descriptor(TEST_KIT, TEST_API);
@@ -384,8 +391,8 @@ HWTEST_F(HiAppEventApiMetricTest, ApiStatsAggregatorTest004, TestSize.Level0)
     aggregator.Record(descriptor, metric);
     aggregator.ClearRecord();
     
-    auto apiMetrics = aggregator.GetApiMetrics();
-    EXPECT_EQ(apiMetrics.size(), 0);
+    auto apiStats = aggregator.GetApiStats();
+    EXPECT_EQ(apiStats.size(), 0);
 }
 
 /**
@@ -450,16 +457,16 @@ HWTEST_F(HiAppEventApiMetricTest, ApiStatsAggregatorTest007, TestSize.Level0)
 HWTEST_F(HiAppEventApiMetricTest, ApiStatsAggregatorTest008, TestSize.Level0)
 {
     /**
-     * @tc.steps: step1. create apiMetrics map with single metric.
+     * @tc.steps: step1. create api stats map with single metric.
      * @tc.steps: step2. call AggregateStats().
      * @tc.steps: step3. check the aggregated result.
      */
-    std::map<ApiDescriptor, std::vector<ApiMetric>, ApiDescriptor::ApiDescriptorComparator> apiMetrics;
+    ApiStatsMap apiStats;
     ApiDescriptor descriptor(TEST_KIT, TEST_API);
     ApiMetric metric{TEST_ERR_CODE, TEST_DURATION, TEST_SUCCESSFUL};
-    apiMetrics[descriptor].push_back(metric);
+    apiStats[descriptor].Add(metric);
     
-    auto reports = ApiStatsAggregator::AggregateStats(apiMetrics);
+    auto reports = ApiStatsAggregator::AggregateStats(apiStats);
     EXPECT_EQ(reports.size(), 1);
     EXPECT_EQ(reports[0].kitName, TEST_KIT);
     EXPECT_EQ(reports[0].apiName, TEST_API);
@@ -478,18 +485,18 @@ HWTEST_F(HiAppEventApiMetricTest, ApiStatsAggregatorTest008, TestSize.Level0)
 HWTEST_F(HiAppEventApiMetricTest, ApiStatsAggregatorTest009, TestSize.Level0)
 {
     /**
-     * @tc.steps: step1. create apiMetrics map with multiple metrics.
+     * @tc.steps: step1. create api stats map with multiple metrics.
      * @tc.steps: step2. call AggregateStats().
      * @tc.steps: step3. check the aggregated statistics.
      */
-    std::map<ApiDescriptor, std::vector<ApiMetric>, ApiDescriptor::ApiDescriptorComparator> apiMetrics;
+    ApiStatsMap apiStats;
     ApiDescriptor descriptor(TEST_KIT, TEST_API);
     ApiMetric metric1{TEST_ERR_CODE, TEST_DURATION, TEST_SUCCESSFUL};
     ApiMetric metric2{TEST_ERR_CODE2, TEST_DURATION2, TEST_SUCCESSFUL2};
-    apiMetrics[descriptor].push_back(metric1);
-    apiMetrics[descriptor].push_back(metric2);
+    apiStats[descriptor].Add(metric1);
+    apiStats[descriptor].Add(metric2);
     
-    auto reports = ApiStatsAggregator::AggregateStats(apiMetrics);
+    auto reports = ApiStatsAggregator::AggregateStats(apiStats);
     EXPECT_EQ(reports.size(), 1);
     EXPECT_EQ(reports[0].callTimes, 2);
     EXPECT_EQ(reports[0].successTimes, 1);
@@ -506,20 +513,20 @@ HWTEST_F(HiAppEventApiMetricTest, ApiStatsAggregatorTest009, TestSize.Level0)
 HWTEST_F(HiAppEventApiMetricTest, ApiStatsAggregatorTest010, TestSize.Level0)
 {
     /**
-     * @tc.steps: step1. create apiMetrics map with different error codes.
+     * @tc.steps: step1. create api stats map with different error codes.
      * @tc.steps: step2. call AggregateStats().
      * @tc.steps: step3. check the error code statistics.
      */
-    std::map<ApiDescriptor, std::vector<ApiMetric>, ApiDescriptor::ApiDescriptorComparator> apiMetrics;
+    ApiStatsMap apiStats;
     ApiDescriptor descriptor(TEST_KIT, TEST_API);
     ApiMetric metric1{TEST_ERR_CODE, TEST_DURATION, TEST_SUCCESSFUL};
     ApiMetric metric2{TEST_ERR_CODE, TEST_DURATION, TEST_SUCCESSFUL2};
     ApiMetric metric3{TEST_ERR_CODE2, TEST_DURATION2, TEST_SUCCESSFUL2};
-    apiMetrics[descriptor].push_back(metric1);
-    apiMetrics[descriptor].push_back(metric2);
-    apiMetrics[descriptor].push_back(metric3);
+    apiStats[descriptor].Add(metric1);
+    apiStats[descriptor].Add(metric2);
+    apiStats[descriptor].Add(metric3);
     
-    auto reports = ApiStatsAggregator::AggregateStats(apiMetrics);
+    auto reports = ApiStatsAggregator::AggregateStats(apiStats);
     EXPECT_EQ(reports.size(), 1);
     EXPECT_EQ(reports[0].errorCodeTypes.size(), 2);
     EXPECT_EQ(reports[0].errorCodeNum.size(), 2);
@@ -533,12 +540,12 @@ HWTEST_F(HiAppEventApiMetricTest, ApiStatsAggregatorTest010, TestSize.Level0)
 HWTEST_F(HiAppEventApiMetricTest, ApiStatsStorageTest001, TestSize.Level0)
 {
     /**
-     * @tc.steps: step1. create empty apiMetrics map.
+     * @tc.steps: step1. create empty api stats map.
      * @tc.steps: step2. call Backup().
      * @tc.steps: step3. check return value.
      */
-    std::map<ApiDescriptor, std::vector<ApiMetric>, ApiDescriptor::ApiDescriptorComparator> apiMetrics;
-    int ret = ApiStatsStorage::GetInstance().Backup(apiMetrics);
+    ApiStatsMap apiStats;
+    int ret = ApiStatsStorage::GetInstance().Backup(apiStats);
     EXPECT_EQ(ret, 0);
 }
 
@@ -550,16 +557,16 @@ HWTEST_F(HiAppEventApiMetricTest, ApiStatsStorageTest001, TestSize.Level0)
 HWTEST_F(HiAppEventApiMetricTest, ApiStatsStorageTest002, TestSize.Level0)
 {
     /**
-     * @tc.steps: step1. create apiMetrics map with single record.
+     * @tc.steps: step1. create api stats map with single record.
      * @tc.steps: step2. call Backup().
      * @tc.steps: step3. check return value.
      */
-    std::map<ApiDescriptor, std::vector<ApiMetric>, ApiDescriptor::ApiDescriptorComparator> apiMetrics;
+    ApiStatsMap apiStats;
     ApiDescriptor descriptor(TEST_KIT, TEST_API);
     ApiMetric metric{TEST_ERR_CODE, TEST_DURATION, TEST_SUCCESSFUL};
-    apiMetrics[descriptor].push_back(metric);
+    apiStats[descriptor].Add(metric);
     
-    int ret = ApiStatsStorage::GetInstance().Backup(apiMetrics);
+    int ret = ApiStatsStorage::GetInstance().Backup(apiStats);
     EXPECT_EQ(ret, 0);
     
     ApiStatsStorage::GetInstance().Clear();
@@ -577,14 +584,14 @@ HWTEST_F(HiAppEventApiMetricTest, ApiStatsStorageTest003, TestSize.Level0)
      * @tc.steps: step2. call QueryAll().
      * @tc.steps: step3. check the queried data.
      */
-    std::map<ApiDescriptor, std::vector<ApiMetric>, ApiDescriptor::ApiDescriptorComparator> apiMetrics;
+    ApiStatsMap apiStats;
     ApiDescriptor descriptor(TEST_KIT, TEST_API);
     ApiMetric metric{TEST_ERR_CODE, TEST_DURATION, TEST_SUCCESSFUL};
-    apiMetrics[descriptor].push_back(metric);
+    apiStats[descriptor].Add(metric);
     
-    ApiStatsStorage::GetInstance().Backup(apiMetrics);
+    ApiStatsStorage::GetInstance().Backup(apiStats);
     
-    std::map<ApiDescriptor, std::vector<ApiMetric>, ApiDescriptor::ApiDescriptorComparator> queriedMetrics;
+    ApiStatsMap queriedMetrics;
     int ret = ApiStatsStorage::GetInstance().QueryAll(queriedMetrics);
     EXPECT_EQ(ret, 0);
     EXPECT_EQ(queriedMetrics.size(), 1);
@@ -604,15 +611,15 @@ HWTEST_F(HiAppEventApiMetricTest, ApiStatsStorageTest004, TestSize.Level0)
      * @tc.steps: step2. call Clear().
      * @tc.steps: step3. QueryAll and check empty result.
      */
-    std::map<ApiDescriptor, std::vector<ApiMetric>, ApiDescriptor::ApiDescriptorComparator> apiMetrics;
+    ApiStatsMap apiStats;
     ApiDescriptor descriptor(TEST_KIT, TEST_API);
     ApiMetric metric{TEST_ERR_CODE, TEST_DURATION, TEST_SUCCESSFUL};
-    apiMetrics[descriptor].push_back(metric);
+    apiStats[descriptor].Add(metric);
     
-    ApiStatsStorage::GetInstance().Backup(apiMetrics);
+    ApiStatsStorage::GetInstance().Backup(apiStats);
     ApiStatsStorage::GetInstance().Clear();
     
-    std::map<ApiDescriptor, std::vector<ApiMetric>, ApiDescriptor::ApiDescriptorComparator> queriedMetrics;
+    ApiStatsMap queriedMetrics;
     int ret = ApiStatsStorage::GetInstance().QueryAll(queriedMetrics);
     EXPECT_EQ(ret, 0);
     EXPECT_EQ(queriedMetrics.size(), 0);
@@ -630,18 +637,18 @@ HWTEST_F(HiAppEventApiMetricTest, ApiStatsStorageTest005, TestSize.Level0)
      * @tc.steps: step2. QueryAll and verify data.
      * @tc.steps: step3. Clear and verify empty.
      */
-    std::map<ApiDescriptor, std::vector<ApiMetric>, ApiDescriptor::ApiDescriptorComparator> apiMetrics;
+    ApiStatsMap apiStats;
     ApiDescriptor descriptor1(TEST_KIT, TEST_API);
     ApiDescriptor descriptor2(TEST_KIT2, TEST_API2);
     ApiMetric metric1{TEST_ERR_CODE, TEST_DURATION, TEST_SUCCESSFUL};
     ApiMetric metric2{TEST_ERR_CODE2, TEST_DURATION2, TEST_SUCCESSFUL2};
-    apiMetrics[descriptor1].push_back(metric1);
-    apiMetrics[descriptor2].push_back(metric2);
-    apiMetrics[descriptor2].push_back(metric2);
+    apiStats[descriptor1].Add(metric1);
+    apiStats[descriptor2].Add(metric2);
+    apiStats[descriptor2].Add(metric2);
     
-    EXPECT_EQ(ApiStatsStorage::GetInstance().Backup(apiMetrics), 0);
+    EXPECT_EQ(ApiStatsStorage::GetInstance().Backup(apiStats), 0);
     
-    std::map<ApiDescriptor, std::vector<ApiMetric>, ApiDescriptor::ApiDescriptorComparator> queriedMetrics;
+    ApiStatsMap queriedMetrics;
     EXPECT_EQ(ApiStatsStorage::GetInstance().QueryAll(queriedMetrics), 0);
     EXPECT_EQ(queriedMetrics.size(), 2);
     
@@ -862,11 +869,271 @@ HWTEST_F(HiAppEventApiMetricTest, ApiStatsStorageTest006, TestSize.Level0)
     AppEventStore::GetInstance().InsertApiMetricInfo(TEST_KIT, TEST_API, invalidDuration);
     AppEventStore::GetInstance().InsertApiMetricInfo(TEST_KIT, TEST_API, invalidSuccessful);
 
-    ApiMetricsMap queriedMetrics;
+    ApiStatsMap queriedMetrics;
     int ret = ApiStatsStorage::GetInstance().QueryAll(queriedMetrics);
     EXPECT_EQ(ret, 0);
     EXPECT_EQ(queriedMetrics.size(), 1);
+    EXPECT_EQ(queriedMetrics.begin()->second.callTimes, 1);
 
     ApiStatsStorage::GetInstance().Clear();
     AppEventStore::GetInstance().DestroyDbStore();
 }
+
+/**
+ * @tc.name: ApiStatsStorageTest007
+ * @tc.desc: check the ApiStatsStorage backups one row per api and merges rows of different windows.
+ * @tc.type: FUNC
+ */
+HWTEST_F(HiAppEventApiMetricTest, ApiStatsStorageTest007, TestSize.Level0)
+{
+    /**
+     * @tc.steps: step1. record many metrics of one api and backup them.
+     * @tc.steps: step2. check only one row is stored for the api.
+     * @tc.steps: step3. backup another window and check QueryAll merges both rows.
+     */
+    constexpr int recordNum = 1000;
+    ApiStatsAggregator aggregator;
+    ApiDescriptor descriptor(TEST_KIT, TEST_API);
+    for (int i = 0; i < recordNum; ++i) {
+        aggregator.Record(descriptor, ApiMetric{TEST_ERR_CODE, TEST_DURATION, TEST_SUCCESSFUL});
+    }
+    EXPECT_EQ(ApiStatsStorage::GetInstance().Backup(aggregator.GetApiStats()), 0);
+
+    std::map<std::pair<std::string, std::string>, std::vector<std::string>> rows;
+    EXPECT_EQ(AppEventStore::GetInstance().QueryApiMetricInfoAll(rows), OHOS::NativeRdb::E_OK);
+    ASSERT_EQ(rows.size(), 1);
+    EXPECT_EQ(rows.begin()->second.size(), 1);
+
+    aggregator.ClearRecord();
+    aggregator.Record(descriptor, ApiMetric{TEST_ERR_CODE2, TEST_DURATION2, TEST_SUCCESSFUL2});
+    EXPECT_EQ(ApiStatsStorage::GetInstance().Backup(aggregator.GetApiStats()), 0);
+
+    ApiStatsMap queriedStats;
+    EXPECT_EQ(ApiStatsStorage::GetInstance().QueryAll(queriedStats), 0);
+    ASSERT_EQ(queriedStats.size(), 1);
+    const auto& stats = queriedStats.begin()->second;
+    EXPECT_EQ(stats.callTimes, recordNum + 1);
+    EXPECT_EQ(stats.successTimes, recordNum);
+    EXPECT_EQ(stats.maxCostTime, TEST_DURATION2);
+    EXPECT_EQ(stats.minCostTime, TEST_DURATION);
+    EXPECT_EQ(stats.totalCostTime, static_cast<int64_t>(TEST_DURATION) * recordNum + TEST_DURATION2);
+    EXPECT_EQ(stats.errorCodeNums.size(), 2);
+    EXPECT_EQ(stats.costTimeSketch.Count(), recordNum + 1);
+
+    ApiStatsStorage::GetInstance().Clear();
+}
+
+/**
+ * @tc.name: ApiDescriptorTest005
+ * @tc.desc: check the ApiDescriptor hash and equality.
+ * @tc.type: FUNC
+ */
+HWTEST_F(HiAppEventApiMetricTest, ApiDescriptorTest005, TestSize.Level0)
+{
+    /**
+     * @tc.steps: step1. create equal and different ApiDescriptors.
+     * @tc.steps: step2. check the precomputed hash and operator==.
+     */
+    ApiDescriptor descriptor1(TEST_KIT, TEST_API);
+    ApiDescriptor descriptor2(TEST_KIT, TEST_API);
+    ApiDescriptor descriptor3(TEST_KIT2, TEST_API2);
+    EXPECT_EQ(descriptor1.Hash(), descriptor2.Hash());
+    EXPECT_TRUE(descriptor1 == descriptor2);
+    EXPECT_FALSE(descriptor1 == descriptor3);
+    ApiDescriptor::ApiDescriptorHasher hasher;
+    EXPECT_EQ(hasher(descriptor1), descriptor1.Hash());
+}
+
+/**
+ * @tc.name: ApiStatsAggregatorTest011
+ * @tc.desc: check the ApiStatsAggregator Record from multiple threads and TakeApiStats.
+ * @tc.type: FUNC
+ */
+HWTEST_F(HiAppEventApiMetricTest, ApiStatsAggregatorTest011, TestSize.Level0)
+{
+    /**
+     * @tc.steps: step1. record metrics of one api from multiple threads.
+     * @tc.steps: step2. call TakeApiStats() and check the merged stats.
+     * @tc.steps: step3. check the aggregator is empty after TakeApiStats().
+     */
+    constexpr int threadNum = 16;
+    constexpr int recordNum = 1000;
+    ApiStatsAggregator aggregator;
+    ApiDescriptor descriptor(TEST_KIT, TEST_API);
+    std::vector<std::thread> threads;
+    for (int i = 0; i < threadNum; ++i) {
+        threads.emplace_back([&aggregator, &descriptor]() {
+            for (int j = 0; j < recordNum; ++j) {
+                aggregator.Record(descriptor, ApiMetric{TEST_ERR_CODE, TEST_DURATION, TEST_SUCCESSFUL});
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    EXPECT_TRUE(aggregator.IsUpdatedAfterLastBackup());
+
+    auto apiStats = aggregator.TakeApiStats();
+    ASSERT_EQ(apiStats.size(), 1);
+    EXPECT_EQ(apiStats[descriptor].callTimes, threadNum * recordNum);
+    EXPECT_EQ(apiStats[descriptor].successTimes, threadNum * recordNum);
+    EXPECT_FALSE(aggregator.IsUpdatedAfterLastBackup());
+    EXPECT_EQ(aggregator.GetApiStats().size(), 0);
+
+    aggregator.RestoreApiStats(apiStats);
+    EXPECT_TRUE(aggregator.IsUpdatedAfterLastBackup());
+    EXPECT_EQ(aggregator.GetApiStats()[descriptor].callTimes, threadNum * recordNum);
+}
+
+/**
+ * @tc.name: ReportApiMetricPerfTest001
+ * @tc.desc: check the throughput of ReportApiMetric from 1 to 16 threads.
+ * @tc.type: PERF
+ */
+HWTEST_F(HiAppEventApiMetricTest, ReportApiMetricPerfTest001, TestSize.Level1)
+{
+    /**
+     * @tc.steps: step1. call ReportApiMetric() from 1, 2, 4, 8 and 16 threads.
+     * @tc.steps: step2. print the calls per second of each thread number.
+     */
+    constexpr int recordNum = 100000;
+    constexpr int maxThreadNum = 16;
+    HiAppEvent::ApiInfo apiInfo;
+    apiInfo.kit = TEST_KIT;
+    apiInfo.api = TEST_API;
+    HiAppEvent::ApiMetric metric{TEST_ERR_CODE, TEST_DURATION, TEST_SUCCESSFUL};
+    for (int threadNum = 1; threadNum <= maxThreadNum; threadNum *= 2) { // 2: double the threads every round
+        std::atomic<int> failedNum {0};
+        std::vector<std::thread> threads;
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < threadNum; ++i) {
+            threads.emplace_back([&apiInfo, &metric, &failedNum]() {
+                for (int j = 0; j < recordNum; ++j) {
+                    if (HiAppEvent::ReportApiMetric(apiInfo, metric) != ErrorCode::HIAPPEVENT_VERIFY_SUCCESSFUL) {
+                        failedNum++;
+                    }
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        auto costUs = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - start).count();
+        EXPECT_EQ(failedNum.load(), 0);
+        constexpr double microPerSecond = 1000000.0;
+        double callsPerSecond = costUs > 0 ? threadNum * recordNum * microPerSecond / costUs : 0;
+        std::cout << "threads=" << threadNum << ", calls=" << threadNum * recordNum << ", cost_us=" << costUs
+            << ", calls_per_sec=" << static_cast<int64_t>(callsPerSecond) << std::endl;
+    }
+}
+
+/**
+ * @tc.name: ApiLatencySketchTest001
+ * @tc.desc: check the ApiLatencySketch quantiles are within the relative accuracy.
+ * @tc.type: FUNC
+ */
+HWTEST_F(HiAppEventApiMetricTest, ApiLatencySketchTest001, TestSize.Level0)
+{
+    /**
+     * @tc.steps: step1. add the values from 1 to 1000 to the sketch.
+     * @tc.steps: step2. check p50, p90 and p99 against the exact values.
+     */
+    constexpr int valueNum = 1000;
+    ApiLatencySketch sketch;
+    EXPECT_TRUE(sketch.IsEmpty());
+    EXPECT_EQ(sketch.Quantile(0.5), 0);
+    for (int i = 1; i <= valueNum; ++i) {
+        sketch.Add(i);
+    }
+    sketch.Add(-1);
+    EXPECT_EQ(sketch.Count(), valueNum);
+
+    const std::vector<std::pair<double, int64_t>> expects = {{0.5, 500}, {0.9, 900}, {0.99, 990}};
+    for (const auto& [quantile, exactValue] : expects) {
+        int64_t value = sketch.Quantile(quantile);
+        double tolerance = exactValue * ApiLatencySketch::RELATIVE_ACCURACY + 1;
+        EXPECT_NEAR(static_cast<double>(value), static_cast<double>(exactValue), tolerance);
+    }
+}
+
+/**
+ * @tc.name: ApiLatencySketchTest002
+ * @tc.desc: check the ApiLatencySketch Merge, Encode and Decode.
+ * @tc.type: FUNC
+ */
+HWTEST_F(HiAppEventApiMetricTest, ApiLatencySketchTest002, TestSize.Level0)
+{
+    /**
+     * @tc.steps: step1. add values to two sketches and merge them.
+     * @tc.steps: step2. encode and decode the merged sketch.
+     * @tc.steps: step3. check the decoded sketch and the invalid encoded values.
+     */
+    ApiLatencySketch sketch1;
+    ApiLatencySketch sketch2;
+    sketch1.Add(0);
+    sketch1.Add(TEST_DURATION);
+    sketch2.Add(TEST_DURATION2);
+    sketch1.Merge(sketch2);
+    EXPECT_EQ(sketch1.Count(), 3);
+
+    ApiLatencySketch decoded;
+    EXPECT_TRUE(decoded.Decode(sketch1.Encode()));
+    EXPECT_EQ(decoded.Count(), sketch1.Count());
+    EXPECT_EQ(decoded.Quantile(0), 0);
+    EXPECT_EQ(decoded.Quantile(1), sketch1.Quantile(1));
+
+    EXPECT_FALSE(decoded.Decode({}));
+    EXPECT_FALSE(decoded.Decode({0, 1}));
+    EXPECT_FALSE(decoded.Decode({0, 1, -1}));
+    EXPECT_EQ(decoded.Count(), sketch1.Count());
+}
+
+/**
+ * @tc.name: ApiLatencySketchTest003
+ * @tc.desc: check the ApiLatencySketch keeps a bounded number of buckets.
+ * @tc.type: FUNC
+ */
+HWTEST_F(HiAppEventApiMetricTest, ApiLatencySketchTest003, TestSize.Level0)
+{
+    /**
+     * @tc.steps: step1. add values spread over the whole int range.
+     * @tc.steps: step2. check the encoded size is bounded and the max value is kept.
+     */
+    ApiLatencySketch sketch;
+    for (int64_t value = 1; value < INT32_MAX; value = value * 11 / 10 + 1) { // 11 / 10: grow by 10 percent
+        sketch.Add(value);
+    }
+    sketch.Add(INT32_MAX);
+    EXPECT_LE(sketch.Encode().size(), 1 + ApiLatencySketch::MAX_BUCKET_NUM * 2); // 2: index and count
+    double tolerance = INT32_MAX * ApiLatencySketch::RELATIVE_ACCURACY;
+    EXPECT_NEAR(static_cast<double>(sketch.Quantile(1)), static_cast<double>(INT32_MAX), tolerance);
+}
+
+/**
+ * @tc.name: ApiStatsAggregatorTest012
+ * @tc.desc: check the ApiStatsAggregator AggregateStats cost time quantiles.
+ * @tc.type: FUNC
+ */
+HWTEST_F(HiAppEventApiMetricTest, ApiStatsAggregatorTest012, TestSize.Level0)
+{
+    /**
+     * @tc.steps: step1. create api stats with cost times from 1 to 100.
+     * @tc.steps: step2. call AggregateStats().
+     * @tc.steps: step3. check p50, p90 and p99 are in range of the min and max cost time.
+     */
+    constexpr int recordNum = 100;
+    ApiStatsMap apiStats;
+    ApiDescriptor descriptor(TEST_KIT, TEST_API);
+    for (int i = 1; i <= recordNum; ++i) {
+        apiStats[descriptor].Add(ApiMetric{TEST_ERR_CODE, i, TEST_SUCCESSFUL});
+    }
+
+    auto reports = ApiStatsAggregator::AggregateStats(apiStats);
+    ASSERT_EQ(reports.size(), 1);
+    EXPECT_NEAR(static_cast<double>(reports[0].p50CostTime), 50.0, 2.0); // 50: exact p50, 2: tolerance
+    EXPECT_NEAR(static_cast<double>(reports[0].p90CostTime), 90.0, 3.0); // 90: exact p90, 3: tolerance
+    EXPECT_NEAR(static_cast<double>(reports[0].p99CostTime), 99.0, 3.0); // 99: exact p99, 3: tolerance
+    EXPECT_LE(reports[0].p99CostTime, reports[0].maxCostTime);
+    EXPECT_GE(reports[0].p50CostTime, reports[0].minCostTime);
+}
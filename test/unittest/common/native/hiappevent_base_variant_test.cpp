@@ -15,9 +15,14 @@
 
 #include <gtest/gtest.h>
 
+#include <cstdint>
+#include <list>
+#include <string>
 #include <variant>
 #include <vector>
 
+#include "app_event_params_codec.h"
+#include "app_event_params_decoder.h"
 #include "hiappevent_base.h"
 
 using namespace testing::ext;
@@ -29,6 +34,81 @@ public:
     void SetUp() {}
     void TearDown() {}
 };
+
+class RecordParamsHandler : public AppEventParamsHandler {
+public:
+    explicit RecordParamsHandler(bool takeNested = true) : takeNested_(takeNested) {}
+
+    void OnKey(const std::string& key) override { trace_ += key + ":"; }
+    void OnNull() override { trace_ += "null,"; }
+    void OnBool(bool value) override { trace_ += value ? "true," : "false,"; }
+    void OnInt(int64_t value) override { trace_ += "i" + std::to_string(value) + ","; }
+    void OnDouble(double value) override { trace_ += "d" + std::to_string(value) + ","; }
+    void OnString(const std::string& value) override { trace_ += "s" + value + ","; }
+
+    void OnBoolArray(const std::vector<bool>& values) override
+    {
+        trace_ += "b[";
+        for (bool value : values) {
+            trace_ += value ? "1" : "0";
+        }
+        trace_ += "],";
+    }
+
+    void OnIntArray(const std::vector<int64_t>& values) override
+    {
+        trace_ += "i[";
+        for (auto value : values) {
+            trace_ += std::to_string(value) + " ";
+        }
+        trace_ += "],";
+    }
+
+    void OnDoubleArray(const std::vector<double>& values) override
+    {
+        trace_ += "d[";
+        for (auto value : values) {
+            trace_ += std::to_string(value) + " ";
+        }
+        trace_ += "],";
+    }
+
+    void OnStringArray(const std::vector<std::string>& values) override
+    {
+        trace_ += "s[";
+        for (const auto& value : values) {
+            trace_ += value + " ";
+        }
+        trace_ += "],";
+    }
+
+    bool OnObjectBegin() override
+    {
+        if (takeNested_) {
+            trace_ += "{";
+        }
+        return takeNested_;
+    }
+
+    void OnObjectEnd() override { trace_ += "},"; }
+
+    bool OnArrayBegin() override
+    {
+        if (takeNested_) {
+            trace_ += "[";
+        }
+        return takeNested_;
+    }
+
+    void OnArrayEnd() override { trace_ += "],"; }
+    void OnRawValue(const char* data, size_t len) override { trace_ += "r" + std::string(data, len) + ","; }
+
+    const std::string& GetTrace() const { return trace_; }
+
+private:
+    bool takeNested_;
+    std::string trace_;
+};
 }
 
 /**
@@ -544,3 +624,246 @@ HWTEST_F(HiAppEventBaseVariantTest, AppEventPack_GetCustomParams001, TestSize.Le
         }
     }
 }
+
+/**
+ * @tc.name: AppEventParamsDecoder_Decode001
+ * @tc.desc: check the params json text is decoded into scalars and typed arrays.
+ * @tc.type: FUNC
+ */
+HWTEST_F(HiAppEventBaseVariantTest, AppEventParamsDecoder_Decode001, TestSize.Level0)
+{
+    std::string paramStr = R"({"b":true,"i":-12,"d":1.5,"s":"a\"\u00e9","n":null,)"
+        R"("ba":[true,false],"ia":[1,2],"da":[1,2.5],"sa":["x","y"],"ea":[]})";
+    RecordParamsHandler handler;
+    EXPECT_TRUE(AppEventParamsDecoder::Decode(paramStr, handler));
+    EXPECT_EQ(handler.GetTrace(), "b:true,i:i-12,d:d1.500000,s:sa\"\xc3\xa9,n:null,ba:b[10],ia:i[1 2 ],"
+        "da:d[1.000000 2.500000 ],sa:s[x y ],ea:[],");
+}
+
+/**
+ * @tc.name: AppEventParamsDecoder_Decode002
+ * @tc.desc: check the nested objects and the mixed arrays are decoded member by member.
+ * @tc.type: FUNC
+ */
+HWTEST_F(HiAppEventBaseVariantTest, AppEventParamsDecoder_Decode002, TestSize.Level0)
+{
+    std::string paramStr = R"({"o":{"k":[1,{"x":"y"}],"e":{}},"m":[1,"a",[true]]})";
+    RecordParamsHandler handler;
+    EXPECT_TRUE(AppEventParamsDecoder::Decode(paramStr, handler));
+    EXPECT_EQ(handler.GetTrace(), "o:{k:[i1,{x:sy,},],e:{},},m:[i1,sa,b[1],],");
+
+    RecordParamsHandler rawHandler(false);
+    EXPECT_TRUE(AppEventParamsDecoder::Decode(paramStr, rawHandler));
+    EXPECT_EQ(rawHandler.GetTrace(), R"(o:r{"k":[1,{"x":"y"}],"e":{}},m:r1,r"a",r[true],],)");
+}
+
+/**
+ * @tc.name: AppEventParamsDecoder_Decode003
+ * @tc.desc: check the typed params of an event are decoded the same as its json text.
+ * @tc.type: FUNC
+ */
+HWTEST_F(HiAppEventBaseVariantTest, AppEventParamsDecoder_Decode003, TestSize.Level0)
+{
+    AppEventPack pack("testDomain", "testName", 1);
+    pack.AddParam("boolKey", true);
+    pack.AddParam("intKey", 100);
+    pack.AddParam("longKey", static_cast<int64_t>(1) << 40);
+    pack.AddParam("doubleKey", 2.25);
+    // the string params are kept escaped once verified
+    pack.AddParam("strKey", std::string(R"(line\n\"quoted\")"));
+    pack.AddParam("intArrKey", std::vector<int>{3, 4});
+    pack.AddParam("strArrKey", std::vector<std::string>{"a", "b"});
+    pack.AddParam("emptyArrKey", std::vector<int>{});
+
+    RecordParamsHandler typedHandler;
+    EXPECT_TRUE(AppEventParamsDecoder::Decode(pack, typedHandler));
+    RecordParamsHandler jsonHandler;
+    EXPECT_TRUE(AppEventParamsDecoder::Decode(pack.GetParamStr(), jsonHandler));
+    EXPECT_EQ(typedHandler.GetTrace(), jsonHandler.GetTrace());
+}
+
+/**
+ * @tc.name: AppEventParamsDecoder_Decode004
+ * @tc.desc: check the malformed params json text is rejected.
+ * @tc.type: FUNC
+ */
+HWTEST_F(HiAppEventBaseVariantTest, AppEventParamsDecoder_Decode004, TestSize.Level0)
+{
+    std::vector<std::string> paramStrs = {
+        "", "[]", "{", R"({"k":})", R"({"k":[1,]})", R"({"k":"a)", R"({"k":1}x)", R"({"k":tru})",
+        R"({"k":"\u12"})", R"({k:1})",
+    };
+    for (const auto& paramStr : paramStrs) {
+        RecordParamsHandler handler;
+        EXPECT_FALSE(AppEventParamsDecoder::Decode(paramStr, handler)) << paramStr;
+    }
+    RecordParamsHandler handler;
+    EXPECT_TRUE(AppEventParamsDecoder::Decode(" { } ", handler));
+    EXPECT_TRUE(handler.GetTrace().empty());
+}
+
+/**
+ * @tc.name: AppEventParamsDecoder_Decode005
+ * @tc.desc: check the numbers out of the range of int64 and the nesting limit of the params json text.
+ * @tc.type: FUNC
+ */
+HWTEST_F(HiAppEventBaseVariantTest, AppEventParamsDecoder_Decode005, TestSize.Level0)
+{
+    std::string paramStr = R"({"max":9223372036854775807,"over":9223372036854775808,"exp":-1e2})";
+    RecordParamsHandler handler;
+    EXPECT_TRUE(AppEventParamsDecoder::Decode(paramStr, handler));
+    EXPECT_EQ(handler.GetTrace(), "max:i9223372036854775807,over:d9223372036854775808.000000,exp:d-100.000000,");
+
+    constexpr size_t validDepth = 100;
+    constexpr size_t invalidDepth = 2000; // 2000 means deeper than the limit of 1000 levels
+    for (bool takeNested : {true, false}) {
+        RecordParamsHandler validHandler(takeNested);
+        paramStr = R"({"k":)" + std::string(validDepth, '[') + std::string(validDepth, ']') + "}";
+        EXPECT_TRUE(AppEventParamsDecoder::Decode(paramStr, validHandler));
+        RecordParamsHandler invalidHandler(takeNested);
+        paramStr = R"({"k":)" + std::string(invalidDepth, '[') + std::string(invalidDepth, ']') + "}";
+        EXPECT_FALSE(AppEventParamsDecoder::Decode(paramStr, invalidHandler));
+    }
+}
+
+/**
+ * @tc.name: AppEventParamsDecoder_Decode006
+ * @tc.desc: check the decimals and the chars of the typed params are decoded the same as their json text.
+ * @tc.type: FUNC
+ */
+HWTEST_F(HiAppEventBaseVariantTest, AppEventParamsDecoder_Decode006, TestSize.Level0)
+{
+    AppEventPack pack("testDomain", "testName", 1);
+    pack.AddParam("floatKey", 0.1f);
+    pack.AddParam("doubleKey", 0.123456789);
+    pack.AddParam("charKey", 'a');
+    pack.AddParam("doubleArrKey", std::vector<double>{1.5, 2.0000001});
+
+    RecordParamsHandler typedHandler;
+    EXPECT_TRUE(AppEventParamsDecoder::Decode(pack, typedHandler));
+    RecordParamsHandler jsonHandler;
+    EXPECT_TRUE(AppEventParamsDecoder::Decode(pack.GetParamStr(), jsonHandler));
+    EXPECT_EQ(typedHandler.GetTrace(), jsonHandler.GetTrace());
+    EXPECT_NE(typedHandler.GetTrace().find("charKey:s97,"), std::string::npos);
+}
+
+/**
+ * @tc.name: AppEventParamsCodec_EncodeDecode001
+ * @tc.desc: check the params of all types are the same after encoded and decoded, and the event stored in the binary
+ *           form has the same json text as before.
+ * @tc.type: FUNC
+ */
+HWTEST_F(HiAppEventBaseVariantTest, AppEventParamsCodec_EncodeDecode001, TestSize.Level0)
+{
+    AppEventPack pack("testDomain", "testName", 1);
+    pack.AddParam("emptyKey");
+    pack.AddParam("boolKey", true);
+    pack.AddParam("charKey", 'c');
+    pack.AddParam("shortKey", static_cast<int16_t>(-300));
+    pack.AddParam("intKey", -1);
+    pack.AddParam("longKey", INT64_MIN);
+    pack.AddParam("floatKey", 1.5f);
+    pack.AddParam("doubleKey", -2.25);
+    pack.AddParam("strKey", std::string("value"));
+    pack.AddParam("boolArrKey", std::vector<bool>{true, false, true, true, false, false, true, false, true});
+    pack.AddParam("charArrKey", std::vector<char>{'a', 'b'});
+    pack.AddParam("shortArrKey", std::vector<int16_t>{INT16_MIN, INT16_MAX});
+    pack.AddParam("intArrKey", std::vector<int>{INT32_MIN, 0, INT32_MAX});
+    pack.AddParam("longArrKey", std::vector<int64_t>{INT64_MIN, INT64_MAX});
+    pack.AddParam("floatArrKey", std::vector<float>{0.5f, -0.25f});
+    pack.AddParam("doubleArrKey", std::vector<double>{});
+    pack.AddParam("strArrKey", std::vector<std::string>{"", "b"});
+
+    std::vector<uint8_t> binary;
+    AppEventParamsCodec::Encode(*pack.GetTypedParams(), binary);
+    std::list<AppEventParam> params;
+    ASSERT_TRUE(AppEventParamsCodec::Decode(binary.data(), binary.size(), params));
+    ASSERT_EQ(params.size(), pack.GetTypedParams()->size());
+    auto it = params.begin();
+    for (const auto& param : *pack.GetTypedParams()) {
+        EXPECT_EQ(it->name, param.name);
+        EXPECT_TRUE(it->value == param.value) << param.name;
+        ++it;
+    }
+
+    AppEventPack storedPack("testDomain", "testName", 1);
+    storedPack.SetStoredParams(binary, AppEventParamsCodec::FORMAT_BINARY);
+    ASSERT_NE(storedPack.GetTypedParams(), nullptr);
+    EXPECT_EQ(storedPack.GetTypedParams()->size(), pack.GetTypedParams()->size());
+    EXPECT_EQ(storedPack.GetParamStr(), pack.GetParamStr());
+    RecordParamsHandler storedHandler;
+    EXPECT_TRUE(AppEventParamsDecoder::Decode(storedPack, storedHandler));
+    RecordParamsHandler typedHandler;
+    EXPECT_TRUE(AppEventParamsDecoder::Decode(pack, typedHandler));
+    EXPECT_EQ(storedHandler.GetTrace(), typedHandler.GetTrace());
+}
+
+/**
+ * @tc.name: AppEventParamsCodec_EncodeDecode002
+ * @tc.desc: check the truncated or malformed binary params are rejected.
+ * @tc.type: FUNC
+ */
+HWTEST_F(HiAppEventBaseVariantTest, AppEventParamsCodec_EncodeDecode002, TestSize.Level0)
+{
+    AppEventPack pack("testDomain", "testName", 1);
+    pack.AddParam("intKey", 100);
+    pack.AddParam("strArrKey", std::vector<std::string>{"a", "b"});
+    std::vector<uint8_t> binary;
+    AppEventParamsCodec::Encode(*pack.GetTypedParams(), binary);
+
+    std::list<AppEventParam> params;
+    for (size_t len = 0; len < binary.size(); ++len) {
+        params.clear();
+        EXPECT_FALSE(AppEventParamsCodec::Decode(binary.data(), len, params)) << len;
+    }
+    std::vector<uint8_t> trailing = binary;
+    trailing.push_back(0);
+    EXPECT_FALSE(AppEventParamsCodec::Decode(trailing.data(), trailing.size(), params));
+    std::vector<uint8_t> badVersion = binary;
+    badVersion[0] = 0xff;
+    EXPECT_FALSE(AppEventParamsCodec::Decode(badVersion.data(), badVersion.size(), params));
+    // the num of params is larger than the remaining bytes
+    std::vector<uint8_t> badSize = {1, 0xff, 0xff, 0xff, 0xff, 0x0f};
+    EXPECT_FALSE(AppEventParamsCodec::Decode(badSize.data(), badSize.size(), params));
+    EXPECT_FALSE(AppEventParamsCodec::Decode(nullptr, 0, params));
+
+    AppEventPack storedPack("testDomain", "testName", 1);
+    storedPack.SetStoredParams(trailing, AppEventParamsCodec::FORMAT_BINARY);
+    ASSERT_NE(storedPack.GetTypedParams(), nullptr);
+    EXPECT_TRUE(storedPack.GetTypedParams()->empty());
+    EXPECT_EQ(storedPack.GetParamStr(), "{}\n");
+}
+
+/**
+ * @tc.name: AppEventPack_GetEventSize001
+ * @tc.desc: check the event size is the same as the size of the event json text.
+ * @tc.type: FUNC
+ */
+HWTEST_F(HiAppEventBaseVariantTest, AppEventPack_GetEventSize001, TestSize.Level0)
+{
+    AppEventPack pack("testDomain", "testName", 1);
+    EXPECT_EQ(pack.GetEventSize(), pack.GetEventStr().size());
+    pack.AddParam("emptyKey");
+    pack.AddParam("boolKey", false);
+    pack.AddParam("charKey", 'c');
+    pack.AddParam("shortKey", static_cast<int16_t>(-300));
+    pack.AddParam("intKey", 0);
+    pack.AddParam("longKey", INT64_MIN);
+    pack.AddParam("doubleKey", -2.25);
+    pack.AddParam("strKey", std::string("value"));
+    pack.AddParam("boolArrKey", std::vector<bool>{true, false});
+    pack.AddParam("intArrKey", std::vector<int>{INT32_MIN, 9, 10, INT32_MAX});
+    pack.AddParam("floatArrKey", std::vector<float>{});
+    pack.AddParam("strArrKey", std::vector<std::string>{"", "b"});
+    EXPECT_EQ(pack.GetEventSize(), pack.GetEventStr().size());
+
+    std::vector<uint8_t> binary;
+    AppEventParamsCodec::Encode(*pack.GetTypedParams(), binary);
+    AppEventPack storedPack("testDomain", "testName", 1);
+    storedPack.SetStoredParams(binary, AppEventParamsCodec::FORMAT_BINARY);
+    EXPECT_EQ(storedPack.GetEventSize(), storedPack.GetEventStr().size());
+    storedPack.SetParamStr("{}\n");
+    EXPECT_EQ(storedPack.GetEventSize(), storedPack.GetEventStr().size());
+    storedPack.AddCustomParams({{"customKey", "\"customValue\""}});
+    EXPECT_EQ(storedPack.GetEventSize(), storedPack.GetEventStr().size());
+}
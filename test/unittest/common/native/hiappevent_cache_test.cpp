@@ -15,21 +15,37 @@
 
 #include "hiappevent_cache_test.h"
 
+#include <chrono>
+#include <fcntl.h>
+#include <future>
+#include <sys/file.h>
+#include <sys/wait.h>
+#include <thread>
+#include <unistd.h>
+
 #include <json/json.h>
 
 #include "api_stats_dao.h"
+#include "app_event_aggregator.h"
 #include "app_event_cache_common.h"
+#include "app_event_crash_ring.h"
+#include "app_event_shared_ring.h"
 #include "app_event_db_cleaner.h"
 #include "app_event_log_cleaner.h"
+#include "app_event_observer_mgr.h"
+#include "app_event_sampler.h"
 #include "app_event_stat.h"
 #include "app_event_store.h"
 #include "app_event_store_callback.h"
+#include "app_event_write_queue.h"
+#include "event_aggregation_policy.h"
 #include "file_util.h"
 #include "hiappevent_base.h"
 #include "hiappevent_clean.h"
 #include "hiappevent_config.h"
 #include "hiappevent_facade.h"
 #include "hiappevent_write.h"
+#include "pipeline_metrics.h"
 #include "rdb_errno.h"
 #include "rdb_helper.h"
 #include "time_util.h"
@@ -59,6 +75,63 @@ std::shared_ptr<AppEventPack> CreateAppEventPack()
 {
     return std::make_shared<AppEventPack>(TEST_EVENT_DOMAIN, TEST_EVENT_NAME, TEST_EVENT_TYPE);
 }
+
+uint64_t GetOverflowDropNum()
+{
+    PipelineMetrics::Snapshot snapshot;
+    PipelineMetrics::GetSnapshot(snapshot);
+    return snapshot.counters[PipelineMetrics::WRITE_DROPPED_OVERFLOW];
+}
+
+uint64_t GetAggregatedNum()
+{
+    PipelineMetrics::Snapshot snapshot;
+    PipelineMetrics::GetSnapshot(snapshot);
+    return snapshot.counters[PipelineMetrics::WRITE_AGGREGATED];
+}
+
+void WaitForQueueTasks()
+{
+    auto promise = std::make_shared<std::promise<void>>();
+    auto future = promise->get_future();
+    AppEventObserverMgr::GetInstance().SubmitTaskToFFRTQueue([promise] {
+        promise->set_value();
+        }, "test_wait");
+    future.wait();
+}
+
+// reserves the space of a record in the shared ring as a writer which stops before finishing it, the header is
+// written with the pid as a record being written unless the pid is 0
+void ReserveSharedRecord(const std::string& ringDir, int32_t pid)
+{
+    constexpr off_t headOffset = 12; // 12 means the offset of the head in the ring header
+    constexpr off_t headerSize = 64; // 64 means the size of the ring header
+    constexpr uint32_t capacity = 4096;
+    constexpr uint32_t writingState = 1;
+    constexpr uint32_t dataLen = 32;
+    constexpr uint32_t recordLen = 64; // 64 means the size of the record header and the data
+    int fd = open(FileUtil::GetFilePathByDir(ringDir, "event_ring").c_str(), O_RDWR | O_CLOEXEC);
+    ASSERT_GE(fd, 0);
+    uint32_t head = 0;
+    ASSERT_EQ(pread(fd, &head, sizeof(head), headOffset), static_cast<ssize_t>(sizeof(head)));
+    if (pid != 0) {
+        uint32_t header[] = { writingState, head, dataLen, 0, static_cast<uint32_t>(pid) };
+        off_t offset = headerSize + static_cast<off_t>(head & (capacity - 1));
+        ASSERT_EQ(pwrite(fd, header, sizeof(header), offset), static_cast<ssize_t>(sizeof(header)));
+    }
+    head += recordLen;
+    ASSERT_EQ(pwrite(fd, &head, sizeof(head), headOffset), static_cast<ssize_t>(sizeof(head)));
+    close(fd);
+}
+
+void ResetWriteQueueConfig()
+{
+    HiAppEventConfig::GetInstance().SetConfigurationItem("write_queue_capacity", "10000");
+    HiAppEventConfig::GetInstance().SetConfigurationItem("write_queue_max_size", "8M");
+    HiAppEventConfig::GetInstance().SetConfigurationItem("write_queue_policy", "drop_oldest");
+    HiAppEventConfig::GetInstance().SetConfigurationItem("write_queue_block_timeout", "100");
+    HiAppEventConfig::GetInstance().SetConfigurationItem("write_queue_sample_rate", "10");
+}
 }
 
 void HiAppEventCacheTest::SetUp()
@@ -335,6 +408,255 @@ HWTEST_F(HiAppEventCacheTest, HiAppEventDBTest006, TestSize.Level0)
     ASSERT_EQ(result, 0);
 }
 
+/**
+ * @tc.name: HiAppEventDBTest007
+ * @tc.desc: check the batch operations of the cached statements.
+ * @tc.type: FUNC
+ */
+HWTEST_F(HiAppEventCacheTest, HiAppEventDBTest007, TestSize.Level1)
+{
+    /**
+     * @tc.steps: step1. open the db.
+     * @tc.steps: step2. insert more mapping records than one statement can bind.
+     * @tc.steps: step3. query records with limit, and take all records.
+     * @tc.steps: step4. delete history events.
+     */
+    int result = AppEventStore::GetInstance().InitDbStore();
+    ASSERT_EQ(result, DB_SUCC);
+    int64_t observerSeq = AppEventStore::GetInstance().InsertObserver(AppEventCacheCommon::Observer(TEST_OBSERVER_NAME,
+        0, ""));
+    ASSERT_GT(observerSeq, 0);
+
+    constexpr size_t eventNum = 150;
+    std::vector<EventObserverInfo> eventObservers;
+    for (size_t i = 0; i < eventNum; ++i) {
+        int64_t eventSeq = AppEventStore::GetInstance().InsertEvent(CreateAppEventPack());
+        ASSERT_GT(eventSeq, 0);
+        eventObservers.emplace_back(EventObserverInfo(eventSeq, observerSeq));
+    }
+    result = AppEventStore::GetInstance().InsertEventMapping(eventObservers);
+    ASSERT_EQ(result, DB_SUCC);
+
+    std::vector<std::shared_ptr<AppEventPack>> events;
+    result = AppEventStore::GetInstance().QueryEvents(events, observerSeq, 10);
+    ASSERT_EQ(result, DB_SUCC);
+    ASSERT_EQ(events.size(), 10);
+    ASSERT_EQ(events[0]->GetSeq(), eventObservers.back().eventSeq);
+
+    events.clear();
+    result = AppEventStore::GetInstance().TakeEvents(events, observerSeq);
+    ASSERT_EQ(result, DB_SUCC);
+    ASSERT_EQ(events.size(), eventNum);
+    events.clear();
+    result = AppEventStore::GetInstance().QueryEvents(events, observerSeq);
+    ASSERT_EQ(result, DB_SUCC);
+    ASSERT_TRUE(events.empty());
+
+    result = AppEventStore::GetInstance().DeleteHistoryEvent(0, 0);
+    ASSERT_EQ(result, DB_SUCC);
+
+    result = AppEventStore::GetInstance().DestroyDbStore();
+    ASSERT_EQ(result, DB_SUCC);
+}
+
+/**
+ * @tc.name: HiAppEventDBTest008
+ * @tc.desc: check the event counters of the observer.
+ * @tc.type: FUNC
+ */
+HWTEST_F(HiAppEventCacheTest, HiAppEventDBTest008, TestSize.Level1)
+{
+    /**
+     * @tc.steps: step1. open the db.
+     * @tc.steps: step2. insert mapping records with event size.
+     * @tc.steps: step3. check the counters after inserting and deleting the mapping records.
+     */
+    int result = AppEventStore::GetInstance().InitDbStore();
+    ASSERT_EQ(result, DB_SUCC);
+    constexpr int64_t testHashCode = 1;
+    int64_t observerSeq = AppEventStore::GetInstance().InsertObserver(AppEventCacheCommon::Observer(TEST_OBSERVER_NAME,
+        testHashCode));
+    ASSERT_GT(observerSeq, 0);
+
+    constexpr int64_t eventSize = 10;
+    std::vector<EventObserverInfo> eventObservers;
+    std::vector<int64_t> eventSeqs;
+    for (int i = 0; i < 3; ++i) { // 3 means num of events
+        int64_t eventSeq = AppEventStore::GetInstance().InsertEvent(CreateAppEventPack());
+        ASSERT_GT(eventSeq, 0);
+        eventObservers.emplace_back(EventObserverInfo(eventSeq, observerSeq, eventSize));
+        eventSeqs.emplace_back(eventSeq);
+    }
+    result = AppEventStore::GetInstance().InsertEventMapping(eventObservers);
+    ASSERT_EQ(result, DB_SUCC);
+
+    AppEventCacheCommon::Observer observer(TEST_OBSERVER_NAME, testHashCode);
+    result = AppEventStore::GetInstance().QueryObserver(observer);
+    ASSERT_EQ(result, DB_SUCC);
+    ASSERT_EQ(observer.seq, observerSeq);
+    ASSERT_EQ(observer.eventRows, 3); // 3 means num of events
+    ASSERT_EQ(observer.eventBytes, 3 * eventSize); // 3 means num of events
+
+    result = AppEventStore::GetInstance().DeleteEventMapping(observerSeq, {eventSeqs[0]});
+    ASSERT_EQ(result, DB_SUCC);
+    result = AppEventStore::GetInstance().QueryObserver(observer);
+    ASSERT_EQ(result, DB_SUCC);
+    ASSERT_EQ(observer.eventRows, 2); // 2 means num of the remaining events
+    ASSERT_EQ(observer.eventBytes, 2 * eventSize); // 2 means num of the remaining events
+
+    result = AppEventStore::GetInstance().DeleteEventMapping(observerSeq);
+    ASSERT_EQ(result, DB_SUCC);
+    result = AppEventStore::GetInstance().QueryObserver(observer);
+    ASSERT_EQ(result, DB_SUCC);
+    ASSERT_EQ(observer.eventRows, 0);
+    ASSERT_EQ(observer.eventBytes, 0);
+
+    result = AppEventStore::GetInstance().DestroyDbStore();
+    ASSERT_EQ(result, DB_SUCC);
+}
+
+/**
+ * @tc.name: HiAppEventDBTest009
+ * @tc.desc: check the large params are stored compressed and read back unchanged.
+ * @tc.type: FUNC
+ */
+HWTEST_F(HiAppEventCacheTest, HiAppEventDBTest009, TestSize.Level1)
+{
+    /**
+     * @tc.steps: step1. open the db.
+     * @tc.steps: step2. insert the events with the small and the large params.
+     * @tc.steps: step3. query the events and check the params.
+     */
+    int result = AppEventStore::GetInstance().InitDbStore();
+    ASSERT_EQ(result, DB_SUCC);
+    int64_t observerSeq = AppEventStore::GetInstance().InsertObserver(AppEventCacheCommon::Observer(TEST_OBSERVER_NAME,
+        0, ""));
+    ASSERT_GT(observerSeq, 0);
+
+    auto smallEvent = CreateAppEventPack();
+    auto largeEvent = std::make_shared<AppEventPack>("OS", "APP_CRASH", TEST_EVENT_TYPE);
+    std::vector<std::string> hilog(100, "I C01234/test_tag: the repetitive log text of the crash"); // 100 lines
+    largeEvent->AddParam("crash_type", std::string("NativeCrash"));
+    largeEvent->AddParam("hilog", hilog);
+    std::vector<std::shared_ptr<AppEventPack>> insertedEvents = { smallEvent, largeEvent };
+    std::vector<EventObserverInfo> eventObservers;
+    for (const auto& event : insertedEvents) {
+        int64_t eventSeq = AppEventStore::GetInstance().InsertEvent(event);
+        ASSERT_GT(eventSeq, 0);
+        eventObservers.emplace_back(EventObserverInfo(eventSeq, observerSeq));
+    }
+    result = AppEventStore::GetInstance().InsertEventMapping(eventObservers);
+    ASSERT_EQ(result, DB_SUCC);
+
+    std::vector<std::shared_ptr<AppEventPack>> events;
+    result = AppEventStore::GetInstance().QueryEvents(events, observerSeq);
+    ASSERT_EQ(result, DB_SUCC);
+    ASSERT_EQ(events.size(), insertedEvents.size());
+    // the events are queried in the descending order of seq, and the large params stay compressed until they are read
+    EXPECT_LT(events[0]->GetEstimatedSize(), largeEvent->GetEstimatedSize());
+    ASSERT_NE(events[0]->GetTypedParams(), nullptr);
+    EXPECT_EQ(events[0]->GetTypedParams()->size(), largeEvent->GetTypedParams()->size());
+    EXPECT_EQ(events[0]->GetParamStr(), largeEvent->GetParamStr());
+    EXPECT_EQ(events[1]->GetParamStr(), smallEvent->GetParamStr());
+
+    result = AppEventStore::GetInstance().DestroyDbStore();
+    ASSERT_EQ(result, DB_SUCC);
+}
+
+/**
+ * @tc.name: HiAppEventDBTest010
+ * @tc.desc: check the typed params are stored in the binary form and the json text params are stored as they are.
+ * @tc.type: FUNC
+ */
+HWTEST_F(HiAppEventCacheTest, HiAppEventDBTest010, TestSize.Level1)
+{
+    /**
+     * @tc.steps: step1. open the db.
+     * @tc.steps: step2. insert the events with the typed params and the json text params.
+     * @tc.steps: step3. query the events and check the params and the event json text.
+     */
+    int result = AppEventStore::GetInstance().InitDbStore();
+    ASSERT_EQ(result, DB_SUCC);
+    int64_t observerSeq = AppEventStore::GetInstance().InsertObserver(AppEventCacheCommon::Observer(TEST_OBSERVER_NAME,
+        0, ""));
+    ASSERT_GT(observerSeq, 0);
+
+    auto typedEvent = CreateAppEventPack();
+    typedEvent->AddParam("int_arr_key", std::vector<int>{1, -2, 3});
+    typedEvent->AddParam("double_key", 0.5);
+    auto textEvent = CreateAppEventPack();
+    textEvent->SetParamStr(R"({"text_key":"text_value"})" "\n");
+    std::vector<std::shared_ptr<AppEventPack>> insertedEvents = { typedEvent, textEvent };
+    std::vector<EventObserverInfo> eventObservers;
+    for (const auto& event : insertedEvents) {
+        int64_t eventSeq = AppEventStore::GetInstance().InsertEvent(event);
+        ASSERT_GT(eventSeq, 0);
+        eventObservers.emplace_back(EventObserverInfo(eventSeq, observerSeq));
+    }
+    result = AppEventStore::GetInstance().InsertEventMapping(eventObservers);
+    ASSERT_EQ(result, DB_SUCC);
+
+    std::vector<std::shared_ptr<AppEventPack>> events;
+    result = AppEventStore::GetInstance().QueryEvents(events, observerSeq);
+    ASSERT_EQ(result, DB_SUCC);
+    ASSERT_EQ(events.size(), insertedEvents.size());
+    // the events are queried in the descending order of seq
+    EXPECT_EQ(events[0]->GetTypedParams(), nullptr);
+    EXPECT_EQ(events[0]->GetParamStr(), textEvent->GetParamStr());
+    EXPECT_EQ(events[0]->GetEventStr(), textEvent->GetEventStr());
+    ASSERT_NE(events[1]->GetTypedParams(), nullptr);
+    EXPECT_EQ(events[1]->GetTypedParams()->size(), typedEvent->GetTypedParams()->size());
+    EXPECT_EQ(events[1]->GetParamStr(), typedEvent->GetParamStr());
+    EXPECT_EQ(events[1]->GetEventStr(), typedEvent->GetEventStr());
+
+    result = AppEventStore::GetInstance().DestroyDbStore();
+    ASSERT_EQ(result, DB_SUCC);
+}
+
+/**
+ * @tc.name: HiAppEventDBTest011
+ * @tc.desc: check the cached custom params are refreshed after the custom params are changed.
+ * @tc.type: FUNC
+ */
+HWTEST_F(HiAppEventCacheTest, HiAppEventDBTest011, TestSize.Level1)
+{
+    int result = AppEventStore::GetInstance().InitDbStore();
+    ASSERT_EQ(result, DB_SUCC);
+
+    auto createEvent = [] () {
+        auto event = CreateAppEventPack();
+        event->SetRunningId(TEST_RUNNING_ID);
+        return event;
+    };
+    auto event = createEvent();
+    ASSERT_EQ(AppEventStore::GetInstance().QueryCustomParamsAdd2EventPack(event), DB_SUCC);
+    EXPECT_EQ(event->GetParamStr(), "{}\n");
+
+    auto eventParams = createEvent();
+    eventParams->AddParam("custom_data", "value_old_str");
+    ASSERT_EQ(AppEventStore::GetInstance().InsertCustomEventParams(eventParams), DB_SUCC);
+    for (int i = 0; i < 2; ++i) { // 2: query from the db and then from the cache
+        event = createEvent();
+        ASSERT_EQ(AppEventStore::GetInstance().QueryCustomParamsAdd2EventPack(event), DB_SUCC);
+        EXPECT_EQ(event->GetParamStr(), "{\"custom_data\":\"value_old_str\"}\n");
+    }
+
+    eventParams = createEvent();
+    eventParams->AddParam("custom_data", "value_str");
+    ASSERT_EQ(AppEventStore::GetInstance().InsertCustomEventParams(eventParams), DB_SUCC);
+    event = createEvent();
+    ASSERT_EQ(AppEventStore::GetInstance().QueryCustomParamsAdd2EventPack(event), DB_SUCC);
+    EXPECT_EQ(event->GetParamStr(), "{\"custom_data\":\"value_str\"}\n");
+
+    ASSERT_EQ(AppEventStore::GetInstance().DeleteCustomEventParams(), DB_SUCC);
+    event = createEvent();
+    ASSERT_EQ(AppEventStore::GetInstance().QueryCustomParamsAdd2EventPack(event), DB_SUCC);
+    EXPECT_EQ(event->GetParamStr(), "{}\n");
+
+    result = AppEventStore::GetInstance().DestroyDbStore();
+    ASSERT_EQ(result, DB_SUCC);
+}
+
 /**
  * @tc.name: HiAppEventCleanTest001
  * @tc.desc: test the DB cleaner operation.
@@ -474,16 +796,18 @@ HWTEST_F(HiAppEventCacheTest, HiAppEventDbOnUpgrade001, TestSize.Level1)
 {
     int ret = OHOS::NativeRdb::E_OK;
     const int oldVersion = 1;
-    const int dbVersion = 3;
+    const int dbVersion = 5;
     HiAppEventConfig::GetInstance().SetStorageDir(TEST_DIR);
     AppEventStore::GetInstance().InitDbStore();
     OHOS::NativeRdb::RdbStoreConfig config(TEST_DB_PATH);
     config.SetSecurityLevel(OHOS::NativeRdb::SecurityLevel::S1);
     AppEventStoreCallback callback;
     auto store = OHOS::NativeRdb::RdbHelper::GetRdbStore(config, dbVersion, callback, ret);
-    // Only test upgrade DB from version 1 to 2, or from 2 to 3 in unit test.
+    // Only test upgrade DB from version 1 to 2, from 2 to 3, from 3 to 4, or from 4 to 5 in unit test.
     EXPECT_NE(callback.OnUpgrade(*store, oldVersion, oldVersion + 1), OHOS::NativeRdb::E_OK);
-    EXPECT_NE(callback.OnUpgrade(*store, oldVersion + 1, dbVersion), OHOS::NativeRdb::E_OK);
+    EXPECT_NE(callback.OnUpgrade(*store, oldVersion + 1, oldVersion + 2), OHOS::NativeRdb::E_OK);
+    EXPECT_NE(callback.OnUpgrade(*store, oldVersion + 2, oldVersion + 3), OHOS::NativeRdb::E_OK);
+    EXPECT_NE(callback.OnUpgrade(*store, oldVersion + 3, dbVersion), OHOS::NativeRdb::E_OK);
     EXPECT_EQ(callback.OnUpgrade(*store, dbVersion, dbVersion + 1), OHOS::NativeRdb::E_OK);
 
     ret = AppEventStore::GetInstance().DestroyDbStore();
@@ -620,3 +944,618 @@ HWTEST_F(HiAppEventCacheTest, AppEventStoreApiMetricTest005, TestSize.Level0)
     result = AppEventStore::GetInstance().DestroyDbStore();
     ASSERT_EQ(result, DB_SUCC);
 }
+
+/**
+ * @tc.name: WriteQueueConfig001
+ * @tc.desc: test the configuration items of the write queue.
+ * @tc.type: FUNC
+ */
+HWTEST_F(HiAppEventCacheTest, WriteQueueConfig001, TestSize.Level1)
+{
+    auto& config = HiAppEventConfig::GetInstance();
+    EXPECT_TRUE(config.SetConfigurationItem("writeQueueCapacity", "100"));
+    EXPECT_TRUE(config.SetConfigurationItem("write_queue_max_size", "1K"));
+    EXPECT_TRUE(config.SetConfigurationItem("write_queue_policy", "SAMPLE"));
+    EXPECT_TRUE(config.SetConfigurationItem("write_queue_block_timeout", "20"));
+    EXPECT_TRUE(config.SetConfigurationItem("write_queue_sample_rate", "5"));
+    WriteQueueConfig queueConfig = config.GetWriteQueueConfig();
+    EXPECT_EQ(queueConfig.capacity, 100u);
+    EXPECT_EQ(queueConfig.maxSize, 1024u);
+    EXPECT_EQ(queueConfig.policy, WriteOverflowPolicy::SAMPLE);
+    EXPECT_EQ(queueConfig.blockTimeout, 20u);
+    EXPECT_EQ(queueConfig.sampleRate, 5u);
+
+    EXPECT_FALSE(config.SetConfigurationItem("write_queue_capacity", "0"));
+    EXPECT_FALSE(config.SetConfigurationItem("write_queue_capacity", "-1"));
+    EXPECT_FALSE(config.SetConfigurationItem("write_queue_max_size", "0"));
+    EXPECT_FALSE(config.SetConfigurationItem("write_queue_policy", "drop_all"));
+    EXPECT_FALSE(config.SetConfigurationItem("write_queue_sample_rate", "abc"));
+    EXPECT_FALSE(config.SetConfigurationItem("write_queue_unknown", "1"));
+    EXPECT_EQ(config.GetWriteQueueConfig().capacity, 100u);
+    ResetWriteQueueConfig();
+}
+
+/**
+ * @tc.name: WriteQueue001
+ * @tc.desc: test the drop-newest and drop-oldest policies of the write queue.
+ * @tc.type: FUNC
+ */
+HWTEST_F(HiAppEventCacheTest, WriteQueue001, TestSize.Level1)
+{
+    constexpr int behaviorType = 4;
+    auto& config = HiAppEventConfig::GetInstance();
+    config.SetConfigurationItem("write_queue_capacity", "5");
+    config.SetConfigurationItem("write_queue_policy", "drop_newest");
+    uint64_t dropNum = GetOverflowDropNum();
+
+    // block the queue, so that the pushed events stay in the write queue
+    auto promise = std::make_shared<std::promise<void>>();
+    auto future = promise->get_future().share();
+    AppEventObserverMgr::GetInstance().SubmitTaskToFFRTQueue([future] {
+        future.wait();
+        }, "test_block");
+    auto& queue = AppEventWriteQueue::GetInstance();
+    for (int i = 0; i < 10; ++i) { // 10 means twice the capacity
+        bool ret = queue.Push(std::make_shared<AppEventPack>(TEST_EVENT_DOMAIN, TEST_EVENT_NAME, behaviorType),
+            "test_write");
+        EXPECT_EQ(ret, i < 5); // 5 means the capacity
+    }
+    EXPECT_EQ(queue.GetSize(), 5u);
+    EXPECT_EQ(GetOverflowDropNum() - dropNum, 5u);
+
+    // the fault event takes the place of the oldest behavior event
+    config.SetConfigurationItem("write_queue_policy", "drop_oldest");
+    EXPECT_TRUE(queue.Push(CreateAppEventPack(), "test_write"));
+    EXPECT_EQ(queue.GetSize(), 5u);
+    EXPECT_EQ(GetOverflowDropNum() - dropNum, 6u);
+
+    config.SetConfigurationItem("write_queue_policy", "block");
+    config.SetConfigurationItem("write_queue_block_timeout", "10");
+    EXPECT_FALSE(queue.Push(CreateAppEventPack(), "test_write"));
+    EXPECT_EQ(GetOverflowDropNum() - dropNum, 7u);
+
+    promise->set_value();
+    WaitForQueueTasks();
+    EXPECT_EQ(queue.GetSize(), 0u);
+    ResetWriteQueueConfig();
+}
+
+/**
+ * @tc.name: WriteQueue002
+ * @tc.desc: test the fault events are queued in the urgent lane and the waiting time is recorded by lanes.
+ * @tc.type: FUNC
+ */
+HWTEST_F(HiAppEventCacheTest, WriteQueue002, TestSize.Level1)
+{
+    constexpr int behaviorType = 4;
+    PipelineMetrics::Snapshot oldSnapshot;
+    PipelineMetrics::GetSnapshot(oldSnapshot);
+
+    auto promise = std::make_shared<std::promise<void>>();
+    auto future = promise->get_future().share();
+    AppEventObserverMgr::GetInstance().SubmitTaskToFFRTQueue([future] {
+        future.wait();
+        }, "test_block");
+    auto& queue = AppEventWriteQueue::GetInstance();
+    for (int i = 0; i < 3; ++i) { // 3 means the number of behavior events
+        EXPECT_TRUE(queue.Push(std::make_shared<AppEventPack>(TEST_EVENT_DOMAIN, TEST_EVENT_NAME, behaviorType),
+            "test_write"));
+    }
+    EXPECT_TRUE(queue.Push(CreateAppEventPack(), "test_write"));
+    EXPECT_EQ(queue.GetSize(AppEventWriteQueue::BEHAVIOR_LANE), 3u);
+    EXPECT_EQ(queue.GetSize(AppEventWriteQueue::URGENT_LANE), 1u);
+    EXPECT_EQ(queue.GetSize(), 4u);
+
+    promise->set_value();
+    WaitForQueueTasks();
+    EXPECT_EQ(queue.GetSize(), 0u);
+    PipelineMetrics::Snapshot snapshot;
+    PipelineMetrics::GetSnapshot(snapshot);
+    EXPECT_EQ(snapshot.histograms[PipelineMetrics::LANE_WAIT_URGENT].count -
+        oldSnapshot.histograms[PipelineMetrics::LANE_WAIT_URGENT].count, 1u);
+    EXPECT_EQ(snapshot.histograms[PipelineMetrics::LANE_WAIT_BEHAVIOR].count -
+        oldSnapshot.histograms[PipelineMetrics::LANE_WAIT_BEHAVIOR].count, 3u);
+}
+
+/**
+ * @tc.name: WriteQueue003
+ * @tc.desc: test the sample policy keeps sampling the events once the write queue is full.
+ * @tc.type: FUNC
+ */
+HWTEST_F(HiAppEventCacheTest, WriteQueue003, TestSize.Level1)
+{
+    constexpr int behaviorType = 4;
+    auto& config = HiAppEventConfig::GetInstance();
+    config.SetConfigurationItem("write_queue_capacity", "4");
+    config.SetConfigurationItem("write_queue_policy", "sample");
+    config.SetConfigurationItem("write_queue_sample_rate", "2");
+    uint64_t dropNum = GetOverflowDropNum();
+
+    auto promise = std::make_shared<std::promise<void>>();
+    auto future = promise->get_future().share();
+    AppEventObserverMgr::GetInstance().SubmitTaskToFFRTQueue([future] {
+        future.wait();
+        }, "test_block");
+    auto& queue = AppEventWriteQueue::GetInstance();
+    constexpr uint64_t pushNum = 20;
+    uint64_t admittedNum = 0;
+    for (uint64_t i = 0; i < pushNum; ++i) {
+        if (queue.Push(std::make_shared<AppEventPack>(TEST_EVENT_DOMAIN, TEST_EVENT_NAME, behaviorType),
+            "test_write")) {
+            ++admittedNum;
+        }
+        EXPECT_LE(queue.GetSize(), 4u); // 4 means the capacity
+    }
+    // one of every two events is admitted after the queue is half full, and the full queue drops its oldest ones
+    EXPECT_GE(admittedNum, pushNum / 2); // 2 means the sample rate
+    EXPECT_EQ(queue.GetSize(), 4u);
+    EXPECT_EQ(GetOverflowDropNum() - dropNum, pushNum - 4u);
+
+    promise->set_value();
+    WaitForQueueTasks();
+    EXPECT_EQ(queue.GetSize(), 0u);
+    ResetWriteQueueConfig();
+}
+
+/**
+ * @tc.name: AppEventSampler001
+ * @tc.desc: test the one-in-n and ratio sampling rules.
+ * @tc.type: FUNC
+ */
+HWTEST_F(HiAppEventCacheTest, AppEventSampler001, TestSize.Level1)
+{
+    auto& sampler = AppEventSampler::GetInstance();
+    ASSERT_TRUE(HiAppEventConfig::GetInstance().SetConfigurationItem("sampling_rule",
+        TEST_EVENT_DOMAIN + ",testName,one_in_n,4"));
+    int keptNum = 0;
+    for (int i = 0; i < 8; ++i) { // 8 means twice the interval
+        auto event = std::make_shared<AppEventPack>(TEST_EVENT_DOMAIN, "testName", TEST_EVENT_TYPE);
+        if (sampler.Sample(*event)) {
+            ++keptNum;
+            EXPECT_NE(event->GetEventStr().find("\"sample_rate\":0.25"), std::string::npos);
+        }
+    }
+    EXPECT_EQ(keptNum, 2); // 2 means 8 / 4
+
+    // the events without rules are kept untouched
+    auto event = CreateAppEventPack();
+    EXPECT_TRUE(sampler.Sample(*event));
+    EXPECT_EQ(event->GetEventStr().find("sample_rate"), std::string::npos);
+
+    ASSERT_TRUE(sampler.SetRule(TEST_EVENT_DOMAIN + ",*,ratio,0.5"));
+    keptNum = 0;
+    constexpr int eventNum = 10000;
+    for (int i = 0; i < eventNum; ++i) {
+        event = CreateAppEventPack();
+        keptNum += sampler.Sample(*event) ? 1 : 0;
+    }
+    EXPECT_GT(keptNum, eventNum * 4 / 10); // 4 / 10 means the lower bound of the ratio
+    EXPECT_LT(keptNum, eventNum * 6 / 10); // 6 / 10 means the upper bound of the ratio
+
+    ASSERT_TRUE(sampler.SetRule(TEST_EVENT_DOMAIN + ",*,none"));
+    event = CreateAppEventPack();
+    EXPECT_TRUE(sampler.Sample(*event));
+    sampler.ClearRules();
+}
+
+/**
+ * @tc.name: AppEventSampler002
+ * @tc.desc: test the token bucket rule and the invalid rules.
+ * @tc.type: FUNC
+ */
+HWTEST_F(HiAppEventCacheTest, AppEventSampler002, TestSize.Level1)
+{
+    auto& sampler = AppEventSampler::GetInstance();
+    EXPECT_FALSE(sampler.SetRule("test_domain,test_name"));
+    EXPECT_FALSE(sampler.SetRule("test_domain,test_name,ratio,2"));
+    EXPECT_FALSE(sampler.SetRule("test_domain,test_name,ratio,abc"));
+    EXPECT_FALSE(sampler.SetRule("test_domain,test_name,one_in_n,0"));
+    EXPECT_FALSE(sampler.SetRule("test_domain,test_name,token_bucket,0"));
+    EXPECT_FALSE(sampler.SetRule("test_domain,test_name,unknown,1"));
+    EXPECT_FALSE(sampler.SetRule(",test_name,one_in_n,2"));
+
+    // one event per hour with a burst of 3 events
+    ASSERT_TRUE(sampler.SetRule(TEST_EVENT_DOMAIN + "," + TEST_EVENT_NAME + ",token_bucket,0.0003,3"));
+    int keptNum = 0;
+    for (int i = 0; i < 10; ++i) { // 10 means the number of events
+        auto event = CreateAppEventPack();
+        keptNum += sampler.Sample(*event) ? 1 : 0;
+    }
+    EXPECT_EQ(keptNum, 3); // 3 means the burst
+    sampler.ClearRules();
+    auto event = CreateAppEventPack();
+    EXPECT_TRUE(sampler.Sample(*event));
+}
+
+/**
+ * @tc.name: AppEventSampler003
+ * @tc.desc: test the param sample_rate is neither repeated nor added beyond the max num of params.
+ * @tc.type: FUNC
+ */
+HWTEST_F(HiAppEventCacheTest, AppEventSampler003, TestSize.Level1)
+{
+    auto& sampler = AppEventSampler::GetInstance();
+    ASSERT_TRUE(sampler.SetRule(TEST_EVENT_DOMAIN + ",*,one_in_n,1"));
+    auto event = CreateAppEventPack();
+    event->AddParam("sample_rate", 0.5);
+    EXPECT_TRUE(sampler.Sample(*event));
+    EXPECT_EQ(event->GetTypedParams()->size(), 1u);
+    EXPECT_NE(event->GetEventStr().find("\"sample_rate\":0.5"), std::string::npos);
+
+    event = CreateAppEventPack();
+    constexpr int maxParamNum = 32;
+    for (int i = 0; i < maxParamNum; ++i) {
+        event->AddParam("key" + std::to_string(i), i);
+    }
+    EXPECT_TRUE(sampler.Sample(*event));
+    EXPECT_EQ(event->FindBaseParam("sample_rate"), nullptr);
+
+    event = CreateAppEventPack();
+    EXPECT_TRUE(sampler.Sample(*event));
+    EXPECT_NE(event->FindBaseParam("sample_rate"), nullptr);
+    sampler.ClearRules();
+}
+
+/**
+ * @tc.name: AppEventAggregator001
+ * @tc.desc: test the rollup of the identical events by the aggregation rule.
+ * @tc.type: FUNC
+ */
+HWTEST_F(HiAppEventCacheTest, AppEventAggregator001, TestSize.Level1)
+{
+    auto& aggregator = AppEventAggregator::GetInstance();
+    EXPECT_FALSE(aggregator.Aggregate(CreateAppEventPack()));
+
+    EventAggregationPolicy policy;
+    ASSERT_EQ(policy.SetEventPolicy({{"domain", TEST_EVENT_DOMAIN}, {"name", TEST_EVENT_NAME},
+        {"window", "60000"}, {"keys", "page"}}), ErrorCode::HIAPPEVENT_VERIFY_SUCCESSFUL);
+    uint64_t aggregatedNum = GetAggregatedNum();
+    std::vector<std::shared_ptr<AppEventPack>> firstEvents;
+    for (const char* page : {"page1", "page2"}) {
+        for (int i = 0; i < 3; ++i) { // 3 means the number of the identical events
+            auto event = CreateAppEventPack();
+            event->AddParam("page", page);
+            event->AddParam("index", i);
+            EXPECT_TRUE(aggregator.Aggregate(event));
+            if (i == 0) {
+                firstEvents.emplace_back(event);
+            }
+        }
+    }
+    EXPECT_EQ(GetAggregatedNum() - aggregatedNum, 4u); // 4 means the events rolled up into the first ones
+
+    // the events of the other names are not aggregated
+    EXPECT_FALSE(aggregator.Aggregate(std::make_shared<AppEventPack>(TEST_EVENT_DOMAIN, "testName", 1)));
+
+    aggregator.Flush(true);
+    for (const auto& event : firstEvents) {
+        std::string eventStr = event->GetEventStr();
+        EXPECT_NE(eventStr.find("\"count\":3"), std::string::npos);
+        EXPECT_NE(eventStr.find("\"first_time\":"), std::string::npos);
+        EXPECT_NE(eventStr.find("\"last_time\":"), std::string::npos);
+    }
+
+    // the window 0 removes the rule
+    ASSERT_EQ(policy.SetEventPolicy({{"domain", TEST_EVENT_DOMAIN}, {"name", TEST_EVENT_NAME},
+        {"window", "0"}}), ErrorCode::HIAPPEVENT_VERIFY_SUCCESSFUL);
+    EXPECT_FALSE(aggregator.Aggregate(CreateAppEventPack()));
+    EventAggregationPolicy::ClearRules();
+    WaitForQueueTasks();
+}
+
+/**
+ * @tc.name: AppEventAggregator002
+ * @tc.desc: test the held events are kept in the crash ring with their counters when the process exits.
+ * @tc.type: FUNC
+ */
+HWTEST_F(HiAppEventCacheTest, AppEventAggregator002, TestSize.Level1)
+{
+    const std::string ringDir = TEST_DIR + "aggregator_ring_test";
+    constexpr uint32_t capacity = 4096;
+    ASSERT_TRUE(FileUtil::ForceCreateDirectory(ringDir));
+    auto& ring = AppEventCrashRing::GetInstance();
+    ASSERT_TRUE(ring.Open(ringDir, capacity));
+    EventAggregationPolicy policy;
+    ASSERT_EQ(policy.SetEventPolicy({{"domain", TEST_EVENT_DOMAIN}, {"name", TEST_EVENT_NAME},
+        {"window", "60000"}}), ErrorCode::HIAPPEVENT_VERIFY_SUCCESSFUL);
+    auto& aggregator = AppEventAggregator::GetInstance();
+    EXPECT_TRUE(aggregator.Aggregate(CreateAppEventPack()));
+    EXPECT_TRUE(aggregator.Aggregate(CreateAppEventPack()));
+    aggregator.FlushToRing();
+
+    // reopen the ring as the next startup, only the held event with its counter is recovered
+    ASSERT_TRUE(ring.Open(ringDir, capacity));
+    std::vector<std::shared_ptr<AppEventPack>> events;
+    ring.TakeRecoveredEvents(events);
+    ASSERT_EQ(events.size(), 1u);
+    EXPECT_NE(events[0]->GetParamStr().find("\"count\":2"), std::string::npos);
+
+    aggregator.Flush(true);
+    EventAggregationPolicy::ClearRules();
+    WaitForQueueTasks();
+    ring.Close();
+    (void)FileUtil::ForceRemoveDirectory(ringDir);
+}
+
+/**
+ * @tc.name: AppEventAggregator003
+ * @tc.desc: test the flushed event stays in the crash ring while it waits in the write queue.
+ * @tc.type: FUNC
+ */
+HWTEST_F(HiAppEventCacheTest, AppEventAggregator003, TestSize.Level1)
+{
+    const std::string ringDir = TEST_DIR + "aggregator_flush_test";
+    constexpr uint32_t capacity = 4096;
+    ASSERT_TRUE(FileUtil::ForceCreateDirectory(ringDir));
+    auto& ring = AppEventCrashRing::GetInstance();
+    ASSERT_TRUE(ring.Open(ringDir, capacity));
+    EventAggregationPolicy policy;
+    ASSERT_EQ(policy.SetEventPolicy({{"domain", TEST_EVENT_DOMAIN}, {"name", TEST_EVENT_NAME},
+        {"window", "60000"}}), ErrorCode::HIAPPEVENT_VERIFY_SUCCESSFUL);
+    auto& aggregator = AppEventAggregator::GetInstance();
+    EXPECT_TRUE(aggregator.Aggregate(CreateAppEventPack()));
+    EXPECT_TRUE(aggregator.Aggregate(CreateAppEventPack()));
+
+    // block the queue, so that the flushed event is not written yet
+    auto promise = std::make_shared<std::promise<void>>();
+    auto future = promise->get_future().share();
+    AppEventObserverMgr::GetInstance().SubmitTaskToFFRTQueue([future] {
+        future.wait();
+        }, "test_block");
+    aggregator.Flush(true);
+    EXPECT_EQ(AppEventWriteQueue::GetInstance().GetSize(), 1u);
+
+    // reopen the ring as the next startup after a crash, the queued event is recovered with its counter
+    ASSERT_TRUE(ring.Open(ringDir, capacity));
+    std::vector<std::shared_ptr<AppEventPack>> events;
+    ring.TakeRecoveredEvents(events);
+    ASSERT_EQ(events.size(), 1u);
+    EXPECT_NE(events[0]->GetParamStr().find("\"count\":2"), std::string::npos);
+
+    promise->set_value();
+    EventAggregationPolicy::ClearRules();
+    WaitForQueueTasks();
+    ring.ReleaseRecoveredEvents();
+    ring.Close();
+    (void)FileUtil::ForceRemoveDirectory(ringDir);
+}
+
+/**
+ * @tc.name: AppEventCrashRing001
+ * @tc.desc: test the pending events of the crash ring are recovered in order after reopening.
+ * @tc.type: FUNC
+ */
+HWTEST_F(HiAppEventCacheTest, AppEventCrashRing001, TestSize.Level1)
+{
+    const std::string ringDir = TEST_DIR + "crash_ring_test";
+    constexpr uint32_t capacity = 4096;
+    ASSERT_TRUE(FileUtil::ForceCreateDirectory(ringDir));
+    auto& ring = AppEventCrashRing::GetInstance();
+    ASSERT_TRUE(ring.Open(ringDir, capacity));
+    EXPECT_FALSE(ring.Open(ringDir, 1000)); // 1000 means a capacity which is not a power of two
+    std::vector<uint32_t> tokens;
+    for (int i = 0; i < 3; ++i) { // 3 means the number of events
+        auto event = CreateAppEventPack();
+        event->AddParam("index", i);
+        tokens.emplace_back(ring.Append(*event));
+        EXPECT_NE(tokens.back(), AppEventCrashRing::INVALID_TOKEN);
+    }
+    ring.Complete(tokens[1]);
+
+    // reopen the ring as the next startup after a crash
+    ASSERT_TRUE(ring.Open(ringDir, capacity));
+    std::vector<std::shared_ptr<AppEventPack>> events;
+    ring.TakeRecoveredEvents(events);
+    ASSERT_EQ(events.size(), 2u);
+    EXPECT_EQ(events[0]->GetDomain(), TEST_EVENT_DOMAIN);
+    EXPECT_EQ(events[0]->GetType(), TEST_EVENT_TYPE);
+    EXPECT_NE(events[0]->GetParamStr().find("\"index\":0"), std::string::npos);
+    EXPECT_NE(events[1]->GetParamStr().find("\"index\":2"), std::string::npos);
+
+    // the oldest records are overwritten once the ring wraps
+    std::string record(capacity / 8, 'a'); // 8 means the size of a record is an eighth of the ring
+    EXPECT_EQ(ring.Append(std::string(capacity, 'a').c_str(), capacity), AppEventCrashRing::INVALID_TOKEN);
+    for (int i = 0; i < 20; ++i) { // 20 means more records than the ring can hold
+        EXPECT_NE(ring.Append(record.c_str(), record.size()), AppEventCrashRing::INVALID_TOKEN);
+    }
+    auto event = CreateAppEventPack();
+    EXPECT_NE(ring.Append(*event), AppEventCrashRing::INVALID_TOKEN);
+    ASSERT_TRUE(ring.Open(ringDir, capacity));
+    events.clear();
+    ring.TakeRecoveredEvents(events);
+    ASSERT_EQ(events.size(), 1u);
+    EXPECT_EQ(events[0]->GetName(), TEST_EVENT_NAME);
+
+    ring.Close();
+    EXPECT_EQ(ring.Append(*event), AppEventCrashRing::INVALID_TOKEN);
+    (void)FileUtil::ForceRemoveDirectory(ringDir);
+}
+
+/**
+ * @tc.name: AppEventCrashRing002
+ * @tc.desc: test the ring of another process is recovered after its owner exits, and removed after it is released.
+ * @tc.type: FUNC
+ */
+HWTEST_F(HiAppEventCacheTest, AppEventCrashRing002, TestSize.Level1)
+{
+    const std::string ringDir = TEST_DIR + "crash_ring_owner_test";
+    constexpr uint32_t capacity = 4096;
+    ASSERT_TRUE(FileUtil::ForceCreateDirectory(ringDir));
+    auto& ring = AppEventCrashRing::GetInstance();
+    ASSERT_TRUE(ring.Open(ringDir, capacity));
+    EXPECT_NE(ring.Append(*CreateAppEventPack()), AppEventCrashRing::INVALID_TOKEN);
+    ring.Close();
+
+    // take the ring as the one of another live process, which holds the lock of it
+    std::vector<std::string> files;
+    FileUtil::GetDirFiles(ringDir, files);
+    ASSERT_EQ(files.size(), 1u);
+    std::string ownPath = files[0];
+    std::string otherPath = FileUtil::GetFilePathByDir(ringDir, "inflight_events_other");
+    ASSERT_EQ(rename(ownPath.c_str(), otherPath.c_str()), 0);
+    int otherFd = open(otherPath.c_str(), O_RDONLY | O_CLOEXEC);
+    ASSERT_GE(otherFd, 0);
+    ASSERT_EQ(flock(otherFd, LOCK_EX | LOCK_NB), 0);
+    ASSERT_TRUE(ring.Open(ringDir, capacity));
+    std::vector<std::shared_ptr<AppEventPack>> events;
+    ring.TakeRecoveredEvents(events);
+    EXPECT_TRUE(events.empty());
+    EXPECT_TRUE(FileUtil::IsFileExists(otherPath));
+
+    // the ring is recovered once the other process exits, and it is kept until the events are written
+    close(otherFd);
+    ASSERT_TRUE(ring.Open(ringDir, capacity));
+    ring.TakeRecoveredEvents(events);
+    ASSERT_EQ(events.size(), 1u);
+    EXPECT_EQ(events[0]->GetName(), TEST_EVENT_NAME);
+    EXPECT_TRUE(FileUtil::IsFileExists(otherPath));
+
+    // the recovered ring stays locked, so it is not recovered again before it is released
+    ASSERT_TRUE(ring.Open(ringDir, capacity));
+    events.clear();
+    ring.TakeRecoveredEvents(events);
+    EXPECT_TRUE(events.empty());
+    ring.ReleaseRecoveredEvents();
+    EXPECT_FALSE(FileUtil::IsFileExists(otherPath));
+
+    ring.Close();
+    (void)FileUtil::ForceRemoveDirectory(ringDir);
+}
+
+/**
+ * @tc.name: AppEventSharedRing001
+ * @tc.desc: test the events published into the shared ring are consumed in order with the pid and tid.
+ * @tc.type: FUNC
+ */
+HWTEST_F(HiAppEventCacheTest, AppEventSharedRing001, TestSize.Level1)
+{
+    const std::string ringDir = TEST_DIR + "ipc_test";
+    constexpr uint32_t capacity = 4096;
+    constexpr int testPid = 12345;
+    auto& ring = AppEventSharedRing::GetInstance();
+    auto event = CreateAppEventPack();
+    EXPECT_FALSE(ring.Publish(*event)); // the multi-process mode is off by default
+    ASSERT_TRUE(ring.Open(ringDir, capacity));
+    for (int i = 0; i < 3; ++i) { // 3 means the number of events
+        event = CreateAppEventPack();
+        event->SetPid(testPid);
+        event->SetTid(i);
+        EXPECT_TRUE(ring.Append(*event));
+    }
+    std::vector<std::shared_ptr<AppEventPack>> events;
+    EXPECT_EQ(ring.Consume(events, 2), 2u); // 2 means the max number to consume
+    EXPECT_EQ(ring.Consume(events, 10), 1u); // 10 means the max number to consume
+    ASSERT_EQ(events.size(), 3u);
+    for (int i = 0; i < 3; ++i) { // 3 means the number of events
+        EXPECT_EQ(events[i]->GetPid(), testPid);
+        EXPECT_EQ(events[i]->GetTid(), i);
+        EXPECT_EQ(events[i]->GetName(), TEST_EVENT_NAME);
+    }
+
+    // a full ring rejects the event instead of overwriting the records, and the records wrap around correctly
+    event->AddParam("payload", std::string(capacity / 8, 'a')); // 8 means an eighth of the ring
+    int appendNum = 0;
+    while (ring.Append(*event)) {
+        ++appendNum;
+    }
+    EXPECT_GT(appendNum, 0);
+    EXPECT_LT(appendNum, 8); // 8 means the ring can not hold more events
+    for (int i = 0; i < 20; ++i) { // 20 means enough rounds to wrap the ring
+        events.clear();
+        EXPECT_EQ(ring.Consume(events, 1), 1u);
+        EXPECT_EQ(events[0]->GetParamStr(), event->GetParamStr());
+        EXPECT_TRUE(ring.Append(*event));
+    }
+    events.clear();
+    EXPECT_EQ(ring.Consume(events, 10), static_cast<size_t>(appendNum)); // 10 means the max number to consume
+
+    EXPECT_TRUE(ring.IsOwner());
+    ring.Close();
+    EXPECT_FALSE(ring.Append(*event));
+    (void)FileUtil::ForceRemoveDirectory(ringDir);
+}
+
+/**
+ * @tc.name: AppEventSharedRing002
+ * @tc.desc: test a record left unfinished is skipped only after its writer has died.
+ * @tc.type: FUNC
+ */
+HWTEST_F(HiAppEventCacheTest, AppEventSharedRing002, TestSize.Level1)
+{
+    const std::string ringDir = TEST_DIR + "ipc_skip_test";
+    constexpr uint32_t capacity = 4096;
+    constexpr int pollNum = 10;
+    auto& ring = AppEventSharedRing::GetInstance();
+    ASSERT_TRUE(ring.Open(ringDir, capacity));
+
+    // the record without a header waits as long as a writer, which may have reserved it, is alive
+    ReserveSharedRecord(ringDir, 0);
+    EXPECT_TRUE(ring.Append(*CreateAppEventPack()));
+    std::vector<std::shared_ptr<AppEventPack>> events;
+    for (int i = 0; i < pollNum; ++i) {
+        EXPECT_EQ(ring.Consume(events, 1), 0u);
+    }
+    // the writer lock is released with the ring, and then no writer is alive
+    ring.Close();
+    ASSERT_TRUE(ring.Open(ringDir, capacity));
+    EXPECT_EQ(ring.Consume(events, 1), 1u);
+
+    // the record being written by a dead process is skipped at once
+    pid_t deadPid = fork();
+    if (deadPid == 0) {
+        _exit(0);
+    }
+    ASSERT_GT(deadPid, 0);
+    ASSERT_EQ(waitpid(deadPid, nullptr, 0), deadPid);
+    ReserveSharedRecord(ringDir, deadPid);
+    EXPECT_TRUE(ring.Append(*CreateAppEventPack()));
+    EXPECT_EQ(ring.Consume(events, 1), 1u);
+
+    // the record being written by a live process is never skipped
+    ReserveSharedRecord(ringDir, getpid());
+    EXPECT_TRUE(ring.Append(*CreateAppEventPack()));
+    for (int i = 0; i < pollNum; ++i) {
+        EXPECT_EQ(ring.Consume(events, 1), 0u);
+    }
+    ASSERT_EQ(events.size(), 2u);
+    EXPECT_EQ(events[0]->GetName(), TEST_EVENT_NAME);
+
+    ring.Close();
+    (void)FileUtil::ForceRemoveDirectory(ringDir);
+}
+
+/**
+ * @tc.name: AppEventSharedRing003
+ * @tc.desc: test the owner drains the ring as soon as an event rings the doorbell.
+ * @tc.type: FUNC
+ */
+HWTEST_F(HiAppEventCacheTest, AppEventSharedRing003, TestSize.Level1)
+{
+    const std::string ringDir = TEST_DIR + "ipc_doorbell_test";
+    constexpr uint32_t capacity = 4096;
+    constexpr int maxWaitNum = 100;
+    auto& ring = AppEventSharedRing::GetInstance();
+    ASSERT_TRUE(ring.Open(ringDir, capacity));
+    ASSERT_TRUE(ring.IsOwner());
+
+    // block the queue, so that the drained event stays in the write queue
+    auto promise = std::make_shared<std::promise<void>>();
+    auto future = promise->get_future().share();
+    AppEventObserverMgr::GetInstance().SubmitTaskToFFRTQueue([future] {
+        future.wait();
+        }, "test_block");
+    auto& queue = AppEventWriteQueue::GetInstance();
+    EXPECT_TRUE(ring.Append(*CreateAppEventPack()));
+    for (int i = 0; i < maxWaitNum && queue.GetSize() == 0; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10)); // 10 means the interval to check the queue
+    }
+    EXPECT_EQ(queue.GetSize(), 1u);
+    std::vector<std::shared_ptr<AppEventPack>> events;
+    EXPECT_EQ(ring.Consume(events, 1), 0u);
+
+    promise->set_value();
+    WaitForQueueTasks();
+    ring.Close();
+    EXPECT_FALSE(ring.IsOwner());
+    (void)FileUtil::ForceRemoveDirectory(ringDir);
+}
@@ -1153,4 +1153,30 @@ HWTEST_F(HiAppEventInnerApiTest, HiAppEventInnerApiTest032, TestSize.Level1)
     };
     AppEventProcessorMgr::AddProcessorAsync(config, cb);
     sleep(1); // Ensure that the asynchronous task is executed.
-}
\ No newline at end of file
+}
+
+/**
+ * @tc.name: HiAppEventInnerApiTest033
+ * @tc.desc: test that the processor id stays valid before and after the db is ready.
+ * @tc.type: FUNC
+ */
+HWTEST_F(HiAppEventInnerApiTest, HiAppEventInnerApiTest033, TestSize.Level1)
+{
+    ReportConfig config = {
+        .name = "test_processor",
+        .routeInfo = "test_routeInfo",
+    };
+    int64_t processorId1 = AppEventProcessorMgr::AddProcessor(config);
+    ASSERT_GT(processorId1, 0);
+    CheckSameConfig(processorId1, config);
+    ASSERT_EQ(AppEventProcessorMgr::RemoveProcessor(processorId1), 0);
+
+    int64_t processorId2 = AppEventProcessorMgr::AddProcessor(config);
+    ASSERT_GT(processorId2, 0);
+    sleep(1); // Ensure that the processor is bound to the db.
+    CheckSameConfig(processorId2, config);
+    ASSERT_EQ(AppEventProcessorMgr::AddProcessor(config), processorId2);
+    ASSERT_EQ(AppEventProcessorMgr::RemoveProcessor(processorId2), 0);
+    ReportConfig realConfig;
+    ASSERT_NE(AppEventProcessorMgr::GetProcessorConfig(processorId2, realConfig), 0);
+}
@@ -24,6 +24,7 @@
 #include "hiappevent_base.h"
 #include "hiappevent_facade.h"
 #include "hiappevent_test_common.h"
+#include "ndk_app_event_arena.h"
 #include "ndk_app_event_processor.h"
 #include "ndk_app_event_processor_service.h"
 #include "processor/test_processor.h"
@@ -1058,3 +1059,47 @@ HWTEST_F(HiAppEventNativeTest, HiAppEventNDKTest036, TestSize.Level0)
     res = OH_HiAppEvent_ReportFrameworkMemAnomaly(OH_KMP_KOTLIN, frameworkVersion.c_str(), description.c_str());
     ASSERT_EQ(res, HIAPPEVENT_REPORT_FREQUENCY_EXCEEDED);
 }
+
+/**
+ * @tc.name: HiAppEventNDKTest037
+ * @tc.desc: check the events laid out by the arena are grouped by name, and the arena is reused by the next build.
+ * @tc.type: FUNC
+ */
+HWTEST_F(HiAppEventNativeTest, HiAppEventNDKTest037, TestSize.Level0)
+{
+    /**
+     * @tc.steps: step1. build the groups of the events with two names.
+     * @tc.steps: step2. check the groups and the events in them.
+     * @tc.steps: step3. build the json strings of the events with the same arena and check them.
+     */
+    std::vector<std::shared_ptr<AppEventPack>> events;
+    for (const char* name : {"name_b", "name_a", "name_b"}) {
+        auto event = std::make_shared<AppEventPack>(TEST_DOMAIN_NAME, name, SECURITY);
+        event->AddParam(TEST_EVENT_PARAM_KEY, static_cast<int16_t>(1));
+        events.emplace_back(event);
+    }
+    NdkAppEventArena arena;
+    const HiAppEvent_AppEventGroup* groups = nullptr;
+    ASSERT_EQ(arena.BuildEventGroups(events, groups), 2); // 2: name_a and name_b
+    ASSERT_TRUE(groups != nullptr);
+    EXPECT_STREQ(groups[0].name, "name_a");
+    ASSERT_EQ(groups[0].infoLen, 1);
+    EXPECT_STREQ(groups[1].name, "name_b");
+    ASSERT_EQ(groups[1].infoLen, 2); // 2: the events named name_b
+    for (uint32_t i = 0; i < 2; ++i) { // 2: the num of groups
+        for (uint32_t j = 0; j < groups[i].infoLen; ++j) {
+            const auto& info = groups[i].appEventInfos[j];
+            EXPECT_STREQ(info.domain, TEST_DOMAIN_NAME);
+            EXPECT_STREQ(info.name, groups[i].name);
+            EXPECT_EQ(info.type, SECURITY);
+            EXPECT_EQ(strncmp(info.params, TEST_EVENT_PARAM, TEST_EVENT_PARAM_LENGTH), 0);
+        }
+    }
+
+    const char* const* eventStrs = arena.BuildEventStrs(events);
+    ASSERT_TRUE(eventStrs != nullptr);
+    for (size_t i = 0; i < events.size(); ++i) {
+        EXPECT_EQ(eventStrs[i], events[i]->GetEventStr());
+    }
+    arena.Trim();
+}
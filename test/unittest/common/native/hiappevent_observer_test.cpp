@@ -16,9 +16,11 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include "app_event_predicate.h"
 #include "app_event_watcher.h"
 #include "application_context.h"
 #include "file_util.h"
+#include "hiappevent_base.h"
 #include "os_event_listener.h"
 #include "time_util.h"
 
@@ -343,4 +345,99 @@ HWTEST_F(HiAppEventObserverTest, AppEventWatcher005, TestSize.Level0)
     appEventWatcher.SetFiltersStr(validFilter);
     EXPECT_EQ(appEventWatcher.GetFiltersStr(), validFilter);
 }
+
+/**
+ * @tc.name: AppEventWatcher006
+ * @tc.desc: test AppEventWatcher GetFiltersStr and SetFiltersStr func with the filter condition
+ * @tc.type: FUNC
+ */
+HWTEST_F(HiAppEventObserverTest, AppEventWatcher006, TestSize.Level0)
+{
+    HiAppEvent::AppEventFilter filter("testDomain", 0xff); // 0xff means all types
+    ASSERT_TRUE(filter.SetCondition("duration > 100"));
+    AppEventWatcher appEventWatcher("testName");
+    appEventWatcher.SetFilters({filter});
+    std::string filtersStr = appEventWatcher.GetFiltersStr();
+    EXPECT_NE(filtersStr.find(R"("condition":"duration > 100")"), std::string::npos);
+
+    AppEventWatcher restoredWatcher("testName");
+    restoredWatcher.SetFiltersStr(filtersStr);
+    auto filters = restoredWatcher.GetFilters();
+    ASSERT_EQ(filters.size(), 1u);
+    EXPECT_EQ(filters[0].GetCondition(), "duration > 100");
+    auto event = std::make_shared<AppEventPack>("testDomain", "testName", 1);
+    event->AddParam("duration", 200);
+    EXPECT_TRUE(filters[0].IsValidEvent(event));
+
+    // the filter with an invalid condition never matches any event instead of being dropped
+    AppEventWatcher invalidWatcher("testName");
+    invalidWatcher.SetFiltersStr(R"([{"domain":"testDomain","names":[],"types":255,"condition":"duration >"}])");
+    filters = invalidWatcher.GetFilters();
+    ASSERT_EQ(filters.size(), 1u);
+    EXPECT_FALSE(filters[0].IsValidEvent(event));
+}
+
+/**
+ * @tc.name: AppEventPredicate001
+ * @tc.desc: test compiling the valid and invalid conditions
+ * @tc.type: FUNC
+ */
+HWTEST_F(HiAppEventObserverTest, AppEventPredicate001, TestSize.Level0)
+{
+    const std::vector<std::string> validConditions = {
+        "foreground",
+        "foreground == true",
+        "!foreground && duration >= 500",
+        "(tag == 'a\\'b' || tag != \"c\") && !(count < -1.5e3)",
+        "$ext_1 <= 10",
+    };
+    for (const auto& condition : validConditions) {
+        auto predicate = HiAppEvent::AppEventPredicate::Compile(condition);
+        ASSERT_NE(predicate, nullptr) << condition;
+        EXPECT_EQ(predicate->ToString(), condition);
+    }
+    const std::vector<std::string> invalidConditions = {
+        "", "duration >", "duration > abc", "(foreground", "foreground)", "a == 'b", "1 == duration",
+        "a && || b", "a = 1", std::string(1025, 'a'), std::string(20, '(') + "a" + std::string(20, ')'),
+    };
+    for (const auto& condition : invalidConditions) {
+        EXPECT_EQ(HiAppEvent::AppEventPredicate::Compile(condition), nullptr) << condition;
+    }
+}
+
+/**
+ * @tc.name: AppEventPredicate002
+ * @tc.desc: test evaluating the condition on the typed params and on the params json
+ * @tc.type: FUNC
+ */
+HWTEST_F(HiAppEventObserverTest, AppEventPredicate002, TestSize.Level0)
+{
+    auto predicate = HiAppEvent::AppEventPredicate::Compile(
+        "foreground == true && (duration > 500 || tag == 'x') && !hidden && level != 3");
+    ASSERT_NE(predicate, nullptr);
+
+    AppEventPack typedEvent("OS", "APP_FREEZE", 1);
+    typedEvent.AddParam("foreground", true);
+    typedEvent.AddParam("duration", static_cast<int64_t>(600));
+    typedEvent.AddParam("level", 2);
+    EXPECT_TRUE(predicate->Evaluate(typedEvent));
+    typedEvent.AddParam("hidden", 1);
+    EXPECT_FALSE(predicate->Evaluate(typedEvent));
+
+    AppEventPack jsonEvent("OS", "APP_FREEZE", 1);
+    jsonEvent.SetParamStr(R"({"stack":{"a":[1,"}"]},"foreground":true,"duration":10,"tag":"x","level":2})");
+    EXPECT_TRUE(predicate->Evaluate(jsonEvent));
+    jsonEvent.SetParamStr(R"({"foreground":true,"duration":10,"tag":"y","level":2})");
+    EXPECT_FALSE(predicate->Evaluate(jsonEvent));
+
+    // the comparison with an absent param or a value of another type is false
+    jsonEvent.SetParamStr(R"({"foreground":true,"duration":"600","tag":"x"})");
+    EXPECT_FALSE(predicate->Evaluate(jsonEvent));
+    jsonEvent.SetParamStr(R"({"foreground":"true","duration":600,"level":2})");
+    EXPECT_FALSE(predicate->Evaluate(jsonEvent));
+
+    // the escaped chars of the json strings are compared after they are unescaped
+    jsonEvent.SetParamStr(R"({"foreground":true,"duration":10,"tag":"\u0078","level":2})");
+    EXPECT_TRUE(predicate->Evaluate(jsonEvent));
+}
 }  // OHOS
\ No newline at end of file
@@ -17,6 +17,7 @@
 #include <gtest/gtest.h>
 
 #include "application_context.h"
+#include "event_aggregation_policy.h"
 #include "event_policy_mgr.h"
 #define private public
 #include "event_policy_utils.h"
@@ -503,4 +504,38 @@ HWTEST_F(HiAppEventPolicyTest, HiAppEventPolicyTest013, TestSize.Level0)
     status = EventPolicyMgr::GetInstance().GetEventPageSwitchStatus("APP_CRASH");
     EXPECT_TRUE(status);
 }
+
+/**
+ * @tc.name: HiAppEventPolicyTest014
+ * @tc.desc: test the SetEventPolicy func with eventAggregationPolicy.
+ * @tc.type: FUNC
+ * @tc.require: issueI5NTOS
+ */
+HWTEST_F(HiAppEventPolicyTest, HiAppEventPolicyTest014, TestSize.Level0)
+{
+    const std::string policyName = "eventAggregationPolicy";
+    auto& policyMgr = EventPolicyMgr::GetInstance();
+    EXPECT_EQ(policyMgr.SetEventPolicy(policyName, {{"name", "test_name"}, {"window", "1000"}}),
+        ErrorCode::ERROR_INVALID_PARAM_VALUE);
+    EXPECT_EQ(policyMgr.SetEventPolicy(policyName, {{"domain", "test_domain"}, {"name", "test_name"}}),
+        ErrorCode::ERROR_INVALID_PARAM_VALUE);
+    EXPECT_EQ(policyMgr.SetEventPolicy(policyName, {{"domain", "test_domain"}, {"name", "test_name"},
+        {"window", "-1"}}), ErrorCode::ERROR_INVALID_PARAM_VALUE);
+    EXPECT_EQ(policyMgr.SetEventPolicy(policyName, {{"domain", "test_domain"}, {"name", "test_name"},
+        {"window", "1000"}, {"keys", "page,,button"}}), ErrorCode::ERROR_INVALID_PARAM_VALUE);
+    EXPECT_FALSE(EventAggregationPolicy::HasRules());
+
+    EXPECT_EQ(policyMgr.SetEventPolicy(policyName, {{"domain", "test_domain"}, {"name", "*"},
+        {"window", "1000"}, {"keys", "page,button"}}), ErrorCode::HIAPPEVENT_VERIFY_SUCCESSFUL);
+    AggregationRule rule;
+    ASSERT_TRUE(EventAggregationPolicy::GetRule("test_domain", "test_name", rule));
+    EXPECT_EQ(rule.window, 1000u);
+    ASSERT_EQ(rule.keys.size(), 2u);
+    EXPECT_EQ(rule.keys[0], "page");
+    EXPECT_FALSE(EventAggregationPolicy::GetRule("test_domain2", "test_name", rule));
+
+    EXPECT_EQ(policyMgr.SetEventPolicy(policyName, {{"domain", "test_domain"}, {"name", "*"}, {"window", "0"}}),
+        ErrorCode::HIAPPEVENT_VERIFY_SUCCESSFUL);
+    EXPECT_FALSE(EventAggregationPolicy::HasRules());
+}
 }  // OHOS
\ No newline at end of file
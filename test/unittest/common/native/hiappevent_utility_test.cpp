@@ -13,12 +13,17 @@
  * limitations under the License.
  */
 #include <iostream>
+#include <thread>
+#include <vector>
 
 #include <gtest/gtest.h>
 #include <json/json.h>
 
+#include "compress_util.h"
 #include "event_json_util.h"
 #include "file_util.h"
+#include "pipeline_metrics.h"
+#include "string_util.h"
 
 using namespace testing::ext;
 using namespace OHOS::HiviewDFX;
@@ -26,6 +31,40 @@ using namespace OHOS::HiviewDFX;
 namespace {
 const std::string TEST_DIR = "/data/test/hiappevent/";
 
+std::string EscapeByChar(const std::string& str)
+{
+    std::string result;
+    for (char c : str) {
+        switch (c) {
+            case '\\':
+                result.append("\\\\");
+                break;
+            case '\"':
+                result.append("\\\"");
+                break;
+            case '\b':
+                result.append("\\b");
+                break;
+            case '\f':
+                result.append("\\f");
+                break;
+            case '\n':
+                result.append("\\n");
+                break;
+            case '\r':
+                result.append("\\r");
+                break;
+            case '\t':
+                result.append("\\t");
+                break;
+            default:
+                result.push_back(c);
+                break;
+        }
+    }
+    return result;
+}
+
 class HiAppEventUtilityTest : public testing::Test {
 public:
     void SetUp() {}
@@ -183,4 +222,211 @@ HWTEST_F(HiAppEventUtilityTest, HiAppEventFileUtil001, TestSize.Level1)
     isDir = FileUtil::IsDirectory(testDir);
     EXPECT_FALSE(isDir);
     std::cout << "HiAppEventFileUtil001 end" << std::endl;
-}
\ No newline at end of file
+}
+/**
+ * @tc.name: HiAppEventPipelineMetrics001
+ * @tc.desc: test the counters and gauges of pipeline metrics.
+ * @tc.type: FUNC
+ */
+HWTEST_F(HiAppEventUtilityTest, HiAppEventPipelineMetrics001, TestSize.Level1)
+{
+    std::cout << "HiAppEventPipelineMetrics001 start" << std::endl;
+    PipelineMetrics::Reset();
+    PipelineMetrics::Add(PipelineMetrics::WRITE_SUBMITTED);
+    PipelineMetrics::Add(PipelineMetrics::BYTES_WRITTEN, 100); // 100 means bytes
+    PipelineMetrics::Add(PipelineMetrics::COUNTER_NUM);
+    PipelineMetrics::UpdateGauge(PipelineMetrics::QUEUE_DEPTH, 2); // 2 means tasks in queue
+    PipelineMetrics::UpdateGauge(PipelineMetrics::QUEUE_DEPTH, -1);
+
+    PipelineMetrics::Snapshot snapshot;
+    PipelineMetrics::GetSnapshot(snapshot);
+    EXPECT_EQ(snapshot.counters[PipelineMetrics::WRITE_SUBMITTED], 1u);
+    EXPECT_EQ(snapshot.counters[PipelineMetrics::BYTES_WRITTEN], 100u);
+    EXPECT_EQ(snapshot.counters[PipelineMetrics::EVENTS_WRITTEN], 0u);
+    EXPECT_EQ(snapshot.gauges[PipelineMetrics::QUEUE_DEPTH], 1);
+    EXPECT_STREQ(PipelineMetrics::GetName(PipelineMetrics::BYTES_WRITTEN), "bytes_written");
+    EXPECT_STREQ(PipelineMetrics::GetName(PipelineMetrics::COUNTER_NUM), "");
+
+    PipelineMetrics::Reset();
+    PipelineMetrics::GetSnapshot(snapshot);
+    EXPECT_EQ(snapshot.counters[PipelineMetrics::WRITE_SUBMITTED], 0u);
+    EXPECT_EQ(snapshot.gauges[PipelineMetrics::QUEUE_DEPTH], 1);
+    PipelineMetrics::UpdateGauge(PipelineMetrics::QUEUE_DEPTH, -1);
+    std::cout << "HiAppEventPipelineMetrics001 end" << std::endl;
+}
+
+/**
+ * @tc.name: HiAppEventPipelineMetrics002
+ * @tc.desc: test the buckets of pipeline metrics histograms.
+ * @tc.type: FUNC
+ */
+HWTEST_F(HiAppEventUtilityTest, HiAppEventPipelineMetrics002, TestSize.Level1)
+{
+    std::cout << "HiAppEventPipelineMetrics002 start" << std::endl;
+    PipelineMetrics::Reset();
+    PipelineMetrics::Observe(PipelineMetrics::DB_OP, 0);
+    PipelineMetrics::Observe(PipelineMetrics::DB_OP, 1);
+    PipelineMetrics::Observe(PipelineMetrics::DB_OP, 3); // 3 means cost in us
+    PipelineMetrics::Observe(PipelineMetrics::DB_OP, 1000); // 1000 means cost in us
+    PipelineMetrics::Observe(PipelineMetrics::DB_OP, UINT64_MAX >> 1);
+    {
+        PipelineMetrics::StageTimer timer(PipelineMetrics::VERIFY);
+    }
+
+    PipelineMetrics::Snapshot snapshot;
+    PipelineMetrics::GetSnapshot(snapshot);
+    const auto& dbOp = snapshot.histograms[PipelineMetrics::DB_OP];
+    EXPECT_EQ(dbOp.count, 5u); // 5 means observed times
+    EXPECT_EQ(dbOp.buckets[0], 1u);
+    EXPECT_EQ(dbOp.buckets[1], 1u);
+    EXPECT_EQ(dbOp.buckets[2], 1u); // 3us is in [2, 4)
+    EXPECT_EQ(dbOp.buckets[10], 1u); // 1000us is in [512, 1024)
+    EXPECT_EQ(dbOp.buckets[PipelineMetrics::BUCKET_NUM - 1], 1u);
+    EXPECT_EQ(snapshot.histograms[PipelineMetrics::VERIFY].count, 1u);
+    EXPECT_EQ(snapshot.histograms[PipelineMetrics::ON_REPORT].count, 0u);
+    std::cout << "HiAppEventPipelineMetrics002 end" << std::endl;
+}
+
+/**
+ * @tc.name: HiAppEventPipelineMetrics003
+ * @tc.desc: test recording pipeline metrics from multiple threads.
+ * @tc.type: FUNC
+ */
+HWTEST_F(HiAppEventUtilityTest, HiAppEventPipelineMetrics003, TestSize.Level1)
+{
+    std::cout << "HiAppEventPipelineMetrics003 start" << std::endl;
+    PipelineMetrics::Reset();
+    constexpr int threadNum = 16;
+    constexpr int recordNum = 10000;
+    std::vector<std::thread> threads;
+    for (int i = 0; i < threadNum; ++i) {
+        threads.emplace_back([] {
+            for (int j = 0; j < recordNum; ++j) {
+                PipelineMetrics::Add(PipelineMetrics::EVENTS_STORED);
+                PipelineMetrics::Observe(PipelineMetrics::DB_INSERT, j);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    PipelineMetrics::Snapshot snapshot;
+    PipelineMetrics::GetSnapshot(snapshot);
+    uint64_t expectedNum = static_cast<uint64_t>(threadNum) * recordNum;
+    EXPECT_EQ(snapshot.counters[PipelineMetrics::EVENTS_STORED], expectedNum);
+    EXPECT_EQ(snapshot.histograms[PipelineMetrics::DB_INSERT].count, expectedNum);
+    uint64_t bucketSum = 0;
+    for (auto num : snapshot.histograms[PipelineMetrics::DB_INSERT].buckets) {
+        bucketSum += num;
+    }
+    EXPECT_EQ(bucketSum, expectedNum);
+    std::cout << "HiAppEventPipelineMetrics003 end" << std::endl;
+}
+
+/**
+ * @tc.name: HiAppEventStringUtil001
+ * @tc.desc: test the escaped chars are found and escaped at any position of the string.
+ * @tc.type: FUNC
+ */
+HWTEST_F(HiAppEventUtilityTest, HiAppEventStringUtil001, TestSize.Level1)
+{
+    constexpr size_t maxLen = 80; // 80 means longer than two rounds of 32 bytes
+    const std::string escapeChars = "\\\"\b\f\n\r\t";
+    for (size_t len = 0; len <= maxLen; ++len) {
+        std::string clean(len, 'a');
+        EXPECT_EQ(StringUtil::FindFirstEscapeChar(clean.data(), clean.size()), len);
+        const char* data = clean.data();
+        StringUtil::EscapeJsonString(clean);
+        EXPECT_EQ(clean.data(), data); // nothing is allocated for a clean string
+        for (size_t pos = 0; pos < len; ++pos) {
+            for (char c : escapeChars) {
+                std::string str(len, 'a');
+                str[pos] = c;
+                str[len - 1] = (pos == len - 1) ? c : '\t';
+                EXPECT_EQ(StringUtil::FindFirstEscapeChar(str.data(), str.size()), pos);
+                std::string expected = EscapeByChar(str);
+                StringUtil::EscapeJsonString(str);
+                EXPECT_EQ(str, expected);
+            }
+        }
+    }
+
+    // the vertical tab, the other control chars and the utf-8 bytes are kept
+    std::string str = "\v\x01\x1f\x7f\xe4\xbd\xa0" + std::string(32, '\x0b'); // 32 means one round
+    EXPECT_EQ(StringUtil::FindFirstEscapeChar(str.data(), str.size()), str.size());
+}
+
+/**
+ * @tc.name: HiAppEventStringUtil002
+ * @tc.desc: test the ascii char classes used by the name checks.
+ * @tc.type: FUNC
+ */
+HWTEST_F(HiAppEventUtilityTest, HiAppEventStringUtil002, TestSize.Level1)
+{
+    constexpr int charNum = 256;
+    for (int i = 0; i < charNum; ++i) {
+        char c = static_cast<char>(i);
+        bool isAlpha = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+        bool isDigit = c >= '0' && c <= '9';
+        EXPECT_EQ(StringUtil::IsAsciiAlpha(c), isAlpha);
+        EXPECT_EQ(StringUtil::IsAsciiAlnum(c), isAlpha || isDigit);
+    }
+}
+
+/**
+ * @tc.name: HiAppEventStringUtil003
+ * @tc.desc: test unescaping the chars of a json string.
+ * @tc.type: FUNC
+ */
+HWTEST_F(HiAppEventUtilityTest, HiAppEventStringUtil003, TestSize.Level1)
+{
+    std::string in = R"(a\"\\\/\b\f\n\r\t\u0041\u00e9\u4E2D\ud83d\ude00)";
+    std::string out;
+    EXPECT_TRUE(StringUtil::UnescapeJsonChars(in.data(), in.size(), out));
+    EXPECT_EQ(out, "a\"\\/\b\f\n\r\tA\xc3\xa9\xe4\xb8\xad\xf0\x9f\x98\x80");
+
+    std::vector<std::string> malformedStrs = { "\\", "\\x", "\\u12", "\\u12zz", "\\ud83d", "\\ud83d\\u0041" };
+    for (const auto& str : malformedStrs) {
+        out.clear();
+        EXPECT_FALSE(StringUtil::UnescapeJsonChars(str.data(), str.size(), out)) << str;
+    }
+}
+
+/**
+ * @tc.name: HiAppEventCompressUtil001
+ * @tc.desc: test compressing and decompressing the params by the codecs.
+ * @tc.type: FUNC
+ */
+HWTEST_F(HiAppEventUtilityTest, HiAppEventCompressUtil001, TestSize.Level1)
+{
+    EXPECT_EQ(CompressUtil::SelectCodec("OS", 10), CompressUtil::CODEC_NONE); // 10 means a small size
+    EXPECT_EQ(CompressUtil::SelectCodec("OS", 4096), CompressUtil::CODEC_DEFLATE_OS_DICT); // 4096 means a large size
+    EXPECT_EQ(CompressUtil::SelectCodec("test_domain", 4096), CompressUtil::CODEC_DEFLATE); // 4096 means a large size
+
+    std::string data = "{\"crash_type\":\"NativeCrash\",\"hilog\":[";
+    for (int i = 0; i < 100; ++i) { // 100 means num of lines
+        data += "\"I C01234/test_tag: line " + std::to_string(i) + "\",";
+    }
+    data += "\"end\"]}";
+    for (int codec : { CompressUtil::CODEC_DEFLATE, CompressUtil::CODEC_DEFLATE_OS_DICT }) {
+        std::vector<uint8_t> compressed;
+        ASSERT_TRUE(CompressUtil::Compress(data, codec, compressed));
+        EXPECT_LT(compressed.size(), data.size());
+        std::string decompressed;
+        ASSERT_TRUE(CompressUtil::Decompress(compressed.data(), compressed.size(), codec, decompressed));
+        EXPECT_EQ(decompressed, data);
+
+        // the truncated data is not accepted
+        EXPECT_FALSE(CompressUtil::Decompress(compressed.data(), compressed.size() / 2, codec, decompressed));
+        if (codec == CompressUtil::CODEC_DEFLATE_OS_DICT) {
+            // the data refers to the dictionary, which is missing without the codec
+            EXPECT_FALSE(CompressUtil::Decompress(compressed.data(), compressed.size(), CompressUtil::CODEC_DEFLATE,
+                decompressed));
+        }
+    }
+
+    std::vector<uint8_t> compressed;
+    EXPECT_FALSE(CompressUtil::Compress(data, CompressUtil::CODEC_NONE, compressed));
+    EXPECT_FALSE(CompressUtil::Compress("abc", CompressUtil::CODEC_DEFLATE, compressed));
+}
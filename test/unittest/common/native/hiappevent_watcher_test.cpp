@@ -90,6 +90,40 @@ private:
     int triggerTimes = 0;
 };
 
+class AppEventMemoryWatcherTest : public AppEventWatcher {
+public:
+    AppEventMemoryWatcherTest(const std::string& name, const std::vector<AppEventFilter>& filters,
+        TriggerCondition cond) : AppEventWatcher(name, filters, cond) {}
+
+    bool IsRealTimeEvent(std::shared_ptr<AppEventPack> event) override
+    {
+        return true;
+    }
+
+    bool CanDeliverFromMemory() override
+    {
+        return true;
+    }
+
+    bool OnEventsFromMemory(const std::vector<std::shared_ptr<AppEventPack>>& events) override
+    {
+        for (const auto& event : events) {
+            EXPECT_EQ(event->GetSeq(), 0);
+        }
+        memoryEventNum += events.size();
+        return isDeliverable;
+    }
+
+    void OnEvents(const std::vector<std::shared_ptr<AppEventPack>>& events) override
+    {
+        storedEventNum += events.size();
+    }
+
+    bool isDeliverable = true;
+    size_t memoryEventNum = 0;
+    size_t storedEventNum = 0;
+};
+
 void BuildSimpleFilters(std::vector<AppEventFilter>& filters)
 {
     filters.emplace_back(AppEventFilter(TEST_DOMAIN, 0xff)); // 0xff means all types
@@ -292,6 +326,47 @@ HWTEST_F(HiAppEventWatcherTest, HiAppEventWatcherTest004, TestSize.Level3)
     std::cout << "HiAppEventWatcherTest004 end" << std::endl;
 }
 
+/**
+ * @tc.name: HiAppEventWatcherTest005
+ * @tc.desc: Test the real-time events are delivered from memory, and only stored when the delivery fails.
+ * @tc.type: FUNC
+ */
+HWTEST_F(HiAppEventWatcherTest, HiAppEventWatcherTest005, TestSize.Level3)
+{
+    /**
+     * @tc.steps: step1. add the watcher which takes the real-time events from memory.
+     * @tc.steps: step2. handle the event delivered, and check the event is not stored.
+     * @tc.steps: step3. handle the event failed to be delivered, and check the event is stored for the watcher.
+     */
+    std::cout << "HiAppEventWatcherTest005 start" << std::endl;
+
+    std::vector<AppEventFilter> filters;
+    BuildSimpleFilters(filters);
+    auto watcher = std::make_shared<AppEventMemoryWatcherTest>(TEST_WATCHER, filters, BuildCondition(0, 0, 0));
+    int64_t observerSeq = AppEventObserverFacade::AddWatcher(watcher);
+    ASSERT_GT(observerSeq, 0);
+
+    std::vector<std::shared_ptr<AppEventPack>> events = { CreateAppEventPack() };
+    AppEventObserverFacade::HandleEvents(events);
+    EXPECT_EQ(watcher->memoryEventNum, 1);
+    EXPECT_EQ(watcher->storedEventNum, 0);
+    EXPECT_EQ(events[0]->GetSeq(), 0);
+
+    watcher->isDeliverable = false;
+    events = { CreateAppEventPack() };
+    AppEventObserverFacade::HandleEvents(events);
+    EXPECT_EQ(watcher->memoryEventNum, 2);
+    EXPECT_EQ(watcher->storedEventNum, 0);
+    EXPECT_GT(events[0]->GetSeq(), 0);
+    std::vector<std::shared_ptr<AppEventPack>> storedEvents;
+    ASSERT_EQ(AppEventStoreFacade::QueryEvents(storedEvents, observerSeq), 0);
+    ASSERT_EQ(storedEvents.size(), 1);
+    EXPECT_EQ(storedEvents[0]->GetSeq(), events[0]->GetSeq());
+
+    AppEventObserverFacade::RemoveObserver(watcher->GetName());
+    std::cout << "HiAppEventWatcherTest005 end" << std::endl;
+}
+
 /**
  * @tc.name: HiAppEventConfigTest001
  * @tc.desc: Test to add watcher onReceive.